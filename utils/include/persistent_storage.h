@@ -16,6 +16,10 @@
 #ifndef OHOS_ROSEN_WINDOW_PERSISTENT_STORAGE_H
 #define OHOS_ROSEN_WINDOW_PERSISTENT_STORAGE_H
 
+#include <atomic>
+#include <mutex>
+#include <set>
+
 #include "preferences.h"
 #include "preferences_helper.h"
 
@@ -23,6 +27,10 @@
 #include "wm_common_inner.h"
 
 namespace OHOS {
+namespace AppExecFwk {
+class EventHandler;
+} // namespace AppExecFwk
+
 namespace Rosen {
 using PersistentPerference = NativePreferences::Preferences;
 class PersistentStorage {
@@ -39,9 +47,28 @@ public:
     static bool HasKey(const std::string& key, PersistentStorageType storageType);
     static void Delete(const std::string& key, PersistentStorageType storageType);
 
+    /*
+     * Insert and Delete change the preferences in memory, changes reach the disk in batches on the flush handler.
+     * Without a handler every change is flushed asynchronously by the preferences. Flush cancels the pending
+     * batch and writes it synchronously, call it before the service stops.
+     */
+    static void SetFlushHandler(const std::shared_ptr<AppExecFwk::EventHandler>& handler);
+    static void Flush();
+
 private:
     static std::shared_ptr<PersistentPerference> GetPreference(PersistentStorageType storageType);
+    static void MarkDirty(PersistentStorageType storageType);
+    static void FlushDirty(bool isSync);
+    static void PostFlushTask();
+    static void RemoveFlushTask();
+
     static std::map<PersistentStorageType, std::string> storagePath_;
+    static std::mutex flushMutex_;
+    static std::set<PersistentStorageType> dirtyTypes_;
+    static uint32_t pendingWriteCount_;
+    static bool isFlushTaskPosted_;
+    static std::shared_ptr<AppExecFwk::EventHandler> flushHandler_;
+    static std::atomic<uint64_t> flushCount_;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -16,9 +16,11 @@
 #ifndef OHOS_VSYNC_STATION_H
 #define OHOS_VSYNC_STATION_H
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include <event_handler.h>
 
@@ -34,13 +36,51 @@ class FrameRateRange;
 using FrameRateLinkerId = uint64_t;
 using NodeId = uint64_t;
 
+/*
+ * Lock free multi producer queue of vsync callbacks. Producers push without blocking, the vsync thread
+ * takes everything pushed so far once per frame. A small table of the callbacks queued in the current
+ * frame lets a repeated push of the same callback return without queueing it again.
+ */
+class VsyncCallbackQueue {
+public:
+    VsyncCallbackQueue() = default;
+    ~VsyncCallbackQueue();
+    VsyncCallbackQueue(const VsyncCallbackQueue&) = delete;
+    VsyncCallbackQueue& operator=(const VsyncCallbackQueue&) = delete;
+
+    void Push(const std::shared_ptr<VsyncCallback>& vsyncCallback);
+
+    /*
+     * Appends the callbacks pushed so far in push order, a callback pushed several times is appended once.
+     * Only called by one consumer thread.
+     */
+    void PopAll(std::vector<std::shared_ptr<VsyncCallback>>& vsyncCallbacks);
+    void Clear();
+    bool IsEmpty() const { return head_.load() == nullptr; }
+
+private:
+    struct Node {
+        std::shared_ptr<VsyncCallback> vsyncCallback;
+        Node* next = nullptr;
+    };
+    static constexpr size_t QUEUED_SLOT_COUNT = 64;
+    static constexpr size_t QUEUED_SLOT_PROBE_COUNT = 4;
+
+    bool MarkQueued(VsyncCallback* vsyncCallback);
+    void ClearQueued();
+
+    std::atomic<Node*> head_ { nullptr };
+    std::array<std::atomic<VsyncCallback*>, QUEUED_SLOT_COUNT> queuedSlots_ {};
+    std::unordered_set<VsyncCallback*> poppedCallbacks_;
+};
+
 class VsyncStation : public std::enable_shared_from_this<VsyncStation> {
 public:
     explicit VsyncStation(NodeId nodeId,
         const std::shared_ptr<AppExecFwk::EventHandler>& vsyncHandler = nullptr);
     ~VsyncStation();
 
-    bool HasRequestedVsync() const { return hasRequestedVsync_; }
+    bool HasRequestedVsync() const { return hasRequestedVsync_.load(); }
     bool IsVsyncReceiverCreated();
     void RequestVsync(const std::shared_ptr<VsyncCallback>& vsyncCallback);
     int64_t GetVSyncPeriod();
@@ -74,15 +114,20 @@ private:
     bool isFirstVsyncRequest_ = true;
     bool isFirstVsyncBack_ = true;
     bool destroyed_ = false;
-    bool hasRequestedVsync_ = false;
     std::shared_ptr<VSyncReceiver> receiver_ = nullptr;
     std::shared_ptr<RSFrameRateLinker> frameRateLinker_ = nullptr;
-    using Callbacks = std::unordered_set<std::shared_ptr<VsyncCallback>>;
-    Callbacks vsyncCallbacks_;
     std::shared_ptr<FrameRateRange> lastFrameRateRange_ = nullptr;
     int32_t lastAnimatorExpectedFrameRate_ = 0;
     // Above guarded by mutex_
 
+    /*
+     * Callbacks are pushed without taking mutex_, only the request of a new vsync takes it, once per frame.
+     * The vsync thread swaps the queued callbacks into dispatchingCallbacks_ before dispatching them.
+     */
+    std::atomic<bool> hasRequestedVsync_ { false };
+    VsyncCallbackQueue vsyncCallbacks_;
+    std::vector<std::shared_ptr<VsyncCallback>> dispatchingCallbacks_;
+
     std::atomic<int32_t> requestVsyncTimes_ {0};
 };
 } // namespace Rosen
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_XML_CONFIG_CACHE_H
+#define OHOS_ROSEN_XML_CONFIG_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "xml_config_base.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Identifies the xml file a cache was built from and the software build that parsed it.
+ */
+struct XmlConfigSource {
+    uint64_t size = 0;
+    int64_t mtimeNs = 0;
+    uint64_t hash = 0;
+    uint64_t buildFingerprint = 0;
+};
+
+class XmlConfigCacheWriter {
+public:
+    void WriteUint32(uint32_t value);
+    void WriteUint64(uint64_t value);
+    void WriteInt32(int32_t value);
+    void WriteBool(bool value);
+    void WriteFloat(float value);
+    void WriteString(const std::string& value);
+    void WriteInts(const std::vector<int>& value);
+    void WriteFloats(const std::vector<float>& value);
+    void WriteStrings(const std::vector<std::string>& value);
+    void WriteConfigItem(const XmlConfigBase::ConfigItem& item);
+    const std::vector<uint8_t>& GetData() const { return data_; }
+
+private:
+    void WriteBytes(const void* bytes, size_t size);
+    void WriteConfigMap(const std::map<std::string, XmlConfigBase::ConfigItem>& value);
+
+    std::vector<uint8_t> data_;
+};
+
+/*
+ * Reads what XmlConfigCacheWriter wrote. Every read is bounds checked and fails instead of reading past the end.
+ */
+class XmlConfigCacheReader {
+public:
+    XmlConfigCacheReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    bool ReadUint32(uint32_t& value);
+    bool ReadUint64(uint64_t& value);
+    bool ReadInt32(int32_t& value);
+    bool ReadBool(bool& value);
+    bool ReadFloat(float& value);
+    bool ReadString(std::string& value);
+    bool ReadInts(std::vector<int>& value);
+    bool ReadFloats(std::vector<float>& value);
+    bool ReadStrings(std::vector<std::string>& value);
+    bool ReadConfigItem(XmlConfigBase::ConfigItem& item);
+    bool IsEnd() const { return offset_ == size_; }
+
+private:
+    bool ReadBytes(void* bytes, size_t size);
+    bool ReadCount(uint32_t& count, size_t minElementSize);
+    bool ReadConfigItem(XmlConfigBase::ConfigItem& item, uint32_t depth);
+    bool ReadConfigMap(std::map<std::string, XmlConfigBase::ConfigItem>& value, uint32_t depth);
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t offset_ = 0;
+};
+
+/*
+ * Binary cache of a parsed xml config. The cache is memory mapped on load and only used when the
+ * size, mtime and hash of the xml file, the software version and the schema version of the caller
+ * all match, callers parse the xml otherwise and store a new cache.
+ */
+class XmlConfigCache {
+public:
+    using Decoder = std::function<bool(XmlConfigCacheReader& reader)>;
+
+    static bool GetSource(const std::string& xmlPath, XmlConfigSource& source);
+    static bool Load(const std::string& cachePath, const XmlConfigSource& source, uint32_t schemaVersion,
+        const Decoder& decoder);
+    static bool Store(const std::string& cachePath, const XmlConfigSource& source, uint32_t schemaVersion,
+        const XmlConfigCacheWriter& writer);
+    static uint64_t Hash(const uint8_t* data, size_t size);
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_XML_CONFIG_CACHE_H
@@ -15,10 +15,15 @@
 
 #include "persistent_storage.h"
 
+#include <event_handler.h>
+
 namespace OHOS {
 namespace Rosen {
 namespace {
 constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "PersistentStorage"};
+constexpr uint32_t FLUSH_BATCH_SIZE = 16;
+constexpr int64_t FLUSH_DELAY_MS = 500;
+const std::string FLUSH_TASK_NAME = "PersistentStorageFlushTask";
 }
 
 template void PersistentStorage::Insert(const std::string&, const int&, PersistentStorageType);
@@ -30,6 +35,12 @@ std::map<PersistentStorageType, std::string> PersistentStorage::storagePath_ = {
     { PersistentStorageType::ASPECT_RATIO, "/data/service/el1/public/window/window_aspect_ratio.xml" },
     { PersistentStorageType::MAXIMIZE_STATE, "/data/service/el1/public/window/window_maximize_state.xml" },
 };
+std::mutex PersistentStorage::flushMutex_;
+std::set<PersistentStorageType> PersistentStorage::dirtyTypes_;
+uint32_t PersistentStorage::pendingWriteCount_ = 0;
+bool PersistentStorage::isFlushTaskPosted_ = false;
+std::shared_ptr<AppExecFwk::EventHandler> PersistentStorage::flushHandler_;
+std::atomic<uint64_t> PersistentStorage::flushCount_ { 0 };
 
 bool PersistentStorage::HasKey(const std::string& key, PersistentStorageType storageType)
 {
@@ -53,10 +64,94 @@ void PersistentStorage::Delete(const std::string& key, PersistentStorageType sto
         return;
     }
     pref->Delete(key);
-    pref->Flush();
+    MarkDirty(storageType);
     WLOGD("[PersistentStorage] Delete key %{public}s", key.c_str());
 }
 
+void PersistentStorage::MarkDirty(PersistentStorageType storageType)
+{
+    {
+        std::lock_guard<std::mutex> lock(flushMutex_);
+        dirtyTypes_.insert(storageType);
+        pendingWriteCount_++;
+        if (pendingWriteCount_ < FLUSH_BATCH_SIZE && flushHandler_ != nullptr) {
+            PostFlushTask();
+            if (isFlushTaskPosted_) {
+                return;
+            }
+        }
+        RemoveFlushTask();
+    }
+    FlushDirty(false);
+}
+
+void PersistentStorage::PostFlushTask()
+{
+    if (isFlushTaskPosted_) {
+        return;
+    }
+    auto task = [] {
+        {
+            std::lock_guard<std::mutex> lock(flushMutex_);
+            isFlushTaskPosted_ = false;
+        }
+        FlushDirty(false);
+    };
+    isFlushTaskPosted_ = flushHandler_->PostTask(task, FLUSH_TASK_NAME, FLUSH_DELAY_MS);
+    if (!isFlushTaskPosted_) {
+        WLOGFW("[PersistentStorage] post flush task failed");
+    }
+}
+
+void PersistentStorage::RemoveFlushTask()
+{
+    if (flushHandler_ != nullptr && isFlushTaskPosted_) {
+        flushHandler_->RemoveTask(FLUSH_TASK_NAME);
+    }
+    isFlushTaskPosted_ = false;
+}
+
+void PersistentStorage::SetFlushHandler(const std::shared_ptr<AppExecFwk::EventHandler>& handler)
+{
+    std::lock_guard<std::mutex> lock(flushMutex_);
+    RemoveFlushTask();
+    flushHandler_ = handler;
+}
+
+void PersistentStorage::Flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(flushMutex_);
+        RemoveFlushTask();
+    }
+    FlushDirty(true);
+}
+
+void PersistentStorage::FlushDirty(bool isSync)
+{
+    std::set<PersistentStorageType> dirtyTypes;
+    {
+        std::lock_guard<std::mutex> lock(flushMutex_);
+        dirtyTypes.swap(dirtyTypes_);
+        pendingWriteCount_ = 0;
+    }
+    for (auto storageType : dirtyTypes) {
+        auto pref = GetPreference(storageType);
+        if (!pref) {
+            continue;
+        }
+        if (isSync) {
+            pref->FlushSync();
+        } else {
+            pref->Flush();
+        }
+        flushCount_++;
+    }
+    if (!dirtyTypes.empty()) {
+        WLOGD("[PersistentStorage] flushed %{public}zu storages, sync: %{public}d", dirtyTypes.size(), isSync);
+    }
+}
+
 std::shared_ptr<PersistentPerference> PersistentStorage::GetPreference(PersistentStorageType storageType)
 {
     auto iter = storagePath_.find(storageType);
@@ -93,8 +188,9 @@ void PersistentStorage::Insert(const std::string& key, const T& value, Persisten
         }
         default:
             WLOGFW("[PersistentStorage] Unknown storage type!");
+            return;
     }
-    pref->Flush();
+    MarkDirty(storageType);
 }
 
 template <typename T>
@@ -38,6 +38,88 @@ constexpr int64_t VSYNC_TIME_OUT_MILLISECONDS = 600;
 constexpr int32_t DEFAULT_ANIMATOR_EXPECTED_FRAME_RATE = -1;
 }
 
+VsyncCallbackQueue::~VsyncCallbackQueue()
+{
+    Clear();
+}
+
+void VsyncCallbackQueue::Push(const std::shared_ptr<VsyncCallback>& vsyncCallback)
+{
+    if (!MarkQueued(vsyncCallback.get())) {
+        return;
+    }
+    auto node = new Node { vsyncCallback, head_.load() };
+    while (!head_.compare_exchange_weak(node->next, node)) {
+    }
+}
+
+bool VsyncCallbackQueue::MarkQueued(VsyncCallback* vsyncCallback)
+{
+    if (vsyncCallback == nullptr) {
+        return true;
+    }
+    // a slot is only cleared after its node is taken, so a marked callback is dispatched after this push
+    size_t index = (reinterpret_cast<uintptr_t>(vsyncCallback) >> 4) % QUEUED_SLOT_COUNT;
+    for (size_t i = 0; i < QUEUED_SLOT_PROBE_COUNT; i++) {
+        auto& slot = queuedSlots_[(index + i) % QUEUED_SLOT_COUNT];
+        VsyncCallback* queued = slot.load();
+        if (queued == vsyncCallback) {
+            return false;
+        }
+        if (queued == nullptr) {
+            if (slot.compare_exchange_strong(queued, vsyncCallback)) {
+                return true;
+            }
+            if (queued == vsyncCallback) {
+                return false;
+            }
+        }
+    }
+    // no free slot, PopAll still drops the duplicates
+    return true;
+}
+
+void VsyncCallbackQueue::ClearQueued()
+{
+    for (auto& slot : queuedSlots_) {
+        slot.store(nullptr);
+    }
+}
+
+void VsyncCallbackQueue::PopAll(std::vector<std::shared_ptr<VsyncCallback>>& vsyncCallbacks)
+{
+    // the latest pushed node is the head, reverse the taken nodes into push order
+    Node* node = head_.exchange(nullptr);
+    ClearQueued();
+    Node* reversed = nullptr;
+    while (node != nullptr) {
+        Node* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+    while (reversed != nullptr) {
+        Node* next = reversed->next;
+        if (poppedCallbacks_.insert(reversed->vsyncCallback.get()).second) {
+            vsyncCallbacks.push_back(std::move(reversed->vsyncCallback));
+        }
+        delete reversed;
+        reversed = next;
+    }
+    poppedCallbacks_.clear();
+}
+
+void VsyncCallbackQueue::Clear()
+{
+    Node* node = head_.exchange(nullptr);
+    ClearQueued();
+    while (node != nullptr) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
 VsyncStation::VsyncStation(NodeId nodeId, const std::shared_ptr<AppExecFwk::EventHandler>& vsyncHandler)
     : nodeId_(nodeId),
       vsyncHandler_(vsyncHandler),
@@ -115,23 +197,28 @@ std::shared_ptr<VSyncReceiver> VsyncStation::GetOrCreateVsyncReceiverLocked()
 __attribute__((no_sanitize("cfi"))) void VsyncStation::RequestVsync(
     const std::shared_ptr<VsyncCallback>& vsyncCallback)
 {
+    // the vsync thread clears hasRequestedVsync_ before taking the callbacks, so a callback pushed
+    // while a vsync is requested is either taken by that vsync or sees the flag cleared
+    vsyncCallbacks_.Push(vsyncCallback);
+    if (hasRequestedVsync_.load()) {
+        TLOGD(WmsLogTag::WMS_MAIN, "Vsync has requested, nodeId: %{public}" PRIu64, nodeId_);
+        return;
+    }
     std::shared_ptr<VSyncReceiver> receiver;
     {
         std::lock_guard<std::mutex> lock(mutex_);
         // check if receiver is ready
         receiver = GetOrCreateVsyncReceiverLocked();
         if (receiver == nullptr) {
+            vsyncCallbacks_.Clear();
             return;
         }
 
-        vsyncCallbacks_.insert(vsyncCallback);
-
         // if Vsync has been requested, just wait callback or timeout
-        if (hasRequestedVsync_) {
+        if (hasRequestedVsync_.exchange(true)) {
             TLOGD(WmsLogTag::WMS_MAIN, "Vsync has requested, nodeId: %{public}" PRIu64, nodeId_);
             return;
         }
-        hasRequestedVsync_ = true;
 
         if (isFirstVsyncRequest_) {
             isFirstVsyncRequest_ = false;
@@ -174,38 +261,36 @@ int64_t VsyncStation::GetVSyncPeriod()
 void VsyncStation::RemoveCallback()
 {
     TLOGI(WmsLogTag::WMS_MAIN, "in");
-    std::lock_guard<std::mutex> lock(mutex_);
-    vsyncCallbacks_.clear();
+    vsyncCallbacks_.Clear();
 }
 
 void VsyncStation::VsyncCallbackInner(int64_t timestamp, int64_t frameCount)
 {
     HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER,
         "OnVsyncCallback %" PRId64 ":%" PRId64, timestamp, frameCount);
-    Callbacks vsyncCallbacks;
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        hasRequestedVsync_ = false;
-        vsyncCallbacks = std::move(vsyncCallbacks_);
-        vsyncCallbacks_.clear();
+        hasRequestedVsync_.store(false);
         vsyncHandler_->RemoveTask(vsyncTimeoutTaskName_);
         if (isFirstVsyncBack_) {
             isFirstVsyncBack_ = false;
             TLOGI(WmsLogTag::WMS_MAIN, "First vsync has come back, nodeId: %{public}" PRIu64, nodeId_);
         }
     }
-    for (const auto& callback: vsyncCallbacks) {
+    vsyncCallbacks_.PopAll(dispatchingCallbacks_);
+    for (const auto& callback: dispatchingCallbacks_) {
         if (callback && callback->onCallback) {
             callback->onCallback(timestamp, frameCount);
         }
     }
+    dispatchingCallbacks_.clear();
 }
 
 void VsyncStation::OnVsyncTimeOut()
 {
     TLOGW(WmsLogTag::WMS_MAIN, "in");
     std::lock_guard<std::mutex> lock(mutex_);
-    hasRequestedVsync_ = false;
+    hasRequestedVsync_.store(false);
 }
 
 std::shared_ptr<RSFrameRateLinker> VsyncStation::GetFrameRateLinker()
@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "xml_config_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <parameters.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr uint32_t CACHE_MAGIC = 0x47464357; // "WCFG"
+constexpr uint32_t CACHE_FORMAT_VERSION = 2;
+constexpr uint32_t MAX_CONFIG_DEPTH = 32;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+constexpr int64_t NS_PER_SECOND = 1000000000;
+constexpr size_t READ_BUFFER_SIZE = 4096;
+const std::string SOFTWARE_VERSION_PARAM = "const.product.software.version";
+
+struct CacheHeader {
+    uint32_t magic = CACHE_MAGIC;
+    uint32_t formatVersion = CACHE_FORMAT_VERSION;
+    uint32_t schemaVersion = 0;
+    uint32_t reserved = 0;
+    uint64_t sourceSize = 0;
+    int64_t sourceMtimeNs = 0;
+    uint64_t sourceHash = 0;
+    uint64_t buildFingerprint = 0;
+    uint64_t payloadSize = 0;
+    uint64_t payloadHash = 0;
+};
+static_assert(sizeof(CacheHeader) == 64, "cache header layout changed");
+
+uint64_t HashUpdate(uint64_t hash, const uint8_t* data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+bool WriteAll(int fd, const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t written = write(fd, bytes, size);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+} // namespace
+
+void XmlConfigCacheWriter::WriteBytes(const void* bytes, size_t size)
+{
+    const auto* begin = static_cast<const uint8_t*>(bytes);
+    data_.insert(data_.end(), begin, begin + size);
+}
+
+void XmlConfigCacheWriter::WriteUint32(uint32_t value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+void XmlConfigCacheWriter::WriteUint64(uint64_t value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+void XmlConfigCacheWriter::WriteInt32(int32_t value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+void XmlConfigCacheWriter::WriteBool(bool value)
+{
+    data_.push_back(value ? 1 : 0);
+}
+
+void XmlConfigCacheWriter::WriteFloat(float value)
+{
+    WriteBytes(&value, sizeof(value));
+}
+
+void XmlConfigCacheWriter::WriteString(const std::string& value)
+{
+    WriteUint32(static_cast<uint32_t>(value.size()));
+    WriteBytes(value.data(), value.size());
+}
+
+void XmlConfigCacheWriter::WriteInts(const std::vector<int>& value)
+{
+    WriteUint32(static_cast<uint32_t>(value.size()));
+    for (auto num : value) {
+        WriteInt32(num);
+    }
+}
+
+void XmlConfigCacheWriter::WriteFloats(const std::vector<float>& value)
+{
+    WriteUint32(static_cast<uint32_t>(value.size()));
+    for (auto num : value) {
+        WriteFloat(num);
+    }
+}
+
+void XmlConfigCacheWriter::WriteStrings(const std::vector<std::string>& value)
+{
+    WriteUint32(static_cast<uint32_t>(value.size()));
+    for (const auto& str : value) {
+        WriteString(str);
+    }
+}
+
+void XmlConfigCacheWriter::WriteConfigMap(const std::map<std::string, XmlConfigBase::ConfigItem>& value)
+{
+    WriteUint32(static_cast<uint32_t>(value.size()));
+    for (const auto& [key, item] : value) {
+        WriteString(key);
+        WriteConfigItem(item);
+    }
+}
+
+void XmlConfigCacheWriter::WriteConfigItem(const XmlConfigBase::ConfigItem& item)
+{
+    WriteUint32(static_cast<uint32_t>(item.type_));
+    switch (item.type_) {
+        case XmlConfigBase::ValueType::MAP:
+            WriteConfigMap(*item.mapValue_);
+            break;
+        case XmlConfigBase::ValueType::BOOL:
+            WriteBool(item.boolValue_);
+            break;
+        case XmlConfigBase::ValueType::STRING:
+            WriteString(item.stringValue_);
+            break;
+        case XmlConfigBase::ValueType::INTS:
+            WriteInts(*item.intsValue_);
+            break;
+        case XmlConfigBase::ValueType::FLOATS:
+            WriteFloats(*item.floatsValue_);
+            break;
+        case XmlConfigBase::ValueType::STRINGS:
+            WriteStrings(*item.stringsValue_);
+            break;
+        default:
+            break;
+    }
+    WriteBool(item.property_ != nullptr);
+    if (item.property_ != nullptr) {
+        WriteConfigMap(*item.property_);
+    }
+}
+
+bool XmlConfigCacheReader::ReadBytes(void* bytes, size_t size)
+{
+    if (size > size_ - offset_) {
+        return false;
+    }
+    if (size > 0) {
+        std::memcpy(bytes, data_ + offset_, size);
+    }
+    offset_ += size;
+    return true;
+}
+
+bool XmlConfigCacheReader::ReadCount(uint32_t& count, size_t minElementSize)
+{
+    if (!ReadUint32(count)) {
+        return false;
+    }
+    // a corrupted count must not turn into a huge allocation
+    return static_cast<uint64_t>(count) * minElementSize <= size_ - offset_;
+}
+
+bool XmlConfigCacheReader::ReadUint32(uint32_t& value)
+{
+    return ReadBytes(&value, sizeof(value));
+}
+
+bool XmlConfigCacheReader::ReadUint64(uint64_t& value)
+{
+    return ReadBytes(&value, sizeof(value));
+}
+
+bool XmlConfigCacheReader::ReadInt32(int32_t& value)
+{
+    return ReadBytes(&value, sizeof(value));
+}
+
+bool XmlConfigCacheReader::ReadBool(bool& value)
+{
+    uint8_t byte = 0;
+    if (!ReadBytes(&byte, sizeof(byte)) || byte > 1) {
+        return false;
+    }
+    value = byte == 1;
+    return true;
+}
+
+bool XmlConfigCacheReader::ReadFloat(float& value)
+{
+    return ReadBytes(&value, sizeof(value));
+}
+
+bool XmlConfigCacheReader::ReadString(std::string& value)
+{
+    uint32_t size = 0;
+    if (!ReadCount(size, sizeof(char))) {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data_ + offset_), size);
+    offset_ += size;
+    return true;
+}
+
+bool XmlConfigCacheReader::ReadInts(std::vector<int>& value)
+{
+    uint32_t count = 0;
+    if (!ReadCount(count, sizeof(int32_t))) {
+        return false;
+    }
+    value.resize(count);
+    for (auto& num : value) {
+        int32_t readNum = 0;
+        ReadInt32(readNum);
+        num = readNum;
+    }
+    return true;
+}
+
+bool XmlConfigCacheReader::ReadFloats(std::vector<float>& value)
+{
+    uint32_t count = 0;
+    if (!ReadCount(count, sizeof(float))) {
+        return false;
+    }
+    value.resize(count);
+    for (auto& num : value) {
+        ReadFloat(num);
+    }
+    return true;
+}
+
+bool XmlConfigCacheReader::ReadStrings(std::vector<std::string>& value)
+{
+    uint32_t count = 0;
+    if (!ReadCount(count, sizeof(uint32_t))) {
+        return false;
+    }
+    value.resize(count);
+    for (auto& str : value) {
+        if (!ReadString(str)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool XmlConfigCacheReader::ReadConfigMap(std::map<std::string, XmlConfigBase::ConfigItem>& value, uint32_t depth)
+{
+    uint32_t count = 0;
+    if (!ReadCount(count, sizeof(uint32_t))) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        std::string key;
+        if (!ReadString(key) || !ReadConfigItem(value[key], depth + 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool XmlConfigCacheReader::ReadConfigItem(XmlConfigBase::ConfigItem& item)
+{
+    return ReadConfigItem(item, 0);
+}
+
+bool XmlConfigCacheReader::ReadConfigItem(XmlConfigBase::ConfigItem& item, uint32_t depth)
+{
+    uint32_t type = 0;
+    if (depth > MAX_CONFIG_DEPTH || !ReadUint32(type)) {
+        return false;
+    }
+    bool ret = true;
+    switch (static_cast<XmlConfigBase::ValueType>(type)) {
+        case XmlConfigBase::ValueType::UNDIFINED:
+            break;
+        case XmlConfigBase::ValueType::MAP: {
+            item.SetValue(std::map<std::string, XmlConfigBase::ConfigItem>());
+            ret = ReadConfigMap(*item.mapValue_, depth);
+            break;
+        }
+        case XmlConfigBase::ValueType::BOOL: {
+            bool value = false;
+            ret = ReadBool(value);
+            item.SetValue(value);
+            break;
+        }
+        case XmlConfigBase::ValueType::STRING: {
+            std::string value;
+            ret = ReadString(value);
+            item.SetValue(value);
+            break;
+        }
+        case XmlConfigBase::ValueType::INTS: {
+            std::vector<int> value;
+            ret = ReadInts(value);
+            item.SetValue(value);
+            break;
+        }
+        case XmlConfigBase::ValueType::FLOATS: {
+            std::vector<float> value;
+            ret = ReadFloats(value);
+            item.SetValue(value);
+            break;
+        }
+        case XmlConfigBase::ValueType::STRINGS: {
+            std::vector<std::string> value;
+            ret = ReadStrings(value);
+            item.SetValue(value);
+            break;
+        }
+        default:
+            return false;
+    }
+    bool hasProperty = false;
+    if (!ret || !ReadBool(hasProperty)) {
+        return false;
+    }
+    if (hasProperty) {
+        std::map<std::string, XmlConfigBase::ConfigItem> property;
+        if (!ReadConfigMap(property, depth)) {
+            return false;
+        }
+        item.SetProperty(property);
+    }
+    return true;
+}
+
+uint64_t XmlConfigCache::Hash(const uint8_t* data, size_t size)
+{
+    return HashUpdate(FNV_OFFSET_BASIS, data, size);
+}
+
+bool XmlConfigCache::GetSource(const std::string& xmlPath, XmlConfigSource& source)
+{
+    int fd = open(xmlPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st = {};
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    uint64_t hash = FNV_OFFSET_BASIS;
+    uint8_t buffer[READ_BUFFER_SIZE];
+    ssize_t readSize = 0;
+    while ((readSize = read(fd, buffer, sizeof(buffer))) > 0) {
+        hash = HashUpdate(hash, buffer, static_cast<size_t>(readSize));
+    }
+    close(fd);
+    if (readSize < 0) {
+        return false;
+    }
+    source.size = static_cast<uint64_t>(st.st_size);
+    source.mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * NS_PER_SECOND + st.st_mtim.tv_nsec;
+    source.hash = hash;
+    // parsing code changes with the build even when the xml does not, an upgrade must not load an old cache
+    std::string softwareVersion = system::GetParameter(SOFTWARE_VERSION_PARAM, "");
+    source.buildFingerprint = Hash(reinterpret_cast<const uint8_t*>(softwareVersion.data()), softwareVersion.size());
+    return true;
+}
+
+bool XmlConfigCache::Load(const std::string& cachePath, const XmlConfigSource& source, uint32_t schemaVersion,
+    const Decoder& decoder)
+{
+    int fd = open(cachePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        TLOGI(WmsLogTag::DEFAULT, "no cache: %{public}s", cachePath.c_str());
+        return false;
+    }
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CacheHeader))) {
+        close(fd);
+        return false;
+    }
+    auto fileSize = static_cast<size_t>(st.st_size);
+    void* addr = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        TLOGE(WmsLogTag::DEFAULT, "mmap failed: %{public}s", cachePath.c_str());
+        return false;
+    }
+    const auto* data = static_cast<const uint8_t*>(addr);
+    CacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const uint8_t* payload = data + sizeof(header);
+    bool ret = header.magic == CACHE_MAGIC && header.formatVersion == CACHE_FORMAT_VERSION &&
+        header.schemaVersion == schemaVersion && header.sourceSize == source.size &&
+        header.sourceMtimeNs == source.mtimeNs && header.sourceHash == source.hash &&
+        header.buildFingerprint == source.buildFingerprint &&
+        header.payloadSize == fileSize - sizeof(header) &&
+        header.payloadHash == Hash(payload, static_cast<size_t>(header.payloadSize));
+    if (!ret) {
+        TLOGI(WmsLogTag::DEFAULT, "cache out of date: %{public}s", cachePath.c_str());
+    } else {
+        XmlConfigCacheReader reader(payload, static_cast<size_t>(header.payloadSize));
+        ret = decoder(reader) && reader.IsEnd();
+        if (!ret) {
+            TLOGE(WmsLogTag::DEFAULT, "decode failed: %{public}s", cachePath.c_str());
+        }
+    }
+    munmap(addr, fileSize);
+    return ret;
+}
+
+bool XmlConfigCache::Store(const std::string& cachePath, const XmlConfigSource& source, uint32_t schemaVersion,
+    const XmlConfigCacheWriter& writer)
+{
+    const auto& payload = writer.GetData();
+    CacheHeader header;
+    header.schemaVersion = schemaVersion;
+    header.sourceSize = source.size;
+    header.sourceMtimeNs = source.mtimeNs;
+    header.sourceHash = source.hash;
+    header.buildFingerprint = source.buildFingerprint;
+    header.payloadSize = payload.size();
+    header.payloadHash = Hash(payload.data(), payload.size());
+
+    // written aside and renamed, a reader never maps a half written cache
+    std::string tmpPath = cachePath + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP);
+    if (fd < 0) {
+        TLOGW(WmsLogTag::DEFAULT, "open failed: %{public}s", tmpPath.c_str());
+        return false;
+    }
+    bool ret = WriteAll(fd, &header, sizeof(header)) && WriteAll(fd, payload.data(), payload.size());
+    close(fd);
+    if (!ret || rename(tmpPath.c_str(), cachePath.c_str()) != 0) {
+        TLOGW(WmsLogTag::DEFAULT, "write failed: %{public}s", cachePath.c_str());
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    TLOGI(WmsLogTag::DEFAULT, "stored: %{public}s, size: %{public}zu", cachePath.c_str(), payload.size());
+    return true;
+}
+} // namespace Rosen
+} // namespace OHOS
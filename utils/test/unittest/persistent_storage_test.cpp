@@ -14,6 +14,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <event_handler.h>
 #include "persistent_storage.h"
 
 using namespace testing;
@@ -107,6 +108,84 @@ HWTEST_F(PersistentStorageTest, StorageOperate, TestSize.Level1)
     LOG_SetCallback(nullptr);
 }
 
+/**
+ * @tc.name: BatchedFlush
+ * @tc.desc: repeated writes are served from memory and reach the disk in batches
+ * @tc.type: FUNC
+ */
+HWTEST_F(PersistentStorageTest, BatchedFlush, TestSize.Level1)
+{
+    const std::string keyName = "batched_flush";
+    PersistentStorage::SetFlushHandler(
+        std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create("PersistentStorageTest")));
+    PersistentStorage::Flush();
+    uint64_t flushCount = PersistentStorage::flushCount_.load();
+    for (int32_t i = 0; i < 10; i++) {
+        PersistentStorage::Insert(keyName, i, PersistentStorageType::MAXIMIZE_STATE);
+    }
+    int32_t value = -1;
+    PersistentStorage::Get(keyName, value, PersistentStorageType::MAXIMIZE_STATE);
+    EXPECT_EQ(9, value);
+    EXPECT_TRUE(PersistentStorage::isFlushTaskPosted_);
+    PersistentStorage::Flush();
+    EXPECT_FALSE(PersistentStorage::isFlushTaskPosted_);
+    EXPECT_EQ(flushCount + 1, PersistentStorage::flushCount_.load());
+
+    // 32 writes flush twice at the batch size, each batch cancels its timer
+    flushCount = PersistentStorage::flushCount_.load();
+    for (int32_t i = 0; i < 32; i++) {
+        PersistentStorage::Insert(keyName, i, PersistentStorageType::MAXIMIZE_STATE);
+    }
+    EXPECT_FALSE(PersistentStorage::isFlushTaskPosted_);
+    PersistentStorage::Flush();
+    EXPECT_EQ(flushCount + 2, PersistentStorage::flushCount_.load());
+
+    PersistentStorage::Delete(keyName, PersistentStorageType::MAXIMIZE_STATE);
+    PersistentStorage::Flush();
+    PersistentStorage::SetFlushHandler(nullptr);
+}
+
+/**
+ * @tc.name: FlushWithoutHandler
+ * @tc.desc: without a flush handler every write is flushed right away
+ * @tc.type: FUNC
+ */
+HWTEST_F(PersistentStorageTest, FlushWithoutHandler, TestSize.Level1)
+{
+    const std::string keyName = "flush_without_handler";
+    PersistentStorage::SetFlushHandler(nullptr);
+    uint64_t flushCount = PersistentStorage::flushCount_.load();
+    PersistentStorage::Insert(keyName, 1, PersistentStorageType::MAXIMIZE_STATE);
+    PersistentStorage::Delete(keyName, PersistentStorageType::MAXIMIZE_STATE);
+    EXPECT_FALSE(PersistentStorage::isFlushTaskPosted_);
+    EXPECT_EQ(flushCount + 2, PersistentStorage::flushCount_.load());
+}
+
+/**
+ * @tc.name: DurabilityOrdering
+ * @tc.desc: a flush persists the last of several changes to a key
+ * @tc.type: FUNC
+ */
+HWTEST_F(PersistentStorageTest, DurabilityOrdering, TestSize.Level1)
+{
+    const std::string keyName = "durability_ordering";
+    const std::string path = PersistentStorage::storagePath_[PersistentStorageType::ASPECT_RATIO];
+    float ratio = 0;
+    PersistentStorage::Insert(keyName, 1.5F, PersistentStorageType::ASPECT_RATIO);
+    PersistentStorage::Delete(keyName, PersistentStorageType::ASPECT_RATIO);
+    PersistentStorage::Insert(keyName, 2.5F, PersistentStorageType::ASPECT_RATIO);
+    PersistentStorage::Flush();
+    NativePreferences::PreferencesHelper::RemovePreferencesFromCache(path);
+    PersistentStorage::Get(keyName, ratio, PersistentStorageType::ASPECT_RATIO);
+    EXPECT_EQ(2.5F, ratio);
+
+    PersistentStorage::Insert(keyName, 3.5F, PersistentStorageType::ASPECT_RATIO);
+    PersistentStorage::Delete(keyName, PersistentStorageType::ASPECT_RATIO);
+    PersistentStorage::Flush();
+    NativePreferences::PreferencesHelper::RemovePreferencesFromCache(path);
+    EXPECT_EQ(false, PersistentStorage::HasKey(keyName, PersistentStorageType::ASPECT_RATIO));
+}
+
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "xml_config_cache.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+using ConfigItem = XmlConfigBase::ConfigItem;
+constexpr uint32_t SCHEMA_VERSION = 7;
+const std::string XML_PATH = "/data/test/xml_config_cache_test.xml";
+const std::string CACHE_PATH = "/data/test/xml_config_cache_test.cache";
+}
+
+class XmlConfigCacheTest : public testing::Test {
+public:
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void XmlConfigCacheTest::SetUp()
+{
+    std::ofstream file(XML_PATH, std::ios::trunc);
+    file << "<Configs><decor enable=\"true\"></decor></Configs>";
+}
+
+void XmlConfigCacheTest::TearDown()
+{
+    std::remove(XML_PATH.c_str());
+    std::remove(CACHE_PATH.c_str());
+}
+
+namespace {
+ConfigItem MakeConfig()
+{
+    std::map<std::string, ConfigItem> property;
+    property["enable"].SetValue(true);
+    property["name"].SetValue(std::string("easeOut"));
+    std::map<std::string, ConfigItem> timing;
+    timing["duration"].SetValue(std::vector<int>({ 350 }));
+    timing["curve"].SetValue(std::vector<float>({ 0.2F, 0.0F, 0.2F, 1.0F }));
+    timing["curve"].SetProperty(property);
+    std::map<std::string, ConfigItem> root;
+    root["timing"].SetValue(timing);
+    root["supportedMode"].SetValue(std::vector<std::string>({ "fullScreen", "split" }));
+    root["decor"].SetProperty(property);
+    ConfigItem config;
+    config.SetValue(root);
+    return config;
+}
+
+std::vector<uint8_t> Encode(const ConfigItem& config)
+{
+    XmlConfigCacheWriter writer;
+    writer.WriteConfigItem(config);
+    return writer.GetData();
+}
+
+bool LoadConfig(const XmlConfigSource& source, uint32_t schemaVersion, ConfigItem& config)
+{
+    return XmlConfigCache::Load(CACHE_PATH, source, schemaVersion, [&config](XmlConfigCacheReader& reader) {
+        return reader.ReadConfigItem(config);
+    });
+}
+
+/**
+ * @tc.name: StoreAndLoad
+ * @tc.desc: a stored config is loaded back unchanged
+ * @tc.type: FUNC
+ */
+HWTEST_F(XmlConfigCacheTest, StoreAndLoad, TestSize.Level1)
+{
+    XmlConfigSource source;
+    ASSERT_TRUE(XmlConfigCache::GetSource(XML_PATH, source));
+    XmlConfigCacheWriter writer;
+    writer.WriteConfigItem(MakeConfig());
+    ASSERT_TRUE(XmlConfigCache::Store(CACHE_PATH, source, SCHEMA_VERSION, writer));
+
+    ConfigItem config;
+    ASSERT_TRUE(LoadConfig(source, SCHEMA_VERSION, config));
+    EXPECT_EQ(Encode(config), Encode(MakeConfig()));
+    EXPECT_EQ(config["timing"]["curve"].GetProp("name").stringValue_, "easeOut");
+    EXPECT_EQ((*config["supportedMode"].stringsValue_)[1], "split");
+}
+
+/**
+ * @tc.name: Invalidation
+ * @tc.desc: the cache is not used for another xml, another build, another schema or a corrupted payload
+ * @tc.type: FUNC
+ */
+HWTEST_F(XmlConfigCacheTest, Invalidation, TestSize.Level1)
+{
+    XmlConfigSource source;
+    ASSERT_TRUE(XmlConfigCache::GetSource(XML_PATH, source));
+    XmlConfigCacheWriter writer;
+    writer.WriteConfigItem(MakeConfig());
+    ASSERT_TRUE(XmlConfigCache::Store(CACHE_PATH, source, SCHEMA_VERSION, writer));
+
+    ConfigItem config;
+    EXPECT_FALSE(LoadConfig(source, SCHEMA_VERSION + 1, config));
+    XmlConfigSource changedSource = source;
+    changedSource.hash++;
+    EXPECT_FALSE(LoadConfig(changedSource, SCHEMA_VERSION, config));
+    changedSource = source;
+    changedSource.mtimeNs++;
+    EXPECT_FALSE(LoadConfig(changedSource, SCHEMA_VERSION, config));
+    changedSource = source;
+    changedSource.buildFingerprint++;
+    EXPECT_FALSE(LoadConfig(changedSource, SCHEMA_VERSION, config));
+
+    {
+        std::fstream file(CACHE_PATH, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('\xff');
+    }
+    EXPECT_FALSE(LoadConfig(source, SCHEMA_VERSION, config));
+    std::remove(CACHE_PATH.c_str());
+    EXPECT_FALSE(LoadConfig(source, SCHEMA_VERSION, config));
+}
+
+/**
+ * @tc.name: TruncatedPayload
+ * @tc.desc: reading a truncated payload fails instead of reading past its end
+ * @tc.type: FUNC
+ */
+HWTEST_F(XmlConfigCacheTest, TruncatedPayload, TestSize.Level1)
+{
+    auto data = Encode(MakeConfig());
+    for (size_t size = 0; size < data.size(); size++) {
+        XmlConfigCacheReader reader(data.data(), size);
+        ConfigItem config;
+        EXPECT_FALSE(reader.ReadConfigItem(config));
+    }
+    XmlConfigCacheWriter writer;
+    writer.WriteUint32(UINT32_MAX);
+    XmlConfigCacheReader reader(writer.GetData().data(), writer.GetData().size());
+    std::vector<std::string> strings;
+    EXPECT_FALSE(reader.ReadStrings(strings));
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
@@ -64,6 +64,9 @@ protected:
     DataHandlerErr PrepareSendData(MessageParcel& data, const DataTransferConfig& config, const AAFwk::Want& toSend);
     virtual bool WriteInterfaceToken(MessageParcel& data) = 0;
     DataHandlerErr ParseReply(MessageParcel& recieved, AAFwk::Want& reply, const DataTransferConfig& config);
+    // wants above the shared memory threshold travel in a sealed ashmem region instead of the parcel
+    static bool WriteWant(MessageParcel& parcel, const AAFwk::Want& want);
+    static sptr<AAFwk::Want> ReadWant(MessageParcel& parcel);
     void PostAsyncTask(Task&& task, const std::string& name, int64_t delayTime);
     bool IsProxyObject() const;
 
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SCENE_RECT_MATH_H
+#define OHOS_ROSEN_WINDOW_SCENE_RECT_MATH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define WS_RECT_MATH_NEON 1
+#endif
+
+#include "wm_common.h"
+#include "ws_common.h"
+
+namespace OHOS::Rosen {
+/*
+ * Allocation free rect operations for the layout and input hot paths.
+ * The scalar operations are constexpr and keep the exact semantics of the helpers they replace,
+ * the batch operations work in place on contiguous rect arrays such as hot areas.
+ */
+namespace RectMath {
+static_assert(sizeof(Rect) == sizeof(int32_t) * 4, "Rect is expected to be four packed 32 bit fields");
+static_assert(sizeof(WSRect) == sizeof(int32_t) * 4, "WSRect is expected to be four packed 32 bit fields");
+
+enum class AvoidSide : uint8_t {
+    TOP,
+    BOTTOM,
+    LEFT,
+    RIGHT,
+};
+
+template<typename R>
+constexpr int32_t Right(const R& rect)
+{
+    return rect.posX_ + static_cast<int32_t>(rect.width_);
+}
+
+template<typename R>
+constexpr int32_t Bottom(const R& rect)
+{
+    return rect.posY_ + static_cast<int32_t>(rect.height_);
+}
+
+/*
+ * All four fields are zero, which is how an unset rect is represented.
+ */
+template<typename R>
+constexpr bool IsZero(const R& rect)
+{
+    return rect.posX_ == 0 && rect.posY_ == 0 && rect.width_ == 0 && rect.height_ == 0;
+}
+
+/*
+ * Edges are inclusive, as WSRect::IsInRegion.
+ */
+constexpr bool Contains(const WSRect& rect, int32_t pointX, int32_t pointY)
+{
+    return pointX >= rect.posX_ && pointX <= Right(rect) && pointY >= rect.posY_ && pointY <= Bottom(rect);
+}
+
+constexpr bool IsOverlap(const WSRect& lhs, const WSRect& rhs)
+{
+    return std::max(lhs.posX_, rhs.posX_) < std::min(Right(lhs), Right(rhs)) &&
+        std::max(lhs.posY_, rhs.posY_) < std::min(Bottom(lhs), Bottom(rhs));
+}
+
+/*
+ * Intersection of two rects moved by (-offsetX, -offsetY), or a zero rect when they do not overlap.
+ */
+constexpr WSRect Overlap(const WSRect& lhs, const WSRect& rhs, int32_t offsetX = 0, int32_t offsetY = 0)
+{
+    const int32_t left = std::max(lhs.posX_, rhs.posX_);
+    const int32_t right = std::min(Right(lhs), Right(rhs));
+    const int32_t top = std::max(lhs.posY_, rhs.posY_);
+    const int32_t bottom = std::min(Bottom(lhs), Bottom(rhs));
+    if (top >= bottom || left >= right) {
+        return { 0, 0, 0, 0 };
+    }
+    return { left - offsetX, top - offsetY, right - left, bottom - top };
+}
+
+constexpr WSRect Offset(const WSRect& rect, int32_t offsetX, int32_t offsetY)
+{
+    return { rect.posX_ + offsetX, rect.posY_ + offsetY, rect.width_, rect.height_ };
+}
+
+constexpr Rect ToRect(const WSRect& rect)
+{
+    return { rect.posX_, rect.posY_, static_cast<uint32_t>(rect.width_), static_cast<uint32_t>(rect.height_) };
+}
+
+constexpr WSRect ToWSRect(const Rect& rect)
+{
+    return { rect.posX_, rect.posY_, static_cast<int32_t>(rect.width_), static_cast<int32_t>(rect.height_) };
+}
+
+/*
+ * Side of the window an avoid area belongs to, decided by which of the window diagonals
+ * the center of the area lies on. avoidAreaRect is relative to the window.
+ */
+constexpr AvoidSide GetAvoidSide(const WSRect& windowRect, const Rect& avoidAreaRect)
+{
+    const uint32_t centerX = static_cast<uint32_t>(avoidAreaRect.posX_) + (avoidAreaRect.width_ >> 1);
+    const uint32_t centerY = static_cast<uint32_t>(avoidAreaRect.posY_) + (avoidAreaRect.height_ >> 1);
+    const float slope = static_cast<float>(windowRect.height_) / static_cast<float>(windowRect.width_);
+    const float res1 = static_cast<float>(centerY) - slope * static_cast<float>(centerX);
+    const float res2 = static_cast<float>(centerY) + slope * static_cast<float>(centerX) -
+        static_cast<float>(windowRect.height_);
+    if (res1 < 0) {
+        return res2 < 0 ? AvoidSide::TOP : AvoidSide::RIGHT;
+    }
+    return res2 < 0 ? AvoidSide::LEFT : AvoidSide::BOTTOM;
+}
+
+/*
+ * Index of the first rect equal to target, or count when there is none.
+ */
+inline size_t FindRect(const Rect* rects, size_t count, const Rect& target)
+{
+    size_t index = 0;
+#ifdef WS_RECT_MATH_NEON
+    const uint32x4_t targetVec = vld1q_u32(reinterpret_cast<const uint32_t*>(&target));
+    for (; index < count; index++) {
+        uint32x4_t equal = vceqq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(rects + index)), targetVec);
+        if (vminvq_u32(equal) != 0) {
+            return index;
+        }
+    }
+#else
+    for (; index < count; index++) {
+        if (rects[index] == target) {
+            return index;
+        }
+    }
+#endif
+    return count;
+}
+
+/*
+ * Moves every non zero rect by (offsetX, offsetY), zero rects stay unset.
+ */
+inline void OffsetRects(Rect* rects, size_t count, int32_t offsetX, int32_t offsetY)
+{
+    size_t index = 0;
+#ifdef WS_RECT_MATH_NEON
+    const int32_t offset[] = { offsetX, offsetY, 0, 0 };
+    const int32x4_t offsetVec = vld1q_s32(offset);
+    for (; index < count; index++) {
+        int32_t* fields = reinterpret_cast<int32_t*>(rects + index);
+        int32x4_t rectVec = vld1q_s32(fields);
+        if (vmaxvq_u32(vreinterpretq_u32_s32(rectVec)) != 0) {
+            vst1q_s32(fields, vaddq_s32(rectVec, offsetVec));
+        }
+    }
+#else
+    for (; index < count; index++) {
+        if (!IsZero(rects[index])) {
+            rects[index].posX_ += offsetX;
+            rects[index].posY_ += offsetY;
+        }
+    }
+#endif
+}
+} // namespace RectMath
+} // namespace OHOS::Rosen
+#endif // OHOS_ROSEN_WINDOW_SCENE_RECT_MATH_H
@@ -19,6 +19,7 @@
 #include <pointer_event.h>
 
 #include <string>
+#include "rect_math.h"
 #include "ws_common.h"
 #include "ws_common_inner.h"
 #include "wm_common.h"
@@ -30,22 +31,12 @@ class SessionHelper {
 public:
     static WSRect GetOverlap(const WSRect& rect1, const WSRect& rect2, int offsetX, int offsetY)
     {
-        int32_t x_begin = std::max(rect1.posX_, rect2.posX_);
-        int32_t x_end = std::min(rect1.posX_ + static_cast<int32_t>(rect1.width_),
-            rect2.posX_ + static_cast<int32_t>(rect2.width_));
-        int32_t y_begin = std::max(rect1.posY_, rect2.posY_);
-        int32_t y_end = std::min(rect1.posY_ + static_cast<int32_t>(rect1.height_),
-            rect2.posY_ + static_cast<int32_t>(rect2.height_));
-        if (y_begin >= y_end || x_begin >= x_end) {
-            return { 0, 0, 0, 0 };
-        }
-        return { x_begin - offsetX, y_begin - offsetY,
-            static_cast<uint32_t>(x_end - x_begin), static_cast<uint32_t>(y_end - y_begin) };
+        return RectMath::Overlap(rect1, rect2, offsetX, offsetY);
     }
 
     static inline bool IsEmptyRect(const WSRect& r)
     {
-        return (r.posX_ == 0 && r.posY_ == 0 && r.width_ == 0 && r.height_ == 0);
+        return RectMath::IsZero(r);
     }
 
     static bool IsPointInRect(int32_t pointPosX, int32_t pointPosY, const Rect& rect)
@@ -61,22 +52,12 @@ public:
 
     static inline WSRect TransferToWSRect(const Rect& rect)
     {
-        WSRect r;
-        r.height_ = rect.height_;
-        r.width_ = rect.width_;
-        r.posX_ = rect.posX_;
-        r.posY_ = rect.posY_;
-        return r;
+        return RectMath::ToWSRect(rect);
     }
 
     static inline Rect TransferToRect(const WSRect& rect)
     {
-        Rect r;
-        r.height_ = rect.height_;
-        r.width_ = rect.width_;
-        r.posX_ = rect.posX_;
-        r.posY_ = rect.posY_;
-        return r;
+        return RectMath::ToRect(rect);
     }
 
     static inline bool IsBelowSystemWindow(WindowType type)
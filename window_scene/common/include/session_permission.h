@@ -16,7 +16,11 @@
 #ifndef OHOS_ROSEN_SESSION_PERMISSION_H
 #define OHOS_ROSEN_SESSION_PERMISSION_H
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <string>
+#include <utility>
 
 namespace OHOS {
 namespace Rosen {
@@ -31,6 +35,91 @@ constexpr const char* PERMISSION_VISIBLE_WINDOW_INFO = "ohos.permission.VISIBLE_
 constexpr const char* PERMISSION_WINDOW_TRANSPARENT = "ohos.permission.SET_WINDOW_TRANSPARENT";
 constexpr const char* PERMISSION_FLOATING_BALL = "ohos.permission.USE_FLOAT_BALL";
 }
+/*
+ * Bounded cache of caller identity and permission results. Entries expire after ttlMs, the oldest
+ * entry is evicted when the cache is full. Erasing bumps the generation, so that a result looked up
+ * before the erase is not put back.
+ */
+template<typename Key, typename Value>
+class CallerResultCache {
+public:
+    CallerResultCache(size_t maxSize, int64_t ttlMs) : maxSize_(maxSize), ttlMs_(ttlMs) {}
+
+    bool Get(const Key& key, Value& value, int64_t nowMs)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = entries_.find(key);
+        if (iter == entries_.end()) {
+            return false;
+        }
+        if (nowMs >= iter->second.expireMs) {
+            entries_.erase(iter);
+            return false;
+        }
+        value = iter->second.value;
+        return true;
+    }
+
+    uint64_t GetGeneration()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return generation_;
+    }
+
+    void Put(const Key& key, const Value& value, int64_t nowMs, uint64_t generation)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (generation != generation_) {
+            return;
+        }
+        if (entries_.size() >= maxSize_ && entries_.find(key) == entries_.end()) {
+            auto oldest = entries_.begin();
+            for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+                if (iter->second.expireMs < oldest->second.expireMs) {
+                    oldest = iter;
+                }
+            }
+            entries_.erase(oldest);
+        }
+        entries_[key] = { value, nowMs + ttlMs_ };
+    }
+
+    template<typename Predicate>
+    void EraseIf(const Predicate& predicate)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_++;
+        for (auto iter = entries_.begin(); iter != entries_.end();) {
+            iter = predicate(iter->first) ? entries_.erase(iter) : std::next(iter);
+        }
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_++;
+        entries_.clear();
+    }
+
+    size_t GetSize()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+private:
+    struct Entry {
+        Value value;
+        int64_t expireMs = 0;
+    };
+
+    std::mutex mutex_;
+    std::map<Key, Entry> entries_;
+    size_t maxSize_;
+    int64_t ttlMs_;
+    uint64_t generation_ = 0;
+};
+
 class SessionPermission {
 public:
     static bool IsSystemServiceCalling(bool needPrintLog = true);
@@ -55,6 +144,21 @@ public:
     static bool IsFoundationCall();
     static std::string GetCallingBundleName();
     static bool IsTokenNativeOrShellType(uint32_t tokenId);
+
+    /*
+     * Bundle names and permission results are cached per caller. Bundle changes clear both caches,
+     * permission state changes drop the results of the changed token.
+     */
+    static void ClearCallerCache();
+    static void OnPermissionStateChanged(uint32_t tokenId);
+    static bool RegisterPermissionStateChangeCallback();
+
+private:
+    static std::string GetBundleNameForUid(int32_t uid);
+
+    static CallerResultCache<int32_t, std::string> bundleNameCache_;
+    static CallerResultCache<std::pair<uint32_t, std::string>, bool> permissionCache_;
+    static std::atomic<bool> isPermissionCacheEnabled_;
 };
 } // Rosen
 } // OHOS
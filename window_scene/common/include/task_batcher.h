@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SCENE_TASK_BATCHER_H
+#define OHOS_ROSEN_WINDOW_SCENE_TASK_BATCHER_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OHOS::Rosen {
+/*
+ * Runs tasks raised on other threads in batches, one posted event per batch, in the order they were added.
+ * At most one batch waits to run: the tasks added meanwhile collect in the open batch, which is closed and
+ * posted when the waiting batch starts, or at once when it holds MAX_BATCH_SIZE tasks.
+ * The post function must queue the event, it is called under the batcher lock.
+ */
+class TaskBatcher {
+public:
+    using Task = std::function<void()>;
+    using PostFunc = std::function<bool(Task&&)>;
+    static constexpr size_t MAX_BATCH_SIZE = 64;
+
+    TaskBatcher(const std::string& name, PostFunc&& postFunc);
+    void AddTask(Task&& task, const std::string& taskName);
+    void RemoveTask(const std::string& taskName);
+
+private:
+    struct Batch {
+        std::vector<std::pair<std::string, Task>> tasks;
+    };
+
+    void PostBatchLocked(std::shared_ptr<Batch> batch);
+    void RunBatch(const std::shared_ptr<Batch>& batch);
+
+    std::string name_;
+    PostFunc postFunc_;
+    std::mutex mutex_;
+    std::shared_ptr<Batch> openBatch_;
+    std::deque<std::shared_ptr<Batch>> postedBatches_;
+};
+} // namespace OHOS::Rosen
+#endif // OHOS_ROSEN_WINDOW_SCENE_TASK_BATCHER_H
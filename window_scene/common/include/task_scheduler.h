@@ -16,7 +16,10 @@
 #ifndef OHOS_ROSEN_WINDOW_SCENE_TASK_SCHEDULER_H
 #define OHOS_ROSEN_WINDOW_SCENE_TASK_SCHEDULER_H
 
+#include <array>
+#include <atomic>
 #include <event_handler.h>
+#include <mutex>
 
 #include <unistd.h>
 #include "window_manager_hilog.h"
@@ -26,6 +29,42 @@ namespace OHOS::Rosen {
 void StartTraceForSyncTask(const std::string& name);
 void FinishTraceForSyncTask();
 
+/*
+ * Timing of the tasks posted with one name, durations in microseconds.
+ * Buckets are log2 histograms, bucket i counts values in [2^(i-1), 2^i).
+ */
+constexpr size_t TASK_TIMING_BUCKET_NUM = 26;
+struct TaskTimingStat {
+    uint64_t count = 0;
+    int64_t totalCostUs = 0;
+    int64_t maxCostUs = 0;
+    int64_t totalWaitUs = 0;
+    int64_t maxWaitUs = 0;
+    uint64_t overBudgetCount = 0;
+    std::array<uint32_t, TASK_TIMING_BUCKET_NUM> costBuckets {};
+    uint64_t syncCount = 0;
+    int64_t totalBlockUs = 0;
+    int64_t maxBlockUs = 0;
+    std::array<uint32_t, TASK_TIMING_BUCKET_NUM> blockBuckets {};
+};
+
+/*
+ * Export tasks are identified by id, tasks added with the same id before they run are coalesced
+ * and only the last one is executed.
+ */
+enum class ExportTaskId : uint8_t {
+    NOTIFY_MEM_MGR = 0,
+    END,
+};
+
+constexpr size_t EXPORT_TASK_ID_NUM = static_cast<size_t>(ExportTaskId::END);
+
+struct ExportTaskStat {
+    uint64_t added = 0;
+    uint64_t coalesced = 0;
+    uint64_t posted = 0;
+};
+
 class TaskScheduler {
 public:
     explicit TaskScheduler(const std::string& threadName);
@@ -35,6 +74,8 @@ public:
 
     using Task = std::function<void()>;
     void PostAsyncTask(Task&& task, const std::string& name, int64_t delayTime = 0);
+    // never runs inline, a task posted from the scheduler thread runs after the current one
+    void PostQueuedTask(Task&& task, const std::string& name, int64_t delayTime = 0);
     void PostTask(Task&& task, const std::string& name, int64_t delayTime = 0);
     void RemoveTask(const std::string& name);
     void PostVoidSyncTask(Task&& task, const std::string& name = "ssmTask");
@@ -42,16 +83,22 @@ public:
     Return PostSyncTask(SyncTask&& task, const std::string& name = "ssmTask")
     {
         Return ret;
+        const int64_t enqueueUs = GetTimingStartUs();
         if (handler_->GetEventRunner()->IsCurrentRunnerThread()) {
+            const int64_t outerInlineCostUs = EnterTaskTiming(enqueueUs);
             StartTraceForSyncTask(name);
             ret = task();
             FinishTraceForSyncTask();
+            RecordTaskTiming(name, enqueueUs, enqueueUs, outerInlineCostUs);
             return ret;
         }
-        auto syncTask = [this, &ret, &task, &name] {
+        auto syncTask = [this, &ret, &task, &name, enqueueUs] {
+            const int64_t startUs = enqueueUs == 0 ? 0 : GetTimingNowUs();
+            const int64_t outerInlineCostUs = EnterTaskTiming(startUs);
             StartTraceForSyncTask(name);
             ret = task();
             FinishTraceForSyncTask();
+            RecordTaskTiming(name, enqueueUs, startUs, outerInlineCostUs);
             ExecuteExportTask();
         };
         AppExecFwk::EventQueue::Priority priority = AppExecFwk::EventQueue::Priority::IMMEDIATE;
@@ -63,19 +110,58 @@ public:
         if (!result) {
             TLOGE(WmsLogTag::DEFAULT, "post task failed");
         }
+        RecordSyncBlockTiming(name, enqueueUs);
         return ret;
     }
 
     void SetExportHandler(const std::shared_ptr<AppExecFwk::EventHandler>& handler);
     /*
      * Add export task, which will be executed after a task OS_SceneSession,
-     * same name means same task, will be only executed once.
+     * same id means same task, will be only executed once.
      */
-    void AddExportTask(std::string taskName, Task&& task);
+    void AddExportTask(ExportTaskId id, Task&& task);
+    ExportTaskStat GetExportTaskStat(ExportTaskId id) const;
+    void DumpExportTaskInfo(std::string& dumpInfo) const;
+
+    /*
+     * Task timing, off unless persist.window.task_scheduler.timing is set or it is switched on by dump.
+     * Records queue wait and run time per task name, and how long sync posters from other threads block.
+     * The run time of a task excludes the tasks it runs inline, which are recorded under their own names.
+     * A budget of 0 turns off the over budget check.
+     */
+    void SetTimingEnabled(bool enabled);
+    bool IsTimingEnabled() const { return timingEnabled_.load(std::memory_order_relaxed); }
+    void ResetTimingStat();
+    bool GetTaskTimingStat(const std::string& name, TaskTimingStat& stat) const;
+    void DumpTimingInfo(std::string& dumpInfo) const;
+    static int64_t GetTimingPercentileUs(const std::array<uint32_t, TASK_TIMING_BUCKET_NUM>& buckets,
+        uint64_t count, int64_t maxUs, uint32_t percent);
 
 private:
     void ExecuteExportTask();
-    std::unordered_map<std::string, Task> exportFuncMap_; // ONLY Accessed in OS_SceneSession
+    void PostTaskToHandler(Task&& task, const std::string& name, int64_t delayTime, int64_t enqueueUs);
+
+    static int64_t GetTimingNowUs();
+    /*
+     * Returns 0 when timing is off, in which case nothing is recorded for the task.
+     */
+    int64_t GetTimingStartUs() const { return IsTimingEnabled() ? GetTimingNowUs() : 0; }
+    /*
+     * Returns the inline cost collected so far by the enclosing task, to be passed back to RecordTaskTiming.
+     */
+    static int64_t EnterTaskTiming(int64_t startUs);
+    void RecordTaskTiming(const std::string& name, int64_t enqueueUs, int64_t startUs, int64_t outerInlineCostUs);
+    void RecordSyncBlockTiming(const std::string& name, int64_t enqueueUs);
+    TaskTimingStat& GetTimingStatLocked(const std::string& name);
+
+    std::atomic<bool> timingEnabled_ { false };
+    int64_t budgetUs_ = 0;
+    mutable std::mutex timingMutex_;
+    std::unordered_map<std::string, TaskTimingStat> timingStatMap_;
+    std::array<Task, EXPORT_TASK_ID_NUM> exportTasks_; // ONLY Accessed in OS_SceneSession
+    bool hasExportTask_ = false; // ONLY Accessed in OS_SceneSession
+    mutable std::mutex exportStatMutex_;
+    std::array<ExportTaskStat, EXPORT_TASK_ID_NUM> exportStats_;
     std::shared_ptr<AppExecFwk::EventHandler> handler_;
     std::shared_ptr<AppExecFwk::EventHandler> exportHandler_;
 };
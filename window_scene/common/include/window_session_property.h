@@ -16,6 +16,7 @@
 #ifndef OHOS_ROSEN_WINDOW_SESSION_PROPERTY_H
 #define OHOS_ROSEN_WINDOW_SESSION_PROPERTY_H
 
+#include <atomic>
 #include <refbase.h>
 #include <string>
 #include <unordered_map>
@@ -72,6 +73,7 @@ public:
     void SetSnapshotSkip(bool isSkip);
     void SetBrightness(float brightness);
     void SetDisplayId(uint64_t displayId);
+    static uint64_t GetDisplayIdGeneration();
     void SetIsFollowParentWindowDisplayId(bool enabled);
     void SetWindowType(WindowType type);
     void SetParentId(int32_t parentId);
@@ -168,6 +170,7 @@ public:
     bool IsFloatingWindowAppType() const;
     void GetTouchHotAreas(std::vector<Rect>& rects) const;
     KeyboardTouchHotAreas GetKeyboardTouchHotAreas() const;
+    uint64_t GetInputLayoutGeneration() const;
     bool GetKeepKeyboardFlag() const;
     uint32_t GetCallingSessionId() const;
     PiPTemplateInfo GetPiPTemplateInfo() const;
@@ -431,6 +434,7 @@ private:
     void ReadActionUpdateBackgroundAlpha(Parcel& parcel);
     void ReadActionUpdateExclusivelyHighlighted(Parcel& parcel);
     void ReadActionUpdateFollowScreenChange(Parcel& parcel);
+    void MarkInputLayoutChanged();
     std::string windowName_;
     SessionInfo sessionInfo_;
     mutable std::mutex windowRectMutex_;
@@ -491,6 +495,12 @@ private:
     mutable std::mutex touchHotAreasMutex_;
     std::vector<Rect> touchHotAreas_;  // coordinates relative to window.
     KeyboardTouchHotAreas keyboardTouchHotAreas_;  // coordinates relative to window.
+    /*
+     * Restamped from the process wide counter whenever a field the MMI transform, hot areas or pointer change
+     * areas are built from changes, unique across properties.
+     */
+    static std::atomic<uint64_t> inputLayoutGenerationCounter_;
+    std::atomic<uint64_t> inputLayoutGeneration_ { ++inputLayoutGenerationCounter_ };
     bool hideNonSystemFloatingWindows_ = false;
     bool isSkipSelfWhenShowOnVirtualScreen_ = false;
     bool isSkipEventOnCastPlus_ = false;
@@ -510,6 +520,7 @@ private:
     int32_t collaboratorType_ = CollaboratorType::DEFAULT_TYPE;
     static const std::map<uint64_t, HandlWritePropertyFunc> writeFuncMap_;
     static const std::map<uint64_t, HandlReadPropertyFunc> readFuncMap_;
+    static std::atomic<uint64_t> displayIdGeneration_; // bumped whenever any property changes its display
     bool isAppSupportPhoneInPc_ = false;
     bool isPcAppInLargeScreenDevice_ = false;
     mutable std::mutex compatibleModeMutex_;
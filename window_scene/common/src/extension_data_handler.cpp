@@ -15,8 +15,12 @@
 
 #include "common/include/extension_data_handler.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <sstream>
+#include <sys/mman.h>
 
+#include <ashmem.h>
 #include <hitrace_meter.h>
 #include <iremote_proxy.h>
 #include <message_parcel.h>
@@ -26,6 +30,16 @@
 #include "window_manager_hilog.h"
 
 namespace OHOS::Rosen::Extension {
+namespace {
+enum class WantPayloadType : uint32_t {
+    INLINE = 0,
+    SHARED_MEMORY,
+};
+// below this the ashmem create, map and fd transfer cost more than copying through binder
+constexpr size_t SHARED_MEMORY_THRESHOLD = 64 * 1024;
+constexpr size_t MAX_PAYLOAD_SIZE = 64 * 1024 * 1024;
+const char* const PAYLOAD_ASHMEM_NAME = "ExtensionDataPayload";
+}
 
 bool DataTransferConfig::Marshalling(Parcel& parcel) const
 {
@@ -101,7 +115,7 @@ DataHandlerErr DataHandler::PrepareSendData(MessageParcel& data, const DataTrans
         return DataHandlerErr::WRITE_PARCEL_ERROR;
     }
 
-    if (!data.WriteParcelable(&toSend)) {
+    if (!WriteWant(data, toSend)) {
         TLOGE(WmsLogTag::WMS_UIEXT, "write toSend failed, %{public}s", config.ToString().c_str());
         return DataHandlerErr::WRITE_PARCEL_ERROR;
     }
@@ -121,7 +135,7 @@ DataHandlerErr DataHandler::ParseReply(MessageParcel& replyParcel, AAFwk::Want&
     }
 
     if (config.needReply) {
-        sptr<AAFwk::Want> response = replyParcel.ReadParcelable<AAFwk::Want>();
+        sptr<AAFwk::Want> response = ReadWant(replyParcel);
         if (!response) {
             TLOGE(WmsLogTag::WMS_UIEXT, "read response failed, %{public}s", config.ToString().c_str());
             return DataHandlerErr::READ_PARCEL_ERROR;
@@ -132,6 +146,88 @@ DataHandlerErr DataHandler::ParseReply(MessageParcel& replyParcel, AAFwk::Want&
     return static_cast<DataHandlerErr>(replyCode);
 }
 
+/*
+ * The want is marshalled in place behind a type header. Once it turns out large and free of objects
+ * such as remote objects and fds, its bytes move into a sealed ashmem region and the parcel is rewound
+ * to carry only the header, the payload size and the fd.
+ */
+bool DataHandler::WriteWant(MessageParcel& parcel, const AAFwk::Want& want)
+{
+    size_t headerPos = parcel.GetWritePosition();
+    if (!parcel.WriteUint32(static_cast<uint32_t>(WantPayloadType::INLINE))) {
+        return false;
+    }
+    size_t payloadPos = parcel.GetWritePosition();
+    size_t objectCount = parcel.GetOffsetsSize();
+    parcel.SetMaxCapacity(std::max(parcel.GetMaxCapacity(), MAX_PAYLOAD_SIZE));
+    if (!parcel.WriteParcelable(&want)) {
+        return false;
+    }
+    size_t payloadSize = parcel.GetWritePosition() - payloadPos;
+    if (payloadSize < SHARED_MEMORY_THRESHOLD || parcel.GetOffsetsSize() != objectCount) {
+        return true;
+    }
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "uiext:WriteWantToAshmem size:%zu", payloadSize);
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(PAYLOAD_ASHMEM_NAME, payloadSize);
+    if (ashmem == nullptr) {
+        TLOGW(WmsLogTag::WMS_UIEXT, "create ashmem failed, size: %{public}zu", payloadSize);
+        return true;
+    }
+    bool written = ashmem->MapReadAndWriteAshmem() &&
+        ashmem->WriteToAshmem(reinterpret_cast<const void*>(parcel.GetData() + payloadPos), payloadSize, 0);
+    ashmem->UnmapAshmem();
+    // sealed, the peer can only map it read only
+    if (!written || !ashmem->SetProtection(PROT_READ)) {
+        TLOGW(WmsLogTag::WMS_UIEXT, "fill ashmem failed, size: %{public}zu", payloadSize);
+        ashmem->CloseAshmem();
+        return true;
+    }
+    bool ret = parcel.RewindWrite(headerPos) &&
+        parcel.WriteUint32(static_cast<uint32_t>(WantPayloadType::SHARED_MEMORY)) &&
+        parcel.WriteUint64(static_cast<uint64_t>(payloadSize)) && parcel.WriteAshmem(ashmem);
+    // the parcel holds its own dup of the fd
+    ashmem->CloseAshmem();
+    return ret;
+}
+
+sptr<AAFwk::Want> DataHandler::ReadWant(MessageParcel& parcel)
+{
+    uint32_t payloadType = 0;
+    if (!parcel.ReadUint32(payloadType)) {
+        return nullptr;
+    }
+    if (payloadType == static_cast<uint32_t>(WantPayloadType::INLINE)) {
+        return parcel.ReadParcelable<AAFwk::Want>();
+    }
+    uint64_t payloadSize = 0;
+    if (payloadType != static_cast<uint32_t>(WantPayloadType::SHARED_MEMORY) || !parcel.ReadUint64(payloadSize) ||
+        payloadSize == 0 || payloadSize > MAX_PAYLOAD_SIZE) {
+        TLOGE(WmsLogTag::WMS_UIEXT, "invalid payload, type: %{public}u", payloadType);
+        return nullptr;
+    }
+    sptr<Ashmem> ashmem = parcel.ReadAshmem();
+    if (ashmem == nullptr) {
+        TLOGE(WmsLogTag::WMS_UIEXT, "read ashmem failed");
+        return nullptr;
+    }
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "uiext:ReadWantFromAshmem size:%" PRIu64, payloadSize);
+    sptr<AAFwk::Want> want = nullptr;
+    if (static_cast<uint64_t>(ashmem->GetAshmemSize()) >= payloadSize && ashmem->MapReadOnlyAshmem()) {
+        const void* payload = ashmem->ReadFromAshmem(static_cast<int32_t>(payloadSize), 0);
+        Parcel payloadParcel;
+        payloadParcel.SetMaxCapacity(MAX_PAYLOAD_SIZE);
+        if (payload != nullptr && payloadParcel.WriteBuffer(payload, static_cast<size_t>(payloadSize))) {
+            want = payloadParcel.ReadParcelable<AAFwk::Want>();
+        }
+        ashmem->UnmapAshmem();
+    }
+    ashmem->CloseAshmem();
+    if (want == nullptr) {
+        TLOGE(WmsLogTag::WMS_UIEXT, "read want from ashmem failed, size: %{public}" PRIu64, payloadSize);
+    }
+    return want;
+}
+
 // process data from peer
 void DataHandler::NotifyDataConsumer(MessageParcel& recieved, MessageParcel& reply)
 {
@@ -142,7 +238,7 @@ void DataHandler::NotifyDataConsumer(MessageParcel& recieved, MessageParcel& rep
         return;
     }
 
-    sptr<AAFwk::Want> sendWant = recieved.ReadParcelable<AAFwk::Want>();
+    sptr<AAFwk::Want> sendWant = ReadWant(recieved);
     if (sendWant == nullptr) {
         TLOGE(WmsLogTag::WMS_UIEXT, "read want failed");
         reply.WriteUint32(static_cast<uint32_t>(DataHandlerErr::READ_PARCEL_ERROR));
@@ -158,7 +254,7 @@ void DataHandler::NotifyDataConsumer(MessageParcel& recieved, MessageParcel& rep
     auto ret = NotifyDataConsumer(std::move(*sendWant), replyWant, *config);
     reply.WriteUint32(static_cast<uint32_t>(ret));
     if (needReply && replyWant) {
-        reply.WriteParcelable(&(replyWant.value()));
+        WriteWant(reply, replyWant.value());
     }
 }
 
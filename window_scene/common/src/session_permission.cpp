@@ -28,6 +28,7 @@
 #include <singleton.h>
 #include <singleton_container.h>
 #include <pwd.h>
+#include <chrono>
 #include "common/include/session_permission.h"
 #include "parameters.h"
 #include "window_manager_hilog.h"
@@ -37,6 +38,27 @@ namespace Rosen {
 namespace {
 constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "SessionPermission"};
 constexpr int32_t FOUNDATION_UID = 5523;
+constexpr size_t BUNDLE_NAME_CACHE_MAX_SIZE = 128;
+constexpr int64_t BUNDLE_NAME_CACHE_TTL_MS = 60000;
+constexpr size_t PERMISSION_CACHE_MAX_SIZE = 512;
+constexpr int64_t PERMISSION_CACHE_TTL_MS = 5000;
+
+int64_t GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class PermissionStateChangeCallback : public Security::AccessToken::PermStateChangeCallbackCustomize {
+public:
+    explicit PermissionStateChangeCallback(const Security::AccessToken::PermStateChangeScope& scope)
+        : PermStateChangeCallbackCustomize(scope) {}
+
+    void PermStateChangeCallback(Security::AccessToken::PermStateChangeInfo& result) override
+    {
+        SessionPermission::OnPermissionStateChanged(result.tokenID);
+    }
+};
 
 sptr<AppExecFwk::IBundleMgr> GetBundleManagerProxy()
 {
@@ -61,6 +83,12 @@ sptr<AppExecFwk::IBundleMgr> GetBundleManagerProxy()
 }
 }
 
+CallerResultCache<int32_t, std::string> SessionPermission::bundleNameCache_(
+    BUNDLE_NAME_CACHE_MAX_SIZE, BUNDLE_NAME_CACHE_TTL_MS);
+CallerResultCache<std::pair<uint32_t, std::string>, bool> SessionPermission::permissionCache_(
+    PERMISSION_CACHE_MAX_SIZE, PERMISSION_CACHE_TTL_MS);
+std::atomic<bool> SessionPermission::isPermissionCacheEnabled_ { false };
+
 bool SessionPermission::IsSystemServiceCalling(bool needPrintLog)
 {
     const auto tokenId = IPCSkeleton::GetCallingTokenID();
@@ -110,30 +138,27 @@ bool SessionPermission::IsSACalling()
 
 bool SessionPermission::VerifyCallingPermission(const std::string& permissionName)
 {
-    auto callerToken = IPCSkeleton::GetCallingTokenID();
-    TLOGD(WmsLogTag::DEFAULT, "permission %{public}s, callingTokenID:%{private}u",
-        permissionName.c_str(), callerToken);
-    int32_t ret = Security::AccessToken::AccessTokenKit::VerifyAccessToken(callerToken, permissionName);
-    if (ret != Security::AccessToken::PermissionState::PERMISSION_GRANTED) {
-        TLOGE(WmsLogTag::DEFAULT,
-            "permission %{public}s: PERMISSION_DENIED, callingTokenID:%{private}u, ret:%{public}d",
-            permissionName.c_str(), callerToken, ret);
-        return false;
-    }
-    TLOGD(WmsLogTag::DEFAULT, "Verify AccessToken success. permission %{public}s, callingTokenID:%{private}u",
-        permissionName.c_str(), callerToken);
-    return true;
+    return VerifyPermissionByCallerToken(IPCSkeleton::GetCallingTokenID(), permissionName);
 }
 
 bool SessionPermission::VerifyPermissionByCallerToken(const uint32_t callerToken, const std::string& permissionName)
 {
     TLOGD(WmsLogTag::DEFAULT, "permission %{public}s, callingTokenID:%{private}u",
         permissionName.c_str(), callerToken);
-    int32_t ret = Security::AccessToken::AccessTokenKit::VerifyAccessToken(callerToken, permissionName);
-    if (ret != Security::AccessToken::PermissionState::PERMISSION_GRANTED) {
-        TLOGE(WmsLogTag::DEFAULT,
-            "permission %{public}s: PERMISSION_DENIED, callingTokenID:%{private}u, ret:%{public}d",
-            permissionName.c_str(), callerToken, ret);
+    auto cacheKey = std::make_pair(callerToken, permissionName);
+    bool isGranted = false;
+    bool isCacheEnabled = isPermissionCacheEnabled_.load();
+    if (!isCacheEnabled || !permissionCache_.Get(cacheKey, isGranted, GetNowMs())) {
+        uint64_t generation = permissionCache_.GetGeneration();
+        int32_t ret = Security::AccessToken::AccessTokenKit::VerifyAccessToken(callerToken, permissionName);
+        isGranted = ret == Security::AccessToken::PermissionState::PERMISSION_GRANTED;
+        if (isCacheEnabled) {
+            permissionCache_.Put(cacheKey, isGranted, GetNowMs(), generation);
+        }
+    }
+    if (!isGranted) {
+        TLOGE(WmsLogTag::DEFAULT, "permission %{public}s: PERMISSION_DENIED, callingTokenID:%{private}u",
+            permissionName.c_str(), callerToken);
         return false;
     }
     TLOGD(WmsLogTag::DEFAULT, "Verify AccessToken success. permission %{public}s, callingTokenID:%{private}u",
@@ -212,17 +237,7 @@ bool SessionPermission::IsSameBundleNameAsCalling(const std::string& bundleName)
     if (bundleName == "") {
         return false;
     }
-    auto bundleManagerServiceProxy_ = GetBundleManagerProxy();
-    if (!bundleManagerServiceProxy_) {
-        WLOGFE("failed to get BundleManagerServiceProxy");
-        return false;
-    }
-    int uid = IPCSkeleton::GetCallingUid();
-    // reset ipc identity
-    std::string identity = IPCSkeleton::ResetCallingIdentity();
-    std::string callingBundleName;
-    bundleManagerServiceProxy_->GetNameForUid(uid, callingBundleName);
-    IPCSkeleton::SetCallingIdentity(identity);
+    std::string callingBundleName = GetBundleNameForUid(IPCSkeleton::GetCallingUid());
     if (callingBundleName == bundleName) {
         WLOGFD("verify bundle name success");
         return true;
@@ -244,16 +259,14 @@ bool SessionPermission::IsSameAppAsCalling(const std::string& bundleName, const
         return false;
     }
     int uid = IPCSkeleton::GetCallingUid();
-    // reset ipc identity
-    std::string identity = IPCSkeleton::ResetCallingIdentity();
-    std::string callingBundleName;
-    bundleManagerServiceProxy->GetNameForUid(uid, callingBundleName);
+    std::string callingBundleName = GetBundleNameForUid(uid);
     if (callingBundleName != bundleName) {
         TLOGE(WmsLogTag::DEFAULT, "verify app failed, callingBundleName %{public}s, bundleName %{public}s.",
               callingBundleName.c_str(), bundleName.c_str());
-        IPCSkeleton::SetCallingIdentity(identity);
         return false;
     }
+    // reset ipc identity
+    std::string identity = IPCSkeleton::ResetCallingIdentity();
     AppExecFwk::BundleInfo bundleInfo;
     int userId = uid / 200000; // 200000 use uid to caculate userId
     bool ret = bundleManagerServiceProxy->GetBundleInfoV9(
@@ -286,10 +299,9 @@ bool SessionPermission::IsStartedByUIExtension()
     }
 
     int uid = IPCSkeleton::GetCallingUid();
+    std::string bundleName = GetBundleNameForUid(uid);
     // reset ipc identity
     std::string identity = IPCSkeleton::ResetCallingIdentity();
-    std::string bundleName;
-    bundleManagerServiceProxy->GetNameForUid(uid, bundleName);
     AppExecFwk::BundleInfo bundleInfo;
     int userId = uid / 200000; // 200000 use uid to caculate userId
     bool result = bundleManagerServiceProxy->GetBundleInfo(bundleName,
@@ -343,26 +355,68 @@ bool SessionPermission::IsFoundationCall()
 
 std::string SessionPermission::GetCallingBundleName()
 {
-    auto bundleManagerServiceProxy = GetBundleManagerProxy();
-    if (!bundleManagerServiceProxy) {
-        WLOGFE("failed to get BundleManagerServiceProxy");
-        return "";
-    }
     int uid = IPCSkeleton::GetCallingUid();
-    // reset ipc identity
-    std::string identity = IPCSkeleton::ResetCallingIdentity();
-    std::string callingBundleName;
-    bundleManagerServiceProxy->GetNameForUid(uid, callingBundleName);
+    std::string callingBundleName = GetBundleNameForUid(uid);
     // if bundlename is empty, fill in pw_name
     if (callingBundleName.empty()) {
         if (struct passwd* user = getpwuid(uid)) {
             callingBundleName = user->pw_name;
         }
     }
-    IPCSkeleton::SetCallingIdentity(identity);
     return callingBundleName;
 }
 
+std::string SessionPermission::GetBundleNameForUid(int32_t uid)
+{
+    std::string bundleName;
+    if (bundleNameCache_.Get(uid, bundleName, GetNowMs())) {
+        return bundleName;
+    }
+    auto bundleManagerServiceProxy = GetBundleManagerProxy();
+    if (!bundleManagerServiceProxy) {
+        WLOGFE("failed to get BundleManagerServiceProxy");
+        return "";
+    }
+    uint64_t generation = bundleNameCache_.GetGeneration();
+    // reset ipc identity
+    std::string identity = IPCSkeleton::ResetCallingIdentity();
+    bundleManagerServiceProxy->GetNameForUid(uid, bundleName);
+    IPCSkeleton::SetCallingIdentity(identity);
+    if (!bundleName.empty()) {
+        bundleNameCache_.Put(uid, bundleName, GetNowMs(), generation);
+    }
+    return bundleName;
+}
+
+void SessionPermission::ClearCallerCache()
+{
+    bundleNameCache_.Clear();
+    permissionCache_.Clear();
+}
+
+void SessionPermission::OnPermissionStateChanged(uint32_t tokenId)
+{
+    TLOGD(WmsLogTag::DEFAULT, "tokenId:%{private}u", tokenId);
+    permissionCache_.EraseIf([tokenId](const std::pair<uint32_t, std::string>& key) {
+        return key.first == tokenId;
+    });
+}
+
+bool SessionPermission::RegisterPermissionStateChangeCallback()
+{
+    // an empty scope listens to every token and permission
+    Security::AccessToken::PermStateChangeScope scope;
+    auto callback = std::make_shared<PermissionStateChangeCallback>(scope);
+    int32_t ret = Security::AccessToken::AccessTokenKit::RegisterPermStateChangeCallback(callback);
+    if (ret != 0) {
+        TLOGW(WmsLogTag::DEFAULT, "failed, ret:%{public}d", ret);
+        return false;
+    }
+    permissionCache_.Clear();
+    isPermissionCacheEnabled_.store(true);
+    return true;
+}
+
 bool SessionPermission::VerifyPermissionByBundleName(
     const std::string& permissionName, const std::string& bundleName, uint32_t userId)
 {
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/include/task_batcher.h"
+
+#include <algorithm>
+
+#include "hitrace_meter.h"
+#include "window_manager_hilog.h"
+
+namespace OHOS::Rosen {
+TaskBatcher::TaskBatcher(const std::string& name, PostFunc&& postFunc)
+    : name_(name), postFunc_(std::move(postFunc))
+{
+}
+
+void TaskBatcher::AddTask(Task&& task, const std::string& taskName)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (openBatch_ == nullptr) {
+        openBatch_ = std::make_shared<Batch>();
+    }
+    openBatch_->tasks.emplace_back(taskName, std::move(task));
+    if (!postedBatches_.empty() && openBatch_->tasks.size() < MAX_BATCH_SIZE) {
+        return;
+    }
+    PostBatchLocked(std::move(openBatch_));
+}
+
+void TaskBatcher::RemoveTask(const std::string& taskName)
+{
+    auto removeFrom = [&taskName](Batch& batch) {
+        batch.tasks.erase(std::remove_if(batch.tasks.begin(), batch.tasks.end(),
+            [&taskName](const auto& task) { return task.first == taskName; }), batch.tasks.end());
+    };
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (openBatch_ != nullptr) {
+        removeFrom(*openBatch_);
+    }
+    for (const auto& batch : postedBatches_) {
+        removeFrom(*batch);
+    }
+}
+
+void TaskBatcher::PostBatchLocked(std::shared_ptr<Batch> batch)
+{
+    postedBatches_.push_back(batch);
+    if (postFunc_([this, batch] { RunBatch(batch); })) {
+        return;
+    }
+    TLOGE(WmsLogTag::DEFAULT, "post %{public}s failed, tasks: %{public}zu", name_.c_str(), batch->tasks.size());
+    postedBatches_.pop_back();
+    openBatch_ = std::move(batch); // the open batch was just taken, the tasks go out with the next post
+}
+
+void TaskBatcher::RunBatch(const std::shared_ptr<Batch>& batch)
+{
+    std::vector<std::pair<std::string, Task>> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = std::find(postedBatches_.begin(), postedBatches_.end(), batch);
+        if (iter != postedBatches_.end()) {
+            postedBatches_.erase(iter);
+        }
+        tasks.swap(batch->tasks);
+        if (openBatch_ != nullptr && postedBatches_.empty()) {
+            PostBatchLocked(std::move(openBatch_));
+        }
+    }
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "%s:%zu", name_.c_str(), tasks.size());
+    for (auto& task : tasks) {
+        task.second();
+    }
+}
+} // namespace OHOS::Rosen
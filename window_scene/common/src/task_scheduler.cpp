@@ -14,14 +14,53 @@
  */
 
 #include "common/include/task_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <parameters.h>
+
 #include "hitrace_meter.h"
 #include "window_manager_hilog.h"
 
 namespace OHOS::Rosen {
+namespace {
+constexpr uint32_t DEFAULT_TIMING_BUDGET_MS = 16;
+constexpr int64_t US_PER_MS = 1000;
+constexpr size_t MAX_TIMING_NAME_NUM = 256;
+constexpr size_t TIMING_DUMP_TOP_NUM = 10;
+constexpr uint32_t TIMING_PERCENT_P99 = 99;
+constexpr uint32_t TIMING_PERCENT_ALL = 100;
+constexpr int32_t TIMING_DUMP_COLUMN_WIDTH = 14;
+const std::string TIMING_OTHERS_NAME = "others";
+constexpr std::array<const char*, EXPORT_TASK_ID_NUM> EXPORT_TASK_NAMES = { "notifyMemMgr" };
+
+// cost of the timed tasks run inline by the timed task running on this thread
+thread_local int64_t g_inlineCostUs = 0;
+
+size_t GetTimingBucket(int64_t valueUs)
+{
+    size_t bucket = 0;
+    while (valueUs > 0 && bucket < TASK_TIMING_BUCKET_NUM - 1) {
+        valueUs >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+} // namespace
+
 TaskScheduler::TaskScheduler(const std::string& threadName)
 {
     auto runner = AppExecFwk::EventRunner::Create(threadName);
     handler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    timingEnabled_.store(system::GetBoolParameter("persist.window.task_scheduler.timing", false),
+        std::memory_order_relaxed);
+    budgetUs_ = static_cast<int64_t>(system::GetUintParameter<uint32_t>(
+        "persist.window.task_scheduler.budget_ms", DEFAULT_TIMING_BUDGET_MS)) * US_PER_MS;
 }
 
 std::shared_ptr<AppExecFwk::EventHandler> TaskScheduler::GetEventHandler()
@@ -31,14 +70,34 @@ std::shared_ptr<AppExecFwk::EventHandler> TaskScheduler::GetEventHandler()
 
 void TaskScheduler::PostAsyncTask(Task&& task, const std::string& name, int64_t delayTime)
 {
+    int64_t enqueueUs = GetTimingStartUs();
     if (delayTime == 0 && handler_->GetEventRunner()->IsCurrentRunnerThread()) {
+        const int64_t outerInlineCostUs = EnterTaskTiming(enqueueUs);
         HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:%s", name.c_str());
         task();
+        RecordTaskTiming(name, enqueueUs, enqueueUs, outerInlineCostUs);
         return;
     }
-    auto localTask = [this, task = std::move(task), name] {
+    PostTaskToHandler(std::move(task), name, delayTime, enqueueUs);
+}
+
+void TaskScheduler::PostQueuedTask(Task&& task, const std::string& name, int64_t delayTime)
+{
+    PostTaskToHandler(std::move(task), name, delayTime, GetTimingStartUs());
+}
+
+void TaskScheduler::PostTaskToHandler(Task&& task, const std::string& name, int64_t delayTime, int64_t enqueueUs)
+{
+    if (enqueueUs != 0) {
+        // the requested delay is not queue wait
+        enqueueUs += delayTime * US_PER_MS;
+    }
+    auto localTask = [this, task = std::move(task), name, enqueueUs] {
+        const int64_t startUs = enqueueUs == 0 ? 0 : GetTimingNowUs();
+        const int64_t outerInlineCostUs = EnterTaskTiming(startUs);
         HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:%s", name.c_str());
         task();
+        RecordTaskTiming(name, enqueueUs, startUs, outerInlineCostUs);
         ExecuteExportTask();
     };
     handler_->PostTask(std::move(localTask), "wms:" + name, delayTime, AppExecFwk::EventQueue::Priority::IMMEDIATE);
@@ -56,17 +115,24 @@ void TaskScheduler::RemoveTask(const std::string& name)
 
 void TaskScheduler::PostVoidSyncTask(Task&& task, const std::string& name)
 {
+    const int64_t enqueueUs = GetTimingStartUs();
     if (handler_->GetEventRunner()->IsCurrentRunnerThread()) {
+        const int64_t outerInlineCostUs = EnterTaskTiming(enqueueUs);
         HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:%s", name.c_str());
         task();
+        RecordTaskTiming(name, enqueueUs, enqueueUs, outerInlineCostUs);
         return;
     }
-    auto localTask = [this, &task, &name] {
+    auto localTask = [this, &task, &name, enqueueUs] {
+        const int64_t startUs = enqueueUs == 0 ? 0 : GetTimingNowUs();
+        const int64_t outerInlineCostUs = EnterTaskTiming(startUs);
         HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:%s", name.c_str());
         task();
+        RecordTaskTiming(name, enqueueUs, startUs, outerInlineCostUs);
         ExecuteExportTask();
     };
     handler_->PostSyncTask(std::move(localTask), "wms:" + name, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+    RecordSyncBlockTiming(name, enqueueUs);
 }
 
 void TaskScheduler::SetExportHandler(const std::shared_ptr<AppExecFwk::EventHandler>& handler)
@@ -74,30 +140,255 @@ void TaskScheduler::SetExportHandler(const std::shared_ptr<AppExecFwk::EventHand
     exportHandler_ = handler;
 }
 
-void TaskScheduler::AddExportTask(std::string taskName, Task&& task)
+void TaskScheduler::AddExportTask(ExportTaskId id, Task&& task)
 {
-    if (handler_->GetEventRunner()->IsCurrentRunnerThread()) {
-        exportFuncMap_[std::move(taskName)] = std::move(task);
-    } else {
+    if (!handler_->GetEventRunner()->IsCurrentRunnerThread()) {
         task();
+        return;
+    }
+    auto& exportTask = exportTasks_[static_cast<size_t>(id)];
+    {
+        std::lock_guard<std::mutex> lock(exportStatMutex_);
+        auto& stat = exportStats_[static_cast<size_t>(id)];
+        stat.added++;
+        if (exportTask != nullptr) {
+            stat.coalesced++;
+        }
     }
+    exportTask = std::move(task);
+    hasExportTask_ = true;
 }
 
 void TaskScheduler::ExecuteExportTask()
 {
-    if (!exportHandler_ || exportFuncMap_.empty()) {
+    if (!exportHandler_ || !hasExportTask_) {
         return;
     }
-    auto task = [funcMap = std::move(exportFuncMap_)] {
-        for (auto iter = funcMap.begin(); iter != funcMap.end(); iter++) {
-            HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:%s", iter->first.c_str());
-            iter->second();
+    {
+        std::lock_guard<std::mutex> lock(exportStatMutex_);
+        for (size_t id = 0; id < EXPORT_TASK_ID_NUM; id++) {
+            if (exportTasks_[id] != nullptr) {
+                exportStats_[id].posted++;
+            }
+        }
+    }
+    auto task = [tasks = std::move(exportTasks_)] {
+        for (size_t id = 0; id < EXPORT_TASK_ID_NUM; id++) {
+            if (tasks[id] == nullptr) {
+                continue;
+            }
+            HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:%s", EXPORT_TASK_NAMES[id]);
+            tasks[id]();
         }
     };
-    exportFuncMap_.clear();
+    exportTasks_ = {};
+    hasExportTask_ = false;
     exportHandler_->PostTask(std::move(task), "wms:exportTask");
 }
 
+ExportTaskStat TaskScheduler::GetExportTaskStat(ExportTaskId id) const
+{
+    std::lock_guard<std::mutex> lock(exportStatMutex_);
+    return exportStats_[static_cast<size_t>(id)];
+}
+
+void TaskScheduler::DumpExportTaskInfo(std::string& dumpInfo) const
+{
+    std::ostringstream oss;
+    oss << "Export task:" << std::endl;
+    for (const char* column : { "Added", "Coalesced", "Posted", "CoalescingRatio" }) {
+        oss << std::left << std::setw(TIMING_DUMP_COLUMN_WIDTH) << column;
+    }
+    oss << "Name" << std::endl;
+    for (size_t id = 0; id < EXPORT_TASK_ID_NUM; id++) {
+        auto stat = GetExportTaskStat(static_cast<ExportTaskId>(id));
+        double ratio = stat.added == 0 ? 0.0 :
+            static_cast<double>(stat.coalesced) / static_cast<double>(stat.added);
+        oss << std::left << std::setw(TIMING_DUMP_COLUMN_WIDTH) << stat.added
+            << std::setw(TIMING_DUMP_COLUMN_WIDTH) << stat.coalesced
+            << std::setw(TIMING_DUMP_COLUMN_WIDTH) << stat.posted
+            << std::setw(TIMING_DUMP_COLUMN_WIDTH) << ratio << EXPORT_TASK_NAMES[id] << std::endl;
+    }
+    dumpInfo.append(oss.str());
+}
+
+int64_t TaskScheduler::GetTimingNowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TaskScheduler::SetTimingEnabled(bool enabled)
+{
+    timingEnabled_.store(enabled, std::memory_order_relaxed);
+    TLOGI(WmsLogTag::DEFAULT, "enabled: %{public}d", enabled);
+}
+
+void TaskScheduler::ResetTimingStat()
+{
+    std::lock_guard<std::mutex> lock(timingMutex_);
+    timingStatMap_.clear();
+}
+
+TaskTimingStat& TaskScheduler::GetTimingStatLocked(const std::string& name)
+{
+    auto iter = timingStatMap_.find(name);
+    if (iter != timingStatMap_.end()) {
+        return iter->second;
+    }
+    // names carrying ids must not grow the map without bound
+    if (timingStatMap_.size() >= MAX_TIMING_NAME_NUM) {
+        return timingStatMap_[TIMING_OTHERS_NAME];
+    }
+    return timingStatMap_[name];
+}
+
+int64_t TaskScheduler::EnterTaskTiming(int64_t startUs)
+{
+    if (startUs == 0) {
+        return 0;
+    }
+    const int64_t outerInlineCostUs = g_inlineCostUs;
+    g_inlineCostUs = 0;
+    return outerInlineCostUs;
+}
+
+void TaskScheduler::RecordTaskTiming(const std::string& name, int64_t enqueueUs, int64_t startUs,
+    int64_t outerInlineCostUs)
+{
+    if (enqueueUs == 0 || startUs == 0) {
+        return;
+    }
+    const int64_t runUs = GetTimingNowUs() - startUs;
+    // tasks run inline are recorded under their own names, so they are not counted twice
+    const int64_t costUs = std::max<int64_t>(runUs - g_inlineCostUs, 0);
+    g_inlineCostUs = outerInlineCostUs + runUs;
+    const bool isOverBudget = budgetUs_ > 0 && costUs > budgetUs_;
+    const int64_t waitUs = std::max<int64_t>(startUs - enqueueUs, 0);
+    {
+        std::lock_guard<std::mutex> lock(timingMutex_);
+        auto& stat = GetTimingStatLocked(name);
+        stat.count++;
+        stat.totalCostUs += costUs;
+        stat.maxCostUs = std::max(stat.maxCostUs, costUs);
+        stat.totalWaitUs += waitUs;
+        stat.maxWaitUs = std::max(stat.maxWaitUs, waitUs);
+        stat.costBuckets[GetTimingBucket(costUs)]++;
+        if (isOverBudget) {
+            stat.overBudgetCount++;
+        }
+    }
+    if (isOverBudget) {
+        TLOGW(WmsLogTag::DEFAULT, "task %{public}s over budget, cost: %{public}" PRId64 "us, wait: %{public}"
+            PRId64 "us", name.c_str(), costUs, waitUs);
+    }
+}
+
+void TaskScheduler::RecordSyncBlockTiming(const std::string& name, int64_t enqueueUs)
+{
+    if (enqueueUs == 0) {
+        return;
+    }
+    const int64_t blockUs = GetTimingNowUs() - enqueueUs;
+    std::lock_guard<std::mutex> lock(timingMutex_);
+    auto& stat = GetTimingStatLocked(name);
+    stat.syncCount++;
+    stat.totalBlockUs += blockUs;
+    stat.maxBlockUs = std::max(stat.maxBlockUs, blockUs);
+    stat.blockBuckets[GetTimingBucket(blockUs)]++;
+}
+
+bool TaskScheduler::GetTaskTimingStat(const std::string& name, TaskTimingStat& stat) const
+{
+    std::lock_guard<std::mutex> lock(timingMutex_);
+    auto iter = timingStatMap_.find(name);
+    if (iter == timingStatMap_.end()) {
+        return false;
+    }
+    stat = iter->second;
+    return true;
+}
+
+int64_t TaskScheduler::GetTimingPercentileUs(const std::array<uint32_t, TASK_TIMING_BUCKET_NUM>& buckets,
+    uint64_t count, int64_t maxUs, uint32_t percent)
+{
+    if (count == 0) {
+        return 0;
+    }
+    // rank of the percentile sample, rounded up
+    const uint64_t rank = (count * percent + TIMING_PERCENT_ALL - 1) / TIMING_PERCENT_ALL;
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < buckets.size(); bucket++) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            // upper bound of the bucket, never above the largest sample
+            const int64_t upperUs = bucket == 0 ? 0 : (static_cast<int64_t>(1) << bucket) - 1;
+            return std::min(upperUs, maxUs);
+        }
+    }
+    return maxUs;
+}
+
+void TaskScheduler::DumpTimingInfo(std::string& dumpInfo) const
+{
+    std::vector<std::pair<std::string, TaskTimingStat>> stats;
+    {
+        std::lock_guard<std::mutex> lock(timingMutex_);
+        stats.assign(timingStatMap_.begin(), timingStatMap_.end());
+    }
+    std::vector<int64_t> p99s(stats.size());
+    for (size_t i = 0; i < stats.size(); i++) {
+        const auto& stat = stats[i].second;
+        p99s[i] = GetTimingPercentileUs(stat.costBuckets, stat.count, stat.maxCostUs, TIMING_PERCENT_P99);
+    }
+    std::ostringstream oss;
+    oss << "Task timing: " << (IsTimingEnabled() ? "on" : "off") << ", budget(us): ";
+    if (budgetUs_ > 0) {
+        oss << budgetUs_;
+    } else {
+        oss << "off";
+    }
+    oss << ", names: " << stats.size() << std::endl;
+    auto dumpTop = [&oss, &stats, &p99s](const std::string& title, auto&& compare) {
+        std::vector<size_t> order(stats.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        const size_t topNum = std::min(order.size(), TIMING_DUMP_TOP_NUM);
+        std::partial_sort(order.begin(), order.begin() + topNum, order.end(), compare);
+        oss << title << std::endl;
+        // std::setw keeps the columns aligned whatever the width of the values
+        for (const char* column : { "Count", "Total(us)", "Avg(us)", "P99(us)", "Max(us)", "AvgWait(us)",
+            "MaxWait(us)", "OverBudget", "Sync", "AvgBlock(us)", "P99Block(us)" }) {
+            oss << std::left << std::setw(TIMING_DUMP_COLUMN_WIDTH) << column;
+        }
+        oss << "Name" << std::endl;
+        for (size_t i = 0; i < topNum; i++) {
+            const auto& [name, stat] = stats[order[i]];
+            const int64_t count = static_cast<int64_t>(std::max<uint64_t>(stat.count, 1));
+            const int64_t syncCount = static_cast<int64_t>(std::max<uint64_t>(stat.syncCount, 1));
+            for (int64_t value : { static_cast<int64_t>(stat.count), stat.totalCostUs, stat.totalCostUs / count,
+                p99s[order[i]], stat.maxCostUs, stat.totalWaitUs / count, stat.maxWaitUs,
+                static_cast<int64_t>(stat.overBudgetCount), static_cast<int64_t>(stat.syncCount),
+                stat.totalBlockUs / syncCount,
+                GetTimingPercentileUs(stat.blockBuckets, stat.syncCount, stat.maxBlockUs, TIMING_PERCENT_P99) }) {
+                oss << std::left << std::setw(TIMING_DUMP_COLUMN_WIDTH) << value;
+            }
+            oss << name << std::endl;
+        }
+    };
+    dumpTop("Top by total time:", [&stats](size_t lhs, size_t rhs) {
+        return stats[lhs].second.totalCostUs > stats[rhs].second.totalCostUs;
+    });
+    dumpTop("Top by p99:", [&p99s](size_t lhs, size_t rhs) {
+        return p99s[lhs] > p99s[rhs];
+    });
+    dumpTop("Top by sync block:", [&stats](size_t lhs, size_t rhs) {
+        return stats[lhs].second.totalBlockUs > stats[rhs].second.totalBlockUs;
+    });
+    dumpInfo.append(oss.str());
+}
+
 void StartTraceForSyncTask(const std::string& name)
 {
     StartTraceArgs(HITRACE_TAG_WINDOW_MANAGER, "ssm:%s", name.c_str());
@@ -26,6 +26,9 @@ constexpr uint32_t TOUCH_HOT_AREA_MAX_NUM = 50;
 constexpr uint32_t TRANSITION_ANIMATION_MAP_SIZE_MAX_NUM = 100;
 }
 
+std::atomic<uint64_t> WindowSessionProperty::displayIdGeneration_ { 0 };
+std::atomic<uint64_t> WindowSessionProperty::inputLayoutGenerationCounter_ { 0 };
+
 const std::map<uint64_t, HandlWritePropertyFunc> WindowSessionProperty::writeFuncMap_ {
     std::make_pair(static_cast<uint64_t>(WSPropertyChangeAction::ACTION_UPDATE_TURN_SCREEN_ON),
         &WindowSessionProperty::WriteActionUpdateTurnScreenOn),
@@ -218,6 +221,7 @@ void WindowSessionProperty::SetRectAnimationConfig(const RectAnimationConfig& re
 void WindowSessionProperty::SetWindowType(WindowType type)
 {
     type_ = type;
+    MarkInputLayoutChanged();
 }
 
 void WindowSessionProperty::SetFocusable(bool isFocusable)
@@ -308,7 +312,16 @@ void WindowSessionProperty::SetSystemCalling(bool isSystemCalling)
 
 void WindowSessionProperty::SetDisplayId(DisplayId displayId)
 {
+    if (displayId_ != displayId) {
+        displayIdGeneration_.fetch_add(1);
+    }
     displayId_ = displayId;
+    MarkInputLayoutChanged();
+}
+
+uint64_t WindowSessionProperty::GetDisplayIdGeneration()
+{
+    return displayIdGeneration_.load();
 }
 
 void WindowSessionProperty::SetIsFollowParentWindowDisplayId(bool enabled)
@@ -630,6 +643,7 @@ MaximizeMode WindowSessionProperty::GetMaximizeMode() const
 void WindowSessionProperty::SetMaximizeMode(MaximizeMode mode)
 {
     maximizeMode_ = mode;
+    MarkInputLayoutChanged();
 }
 
 void WindowSessionProperty::SetFollowScreenChange(bool isFollowScreenChange)
@@ -659,6 +673,7 @@ std::unordered_map<WindowType, SystemBarProperty> WindowSessionProperty::GetSyst
 void WindowSessionProperty::SetWindowLimits(const WindowLimits& windowLimits)
 {
     limits_ = windowLimits;
+    MarkInputLayoutChanged();
 }
 
 WindowLimits WindowSessionProperty::GetWindowLimits() const
@@ -669,6 +684,7 @@ WindowLimits WindowSessionProperty::GetWindowLimits() const
 void WindowSessionProperty::SetWindowMode(WindowMode mode)
 {
     windowMode_ = mode;
+    MarkInputLayoutChanged();
 }
 
 WindowMode WindowSessionProperty::GetWindowMode() const
@@ -705,6 +721,7 @@ KeyboardLayoutParams WindowSessionProperty::GetKeyboardLayoutParams() const
 void WindowSessionProperty::SetDecorEnable(bool isDecorEnable)
 {
     isDecorEnable_ = isDecorEnable;
+    MarkInputLayoutChanged();
 }
 
 bool WindowSessionProperty::IsDecorEnable()
@@ -778,6 +795,7 @@ void WindowSessionProperty::SetTouchHotAreas(const std::vector<Rect>& rects)
     {
         std::lock_guard lock(touchHotAreasMutex_);
         setTouchHotAreasInner(rects, touchHotAreas_);
+        MarkInputLayoutChanged();
     }
     if (touchHotAreasChangeCallback_) {
         touchHotAreasChangeCallback_();
@@ -796,6 +814,7 @@ void WindowSessionProperty::SetKeyboardTouchHotAreas(const KeyboardTouchHotAreas
             keyboardTouchHotAreas.landscapePanelHotAreas_, keyboardTouchHotAreas_.landscapePanelHotAreas_);
         setTouchHotAreasInner(
             keyboardTouchHotAreas.portraitPanelHotAreas_, keyboardTouchHotAreas_.portraitPanelHotAreas_);
+        MarkInputLayoutChanged();
     }
     if (touchHotAreasChangeCallback_) {
         touchHotAreasChangeCallback_();
@@ -814,6 +833,16 @@ KeyboardTouchHotAreas WindowSessionProperty::GetKeyboardTouchHotAreas() const
     return keyboardTouchHotAreas_;
 }
 
+uint64_t WindowSessionProperty::GetInputLayoutGeneration() const
+{
+    return inputLayoutGeneration_.load();
+}
+
+void WindowSessionProperty::MarkInputLayoutChanged()
+{
+    inputLayoutGeneration_.store(++inputLayoutGenerationCounter_);
+}
+
 void WindowSessionProperty::KeepKeyboardOnFocus(bool keepKeyboardFlag)
 {
     keepKeyboardFlag_ = keepKeyboardFlag;
@@ -1522,6 +1551,9 @@ void WindowSessionProperty::CopyFrom(const sptr<WindowSessionProperty>& property
     isSystemPrivacyMode_ = property->isSystemPrivacyMode_;
     isSnapshotSkip_ = property->isSnapshotSkip_;
     brightness_ = property->brightness_;
+    if (displayId_ != property->displayId_) {
+        displayIdGeneration_.fetch_add(1);
+    }
     displayId_ = property->displayId_;
     parentId_ = property->parentId_;
     flags_ = property->flags_;
@@ -1547,6 +1579,7 @@ void WindowSessionProperty::CopyFrom(const sptr<WindowSessionProperty>& property
     isFloatingWindowAppType_ = property->isFloatingWindowAppType_;
     touchHotAreas_ = property->touchHotAreas_;
     keyboardTouchHotAreas_ = property->keyboardTouchHotAreas_;
+    MarkInputLayoutChanged();
     hideNonSystemFloatingWindows_ = property->hideNonSystemFloatingWindows_;
     isSkipSelfWhenShowOnVirtualScreen_ = property->isSkipSelfWhenShowOnVirtualScreen_;
     isSkipEventOnCastPlus_ = property->isSkipEventOnCastPlus_;
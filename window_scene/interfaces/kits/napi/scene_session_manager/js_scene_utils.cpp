@@ -36,6 +36,7 @@ namespace {
 constexpr HiviewDFX::HiLogLabel LABEL = { LOG_CORE, HILOG_DOMAIN_WINDOW, "JsSceneUtils" };
 constexpr int32_t US_PER_NS = 1000;
 constexpr int32_t INVALID_VAL = -9999;
+const std::string BATCHED_TASK_NAME = "wms:SCBCbBatch";
 
 const std::unordered_map<int32_t, ThrowSlipMode> FINGERS_TO_THROWSLIPMODE_MAP = {
     { 3, ThrowSlipMode::THREE_FINGERS_SWIPE },
@@ -2620,6 +2621,9 @@ void MainThreadScheduler::PostMainThreadTask(Task&& localTask, std::string trace
     if (handler_ && handler_->GetEventRunner()->IsCurrentRunnerThread()) {
         return task();
     } else if (handler_ && !handler_->GetEventRunner()->IsCurrentRunnerThread()) {
+        if (delayTime == 0) {
+            return GetTaskBatcher().AddTask(std::move(task), traceInfo);
+        }
         handler_->PostTask(std::move(task), "wms:" + traceInfo, delayTime,
             OHOS::AppExecFwk::EventQueue::Priority::IMMEDIATE);
     } else {
@@ -2627,10 +2631,25 @@ void MainThreadScheduler::PostMainThreadTask(Task&& localTask, std::string trace
     }
 }
 
+/*
+ * Callbacks posted from other threads while a batch waits for the main thread run together in the next
+ * main thread task, in posting order, instead of one event each.
+ */
+TaskBatcher& MainThreadScheduler::GetTaskBatcher()
+{
+    static TaskBatcher taskBatcher("SCBCbBatch", [handler = std::make_shared<OHOS::AppExecFwk::EventHandler>(
+        OHOS::AppExecFwk::EventRunner::GetMainEventRunner())](TaskBatcher::Task&& task) {
+        return handler->PostTask(std::move(task), BATCHED_TASK_NAME, 0,
+            OHOS::AppExecFwk::EventQueue::Priority::IMMEDIATE);
+    });
+    return taskBatcher;
+}
+
 void MainThreadScheduler::RemoveMainThreadTaskByName(const std::string taskName)
 {
     if (handler_ && !handler_->GetEventRunner()->IsCurrentRunnerThread()) {
         handler_->RemoveTask("wms:" + taskName);
+        GetTaskBatcher().RemoveTask(taskName);
     }
 }
 } // namespace OHOS::Rosen
\ No newline at end of file
@@ -23,6 +23,7 @@
 
 #include "dm_common.h"
 #include "interfaces/include/ws_common.h"
+#include "common/include/task_batcher.h"
 #include "common/include/window_session_property.h"
 #include "wm_common.h"
 #include "hitrace_meter.h"
@@ -317,6 +318,11 @@ public:
 
 private:
     void GetMainEventHandler();
+
+    /*
+     * Shared by all schedulers, they all post to the main runner.
+     */
+    static TaskBatcher& GetTaskBatcher();
     napi_env env_;
     std::shared_ptr<int> envChecker_;
     std::shared_ptr<OHOS::AppExecFwk::EventHandler> handler_;
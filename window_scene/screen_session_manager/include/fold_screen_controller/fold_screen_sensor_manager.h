@@ -21,7 +21,9 @@
 #include <mutex>
 #include <climits>
 
+#include "common/include/task_scheduler.h"
 #include "fold_screen_controller.h"
+#include "fold_screen_controller/posture_sample_filter.h"
 #include "fold_screen_controller/sensor_fold_state_manager/sensor_fold_state_manager.h"
 #include "refbase.h"
 #include "wm_single_instance.h"
@@ -49,6 +51,8 @@ public:
 
     void SetSensorFoldStateManager(sptr<SensorFoldStateManager> sensorFoldStateManager);
 
+    void SetTaskScheduler(std::shared_ptr<TaskScheduler> scheduler);
+
     void HandlePostureData(const SensorEvent * const event);
 
     void HandleHallData(const SensorEvent * const event);
@@ -104,6 +108,12 @@ private:
 
     void NotifyFoldAngleChanged(float foldAngle);
 
+    void PostPostureFlushTask();
+
+    void PostSensorTask(TaskScheduler::Task&& task, const std::string& name);
+
+    void ApplyPosture(float angle, uint16_t hall, uint64_t sequence);
+
     FoldScreenSensorManager();
 
     ~FoldScreenSensorManager() = default;
@@ -115,6 +125,10 @@ private:
     bool registerPosture_ = false;
 
     bool registerHall_ = false;
+
+    PostureSampleFilter postureFilter_;
+
+    std::shared_ptr<TaskScheduler> taskScheduler_ = nullptr;
 };
 } // namespace Rosen
 } // namespace OHOS
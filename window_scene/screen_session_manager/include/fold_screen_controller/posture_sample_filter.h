@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_POSTURE_SAMPLE_FILTER_H
+#define OHOS_ROSEN_POSTURE_SAMPLE_FILTER_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+namespace Rosen {
+
+struct PostureSampleFilterConfig {
+    // angle changes smaller than this are held back, so noise around a threshold is not re-evaluated
+    float angleDeadband = 0.5F;
+    // at most one sample is forwarded per interval, hall changes and threshold crossings excepted
+    int64_t minIntervalMs = 0;
+    // a held back change is forwarded once the last forwarded sample is this old, or by the flush timer
+    int64_t settleMs = 100;
+};
+
+/*
+ * Decides which posture samples reach the fold state classification. Samples are forwarded when the
+ * hinge angle really moved, crossed one of the classification thresholds, when a hall value changed or
+ * when a small change has settled. Without thresholds every angle change is forwarded, so the deadband
+ * never delays a state change the filter does not know about.
+ * A held back change stays pending until the next forwarded sample or Flush, the caller schedules Flush
+ * settleMs after Accept asks for it so the final angle of a movement is never lost.
+ * Every forwarded sample is stamped with a rising sequence, the caller applies samples on one thread and
+ * skips those MarkApplied rejects, so a flushed sample that runs late never rolls a newer one back.
+ */
+class PostureSampleFilter {
+public:
+    explicit PostureSampleFilter(const PostureSampleFilterConfig& config = {});
+
+    /*
+     * Returns true when the sample is forwarded. needFlush is set when the sample is the first one held back
+     * since the last forward.
+     */
+    bool Accept(const std::vector<float>& angles, const std::vector<uint16_t>& halls, int64_t timestampMs,
+        bool& needFlush);
+    bool Accept(const std::vector<float>& angles, const std::vector<uint16_t>& halls, int64_t timestampMs,
+        bool& needFlush, uint64_t& sequence);
+
+    /*
+     * Forwards the pending change into angles and halls, returns false when there is none.
+     */
+    bool Flush(std::vector<float>& angles, std::vector<uint16_t>& halls, int64_t timestampMs);
+    bool Flush(std::vector<float>& angles, std::vector<uint16_t>& halls, int64_t timestampMs, uint64_t& sequence);
+
+    /*
+     * Returns false when a sample forwarded after this one was already applied.
+     */
+    bool MarkApplied(uint64_t sequence);
+
+    void SetAngleThresholds(const std::vector<float>& thresholds);
+
+    void Reset();
+
+    int64_t GetSettleMs() const { return config_.settleMs; }
+
+    uint64_t GetReceivedCount() const;
+
+    uint64_t GetForwardedCount() const;
+
+    static int64_t GetNowMs();
+
+private:
+    bool IsThresholdCrossed(const std::vector<float>& angles) const;
+    uint64_t Forward(const std::vector<float>& angles, const std::vector<uint16_t>& halls, int64_t timestampMs);
+
+    const PostureSampleFilterConfig config_;
+    mutable std::mutex mutex_;
+    std::vector<float> angleThresholds_;
+    bool hasForwarded_ = false;
+    std::vector<float> lastAngles_;
+    std::vector<uint16_t> lastHalls_;
+    int64_t lastForwardMs_ = 0;
+    bool hasPending_ = false;
+    std::vector<float> pendingAngles_;
+    std::vector<uint16_t> pendingHalls_;
+    uint64_t receivedCount_ = 0;
+    uint64_t forwardedCount_ = 0;
+    uint64_t appliedSequence_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_POSTURE_SAMPLE_FILTER_H
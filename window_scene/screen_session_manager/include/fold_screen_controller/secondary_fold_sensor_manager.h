@@ -21,9 +21,11 @@
 #include <mutex>
 #include <climits>
 
+#include "common/include/task_scheduler.h"
 #include "fold_screen_controller.h"
 #include "fold_screen_controller/sensor_fold_state_manager/sensor_fold_state_manager.h"
 #include "fold_screen_controller/fold_screen_sensor_manager.h"
+#include "fold_screen_controller/posture_sample_filter.h"
 #include "refbase.h"
 #include "wm_single_instance.h"
 #include "sensor_agent.h"
@@ -37,6 +39,7 @@ class SecondaryFoldSensorManager : public RefBase {
 public:
     void SetFoldScreenPolicy(sptr<FoldScreenPolicy> foldScreenPolicy);
     void SetSensorFoldStateManager(sptr<SensorFoldStateManager> sensorFoldStateManager);
+    void SetTaskScheduler(std::shared_ptr<TaskScheduler> scheduler);
     void RegisterPostureCallback();
     void RegisterHallCallback();
     void UnRegisterPostureCallback();
@@ -58,10 +61,15 @@ private:
     std::vector<float> globalAngle_ = {-1.0F, -1.0F, -1.0F};
     std::vector<uint16_t> globalHall_ = {USHRT_MAX, USHRT_MAX};
     bool registerPosture_ = false;
+    PostureSampleFilter postureFilter_;
+    std::shared_ptr<TaskScheduler> taskScheduler_ = nullptr;
 
     SecondaryFoldSensorManager() = default;
     ~SecondaryFoldSensorManager() = default;
     void NotifyFoldAngleChanged(const std::vector<float> &angles);
+    void PostPostureFlushTask();
+    void PostSensorTask(TaskScheduler::Task&& task, const std::string& name);
+    void ApplyPosture(const std::vector<float>& angles, const std::vector<uint16_t>& halls, uint64_t sequence);
     bool GetPostureInner(const SensorEvent * const event, float &valueBc, float &valueAb,
         float &valueAbAnti);
     bool GetHallInner(const SensorEvent * const event, uint16_t &valueBc, uint16_t &valueAb);
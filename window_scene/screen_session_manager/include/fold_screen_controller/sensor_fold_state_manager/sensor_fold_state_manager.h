@@ -36,6 +36,10 @@ public:
     virtual void HandleAngleOrHallChange(const std::vector<float> &angles, const std::vector<uint16_t> &halls,
         sptr<FoldScreenPolicy> foldScreenPolicy, bool isPostureRegistered);
     virtual void RegisterApplicationStateObserver();
+    /*
+     * Angles at which GetNextFoldState may change its result, empty when they are not known.
+     */
+    virtual std::vector<float> GetAngleThresholds() const;
     void ClearState(sptr<FoldScreenPolicy> foldScreenPolicy);
     bool IsTentMode();
 
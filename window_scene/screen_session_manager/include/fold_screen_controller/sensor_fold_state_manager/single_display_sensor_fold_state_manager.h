@@ -30,6 +30,7 @@ public:
     void HandleAngleChange(float angle, int hall, sptr<FoldScreenPolicy> foldScreenPolicy) override;
     void HandleHallChange(float angle, int hall, sptr<FoldScreenPolicy> foldScreenPolicy) override;
     void RegisterApplicationStateObserver() override;
+    std::vector<float> GetAngleThresholds() const override;
 
 private:
     FoldStatus GetNextFoldState(float angle, int hall);
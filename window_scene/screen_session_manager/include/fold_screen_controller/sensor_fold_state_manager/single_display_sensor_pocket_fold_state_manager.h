@@ -64,6 +64,7 @@ public:
     void HandleHallChange(float angle, int hall, sptr<FoldScreenPolicy> foldScreenPolicy) override;
     void HandleTentChange(int tentType, sptr<FoldScreenPolicy> foldScreenPolicy, int32_t hall = -1) override;
     void RegisterApplicationStateObserver() override;
+    std::vector<float> GetAngleThresholds() const override;
     
 private:
     FoldStatus GetNextFoldState(float angle, int hall);
@@ -29,6 +29,7 @@
 #include "sensor_agent.h"
 #include "sensor_agent_type.h"
 #include "common/include/task_scheduler.h"
+#include "fold_screen_controller/posture_sample_filter.h"
 #include "session/screen/include/screen_property.h"
 #include "dm_common.h"
  
@@ -76,8 +77,14 @@ private:
     int32_t curInterval_ = 0;
 
     uint16_t curHall_ = USHRT_MAX;
+
+    PostureSampleFilter postureFilter_;
  
-    void NotifyFoldAngleChanged(float foldAngle);
+    void NotifyFoldAngleChanged(float foldAngle, bool needHandleAngle = true);
+
+    void HandleFoldAngle(float foldAngle);
+
+    void PostPostureFlushTask();
  
     void NotifyHallChanged(uint16_t hall);
 
@@ -21,6 +21,7 @@
 
 #include "cutout_info.h"
 #include "xml_config_base.h"
+#include "xml_config_cache.h"
 #include "libxml/parser.h"
 
 namespace OHOS::Rosen {
@@ -79,6 +80,7 @@ private:
     static std::map<std::string, std::vector<std::string>> stringListConfig_;
     static std::vector<DisplayConfig> displaysConfigs_;
     static std::vector<DMRect> subCutoutBoundaryRect_;
+    static std::map<std::string, DMRect> cutoutSvgBoundaryRects_;
     static bool isWaterfallDisplay_;
     static bool isScreenCompressionEnableInLandscape_;
     static uint32_t curvedAreaInLandscape_;
@@ -91,15 +93,22 @@ private:
 
     static bool IsValidNode(const xmlNode& currNode);
     static void ReadEnableConfigInfo(const xmlNodePtr& currNode);
+    static void SetEnableConfig(const std::string& nodeName, bool enable);
     static void ReadIntNumbersConfigInfo(const xmlNodePtr& currNode);
     static void ReadStringConfigInfo(const xmlNodePtr& currNode);
     static void ReadStringListConfigInfo(const xmlNodePtr& currNode, std::string name);
     static std::string GetConfigPath(const std::string& configFileName);
     static void ParseNodeConfig(const xmlNodePtr& currNode);
+    static bool LoadConfig(const std::string& configFilePath, const std::string& cachePath);
+    static bool ParseConfigXml(const std::string& configFilePath);
+    static uint32_t GetConfigCacheVersion();
+    static void WriteConfigCache(XmlConfigCacheWriter& writer);
+    static bool ReadConfigCache(XmlConfigCacheReader& reader);
 
     static std::vector<std::string> Split(std::string str, std::string pattern);
     static bool IsNumber(std::string str);
     static DMRect CalcCutoutBoundaryRect(const std::string svgPath);
+    static DMRect CalcCutoutBoundaryRectFromSvg(const std::string& svgPath);
     static void ReadPhysicalDisplayConfigInfo(const xmlNodePtr& currNode);
     static void ReadScrollableParam(const xmlNodePtr& currNode);
     static uint64_t ParseStrToUll(const std::string& contentStr);
@@ -59,9 +59,11 @@ FoldScreenController::FoldScreenController(std::recursive_mutex& displayInfoMute
     if (FoldScreenStateInternel::IsSecondaryDisplayFoldDevice()) {
         SecondaryFoldSensorManager::GetInstance().SetFoldScreenPolicy(foldScreenPolicy_);
         SecondaryFoldSensorManager::GetInstance().SetSensorFoldStateManager(sensorFoldStateManager_);
+        SecondaryFoldSensorManager::GetInstance().SetTaskScheduler(screenPowerTaskScheduler_);
     } else {
         FoldScreenSensorManager::GetInstance().SetFoldScreenPolicy(foldScreenPolicy_);
         FoldScreenSensorManager::GetInstance().SetSensorFoldStateManager(sensorFoldStateManager_);
+        FoldScreenSensorManager::GetInstance().SetTaskScheduler(screenPowerTaskScheduler_);
     }
 #endif
 }
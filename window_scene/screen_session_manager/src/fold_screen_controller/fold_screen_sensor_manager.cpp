@@ -52,6 +52,9 @@ static float LARGE_FOLD_HALF_FOLDED_MIN_THRESHOLD = static_cast<float>(system::G
     ("const.large_fold.half_folded_min_threshold", 25));
 constexpr float MINI_NOTIFY_FOLD_ANGLE = 0.5F;
 float oldFoldAngle = 0.0F;
+const std::string POSTURE_FLUSH_TASK_NAME = "DMSPostureFlush";
+const std::string POSTURE_APPLY_TASK_NAME = "DMSHandlePosture";
+const std::string HALL_APPLY_TASK_NAME = "DMSHandleHall";
 } // namespace
 WM_IMPLEMENT_SINGLE_INSTANCE(FoldScreenSensorManager);
 
@@ -67,6 +70,14 @@ void FoldScreenSensorManager::SetFoldScreenPolicy(sptr<FoldScreenPolicy> foldScr
 void FoldScreenSensorManager::SetSensorFoldStateManager(sptr<SensorFoldStateManager> sensorFoldStateManager)
 {
     sensorFoldStateManager_ = sensorFoldStateManager;
+    if (sensorFoldStateManager_ != nullptr) {
+        postureFilter_.SetAngleThresholds(sensorFoldStateManager_->GetAngleThresholds());
+    }
+}
+
+void FoldScreenSensorManager::SetTaskScheduler(std::shared_ptr<TaskScheduler> scheduler)
+{
+    taskScheduler_ = scheduler;
 }
 
 void FoldScreenSensorManager::RegisterPostureCallback()
@@ -95,6 +106,10 @@ void FoldScreenSensorManager::UnRegisterPostureCallback()
         deactivateRet, unsubscribeRet);
     if (deactivateRet == SENSOR_SUCCESS && unsubscribeRet == SENSOR_SUCCESS) {
         registerPosture_ = false;
+        postureFilter_.Reset();
+        if (taskScheduler_ != nullptr) {
+            taskScheduler_->RemoveTask(POSTURE_FLUSH_TASK_NAME);
+        }
         TLOGI(WmsLogTag::DMS, "UnRegisterPostureCallback success.");
     }
 }
@@ -150,10 +165,54 @@ void FoldScreenSensorManager::HandlePostureData(const SensorEvent * const event)
         return;
     }
     TLOGD(WmsLogTag::DMS, "angle value in PostureData is: %{public}f.", globalAngle);
-    sensorFoldStateManager_->HandleAngleChange(globalAngle, globalHall, foldScreenPolicy_);
+    bool needFlush = false;
+    uint64_t sequence = 0;
+    if (postureFilter_.Accept({ globalAngle }, { globalHall }, PostureSampleFilter::GetNowMs(), needFlush,
+        sequence)) {
+        PostSensorTask([this, angle = globalAngle, hall = globalHall, sequence] {
+            ApplyPosture(angle, hall, sequence);
+        }, POSTURE_APPLY_TASK_NAME);
+    } else if (needFlush) {
+        PostPostureFlushTask();
+    }
     NotifyFoldAngleChanged(globalAngle);
 }
 
+void FoldScreenSensorManager::PostPostureFlushTask()
+{
+    if (taskScheduler_ == nullptr) {
+        return;
+    }
+    auto task = [this] {
+        std::vector<float> angles;
+        std::vector<uint16_t> halls;
+        uint64_t sequence = 0;
+        if (!postureFilter_.Flush(angles, halls, PostureSampleFilter::GetNowMs(), sequence)) {
+            return;
+        }
+        TLOGND(WmsLogTag::DMS, "flush held angle: %{public}f.", angles[0]);
+        ApplyPosture(angles[0], halls[0], sequence);
+    };
+    taskScheduler_->PostAsyncTask(task, POSTURE_FLUSH_TASK_NAME, postureFilter_.GetSettleMs());
+}
+
+void FoldScreenSensorManager::PostSensorTask(TaskScheduler::Task&& task, const std::string& name)
+{
+    if (taskScheduler_ == nullptr) {
+        task();
+        return;
+    }
+    taskScheduler_->PostAsyncTask(std::move(task), name);
+}
+
+void FoldScreenSensorManager::ApplyPosture(float angle, uint16_t hall, uint64_t sequence)
+{
+    if (sensorFoldStateManager_ == nullptr || !postureFilter_.MarkApplied(sequence)) {
+        return;
+    }
+    sensorFoldStateManager_->HandleAngleChange(angle, hall, foldScreenPolicy_);
+}
+
 void FoldScreenSensorManager::NotifyFoldAngleChanged(float foldAngle)
 {
     if (fabs(foldAngle - oldFoldAngle) < MINI_NOTIFY_FOLD_ANGLE) {
@@ -200,7 +259,9 @@ void FoldScreenSensorManager::HandleHallData(const SensorEvent * const event)
     if (!registerPosture_) {
         globalAngle = ANGLE_MIN_VAL;
     }
-    sensorFoldStateManager_->HandleHallChange(globalAngle, globalHall, foldScreenPolicy_);
+    PostSensorTask([this, angle = globalAngle, hall = globalHall] {
+        sensorFoldStateManager_->HandleHallChange(angle, hall, foldScreenPolicy_);
+    }, HALL_APPLY_TASK_NAME);
 }
 
 void FoldScreenSensorManager::RegisterApplicationStateObserver()
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fold_screen_controller/posture_sample_filter.h"
+
+#include <chrono>
+#include <cmath>
+
+namespace OHOS {
+namespace Rosen {
+PostureSampleFilter::PostureSampleFilter(const PostureSampleFilterConfig& config) : config_(config) {}
+
+bool PostureSampleFilter::Accept(const std::vector<float>& angles, const std::vector<uint16_t>& halls,
+    int64_t timestampMs, bool& needFlush)
+{
+    uint64_t sequence = 0;
+    return Accept(angles, halls, timestampMs, needFlush, sequence);
+}
+
+bool PostureSampleFilter::Accept(const std::vector<float>& angles, const std::vector<uint16_t>& halls,
+    int64_t timestampMs, bool& needFlush, uint64_t& sequence)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    receivedCount_++;
+    needFlush = false;
+    if (!hasForwarded_ || angles.size() != lastAngles_.size() || halls != lastHalls_ ||
+        IsThresholdCrossed(angles)) {
+        sequence = Forward(angles, halls, timestampMs);
+        return true;
+    }
+    bool isMoved = false;
+    bool isChanged = false;
+    for (size_t i = 0; i < angles.size(); i++) {
+        float delta = std::fabs(angles[i] - lastAngles_[i]);
+        isMoved = isMoved || std::isgreaterequal(delta, config_.angleDeadband) || angleThresholds_.empty();
+        isChanged = isChanged || std::isgreater(delta, 0.0F);
+    }
+    int64_t elapsedMs = timestampMs - lastForwardMs_;
+    if (isChanged && elapsedMs >= config_.minIntervalMs && (isMoved || elapsedMs >= config_.settleMs)) {
+        sequence = Forward(angles, halls, timestampMs);
+        return true;
+    }
+    if (!isChanged) {
+        hasPending_ = false;
+        return false;
+    }
+    needFlush = !hasPending_;
+    hasPending_ = true;
+    pendingAngles_ = angles;
+    pendingHalls_ = halls;
+    return false;
+}
+
+bool PostureSampleFilter::Flush(std::vector<float>& angles, std::vector<uint16_t>& halls, int64_t timestampMs)
+{
+    uint64_t sequence = 0;
+    return Flush(angles, halls, timestampMs, sequence);
+}
+
+bool PostureSampleFilter::Flush(std::vector<float>& angles, std::vector<uint16_t>& halls, int64_t timestampMs,
+    uint64_t& sequence)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasPending_) {
+        return false;
+    }
+    angles = pendingAngles_;
+    halls = pendingHalls_;
+    sequence = Forward(angles, halls, timestampMs);
+    return true;
+}
+
+bool PostureSampleFilter::MarkApplied(uint64_t sequence)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sequence <= appliedSequence_) {
+        return false;
+    }
+    appliedSequence_ = sequence;
+    return true;
+}
+
+bool PostureSampleFilter::IsThresholdCrossed(const std::vector<float>& angles) const
+{
+    for (size_t i = 0; i < angles.size(); i++) {
+        for (float threshold : angleThresholds_) {
+            if (std::isless(angles[i], threshold) != std::isless(lastAngles_[i], threshold) ||
+                std::isgreater(angles[i], threshold) != std::isgreater(lastAngles_[i], threshold)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint64_t PostureSampleFilter::Forward(const std::vector<float>& angles, const std::vector<uint16_t>& halls,
+    int64_t timestampMs)
+{
+    hasForwarded_ = true;
+    hasPending_ = false;
+    lastAngles_ = angles;
+    lastHalls_ = halls;
+    lastForwardMs_ = timestampMs;
+    return ++forwardedCount_;
+}
+
+void PostureSampleFilter::SetAngleThresholds(const std::vector<float>& thresholds)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    angleThresholds_ = thresholds;
+}
+
+void PostureSampleFilter::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    hasForwarded_ = false;
+    hasPending_ = false;
+    lastAngles_.clear();
+    lastHalls_.clear();
+    lastForwardMs_ = 0;
+}
+
+uint64_t PostureSampleFilter::GetReceivedCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return receivedCount_;
+}
+
+uint64_t PostureSampleFilter::GetForwardedCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return forwardedCount_;
+}
+
+int64_t PostureSampleFilter::GetNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -52,6 +52,9 @@ const int32_t GLOBAL_FULL_STATUS_WIDTH = 2;
 const int32_t SCREEN_HEIGHT = 3;
 const int32_t FULL_STATUS_OFFSET_X = 4;
 const int32_t PARAMS_VECTOR_SIZE = 5;
+const std::string POSTURE_FLUSH_TASK_NAME = "DMSSecondaryPostureFlush";
+const std::string POSTURE_APPLY_TASK_NAME = "DMSSecondaryHandlePosture";
+const std::string HALL_APPLY_TASK_NAME = "DMSSecondaryHandleHall";
 } // namespace
 WM_IMPLEMENT_SINGLE_INSTANCE(SecondaryFoldSensorManager);
 
@@ -73,6 +76,14 @@ void SecondaryFoldSensorManager::SetFoldScreenPolicy(sptr<FoldScreenPolicy> fold
 void SecondaryFoldSensorManager::SetSensorFoldStateManager(sptr<SensorFoldStateManager> sensorFoldStateManager)
 {
     sensorFoldStateManager_ = sensorFoldStateManager;
+    if (sensorFoldStateManager_ != nullptr) {
+        postureFilter_.SetAngleThresholds(sensorFoldStateManager_->GetAngleThresholds());
+    }
+}
+
+void SecondaryFoldSensorManager::SetTaskScheduler(std::shared_ptr<TaskScheduler> scheduler)
+{
+    taskScheduler_ = scheduler;
 }
 
 void SecondaryFoldSensorManager::RegisterPostureCallback()
@@ -100,6 +111,10 @@ void SecondaryFoldSensorManager::UnRegisterPostureCallback()
         deactivateRet, unsubscribeRet);
     if (deactivateRet == SENSOR_SUCCESS && unsubscribeRet == SENSOR_SUCCESS) {
         registerPosture_ = false;
+        postureFilter_.Reset();
+        if (taskScheduler_ != nullptr) {
+            taskScheduler_->RemoveTask(POSTURE_FLUSH_TASK_NAME);
+        }
         TLOGI(WmsLogTag::DMS, "success.");
     }
 }
@@ -149,10 +164,55 @@ void SecondaryFoldSensorManager::HandlePostureData(const SensorEvent * const eve
     if (sensorFoldStateManager_ == nullptr) {
         return;
     }
-    sensorFoldStateManager_->HandleAngleOrHallChange(globalAngle_, globalHall_, foldScreenPolicy_, true);
+    bool needFlush = false;
+    uint64_t sequence = 0;
+    if (postureFilter_.Accept(globalAngle_, globalHall_, PostureSampleFilter::GetNowMs(), needFlush, sequence)) {
+        PostSensorTask([this, angles = globalAngle_, halls = globalHall_, sequence] {
+            ApplyPosture(angles, halls, sequence);
+        }, POSTURE_APPLY_TASK_NAME);
+    } else if (needFlush) {
+        PostPostureFlushTask();
+    }
     NotifyFoldAngleChanged(globalAngle_);
 }
 
+void SecondaryFoldSensorManager::PostPostureFlushTask()
+{
+    if (taskScheduler_ == nullptr) {
+        return;
+    }
+    auto task = [this] {
+        std::vector<float> angles;
+        std::vector<uint16_t> halls;
+        uint64_t sequence = 0;
+        if (!postureFilter_.Flush(angles, halls, PostureSampleFilter::GetNowMs(), sequence)) {
+            return;
+        }
+        TLOGND(WmsLogTag::DMS, "flush held %{public}s",
+            FoldScreenStateInternel::TransVec2Str(angles, "angle").c_str());
+        ApplyPosture(angles, halls, sequence);
+    };
+    taskScheduler_->PostAsyncTask(task, POSTURE_FLUSH_TASK_NAME, postureFilter_.GetSettleMs());
+}
+
+void SecondaryFoldSensorManager::PostSensorTask(TaskScheduler::Task&& task, const std::string& name)
+{
+    if (taskScheduler_ == nullptr) {
+        task();
+        return;
+    }
+    taskScheduler_->PostAsyncTask(std::move(task), name);
+}
+
+void SecondaryFoldSensorManager::ApplyPosture(const std::vector<float>& angles, const std::vector<uint16_t>& halls,
+    uint64_t sequence)
+{
+    if (sensorFoldStateManager_ == nullptr || !postureFilter_.MarkApplied(sequence)) {
+        return;
+    }
+    sensorFoldStateManager_->HandleAngleOrHallChange(angles, halls, foldScreenPolicy_, true);
+}
+
 void SecondaryFoldSensorManager::NotifyFoldAngleChanged(const std::vector<float> &angles)
 {
     if (angles.size() < SECONDARY_HALL_SIZE) {
@@ -192,7 +252,9 @@ void SecondaryFoldSensorManager::HandleHallDataExt(const SensorEvent * const eve
     if (sensorFoldStateManager_ == nullptr) {
         return;
     }
-    sensorFoldStateManager_->HandleAngleOrHallChange(globalAngle_, globalHall_, foldScreenPolicy_, registerPosture_);
+    PostSensorTask([this, angles = globalAngle_, halls = globalHall_, isPostureRegistered = registerPosture_] {
+        sensorFoldStateManager_->HandleAngleOrHallChange(angles, halls, foldScreenPolicy_, isPostureRegistered);
+    }, HALL_APPLY_TASK_NAME);
     return;
 }
 
@@ -40,6 +40,11 @@ void SensorFoldStateManager::HandleAngleOrHallChange(const std::vector<float> &a
 
 void SensorFoldStateManager::HandleTentChange(int tentType, sptr<FoldScreenPolicy> foldScreenPolicy, int32_t hall) {}
 
+std::vector<float> SensorFoldStateManager::GetAngleThresholds() const
+{
+    return {};
+}
+
 void SensorFoldStateManager::HandleSensorChange(FoldStatus nextState, float angle,
     sptr<FoldScreenPolicy> foldScreenPolicy)
 {
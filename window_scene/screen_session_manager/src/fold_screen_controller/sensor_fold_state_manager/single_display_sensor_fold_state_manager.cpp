@@ -115,4 +115,12 @@ FoldStatus SingleDisplaySensorFoldStateManager::GetNextFoldState(float angle, in
 }
 
 void SingleDisplaySensorFoldStateManager::RegisterApplicationStateObserver() {}
+
+std::vector<float> SingleDisplaySensorFoldStateManager::GetAngleThresholds() const
+{
+    return { ANGLE_MIN_VAL, OPEN_ALTA_HALF_FOLDED_MIN_THRESHOLD,
+        OPEN_ALTA_HALF_FOLDED_MIN_THRESHOLD + ALTA_HALF_FOLDED_BUFFER, CLOSE_ALTA_HALF_FOLDED_MIN_THRESHOLD,
+        CLOSE_ALTA_HALF_FOLDED_MIN_THRESHOLD + ALTA_HALF_FOLDED_BUFFER, LARGER_BOUNDARY_FOR_ALTA_THRESHOLD,
+        ALTA_HALF_FOLDED_MAX_THRESHOLD - ALTA_HALF_FOLDED_BUFFER, ALTA_HALF_FOLDED_MAX_THRESHOLD };
+}
 } // namespace OHOS::Rosen
\ No newline at end of file
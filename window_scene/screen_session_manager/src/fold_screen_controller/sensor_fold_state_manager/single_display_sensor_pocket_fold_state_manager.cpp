@@ -163,6 +163,15 @@ void SingleDisplaySensorPocketFoldStateManager::RegisterApplicationStateObserver
     }
 }
 
+std::vector<float> SingleDisplaySensorPocketFoldStateManager::GetAngleThresholds() const
+{
+    return { ANGLE_MIN_VAL, TENT_MODE_EXIT_MIN_THRESHOLD, OPEN_ALTA_HALF_FOLDED_MIN_THRESHOLD,
+        OPEN_ALTA_HALF_FOLDED_MIN_THRESHOLD + ALTA_HALF_FOLDED_BUFFER, CLOSE_ALTA_HALF_FOLDED_MIN_THRESHOLD,
+        CLOSE_ALTA_HALF_FOLDED_MIN_THRESHOLD + ALTA_HALF_FOLDED_BUFFER, LARGER_BOUNDARY_FOR_ALTA_THRESHOLD,
+        ALTA_HALF_FOLDED_MAX_THRESHOLD - ALTA_HALF_FOLDED_BUFFER, ALTA_HALF_FOLDED_MAX_THRESHOLD,
+        TENT_MODE_EXIT_MAX_THRESHOLD };
+}
+
 void SingleDisplaySensorPocketFoldStateManager::HandleTentChange(int tentType,
     sptr<FoldScreenPolicy> foldScreenPolicy, int32_t hall)
 {
@@ -43,6 +43,7 @@ constexpr int32_t POSTURE_INTERVAL_FOR_WIDE_ANGLE = 10000000; // 10ms
 constexpr float UNFOLD_ANGLE = 170.0F;
 constexpr uint16_t SENSOR_EVENT_FIRST_DATA = 0;
 constexpr float ACCURACY_ERROR_FOR_PC = 0.0001F;
+const std::string POSTURE_FLUSH_TASK_NAME = "DMSPostureFlush";
 } // namespace
 
 SuperFoldSensorManager &SuperFoldSensorManager::GetInstance()
@@ -85,6 +86,10 @@ void SuperFoldSensorManager::UnregisterPostureCallback()
     TLOGI(WmsLogTag::DMS, "deactivateRet: %{public}d, unsubscribeRet: %{public}d",
         deactivateRet, unsubscribeRet);
     if (deactivateRet == SENSOR_SUCCESS && unsubscribeRet == SENSOR_SUCCESS) {
+        postureFilter_.Reset();
+        if (taskScheduler_) {
+            taskScheduler_->RemoveTask(POSTURE_FLUSH_TASK_NAME);
+        }
         TLOGI(WmsLogTag::DMS, "FoldScreenSensorManager.UnRegisterPostureCallback success.");
     }
 }
@@ -147,15 +152,53 @@ void SuperFoldSensorManager::HandlePostureData(const SensorEvent * const event)
         return;
     }
     TLOGD(WmsLogTag::DMS, "angle value is: %{public}f.", curAngle_);
-    auto task = [this, curAngle = curAngle_] {
-        NotifyFoldAngleChanged(curAngle);
+    // the orientation decides whether an angle event is handled, a flip has to get through at once
+    uint16_t isHorizontal = ScreenRotationProperty::isDeviceHorizontal() ? 1 : 0;
+    bool needFlush = false;
+    uint64_t sequence = 0;
+    bool needHandleAngle = postureFilter_.Accept({ curAngle_ }, { isHorizontal }, PostureSampleFilter::GetNowMs(),
+        needFlush, sequence);
+    auto task = [this, curAngle = curAngle_, needHandleAngle, sequence] {
+        NotifyFoldAngleChanged(curAngle, needHandleAngle && postureFilter_.MarkApplied(sequence));
     };
     if (taskScheduler_) {
         taskScheduler_->PostAsyncTask(task, "DMSHandlePosture");
     }
+    if (needFlush) {
+        PostPostureFlushTask();
+    }
+}
+
+void SuperFoldSensorManager::PostPostureFlushTask()
+{
+    if (!taskScheduler_) {
+        return;
+    }
+    auto task = [this] {
+        std::vector<float> angles;
+        std::vector<uint16_t> halls;
+        uint64_t sequence = 0;
+        if (!postureFilter_.Flush(angles, halls, PostureSampleFilter::GetNowMs(), sequence) ||
+            !postureFilter_.MarkApplied(sequence)) {
+            return;
+        }
+        TLOGND(WmsLogTag::DMS, "flush held angle: %{public}f.", angles[0]);
+        HandleFoldAngle(angles[0]);
+    };
+    taskScheduler_->PostAsyncTask(task, POSTURE_FLUSH_TASK_NAME, postureFilter_.GetSettleMs());
+}
+
+void SuperFoldSensorManager::NotifyFoldAngleChanged(float foldAngle, bool needHandleAngle)
+{
+    std::vector<float> foldAngles;
+    foldAngles.push_back(foldAngle);
+    ScreenSessionManager::GetInstance().NotifyFoldAngleChanged(foldAngles);
+    if (needHandleAngle) {
+        HandleFoldAngle(foldAngle);
+    }
 }
 
-void SuperFoldSensorManager::NotifyFoldAngleChanged(float foldAngle)
+void SuperFoldSensorManager::HandleFoldAngle(float foldAngle)
 {
     SuperFoldStatusChangeEvents events = SuperFoldStatusChangeEvents::UNDEFINED;
     if (std::isgreaterequal(foldAngle, ANGLE_FLAT_THRESHOLD)) {
@@ -175,10 +218,6 @@ void SuperFoldSensorManager::NotifyFoldAngleChanged(float foldAngle)
         }
         TLOGD(WmsLogTag::DMS, "NotifyFoldAngleChanged is in BufferArea");
     }
-    // notify
-    std::vector<float> foldAngles;
-    foldAngles.push_back(foldAngle);
-    ScreenSessionManager::GetInstance().NotifyFoldAngleChanged(foldAngles);
     if (!ScreenRotationProperty::isDeviceHorizontal() ||
         events == SuperFoldStatusChangeEvents::ANGLE_CHANGE_EXPANDED) {
         HandleSuperSensorChange(events);
@@ -291,7 +330,10 @@ float SuperFoldSensorManager::GetCurAngle()
     return curAngle_;
 }
 
-SuperFoldSensorManager::SuperFoldSensorManager() {}
+SuperFoldSensorManager::SuperFoldSensorManager()
+{
+    postureFilter_.SetAngleThresholds({ ANGLE_MIN_VAL, ANGLE_HALF_FOLD_THRESHOLD, ANGLE_FLAT_THRESHOLD });
+}
 
 SuperFoldSensorManager::~SuperFoldSensorManager() {}
 
@@ -33,12 +33,16 @@
 #include "include/utils/SkParsePath.h"
 #include "screen_session_manager.h"
 #include "window_manager_hilog.h"
+#include "xml_config_cache.h"
 
 namespace OHOS::Rosen {
 namespace {
 constexpr uint32_t NO_WATERFALL_DISPLAY_COMPRESSION_SIZE = 0;
 constexpr uint32_t DISPLAY_PHYSICAL_SIZE = 2;
 constexpr uint32_t SCROLLABLE_PARAM_SIZE = 2;
+constexpr const char* CONFIG_CACHE_PATH = "/data/service/el1/public/window/display_manager_config.cache";
+// bump when parsing produces a different config for the same xml
+constexpr uint32_t CONFIG_CACHE_VERSION = 1;
 enum XmlNodeElement {
     DPI = 0,
     SUB_DPI,
@@ -70,6 +74,53 @@ enum XmlNodeElement {
     PC_MODE_DPI,
     SUPPORT_DURING_CALL
 };
+
+void WriteRect(XmlConfigCacheWriter& writer, const DMRect& rect)
+{
+    writer.WriteInt32(rect.posX_);
+    writer.WriteInt32(rect.posY_);
+    writer.WriteUint32(rect.width_);
+    writer.WriteUint32(rect.height_);
+}
+
+bool ReadRect(XmlConfigCacheReader& reader, DMRect& rect)
+{
+    return reader.ReadInt32(rect.posX_) && reader.ReadInt32(rect.posY_) &&
+        reader.ReadUint32(rect.width_) && reader.ReadUint32(rect.height_);
+}
+
+void WriteDisplayConfig(XmlConfigCacheWriter& writer, const DisplayConfig& config)
+{
+    writer.WriteUint64(config.physicalId);
+    writer.WriteUint64(config.logicalId);
+    writer.WriteString(config.name);
+    writer.WriteInt32(config.dpi);
+    writer.WriteBool(config.hasFlag);
+    writer.WriteString(config.flag.type);
+    writer.WriteInt32(config.flag.value);
+}
+
+bool ReadDisplayConfig(XmlConfigCacheReader& reader, DisplayConfig& config)
+{
+    return reader.ReadUint64(config.physicalId) && reader.ReadUint64(config.logicalId) &&
+        reader.ReadString(config.name) && reader.ReadInt32(config.dpi) && reader.ReadBool(config.hasFlag) &&
+        reader.ReadString(config.flag.type) && reader.ReadInt32(config.flag.value);
+}
+
+void WriteFoldDisplayMode(XmlConfigCacheWriter& writer, FoldDisplayMode mode)
+{
+    writer.WriteUint32(static_cast<uint32_t>(mode));
+}
+
+bool ReadFoldDisplayMode(XmlConfigCacheReader& reader, FoldDisplayMode& mode)
+{
+    uint32_t value = 0;
+    if (!reader.ReadUint32(value)) {
+        return false;
+    }
+    mode = static_cast<FoldDisplayMode>(value);
+    return true;
+}
 }
 
 std::map<std::string, bool> ScreenSceneConfig::enableConfig_;
@@ -81,6 +132,7 @@ std::vector<DisplayPhysicalResolution> ScreenSceneConfig::displayPhysicalResolut
 std::map<FoldDisplayMode, ScrollableParam> ScreenSceneConfig::scrollableParams_;
 std::vector<DisplayConfig> ScreenSceneConfig::displaysConfigs_;
 std::vector<DMRect> ScreenSceneConfig::subCutoutBoundaryRect_;
+std::map<std::string, DMRect> ScreenSceneConfig::cutoutSvgBoundaryRects_;
 bool ScreenSceneConfig::isWaterfallDisplay_ = false;
 bool ScreenSceneConfig::isSupportCapture_ = false;
 bool ScreenSceneConfig::isScreenCompressionEnableInLandscape_ = false;
@@ -165,6 +217,204 @@ std::string ScreenSceneConfig::GetConfigPath(const std::string& configFileName)
 bool ScreenSceneConfig::LoadConfigXml()
 {
     auto configFilePath = GetConfigPath("etc/window/resources/display_manager_config.xml");
+    return LoadConfig(configFilePath, CONFIG_CACHE_PATH);
+}
+
+bool ScreenSceneConfig::LoadConfig(const std::string& configFilePath, const std::string& cachePath)
+{
+    XmlConfigSource source;
+    bool hasSource = XmlConfigCache::GetSource(configFilePath, source);
+    if (hasSource && XmlConfigCache::Load(cachePath, source, GetConfigCacheVersion(), ReadConfigCache)) {
+        TLOGI(WmsLogTag::DMS, "filePath: %{public}s, loaded from cache", configFilePath.c_str());
+        return true;
+    }
+    if (!ParseConfigXml(configFilePath)) {
+        return false;
+    }
+    if (hasSource) {
+        XmlConfigCacheWriter writer;
+        WriteConfigCache(writer);
+        XmlConfigCache::Store(cachePath, source, GetConfigCacheVersion(), writer);
+    }
+    return true;
+}
+
+uint32_t ScreenSceneConfig::GetConfigCacheVersion()
+{
+    XmlConfigCacheWriter writer;
+    writer.WriteUint32(CONFIG_CACHE_VERSION);
+    for (const auto& [element, name] : xmlNodeMap_) {
+        writer.WriteInt32(element);
+        writer.WriteString(name);
+    }
+    return static_cast<uint32_t>(XmlConfigCache::Hash(writer.GetData().data(), writer.GetData().size()));
+}
+
+void ScreenSceneConfig::WriteConfigCache(XmlConfigCacheWriter& writer)
+{
+    // the cutout paths are parsed here once, later starts take the boundary rects from the cache
+    for (auto element : { DEFAULT_DISPLAY_CUTOUT_PATH, SUB_DISPLAY_CUTOUT_PATH }) {
+        auto iter = stringConfig_.find(xmlNodeMap_[element]);
+        if (iter != stringConfig_.end() && !iter->second.empty()) {
+            CalcCutoutBoundaryRect(iter->second);
+        }
+    }
+    writer.WriteUint32(static_cast<uint32_t>(enableConfig_.size()));
+    for (const auto& [name, enable] : enableConfig_) {
+        writer.WriteString(name);
+        writer.WriteBool(enable);
+    }
+    writer.WriteUint32(static_cast<uint32_t>(intNumbersConfig_.size()));
+    for (const auto& [name, numbers] : intNumbersConfig_) {
+        writer.WriteString(name);
+        writer.WriteInts(numbers);
+    }
+    writer.WriteUint32(static_cast<uint32_t>(stringConfig_.size()));
+    for (const auto& [name, str] : stringConfig_) {
+        writer.WriteString(name);
+        writer.WriteString(str);
+    }
+    writer.WriteUint32(static_cast<uint32_t>(stringListConfig_.size()));
+    for (const auto& [name, strings] : stringListConfig_) {
+        writer.WriteString(name);
+        writer.WriteStrings(strings);
+    }
+    writer.WriteUint32(static_cast<uint32_t>(displaysConfigs_.size()));
+    for (const auto& config : displaysConfigs_) {
+        WriteDisplayConfig(writer, config);
+    }
+    writer.WriteUint32(static_cast<uint32_t>(displayPhysicalResolution_.size()));
+    for (const auto& resolution : displayPhysicalResolution_) {
+        WriteFoldDisplayMode(writer, resolution.foldDisplayMode_);
+        writer.WriteUint32(resolution.physicalWidth_);
+        writer.WriteUint32(resolution.physicalHeight_);
+    }
+    writer.WriteUint32(static_cast<uint32_t>(scrollableParams_.size()));
+    for (const auto& [mode, param] : scrollableParams_) {
+        WriteFoldDisplayMode(writer, mode);
+        writer.WriteString(param.velocityScale_);
+        writer.WriteString(param.friction_);
+    }
+    writer.WriteUint32(static_cast<uint32_t>(cutoutSvgBoundaryRects_.size()));
+    for (const auto& [svgPath, rect] : cutoutSvgBoundaryRects_) {
+        writer.WriteString(svgPath);
+        WriteRect(writer, rect);
+    }
+}
+
+bool ScreenSceneConfig::ReadConfigCache(XmlConfigCacheReader& reader)
+{
+    // decoded aside, a corrupted cache leaves the config untouched for the xml fallback
+    std::map<std::string, bool> enableConfig;
+    std::map<std::string, std::vector<int>> intNumbersConfig;
+    std::map<std::string, std::string> stringConfig;
+    std::map<std::string, std::vector<std::string>> stringListConfig;
+    std::vector<DisplayConfig> displaysConfigs;
+    std::vector<DisplayPhysicalResolution> displayPhysicalResolution;
+    std::map<FoldDisplayMode, ScrollableParam> scrollableParams;
+    std::map<std::string, DMRect> cutoutSvgBoundaryRects;
+    uint32_t count = 0;
+    std::string name;
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!reader.ReadString(name) || !reader.ReadBool(enableConfig[name])) {
+            return false;
+        }
+    }
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!reader.ReadString(name) || !reader.ReadInts(intNumbersConfig[name])) {
+            return false;
+        }
+    }
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!reader.ReadString(name) || !reader.ReadString(stringConfig[name])) {
+            return false;
+        }
+    }
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!reader.ReadString(name) || !reader.ReadStrings(stringListConfig[name])) {
+            return false;
+        }
+    }
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        DisplayConfig config;
+        if (!ReadDisplayConfig(reader, config)) {
+            return false;
+        }
+        displaysConfigs.emplace_back(config);
+    }
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        DisplayPhysicalResolution resolution;
+        if (!ReadFoldDisplayMode(reader, resolution.foldDisplayMode_) ||
+            !reader.ReadUint32(resolution.physicalWidth_) || !reader.ReadUint32(resolution.physicalHeight_)) {
+            return false;
+        }
+        displayPhysicalResolution.emplace_back(resolution);
+    }
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        FoldDisplayMode mode = FoldDisplayMode::UNKNOWN;
+        ScrollableParam param;
+        if (!ReadFoldDisplayMode(reader, mode) || !reader.ReadString(param.velocityScale_) ||
+            !reader.ReadString(param.friction_)) {
+            return false;
+        }
+        scrollableParams[mode] = param;
+    }
+    if (!reader.ReadUint32(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!reader.ReadString(name) || !ReadRect(reader, cutoutSvgBoundaryRects[name])) {
+            return false;
+        }
+    }
+    // merged the way parsing the xml merges into the config
+    for (const auto& [nodeName, enable] : enableConfig) {
+        SetEnableConfig(nodeName, enable);
+    }
+    for (auto& [nodeName, numbers] : intNumbersConfig) {
+        intNumbersConfig_[nodeName] = std::move(numbers);
+    }
+    for (auto& [nodeName, str] : stringConfig) {
+        stringConfig_[nodeName] = std::move(str);
+    }
+    for (auto& [nodeName, strings] : stringListConfig) {
+        stringListConfig_[nodeName] = std::move(strings);
+    }
+    displaysConfigs_.insert(displaysConfigs_.end(), displaysConfigs.begin(), displaysConfigs.end());
+    displayPhysicalResolution_.insert(displayPhysicalResolution_.end(),
+        displayPhysicalResolution.begin(), displayPhysicalResolution.end());
+    for (const auto& [mode, param] : scrollableParams) {
+        scrollableParams_[mode] = param;
+    }
+    for (const auto& [svgPath, rect] : cutoutSvgBoundaryRects) {
+        cutoutSvgBoundaryRects_[svgPath] = rect;
+    }
+    return true;
+}
+
+bool ScreenSceneConfig::ParseConfigXml(const std::string& configFilePath)
+{
     xmlDocPtr docPtr = nullptr;
     {
         std::lock_guard<std::recursive_mutex> lock(mutex_);
@@ -187,7 +437,6 @@ bool ScreenSceneConfig::LoadConfigXml()
             TLOGE(WmsLogTag::DMS, ":invalid node!");
             continue;
         }
-        ParseNodeConfig(curNodePtr);
         if (xmlStrcmp(curNodePtr->name, reinterpret_cast<const xmlChar*>("displays")) != 0) {
             ParseNodeConfig(curNodePtr);
         } else {
@@ -485,25 +734,29 @@ void ScreenSceneConfig::ReadEnableConfigInfo(const xmlNodePtr& currNode)
     }
 
     std::string nodeName = reinterpret_cast<const char *>(currNode->name);
-    if (!xmlStrcmp(enable, reinterpret_cast<const xmlChar*>("true"))) {
-        enableConfig_[nodeName] = true;
-        if (xmlNodeMap_[IS_WATERFALL_DISPLAY] == nodeName) {
-            isWaterfallDisplay_ = true;
-        } else if (xmlNodeMap_[IS_CURVED_COMPRESS_ENABLED] == nodeName) {
-            isScreenCompressionEnableInLandscape_ = true;
-        } else if (xmlNodeMap_[IS_SUPPORT_CAPTURE] == nodeName) {
-            isSupportCapture_ = true;
-        } else if (xmlNodeMap_[IS_SUPPORT_OFFSCREEN_RENDERING] == nodeName) {
-            isSupportOffScreenRendering_ = true;
-        } else if (xmlNodeMap_[IS_CONCURRENT_USER] == nodeName) {
-            isConcurrentUser_ = true;
-        }
-    } else {
-        enableConfig_[nodeName] = false;
-    }
+    SetEnableConfig(nodeName, !xmlStrcmp(enable, reinterpret_cast<const xmlChar*>("true")));
     xmlFree(enable);
 }
 
+void ScreenSceneConfig::SetEnableConfig(const std::string& nodeName, bool enable)
+{
+    enableConfig_[nodeName] = enable;
+    if (!enable) {
+        return;
+    }
+    if (xmlNodeMap_[IS_WATERFALL_DISPLAY] == nodeName) {
+        isWaterfallDisplay_ = true;
+    } else if (xmlNodeMap_[IS_CURVED_COMPRESS_ENABLED] == nodeName) {
+        isScreenCompressionEnableInLandscape_ = true;
+    } else if (xmlNodeMap_[IS_SUPPORT_CAPTURE] == nodeName) {
+        isSupportCapture_ = true;
+    } else if (xmlNodeMap_[IS_SUPPORT_OFFSCREEN_RENDERING] == nodeName) {
+        isSupportOffScreenRendering_ = true;
+    } else if (xmlNodeMap_[IS_CONCURRENT_USER] == nodeName) {
+        isConcurrentUser_ = true;
+    }
+}
+
 void ScreenSceneConfig::ReadStringConfigInfo(const xmlNodePtr& currNode)
 {
     xmlChar* context = xmlNodeGetContent(currNode);
@@ -620,6 +873,17 @@ void ScreenSceneConfig::SetSubCutoutSvgPath(const std::string& svgPath)
 }
 
 DMRect ScreenSceneConfig::CalcCutoutBoundaryRect(std::string svgPath)
+{
+    auto iter = cutoutSvgBoundaryRects_.find(svgPath);
+    if (iter != cutoutSvgBoundaryRects_.end()) {
+        return iter->second;
+    }
+    DMRect cutoutRect = CalcCutoutBoundaryRectFromSvg(svgPath);
+    cutoutSvgBoundaryRects_[svgPath] = cutoutRect;
+    return cutoutRect;
+}
+
+DMRect ScreenSceneConfig::CalcCutoutBoundaryRectFromSvg(const std::string& svgPath)
 {
     DMRect emptyRect = { 0, 0, 0, 0 };
     SkPath skCutoutSvgPath;
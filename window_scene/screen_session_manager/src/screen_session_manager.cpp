@@ -2069,31 +2069,40 @@ sptr<DisplayInfo> ScreenSessionManager::GetDefaultDisplayInfo()
     }
 }
 
+bool ScreenSessionManager::IsDisplayInfoHookedByUid()
+{
+    auto uid = IPCSkeleton::GetCallingUid();
+    std::shared_lock<std::shared_mutex> lock(hookInfoMutex_);
+    auto iter = displayHookMap_.find(uid);
+    return iter != displayHookMap_.end() && !iter->second.isFullScreenInForceSplit_;
+}
+
+sptr<DisplayInfo> ScreenSessionManager::GetDisplayInfoFromSession(const sptr<ScreenSession>& screenSession)
+{
+    // the cached info is shared, a hooked caller gets its own copy to rewrite
+    if (IsDisplayInfoHookedByUid()) {
+        return HookDisplayInfoByUid(screenSession->ConvertToDisplayInfo(), screenSession);
+    }
+    return screenSession->GetCachedDisplayInfo();
+}
+
 sptr<DisplayInfo> ScreenSessionManager::GetDisplayInfoById(DisplayId displayId)
 {
     TLOGD(WmsLogTag::DMS, "enter, displayId: %{public}" PRIu64" ", displayId);
     std::lock_guard<std::recursive_mutex> lock(screenSessionMapMutex_);
-    for (auto sessionIt : screenSessionMap_) {
+    // a display takes the id of its screen, so the map is the display index
+    auto iter = screenSessionMap_.find(displayId);
+    if (iter != screenSessionMap_.end() && iter->second != nullptr && iter->second->GetScreenId() == displayId) {
+        TLOGD(WmsLogTag::DMS, "success");
+        return GetDisplayInfoFromSession(iter->second);
+    }
+    if (!FoldScreenStateInternel::IsSuperFoldDisplayDevice()) {
+        TLOGE(WmsLogTag::DMS, "failed. displayId: %{public}" PRIu64" ", displayId);
+        return nullptr;
+    }
+    for (const auto& sessionIt : screenSessionMap_) {
         auto screenSession = sessionIt.second;
-        if (screenSession == nullptr) {
-            TLOGI(WmsLogTag::DMS, "screenSession is nullptr, ScreenId: %{public}" PRIu64 "",
-                sessionIt.first);
-            continue;
-        }
-        sptr<DisplayInfo> displayInfo = screenSession->ConvertToDisplayInfo();
-        if (displayInfo == nullptr) {
-            TLOGI(WmsLogTag::DMS, "ConvertToDisplayInfo error, displayInfo is nullptr.");
-            continue;
-        }
-        if (displayId == displayInfo->GetDisplayId()) {
-            TLOGD(WmsLogTag::DMS, "success");
-            displayInfo = HookDisplayInfoByUid(displayInfo, screenSession);
-            return displayInfo;
-        }
-        if (!FoldScreenStateInternel::IsSuperFoldDisplayDevice()) {
-            continue;
-        }
-        if (!screenSession->GetScreenProperty().GetIsFakeInUse()) {
+        if (screenSession == nullptr || !screenSession->GetScreenProperty().GetIsFakeInUse()) {
             continue;
         }
         sptr<ScreenSession> fakeScreenSession = screenSession->GetFakeScreenSession();
@@ -2101,16 +2110,9 @@ sptr<DisplayInfo> ScreenSessionManager::GetDisplayInfoById(DisplayId displayId)
             TLOGE(WmsLogTag::DMS, "error, fakeScreenSession is nullptr.");
             continue;
         }
-        sptr<DisplayInfo> fakeDisplayInfo = fakeScreenSession->ConvertToDisplayInfo();
-        if (fakeDisplayInfo == nullptr) {
-            TLOGE(WmsLogTag::DMS, "error, fakeDisplayInfo is nullptr.");
-            continue;
-        }
-        fakeDisplayInfo = HookDisplayInfoByUid(fakeDisplayInfo, fakeScreenSession);
-        DisplayId fakeDisplayId = fakeDisplayInfo->GetDisplayId();
-        if (displayId == fakeDisplayId) {
+        if (fakeScreenSession->GetScreenId() == displayId) {
             TLOGD(WmsLogTag::DMS, "find fake success");
-            return fakeDisplayInfo;
+            return GetDisplayInfoFromSession(fakeScreenSession);
         }
     }
     TLOGE(WmsLogTag::DMS, "failed. displayId: %{public}" PRIu64" ", displayId);
@@ -337,6 +337,7 @@ void ScreenSessionManagerClient::OnDisplayStateChanged(DisplayId defaultDisplayI
 void ScreenSessionManagerClient::OnUpdateFoldDisplayMode(FoldDisplayMode displayMode)
 {
     displayMode_ = displayMode;
+    ScreenProperty::BumpGlobalGeneration();
 }
 
 void ScreenSessionManagerClient::OnGetSurfaceNodeIdsFromMissionIdsChanged(std::vector<uint64_t>& missionIds,
@@ -655,6 +656,7 @@ void ScreenSessionManagerClient::DisconnectAllExternalScreen()
                 NotifyScreenDisconnect(screenSession);
                 ScreenId screenId = sessionIt->first;
                 screenSessionMap_.erase(screenId);
+                ScreenProperty::BumpGlobalGeneration();
                 setScreenId = screenId;
                 screenSession->Disconnect();
                 break;
@@ -1011,6 +1013,7 @@ bool ScreenSessionManagerClient::HandleScreenConnection(SessionOption option)
         std::lock_guard<std::mutex> lock(screenSessionMapMutex_);
         screenSessionMap_[option.screenId_] = screenSession;
         extraScreenSessionMap_[option.screenId_] = screenSession;
+        ScreenProperty::BumpGlobalGeneration();
     }
     screenSession->SetRotationCorrectionMap(option.rotationCorrectionMap_);
     NotifyClientScreenConnect(screenSession);
@@ -1029,6 +1032,7 @@ bool ScreenSessionManagerClient::HandleScreenDisconnection(SessionOption option)
     {
         std::lock_guard<std::mutex> lock(screenSessionMapMutex_);
         screenSessionMap_.erase(option.screenId_);
+        ScreenProperty::BumpGlobalGeneration();
     }
     TLOGW(WmsLogTag::DMS, "disconnect screenId=%{public}" PRIu64, screenSession->GetScreenId());
     screenSession->Disconnect();
@@ -1073,6 +1077,7 @@ bool ScreenSessionManagerClient::OnCreateScreenSessionOnly(ScreenId screenId, Sc
         std::lock_guard<std::mutex> lock(screenSessionMapMutex_);
         screenSessionMap_[screenId] = screenSession;
         extraScreenSessionMap_[screenId] = screenSession;
+        ScreenProperty::BumpGlobalGeneration();
     }
     return true;
 }
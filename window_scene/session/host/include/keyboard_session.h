@@ -106,6 +106,7 @@ private:
     void SetSurfaceBounds(const WSRect& rect, bool isGlobal, bool needFlush = true) override;
     bool IsNeedRaiseSubWindow(const sptr<SceneSession>& callingSession, const WSRect& callingSessionRect);
     void PostKeyboardAnimationSyncTimeoutTask();
+    void OnKeyboardAnimationSyncTimeout();
     void ProcessKeyboardOccupiedAreaInfo(uint32_t callingId, bool needRecalculateAvoidAreas,
         bool needCheckRSTransaction);
     void NotifyOccupiedAreaChanged(const sptr<SceneSession>& callingSession,
@@ -121,6 +122,9 @@ private:
 
     sptr<KeyboardSessionCallback> keyboardCallback_ = nullptr;
     bool isKeyboardSyncTransactionOpen_ = false;
+    bool isOccupiedAreaPending_ = false;
+    KeyboardPanelInfo lastPanelInfo_;
+    sptr<ISessionStage> lastPanelInfoStage_ = nullptr;
     NotifyKeyboarEffectOptionChangeFunc changeKeyboardEffectOptionFunc_;
 };
 } // namespace OHOS::Rosen
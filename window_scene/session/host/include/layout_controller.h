@@ -16,6 +16,7 @@
 #ifndef OHOS_ROSEN_LAYOUT_CONTROLLER_H
 #define OHOS_ROSEN_LAYOUT_CONTROLLER_H
 
+#include <atomic>
 #include <mutex>
 #include <refbase.h>
 #include <struct_multimodal.h>
@@ -32,7 +33,7 @@ public:
     LayoutController(const sptr<WindowSessionProperty>& property);
     ~LayoutController() = default;
 
-    void SetSessionRect(const WSRect& rect) { winRect_ = rect; }
+    void SetSessionRect(const WSRect& rect);
     bool SetSessionGlobalRect(const WSRect& rect);
     void SetClientRect(const WSRect& rect);
     WSRect GetSessionRect() const { return winRect_; }
@@ -56,6 +57,12 @@ public:
     bool IsTransformNeedUpdate(float scaleX, float scaleY, float pivotX, float pivotY);
     void SetSystemConfigFunc(GetSystemConfigFunc&& func);
 
+    /*
+     * Set from any thread when the rect or zOrder changes, taken by the hit-test index owner
+     */
+    void MarkHitTestDirty() { isHitTestDirty_.store(true); }
+    bool TakeHitTestDirty() { return isHitTestDirty_.exchange(false); }
+
 private:
     float scaleX_ = 1.0f;
     float scaleY_ = 1.0f;
@@ -73,6 +80,7 @@ private:
     float aspectRatio_ = 0.0f;
     sptr<WindowSessionProperty> sessionProperty_;
     GetSystemConfigFunc getSystemConfigFunc_;
+    std::atomic<bool> isHitTestDirty_ { false };
 };
 } // namespace OHOS::Rosen
 #endif // OHOS_ROSEN_LAYOUT_CONTROLLER_H
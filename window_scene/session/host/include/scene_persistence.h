@@ -21,7 +21,8 @@
 #include <refbase.h>
 
 #include "common/include/task_scheduler.h"
-#include "session/host/include/ws_ffrt_helper.h"
+#include "session/host/include/ws_snapshot_pipeline.h"
+#include "session/host/include/ws_snapshot_policy.h"
 #include "session/host/include/ws_snapshot_helper.h"
 
 namespace OHOS::Media {
@@ -42,6 +43,7 @@ public:
     static bool IsAstcEnabled();
     void SetHasSnapshot(bool hasSnapshot, SnapshotStatus key = defaultStatus);
     void SetHasSnapshotFreeMultiWindow(bool hasSnapshot);
+    void SetSnapshotEvictedCallback(std::function<void(SnapshotStatus, bool)>&& func);
     bool HasSnapshot() const;
     bool HasSnapshot(SnapshotStatus key, bool freeMultiWindow = false) const;
     void ClearSnapshot(SnapshotStatus key);
@@ -51,11 +53,11 @@ public:
     std::pair<uint32_t, uint32_t> GetSnapshotSize(SnapshotStatus key = defaultStatus,
         bool freeMultiWindow = false) const;
     void SetSnapshotSize(SnapshotStatus key, bool freeMultiWindow, std::pair<uint32_t, uint32_t> size);
-    std::shared_ptr<WSFFRTHelper> GetSnapshotFfrtHelper() const;
 
     void SaveSnapshot(const std::shared_ptr<Media::PixelMap>& pixelMap,
         const std::function<void()> resetSnapshotCallback = []() {}, SnapshotStatus key = defaultStatus,
-        DisplayOrientation rotate = DisplayOrientation::PORTRAIT, bool freeMultiWindow = false);
+        DisplayOrientation rotate = DisplayOrientation::PORTRAIT, bool freeMultiWindow = false,
+        float density = 1.0f);
     bool IsSavingSnapshot(SnapshotStatus key = defaultStatus, bool freeMultiWindow = false);
     void SetIsSavingSnapshot(SnapshotStatus key, bool freeMultiWindow, bool isSavingSnapshot);
     void ResetSnapshotCache();
@@ -64,21 +66,36 @@ public:
 
     void SaveUpdatedIcon(const std::shared_ptr<Media::PixelMap>& pixelMap);
     std::string GetUpdatedIconPath() const;
+    std::string GetSnapshotThumbnailFilePath(SnapshotStatus key, bool freeMultiWindow = false) const;
     std::shared_ptr<Media::PixelMap> GetLocalSnapshotPixelMap(const float oriScale, const float newScale,
         SnapshotStatus key = defaultStatus, bool freeMultiWindow = false);
     DisplayOrientation rotate_[SCREEN_COUNT][ORIENTATION_COUNT] = {};
 
 private:
+    static bool PackSnapshot(const std::string& path, Media::PixelMap& pixelMap, const SnapshotFormat& format,
+        int64_t& packedSize);
+    void RenameSnapshotFile(const std::string& oldPath, const std::string& newPath);
+    WSSnapshotPolicy::EvictFunc GetEvictFunc();
+    void EvictSnapshotFile(const std::string& path);
+    std::pair<uint32_t, uint32_t> LoadSnapshotSize(SnapshotStatus key, bool freeMultiWindow);
+    void SaveSnapshotThumbnail(const std::shared_ptr<Media::PixelMap>& pixelMap, const std::string& thumbnailPath,
+        float density);
+    std::shared_ptr<Media::PixelMap> GetLocalSnapshotThumbnailPixelMap(const float oriScale, const float newScale,
+        SnapshotStatus key, bool freeMultiWindow);
+
     static std::string snapshotDirectory_;
     std::string bundleName_;
     int32_t persistentId_;
     SnapshotStatus capacity_;
     std::string snapshotPath_[SCREEN_COUNT][ORIENTATION_COUNT];
     std::string snapshotFreeMultiWindowPath_;
+    std::string snapshotThumbnailPath_[SCREEN_COUNT][ORIENTATION_COUNT];
+    std::string snapshotFreeMultiWindowThumbnailPath_;
     std::pair<uint32_t, uint32_t> snapshotSize_[SCREEN_COUNT][ORIENTATION_COUNT];
     std::pair<uint32_t, uint32_t> snapshotFreeMultiWindowSize_;
     bool hasSnapshot_[SCREEN_COUNT][ORIENTATION_COUNT] = {};
     bool hasSnapshotFreeMultiWindow_ = false;
+    std::function<void(SnapshotStatus, bool)> snapshotEvictedFunc_; // guarded by savingSnapshotMutex_
 
     static std::string updatedIconDirectory_;
     std::string updatedIconPath_;
@@ -88,7 +105,6 @@ private:
     std::atomic<bool> isSavingSnapshot_[SCREEN_COUNT][ORIENTATION_COUNT] = {};
     std::atomic<bool> isSavingSnapshotFreeMultiWindow_ { false };
 
-    static std::shared_ptr<WSFFRTHelper> snapshotFfrtHelper_;
     mutable std::mutex savingSnapshotMutex_;
     mutable std::mutex hasSnapshotMutex_;
     mutable std::mutex snapshotSizeMutex_;
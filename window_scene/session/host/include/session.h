@@ -19,6 +19,7 @@
 #include <list>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_set>
 #include <vector>
 
 #include <event_handler.h>
@@ -31,6 +32,7 @@
 #include "session/container/include/zidl/session_stage_interface.h"
 #include "session/host/include/zidl/session_stub.h"
 #include "session/host/include/scene_persistence.h"
+#include "session/host/include/ws_snapshot_pipeline.h"
 #include "thread_safety_annotations.h"
 #include "vsync_station.h"
 #include "window_visibility_info.h"
@@ -273,6 +275,14 @@ public:
     std::shared_ptr<Media::PixelMap> GetSnapshot() const;
     std::shared_ptr<Media::PixelMap> Snapshot(
         bool runInFfrt = false, float scaleParam = 0.0f, bool useCurWindow = false) const;
+
+    /*
+     * Capture through WSSnapshotPipeline without blocking the caller, a capture of this session with the same
+     * config, status and rotation that has not started yet is shared. Returns the handle for
+     * WSSnapshotPipeline::CancelCapture, 0 when no capture is requested.
+     */
+    uint64_t SnapshotAsync(SnapshotCaptureCallback&& callback, float scaleParam = 0.0f, bool useCurWindow = false,
+        BackgroundReason reason = BackgroundReason::DEFAULT);
     void ResetSnapshot();
     void SaveSnapshot(bool useFfrt, bool needPersist = true,
         std::shared_ptr<Media::PixelMap> persistentPixelMap = nullptr, bool updateSnapshot = false,
@@ -324,6 +334,7 @@ public:
     SessionInfo& EditSessionInfo();
     DisplayId GetScreenId() const;
     virtual void SetScreenId(uint64_t screenId);
+    static uint64_t GetScreenIdGeneration();
     WindowType GetWindowType() const;
     float GetAspectRatio() const;
     WSError SetAspectRatio(float ratio) override;
@@ -745,9 +756,11 @@ public:
     bool HasSnapshotFreeMultiWindow();
     bool HasSnapshot(SnapshotStatus key);
     bool HasSnapshot();
+    float GetSnapshotDensity() const;
     void DeleteHasSnapshot();
     void DeleteHasSnapshot(SnapshotStatus key);
     void DeleteHasSnapshotFreeMultiWindow();
+    void RegisterSnapshotEvictedCallback();
     void SetFreeMultiWindow();
     std::atomic<bool> freeMultiWindow_ { false };
 
@@ -983,6 +996,7 @@ protected:
     bool isStarting_ = false;   // when start app, session is starting state until foreground
     std::atomic_bool mainUIStateDirty_ = false;
     static bool isScbCoreEnabled_;
+    static std::atomic<uint64_t> screenIdGeneration_; // bumped whenever any session changes its screen
 
     /*
      *CompatibleMode Window scale
@@ -1144,6 +1158,13 @@ private:
     bool borderUnoccupied_ = false;
     void DeletePersistentImageFit();
     uint32_t GetBackgroundColor() const;
+    float GetSnapshotCaptureScale(float scaleParam) const;
+    int32_t GetSnapshotRotation(const SnapshotStatus& key) const;
+    std::shared_ptr<Media::PixelMap> OnSnapshotCaptured(std::shared_ptr<Media::PixelMap> pixelMap,
+        bool isPersistentImageFit) const;
+    void CancelSnapshotCaptures();
+    std::mutex snapshotCaptureMutex_;
+    std::unordered_set<uint64_t> snapshotCaptureHandles_; // captures not completed yet
 
     /*
      * Specific Window
@@ -16,11 +16,18 @@
 #ifndef OHOS_ROSEN_SESSION_CHANGE_RECORDER_H
 #define OHOS_ROSEN_SESSION_CHANGE_RECORDER_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "window_manager_hilog.h"
 #include "wm_single_instance.h"
@@ -41,7 +48,7 @@ enum class RecordType : uint32_t {
 };
 
 /**
- * @brief Scene session change info
+ * @brief Scene session change info, time_ is filled in when the record is dumped or logged
  */
 struct SceneSessionChangeInfo {
     int32_t persistentId_ = INVALID_SESSION_ID;
@@ -50,6 +57,62 @@ struct SceneSessionChangeInfo {
     std::string time_ = "";
 };
 
+/**
+ * @brief Binary session change record, its text is only formatted when dumped or logged
+ */
+struct SessionChangeRecord {
+    int64_t timeNs = 0; // steady clock
+    RecordType recordType = RecordType::RECORD_TYPE_BEGIN;
+    WmsLogTag logTag = WmsLogTag::DEFAULT;
+    int32_t persistentId = INVALID_SESSION_ID;
+    bool isPacked = false;
+    uint32_t args[2] = { 0, 0 };
+    uint64_t textOffset = 0;
+    uint32_t textLen = 0;
+    bool isTextTruncated = false;
+};
+using SessionChangeEntry = std::pair<SessionChangeRecord, std::string>;
+
+/**
+ * @brief Single writer ring of session change records and their text.
+ * Push never blocks the owning thread, Collect may run on any thread and skips records overwritten meanwhile.
+ * The text arena is allocated by the first record that carries text, so rings of packed records stay small.
+ */
+class SessionChangeRing {
+public:
+    SessionChangeRing(uint32_t slotNum, uint32_t textSize);
+
+    /**
+     * @brief Push a record.
+     *
+     * @return The number of records the log thread has not collected yet, more than the slot num means
+     *         the oldest of them was overwritten by this push.
+     */
+    uint64_t Push(SessionChangeRecord& record, const std::string& text);
+    uint64_t Collect(uint64_t fromSeq, std::vector<SessionChangeEntry>& entries) const;
+    uint32_t GetSlotNum() const { return slotNum_; }
+    bool HasText() const { return text_ != nullptr; }
+
+    std::atomic<bool> inUse_ { false };
+    std::atomic<uint64_t> logCursor_ { 0 }; // only written by the log thread
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq { 0 };
+        SessionChangeRecord record;
+    };
+
+    void CopyText(uint64_t offset, const char* src, uint32_t len);
+    void ReadText(uint64_t offset, char* dst, uint32_t len) const;
+
+    uint32_t slotNum_;
+    uint32_t textSize_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<char[]> text_;
+    std::atomic<uint64_t> head_ { 0 };
+    std::atomic<uint64_t> textHead_ { 0 };
+};
+
 class SessionChangeRecorder {
 WM_DECLARE_SINGLE_INSTANCE_BASE(SessionChangeRecorder)
 public:
@@ -61,6 +124,18 @@ public:
      */
     WSError RecordSceneSessionChange(RecordType recordType, SceneSessionChangeInfo& changeInfo);
 
+    /**
+     * @brief Record scene session change as packed arguments, formatted by record type at dump time.
+     *
+     * @param recordType The type of record info.
+     * @param persistentId The id of the changed session.
+     * @param logTag The log tag used when the record is logged.
+     * @param arg0 The first changed value.
+     * @param arg1 The second changed value, if any.
+     */
+    WSError RecordSceneSessionChange(RecordType recordType, int32_t persistentId, WmsLogTag logTag,
+        uint32_t arg0, uint32_t arg1 = 0);
+
     /**
      * @brief Set record size
      *
@@ -72,26 +147,51 @@ public:
 
     void Init();
     void GetSceneSessionNeedDumpInfo(const std::vector<std::string>& dumpParams, std::string& dumpInfo);
+    uint64_t GetDroppedNum() const { return droppedNum_.load(std::memory_order_relaxed); }
     std::atomic<bool> stopLogFlag_ { false };
     std::atomic<bool> isInitFlag_ { false };
 
 private:
-    SessionChangeRecorder() = default;
+    static constexpr uint32_t RECORD_TYPE_NUM = static_cast<uint32_t>(RecordType::RECORD_TYPE_END) + 1;
+
+    SessionChangeRecorder();
     virtual ~SessionChangeRecorder();
-    void RecordLog(RecordType recordType, SceneSessionChangeInfo& changeInfo);
-    void PrintLog(std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> sceneSessionChangeNeedDumpMap);
-    void RecordDump(RecordType recordType, SceneSessionChangeInfo& changeInfo);
+    void Record(SessionChangeRecord& record, const std::string& text);
+    std::shared_ptr<SessionChangeRing> AcquireRing(RecordType recordType);
+    void OnRecordPushed(uint64_t pendingNum, uint32_t slotNum);
+    void CollectRecords(bool isForLog, std::vector<SessionChangeEntry>& entries);
+    void PrintLog(const std::vector<SessionChangeEntry>& entries);
+    std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> GetDumpMap();
     std::string FormatDumpInfoToJsonString (uint32_t specifiedRecordType, int32_t specifiedWindowId,
     std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>>& dumpMap);
     void SimplifyDumpInfo(std::string& dumpInfo, std::string preCompressInfo);
     int CompressString(const char* in_str, size_t in_len, std::string& out_str, int level);
 
-    std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> sceneSessionChangeNeedLogMap_;
-    std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> sceneSessionChangeNeedDumpMap_;
     std::unordered_map<RecordType, uint32_t> recordSizeMap_;
     std::mutex sessionChangeRecorderMutex_;
-    uint32_t currentLogSize_ = 0;
     std::thread mThread;
+
+    /*
+     * The log thread drains every SCHEDULE_SECONDS, or as soon as a ring is full of records it has not collected.
+     */
+    std::mutex drainMutex_;
+    std::condition_variable drainCv_;
+    std::atomic<bool> isDrainRequested_ { false };
+
+    /*
+     * Each thread writes its own ring per record type, so a flood of one type does not evict the others.
+     * Threads beyond maxRingNum_ share sharedRings_: they only try sharedRingMutex_ and drop the record if
+     * another thread holds it, so recording never waits. Dropped and overwritten records are counted.
+     */
+    std::atomic<uint64_t> droppedNum_ { 0 };
+    uint32_t slotNum_;
+    uint32_t textSize_;
+    uint32_t maxRingNum_;
+    std::mutex ringMutex_;
+    uint32_t ringNum_ = 0;
+    std::array<std::vector<std::shared_ptr<SessionChangeRing>>, RECORD_TYPE_NUM> rings_;
+    std::mutex sharedRingMutex_;
+    std::array<std::shared_ptr<SessionChangeRing>, RECORD_TYPE_NUM> sharedRings_;
 };
 } // namespace OHOS::Rosen
 #endif // OHOS_ROSEN_SESSION_CHANGE_RECORDER_H
\ No newline at end of file
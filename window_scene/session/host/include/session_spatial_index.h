@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SCENE_SESSION_SPATIAL_INDEX_H
+#define OHOS_ROSEN_WINDOW_SCENE_SESSION_SPATIAL_INDEX_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "dm_common.h"
+#include "interfaces/include/ws_common.h"
+
+namespace OHOS::Rosen {
+/*
+ * Uniform grid over session rects, one per display. A point query looks at the sessions sharing
+ * the cell of the point instead of every session. Not thread safe, owned by one thread.
+ */
+class SessionSpatialIndex {
+public:
+    static constexpr int32_t DEFAULT_CELL_SIZE = 256;
+
+    explicit SessionSpatialIndex(int32_t cellSize = DEFAULT_CELL_SIZE);
+    ~SessionSpatialIndex() = default;
+
+    void Update(int32_t persistentId, DisplayId displayId, const WSRect& rect, uint32_t zOrder);
+    void Remove(int32_t persistentId);
+    void Clear();
+    size_t GetSize() const { return entries_.size(); }
+
+    /*
+     * Sessions of the display whose rect contains the point, right and bottom edges excluded,
+     * from top to bottom: descending zOrder, then descending persistentId.
+     */
+    void Query(DisplayId displayId, int32_t pointX, int32_t pointY, std::vector<int32_t>& persistentIds) const;
+
+    /*
+     * All sessions of the display, from top to bottom.
+     */
+    void QueryDisplay(DisplayId displayId, std::vector<int32_t>& persistentIds) const;
+
+private:
+    struct Entry {
+        DisplayId displayId = 0;
+        WSRect rect;
+        uint32_t zOrder = 0;
+        int32_t minCellX = 0;
+        int32_t minCellY = 0;
+        int32_t maxCellX = -1;
+        int32_t maxCellY = -1;
+        bool oversized = false;
+    };
+    struct DisplayGrid {
+        std::unordered_map<uint64_t, std::vector<int32_t>> cells;
+        // sessions spanning too many cells, checked by every query of the display
+        std::vector<int32_t> oversized;
+        std::unordered_set<int32_t> sessions;
+    };
+
+    void Insert(int32_t persistentId, Entry& entry);
+    void Erase(int32_t persistentId, const Entry& entry);
+    int32_t GetCell(int64_t value) const;
+    void SortFromTopToBottom(std::vector<int32_t>& persistentIds) const;
+
+    int32_t cellSize_;
+    std::unordered_map<int32_t, Entry> entries_;
+    std::unordered_map<DisplayId, DisplayGrid> displayGrids_;
+};
+} // namespace OHOS::Rosen
+#endif // OHOS_ROSEN_WINDOW_SCENE_SESSION_SPATIAL_INDEX_H
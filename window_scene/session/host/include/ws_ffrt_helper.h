@@ -17,6 +17,7 @@
 #define OHOS_ROSEN_WINDOW_SCENE_FFRT_HELPER_H
 
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace ffrt {
@@ -42,16 +43,28 @@ enum class TaskQos {
 class WSFFRTHelper {
 public:
     WSFFRTHelper();
+    /*
+     * allowInline: a task submitted without delay from an ffrt task runs in place instead of being queued.
+     */
+    WSFFRTHelper(const std::string& queueName, TaskQos qos, int32_t maxConcurrency, bool allowInline = true);
     ~WSFFRTHelper();
+    /*
+     * delayTime: in milliseconds.
+     */
     void SubmitTask(std::function<void()>&& task, const std::string& taskName, uint64_t delayTime = 0,
         TaskQos qos = TaskQos::USER_INTERACTIVE);
     void CancelTask(const std::string& taskName);
+    /*
+     * Drops the handle of a task that has started running, the task itself is left alone.
+     */
+    void ReleaseTask(const std::string& taskName);
     bool IsTaskExisted(const std::string& taskName) const;
     std::size_t CountTask() const;
 
 private:
     std::unique_ptr<TaskHandleMap> taskHandleMap_;
     std::unique_ptr<ffrt::queue> ffrtQueue_;
+    bool allowInline_ = true;
 };
 } // namespace OHOS::Rosen
 
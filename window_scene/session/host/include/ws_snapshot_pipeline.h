@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SCENE_WS_SNAPSHOT_PIPELINE_H
+#define OHOS_ROSEN_WINDOW_SCENE_WS_SNAPSHOT_PIPELINE_H
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "session/host/include/ws_ffrt_helper.h"
+
+namespace OHOS::Media {
+class PixelMap;
+} // namespace OHOS::Media
+
+namespace OHOS::Rosen {
+/**
+ * @brief Queue a snapshot task runs on.
+ * INTERACTIVE: captures the user is about to see (recent, add snapshot window).
+ * BACKGROUND: persistence of snapshots to disk.
+ */
+enum class SnapshotLane : uint32_t {
+    INTERACTIVE = 0,
+    BACKGROUND,
+    COUNT,
+};
+
+enum class SnapshotStage : uint32_t {
+    CAPTURE = 0,
+    DOWNSCALE,
+    ENCODE,
+    COUNT,
+};
+
+struct SnapshotStageStat {
+    uint64_t count = 0;
+    int64_t totalCostUs = 0;
+    int64_t maxCostUs = 0;
+    int64_t lastCostUs = 0;
+};
+
+struct SnapshotLaneStat {
+    uint64_t submitted = 0;
+    uint64_t coalesced = 0;
+    uint64_t rejected = 0;
+    uint32_t depth = 0;
+    uint32_t maxDepth = 0;
+    uint32_t depthLimit = 0;
+};
+
+struct SnapshotCaptureStat {
+    uint64_t requested = 0;
+    uint64_t deduplicated = 0;
+    uint64_t cancelled = 0;
+    uint64_t timeout = 0;
+    uint32_t running = 0;
+    uint32_t waiting = 0;
+};
+
+/*
+ * What a capture produces, requests share a capture in flight only when all fields match.
+ */
+struct SnapshotCaptureKey {
+    int32_t persistentId = 0;
+    float scale = 0.0f;
+    bool useCurWindow = false;
+    uint32_t screenStatus = 0;
+    uint32_t orientation = 0;
+    int32_t rotation = 0;
+
+    bool operator<(const SnapshotCaptureKey& other) const
+    {
+        return std::tie(persistentId, scale, useCurWindow, screenStatus, orientation, rotation) <
+            std::tie(other.persistentId, other.scale, other.useCurWindow, other.screenStatus, other.orientation,
+                other.rotation);
+    }
+};
+
+/*
+ * Receives the captured pixelMap, nullptr when the capture failed or timed out.
+ */
+using SnapshotCaptureCallback = std::function<void(const std::shared_ptr<Media::PixelMap>& pixelMap)>;
+
+/*
+ * Capture backend of one request. Starts the capture and returns at once, onCaptured may be called from any
+ * thread and only its first call counts. Returns false when the capture could not be started.
+ */
+using SnapshotCaptureStarter = std::function<bool(SnapshotCaptureCallback&& onCaptured)>;
+
+class WSSnapshotPipeline {
+public:
+    static WSSnapshotPipeline& GetInstance();
+
+    /*
+     * Submit a task to the lane. A pending task with the same name is replaced by the new one.
+     * Returns false when the lane already holds depthLimit pending tasks, the caller keeps ownership of
+     * whatever cleanup the task would have done.
+     */
+    bool SubmitTask(SnapshotLane lane, std::function<void()>&& task, const std::string& taskName);
+    void CancelTask(SnapshotLane lane, const std::string& taskName);
+    void SetQueueDepthLimit(SnapshotLane lane, uint32_t depthLimit);
+    uint32_t GetQueueDepth(SnapshotLane lane) const;
+
+    /*
+     * Capture asynchronously, the starter and callback are called on the interactive lane. A capture of the same
+     * key whose starter has not run yet is shared and the starter of the later request is dropped, a request after
+     * the start gets a capture of its own. At most captureConcurrency captures run at once, the others wait in
+     * order. Returns a handle for CancelCapture, 0 when the request is invalid.
+     */
+    uint64_t CaptureAsync(const SnapshotCaptureKey& key, SnapshotCaptureStarter&& starter,
+        SnapshotCaptureCallback&& callback, uint32_t timeoutMs);
+
+    /*
+     * Returns false when the capture of the handle has already completed. A capture nobody waits for any more
+     * is dropped if it has not started yet.
+     */
+    bool CancelCapture(uint64_t handle);
+    void SetCaptureConcurrency(uint32_t captureConcurrency);
+    SnapshotCaptureStat GetCaptureStat() const;
+
+    /*
+     * Downscale stage, returns a scaled copy when the long side of pixelMap exceeds maxLongSide,
+     * otherwise the input itself. The input is never modified since it may be shown on screen.
+     */
+    std::shared_ptr<Media::PixelMap> Downscale(const std::shared_ptr<Media::PixelMap>& pixelMap,
+        uint32_t maxLongSide);
+    void RecordStageCost(SnapshotStage stage, int64_t costUs);
+    SnapshotStageStat GetStageStat(SnapshotStage stage) const;
+    SnapshotLaneStat GetLaneStat(SnapshotLane lane) const;
+    void ResetStat();
+    void DumpInfo(std::string& dumpInfo) const;
+
+private:
+    WSSnapshotPipeline();
+    ~WSSnapshotPipeline() = default;
+    WSSnapshotPipeline(const WSSnapshotPipeline&) = delete;
+    WSSnapshotPipeline& operator=(const WSSnapshotPipeline&) = delete;
+
+    struct Lane {
+        std::unique_ptr<WSFFRTHelper> ffrtHelper;
+        std::unordered_map<std::string, uint64_t> pendingTasks; // taskName -> sequence of the latest submit
+        uint64_t sequence = 0;
+        SnapshotLaneStat stat;
+    };
+    void OnTaskStart(SnapshotLane lane, const std::string& taskName, uint64_t sequence);
+
+    struct Capture {
+        SnapshotCaptureKey key;
+        SnapshotCaptureStarter starter;
+        std::vector<std::pair<uint64_t, SnapshotCaptureCallback>> callbacks; // handle -> callback
+        uint32_t timeoutMs = 0;
+        bool isRunning = false;
+        int64_t startTimeUs = 0;
+    };
+    void RunWaitingCapturesLocked(std::vector<uint64_t>& runCaptures);
+    void LaunchCaptures(const std::vector<uint64_t>& runCaptures);
+    void StartCapture(uint64_t captureId);
+    void CompleteCapture(uint64_t captureId, const std::shared_ptr<Media::PixelMap>& pixelMap, bool isTimeout);
+    void NotifyCaptured(uint64_t handle, const SnapshotCaptureCallback& callback,
+        const std::shared_ptr<Media::PixelMap>& pixelMap);
+
+    mutable std::mutex laneMutex_;
+    std::array<Lane, static_cast<size_t>(SnapshotLane::COUNT)> lanes_;
+    mutable std::mutex stageStatMutex_;
+    std::array<SnapshotStageStat, static_cast<size_t>(SnapshotStage::COUNT)> stageStats_;
+
+    mutable std::mutex captureMutex_;
+    std::unordered_map<uint64_t, Capture> captures_; // captureId -> capture
+    std::map<SnapshotCaptureKey, uint64_t> keyCaptures_; // key -> latest captureId in flight
+    std::unordered_map<uint64_t, uint64_t> handleCaptures_; // handle -> captureId
+    std::deque<uint64_t> waitingCaptures_;
+    uint64_t captureSequence_ = 0;
+    uint32_t captureConcurrency_ = 0;
+    SnapshotCaptureStat captureStat_;
+    std::unique_ptr<WSFFRTHelper> captureTimer_;
+};
+
+/*
+ * Records the cost of a snapshot stage from construction to destruction.
+ */
+class SnapshotStageTimer {
+public:
+    explicit SnapshotStageTimer(SnapshotStage stage);
+    ~SnapshotStageTimer();
+
+private:
+    SnapshotStage stage_;
+    int64_t startTimeUs_;
+};
+} // namespace OHOS::Rosen
+
+#endif // OHOS_ROSEN_WINDOW_SCENE_WS_SNAPSHOT_PIPELINE_H
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SCENE_WS_SNAPSHOT_POLICY_H
+#define OHOS_ROSEN_WINDOW_SCENE_WS_SNAPSHOT_POLICY_H
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS::Rosen {
+/**
+ * @brief Size class a snapshot file is stored in.
+ * THUMBNAIL: small copy used by recents.
+ * FULL: capture resolution used by the launch animation.
+ */
+enum class SnapshotTier : uint32_t {
+    THUMBNAIL = 0,
+    FULL,
+    COUNT,
+};
+
+struct SnapshotFormat {
+    const char* mimeType = nullptr;
+    const char* suffix = nullptr;
+    uint8_t quality = 0;
+};
+
+/**
+ * @brief Decides the size class and encoding of snapshot files and keeps the snapshot directory
+ * within a disk budget by removing the least recently used files.
+ */
+class WSSnapshotPolicy {
+public:
+    static constexpr const char* THUMBNAIL_TAG = "_thumb";
+    // removes an evicted file under the lock of its owner and clears the owner's snapshot flags
+    using EvictFunc = std::function<void(const std::string& path)>;
+
+    static WSSnapshotPolicy& GetInstance();
+
+    /*
+     * Size class
+     */
+    void SetThumbnailLongSideVp(uint32_t phoneLongSideVp, uint32_t pcLongSideVp);
+    uint32_t GetThumbnailLongSide(bool isPcWindow, float density) const;
+    static SnapshotFormat GetFormat(SnapshotTier tier, bool isAstcEnabled, bool isPcWindow);
+    static bool IsThumbnailEnough(uint32_t thumbnailLongSide, uint32_t fullLongSide, float oriScale, float newScale);
+
+    /*
+     * Disk budget
+     */
+    void SetDiskBudget(uint64_t budgetBytes);
+    uint64_t GetDiskBudget() const;
+    uint64_t GetDiskUsage() const;
+    void LoadDiskUsage(const std::string& directory);
+    void OnFileWritten(const std::string& path, SnapshotTier tier, const EvictFunc& evictFunc = nullptr);
+    void OnFileAccessed(const std::string& path);
+    void OnFileRemoved(const std::string& path);
+    void OnFileRenamed(const std::string& oldPath, const std::string& newPath, const EvictFunc& evictFunc = nullptr);
+    void SetFileOwner(const std::string& path, const EvictFunc& evictFunc);
+    bool IsFileTracked(const std::string& path) const;
+
+    /*
+     * Evicts least recently used files until the usage fits the budget, full tier files go first.
+     * Owned files are handed to their owner outside the policy lock, files left by a previous run
+     * without an owner are removed directly. Returns the evicted paths.
+     */
+    std::vector<std::string> EnforceDiskBudget();
+
+private:
+    WSSnapshotPolicy();
+    ~WSSnapshotPolicy() = default;
+    WSSnapshotPolicy(const WSSnapshotPolicy&) = delete;
+    WSSnapshotPolicy& operator=(const WSSnapshotPolicy&) = delete;
+
+    struct FileEntry {
+        std::string path;
+        SnapshotTier tier = SnapshotTier::FULL;
+        uint64_t size = 0;
+        EvictFunc evictFunc;
+    };
+    void TouchLocked(const std::string& path, SnapshotTier tier, uint64_t size, const EvictFunc& evictFunc);
+    void RemoveLocked(const std::string& path);
+
+    uint32_t phoneThumbnailLongSideVp_;
+    uint32_t pcThumbnailLongSideVp_;
+    mutable std::mutex diskMutex_;
+    uint64_t diskBudget_;
+    uint64_t diskUsage_ = 0;
+    std::list<FileEntry> lruList_; // front is the most recently used
+    std::unordered_map<std::string, std::list<FileEntry>::iterator> lruMap_;
+};
+} // namespace OHOS::Rosen
+
+#endif // OHOS_ROSEN_WINDOW_SCENE_WS_SNAPSHOT_POLICY_H
@@ -43,6 +43,7 @@ KeyboardSession::KeyboardSession(const SessionInfo& info, const sptr<SpecificSes
 {
     keyboardCallback_ = keyboardCallback;
     scenePersistence_ = sptr<ScenePersistence>::MakeSptr(info.bundleName_, GetPersistentId());
+    RegisterSnapshotEvictedCallback();
     if (info.persistentId_ != 0 && info.persistentId_ != GetPersistentId()) {
         // persistentId changed due to id conflicts. Need to rename the old snapshot if exists
         scenePersistence_->RenameSnapshotFromOldPersistentId(info.persistentId_);
@@ -396,6 +397,7 @@ bool KeyboardSession::CalculateOccupiedArea(const sptr<SceneSession>& callingSes
 void KeyboardSession::ProcessKeyboardOccupiedAreaInfo(uint32_t callingId, bool needRecalculateAvoidAreas,
     bool needCheckRSTransaction)
 {
+    isOccupiedAreaPending_ = false;
     sptr<SceneSession> callingSession = GetSceneSession(callingId);
     if (callingSession == nullptr) {
         TLOGI(WmsLogTag::WMS_KEYBOARD, "Calling session is null");
@@ -427,6 +429,15 @@ void KeyboardSession::NotifyKeyboardPanelInfoChange(WSRect rect, bool isKeyboard
     keyboardPanelInfo.rect_ = SessionHelper::TransferToRect(rect);
     keyboardPanelInfo.gravity_ = static_cast<WindowGravity>(GetKeyboardGravity());
     keyboardPanelInfo.isShowing_ = isKeyboardPanelShow;
+    // every occupied area recalculation reaches here, only tell the keyboard what it does not know yet
+    if (lastPanelInfoStage_ == sessionStage_ && lastPanelInfo_.rect_ == keyboardPanelInfo.rect_ &&
+        lastPanelInfo_.gravity_ == keyboardPanelInfo.gravity_ &&
+        lastPanelInfo_.isShowing_ == keyboardPanelInfo.isShowing_) {
+        TLOGD(WmsLogTag::WMS_KEYBOARD, "Same panel info: %{public}s", keyboardPanelInfo.rect_.ToString().c_str());
+        return;
+    }
+    lastPanelInfoStage_ = sessionStage_;
+    lastPanelInfo_ = keyboardPanelInfo;
 
     sessionStage_->NotifyKeyboardPanelInfoChange(keyboardPanelInfo);
 }
@@ -533,7 +544,9 @@ bool KeyboardSession::RaiseCallingSession(const sptr<SceneSession>& callingSessi
             }
         }
         occupiedAreaChanged = CalculateOccupiedArea(callingSession, newRect, panelAvoidRect, occupiedAreaInfo);
-        if (!IsSystemKeyboard()) {
+        // a panel moving within the same avoid height keeps the raised rect, skip the relayout then
+        if (!IsSystemKeyboard() && !(callingSession->GetSessionRect() == newRect &&
+            callingSession->GetSessionRequestRect() == newRect)) {
             callingSession->UpdateSessionRect(newRect, SizeChangeReason::UNDEFINED);
         }
     } else {
@@ -576,6 +589,7 @@ void KeyboardSession::RestoreCallingSession(uint32_t callingId, const std::share
         TLOGI(WmsLogTag::WMS_KEYBOARD, "Calling session is null");
         return;
     }
+    isOccupiedAreaPending_ = false;
     const WSRect& emptyRect = { 0, 0, 0, 0 };
     int32_t oriPosYBeforeRaisedByKeyboard = callingSession->GetOriPosYBeforeRaisedByKeyboard();
     sptr<OccupiedAreaChangeInfo> occupiedAreaInfo = nullptr;
@@ -774,6 +788,10 @@ void KeyboardSession::CloseRSTransaction()
         handler->RemoveTask(KEYBOARD_ANIM_SYNC_EVENT_NAME);
     }
     RSSyncTransactionAdapter::CloseSyncTransaction(GetRSUIContext(), handler);
+    if (isOccupiedAreaPending_) {
+        TLOGI(WmsLogTag::WMS_KEYBOARD, "Process pending occupied area");
+        ProcessKeyboardOccupiedAreaInfo(GetCallingSessionId(), false, false);
+    }
 }
 
 std::shared_ptr<RSTransaction> KeyboardSession::GetRSTransaction()
@@ -1036,15 +1054,7 @@ void KeyboardSession::PostKeyboardAnimationSyncTimeoutTask()
             TLOGNE(WmsLogTag::WMS_KEYBOARD, "keyboard session is null");
             return;
         }
-        if (!session->GetIsKeyboardSyncTransactionOpen()) {
-            TLOGND(WmsLogTag::WMS_KEYBOARD, "closed anim_sync in time");
-            return;
-        }
-        std::string msg("close anim_sync timeout");
-        WindowInfoReporter::GetInstance().ReportKeyboardLifeCycleException(
-            session->GetPersistentId(),
-            KeyboardLifeCycleException::ANIM_SYNC_EXCEPTION,
-            msg);
+        session->OnKeyboardAnimationSyncTimeout();
     };
     auto handler = GetEventHandler();
     if (!handler) {
@@ -1054,6 +1064,21 @@ void KeyboardSession::PostKeyboardAnimationSyncTimeoutTask()
     handler->PostTask(task, KEYBOARD_ANIM_SYNC_EVENT_NAME, THRESHOLD);
 }
 
+void KeyboardSession::OnKeyboardAnimationSyncTimeout()
+{
+    if (!GetIsKeyboardSyncTransactionOpen()) {
+        TLOGD(WmsLogTag::WMS_KEYBOARD, "closed anim_sync in time");
+        return;
+    }
+    std::string msg("close anim_sync timeout");
+    WindowInfoReporter::GetInstance().ReportKeyboardLifeCycleException(
+        GetPersistentId(),
+        KeyboardLifeCycleException::ANIM_SYNC_EXCEPTION,
+        msg);
+    // a transaction nobody closes would defer every later occupied area update, close it and flush the pending one
+    CloseRSTransaction();
+}
+
 void KeyboardSession::SetSkipEventOnCastPlus(bool isSkip)
 {
     PostTask([weakThis = wptr(this), isSkip, where = __func__]() {
@@ -1124,9 +1149,17 @@ void KeyboardSession::CalculateOccupiedAreaAfterUIRefresh()
             needRecalculateOccupiedArea = true;
         }
     }
-    if (needRecalculateOccupiedArea) {
-        ProcessKeyboardOccupiedAreaInfo(callingId, false, stateChanged_);
-        stateChanged_ = false;
+    if (!needRecalculateOccupiedArea) {
+        return;
+    }
+    // panel updates inside a keyboard sync transaction collapse into the one sent when it closes
+    if (isKeyboardSyncTransactionOpen_ && !stateChanged_) {
+        TLOGD(WmsLogTag::WMS_KEYBOARD, "Defer occupied area until sync transaction closes, id: %{public}d",
+            callingId);
+        isOccupiedAreaPending_ = true;
+        return;
     }
+    ProcessKeyboardOccupiedAreaInfo(callingId, false, stateChanged_);
+    stateChanged_ = false;
 }
 } // namespace OHOS::Rosen
\ No newline at end of file
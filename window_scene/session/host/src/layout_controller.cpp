@@ -19,6 +19,7 @@
 #include <transaction/rs_transaction.h>
 #include <ui/rs_surface_node.h>
 
+#include "common/include/rect_math.h"
 #include "display_manager.h"
 #include "screen_session_manager_client/include/screen_session_manager_client.h"
 #include "session/host/include/scene_persistent_storage.h"
@@ -39,6 +40,14 @@ LayoutController::LayoutController(const sptr<WindowSessionProperty>& property)
     sessionProperty_ = property;
 }
 
+void LayoutController::SetSessionRect(const WSRect& rect)
+{
+    if (winRect_ != rect) {
+        MarkHitTestDirty();
+    }
+    winRect_ = rect;
+}
+
 // LCOV_EXCL_START
 bool LayoutController::SetSessionGlobalRect(const WSRect& rect)
 {
@@ -102,11 +111,9 @@ WSRect LayoutController::ConvertRelativeRectToGlobal(const WSRect& relativeRect,
     const ScreenProperty& screenProperty = screenSession->GetScreenProperty();
     int32_t currentDisplayOffsetX = static_cast<int32_t>(screenProperty.GetStartX());
     int32_t currentDisplayOffsetY = static_cast<int32_t>(screenProperty.GetStartY());
-    TLOGI(WmsLogTag::WMS_LAYOUT, "id:%{public}d, relativeRect:%{public}s, offsetX:%{public}d, offsetY:%{public}d",
+    TLOGD(WmsLogTag::WMS_LAYOUT, "id:%{public}d, relativeRect:%{public}s, offsetX:%{public}d, offsetY:%{public}d",
         GetSessionPersistentId(), relativeRect.ToString().c_str(), currentDisplayOffsetX, currentDisplayOffsetY);
-    return {relativeRect.posX_ + currentDisplayOffsetX,
-            relativeRect.posY_ + currentDisplayOffsetY,
-            relativeRect.width_, relativeRect.height_};
+    return RectMath::Offset(relativeRect, currentDisplayOffsetX, currentDisplayOffsetY);
 }
 
 WSRect LayoutController::ConvertGlobalRectToRelative(const WSRect& globalRect, DisplayId targetDisplayId) const
@@ -126,11 +133,9 @@ WSRect LayoutController::ConvertGlobalRectToRelative(const WSRect& globalRect, D
     const ScreenProperty& screenProperty = screenSession->GetScreenProperty();
     int32_t targetDisplayOffsetX = static_cast<int32_t>(screenProperty.GetStartX());
     int32_t targetDisplayOffsetY = static_cast<int32_t>(screenProperty.GetStartY());
-    TLOGI(WmsLogTag::WMS_LAYOUT, "id:%{public}d, globalRect:%{public}s, offsetX:%{public}d, offsetY:%{public}d",
+    TLOGD(WmsLogTag::WMS_LAYOUT, "id:%{public}d, globalRect:%{public}s, offsetX:%{public}d, offsetY:%{public}d",
         GetSessionPersistentId(), globalRect.ToString().c_str(), targetDisplayOffsetX, targetDisplayOffsetY);
-    return {globalRect.posX_ - targetDisplayOffsetX,
-            globalRect.posY_ - targetDisplayOffsetY,
-            globalRect.width_, globalRect.height_};
+    return RectMath::Offset(globalRect, -targetDisplayOffsetX, -targetDisplayOffsetY);
 }
 
 int32_t LayoutController::GetSessionPersistentId() const
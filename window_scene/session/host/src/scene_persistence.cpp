@@ -15,22 +15,20 @@
 
 #include "session/host/include/scene_persistence.h"
 
+#include <algorithm>
 #include <sys/stat.h>
 
 #include <hitrace_meter.h>
 #include <image_packer.h>
 #include <parameters.h>
 
+#include "session/host/include/ws_snapshot_policy.h"
 #include "window_manager_hilog.h"
 
 namespace OHOS::Rosen {
 namespace {
 constexpr HiviewDFX::HiLogLabel LABEL = { LOG_CORE, HILOG_DOMAIN_WINDOW, "ScenePersistence" };
 constexpr const char* UNDERLINE_SEPARATOR = "_";
-constexpr const char* ASTC_IMAGE_FORMAT_LOW = "image/astc/8*8";
-constexpr const char* ASTC_IMAGE_FORMAT_HIGH = "image/astc/4*4";
-constexpr const char* ASTC_IMAGE_SUFFIX = ".astc";
-constexpr uint8_t ASTC_IMAGE_QUALITY = 20;
 
 constexpr const char* IMAGE_FORMAT = "image/png";
 constexpr const char* IMAGE_SUFFIX = ".png";
@@ -38,21 +36,30 @@ constexpr uint8_t IMAGE_QUALITY = 100;
 constexpr int32_t ICON_IMAGE_WIDTH_HEIGHT_SIZE_LIMIT = 1024;
 constexpr double ICON_IMAGE_MAX_SCALE = 1;
 constexpr uint8_t SUCCESS = 0;
+constexpr uint32_t SNAPSHOT_MAX_LONG_SIDE_UNLIMITED = 0;
+
+uint32_t GetSnapshotMaxLongSide()
+{
+    static const uint32_t snapshotMaxLongSide = system::GetUintParameter<uint32_t>(
+        "persist.window.snapshot.max_long_side", SNAPSHOT_MAX_LONG_SIDE_UNLIMITED);
+    return snapshotMaxLongSide;
+}
 } // namespace
 
 std::string ScenePersistence::snapshotDirectory_;
 std::string ScenePersistence::updatedIconDirectory_;
-std::shared_ptr<WSFFRTHelper> ScenePersistence::snapshotFfrtHelper_;
 bool ScenePersistence::isAstcEnabled_ = false;
 
 bool ScenePersistence::CreateSnapshotDir(const std::string& directory)
 {
     snapshotDirectory_ = directory + "/SceneSnapShot/";
-    if (mkdir(snapshotDirectory_.c_str(), S_IRWXU)) {
+    bool isCreated = mkdir(snapshotDirectory_.c_str(), S_IRWXU) == 0;
+    if (!isCreated) {
         TLOGD(WmsLogTag::WMS_PATTERN, "mkdir failed or the directory already exists");
-        return false;
     }
-    return true;
+    // snapshots left by the previous run count against the disk budget
+    WSSnapshotPolicy::GetInstance().LoadDiskUsage(snapshotDirectory_);
+    return isCreated;
 }
 
 bool ScenePersistence::CreateUpdatedIconDir(const std::string& directory)
@@ -74,38 +81,42 @@ ScenePersistence::ScenePersistence(const std::string& bundleName, int32_t persis
     : bundleName_(bundleName), persistentId_(persistentId), capacity_(capacity)
 {
     InitAstcEnabled();
-    auto suffix = isAstcEnabled_ ? ASTC_IMAGE_SUFFIX : IMAGE_SUFFIX;
+    const std::string multiWindowUIType = system::GetParameter("const.window.multiWindowUIType", "HandsetSmartWindow");
+    isPcWindow_ = (multiWindowUIType == "FreeFormMultiWindow");
+    auto suffix = WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, isAstcEnabled_, isPcWindow_).suffix;
     for (uint32_t screenStatus = SCREEN_UNKNOWN; screenStatus < SCREEN_COUNT; screenStatus++) {
         for (uint32_t orientation = SNAPSHOT_PORTRAIT; orientation < ORIENTATION_COUNT; orientation++) {
-            snapshotPath_[screenStatus][orientation] = snapshotDirectory_ + bundleName + UNDERLINE_SEPARATOR +
+            std::string basePath = snapshotDirectory_ + bundleName + UNDERLINE_SEPARATOR +
                 std::to_string(persistentId) + UNDERLINE_SEPARATOR + std::to_string(screenStatus) +
-                std::to_string(orientation) + suffix;
+                std::to_string(orientation);
+            snapshotPath_[screenStatus][orientation] = basePath + suffix;
+            snapshotThumbnailPath_[screenStatus][orientation] = basePath + WSSnapshotPolicy::THUMBNAIL_TAG +
+                WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, isAstcEnabled_, isPcWindow_).suffix;
         }
     }
-    snapshotFreeMultiWindowPath_ = snapshotDirectory_ + bundleName + UNDERLINE_SEPARATOR +
-        std::to_string(persistentId) + suffix;
+    std::string freeMultiWindowBasePath = snapshotDirectory_ + bundleName + UNDERLINE_SEPARATOR +
+        std::to_string(persistentId);
+    snapshotFreeMultiWindowPath_ = freeMultiWindowBasePath + suffix;
+    snapshotFreeMultiWindowThumbnailPath_ = freeMultiWindowBasePath + WSSnapshotPolicy::THUMBNAIL_TAG +
+        WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, isAstcEnabled_, isPcWindow_).suffix;
     updatedIconPath_ = updatedIconDirectory_ + bundleName + IMAGE_SUFFIX;
-    if (snapshotFfrtHelper_ == nullptr) {
-        snapshotFfrtHelper_ = std::make_shared<WSFFRTHelper>();
-    }
-    const std::string multiWindowUIType = system::GetParameter("const.window.multiWindowUIType", "HandsetSmartWindow");
-    isPcWindow_ = (multiWindowUIType == "FreeFormMultiWindow");
 }
 
 ScenePersistence::~ScenePersistence()
 {
     TLOGI(WmsLogTag::WMS_PATTERN, "destroyed, persistentId: %{public}d", persistentId_);
-    for (const auto& row : snapshotPath_) {
-        for (auto& snapshotPath : row) {
-            remove(snapshotPath.c_str());
+    auto removeSnapshotFile = [](const std::string& path) {
+        remove(path.c_str());
+        WSSnapshotPolicy::GetInstance().OnFileRemoved(path);
+    };
+    for (uint32_t screenStatus = SCREEN_UNKNOWN; screenStatus < SCREEN_COUNT; screenStatus++) {
+        for (uint32_t orientation = SNAPSHOT_PORTRAIT; orientation < ORIENTATION_COUNT; orientation++) {
+            removeSnapshotFile(snapshotPath_[screenStatus][orientation]);
+            removeSnapshotFile(snapshotThumbnailPath_[screenStatus][orientation]);
         }
     }
-    remove(snapshotFreeMultiWindowPath_.c_str());
-}
-
-std::shared_ptr<WSFFRTHelper> ScenePersistence::GetSnapshotFfrtHelper() const
-{
-    return snapshotFfrtHelper_;
+    removeSnapshotFile(snapshotFreeMultiWindowPath_);
+    removeSnapshotFile(snapshotFreeMultiWindowThumbnailPath_);
 }
 
 void ScenePersistence::InitAstcEnabled()
@@ -119,16 +130,123 @@ bool ScenePersistence::IsAstcEnabled()
     return isAstcEnabled_;
 }
 
+bool ScenePersistence::PackSnapshot(const std::string& path, Media::PixelMap& pixelMap,
+    const SnapshotFormat& format, int64_t& packedSize)
+{
+    OHOS::Media::ImagePacker imagePacker;
+    OHOS::Media::PackOption option;
+    option.format = format.mimeType;
+    option.quality = format.quality;
+    option.numberHint = 1;
+    remove(path.c_str());
+    if (imagePacker.StartPacking(path, option)) {
+        TLOGNE(WmsLogTag::WMS_PATTERN, "Save snapshot failed, starting packing error");
+        return false;
+    }
+    if (imagePacker.AddImage(pixelMap)) {
+        TLOGNE(WmsLogTag::WMS_PATTERN, "Save snapshot failed, adding image error");
+        return false;
+    }
+    if (imagePacker.FinalizePacking(packedSize)) {
+        TLOGNE(WmsLogTag::WMS_PATTERN, "Save snapshot failed, finalizing packing error");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Stores the thumbnail tier for recents when the capture is larger than the thumbnail size of the
+ * window mode and display density.
+ */
+void ScenePersistence::SaveSnapshotThumbnail(const std::shared_ptr<Media::PixelMap>& pixelMap,
+    const std::string& thumbnailPath, float density)
+{
+    auto& policy = WSSnapshotPolicy::GetInstance();
+    uint32_t thumbnailLongSide = policy.GetThumbnailLongSide(isPcWindow_, density);
+    auto thumbnail = WSSnapshotPipeline::GetInstance().Downscale(pixelMap, thumbnailLongSide);
+    int64_t packedSize = 0;
+    if (thumbnailLongSide == 0 || thumbnail == pixelMap || thumbnail == nullptr ||
+        !PackSnapshot(thumbnailPath, *thumbnail,
+            WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, IsAstcEnabled(), isPcWindow_), packedSize)) {
+        // a stale thumbnail must not outlive the full snapshot it was made from
+        remove(thumbnailPath.c_str());
+        policy.OnFileRemoved(thumbnailPath);
+        return;
+    }
+    policy.OnFileWritten(thumbnailPath, SnapshotTier::THUMBNAIL, GetEvictFunc());
+}
+
+WSSnapshotPolicy::EvictFunc ScenePersistence::GetEvictFunc()
+{
+    return [weakThis = wptr(this)](const std::string& path) {
+        auto scenePersistence = weakThis.promote();
+        if (scenePersistence == nullptr) {
+            remove(path.c_str());
+            return;
+        }
+        scenePersistence->EvictSnapshotFile(path);
+    };
+}
+
+/**
+ * Removes a file picked by the disk budget. An evicted full tier takes its thumbnail with it and clears
+ * the snapshot flags, so nothing points at a missing file.
+ */
+void ScenePersistence::EvictSnapshotFile(const std::string& path)
+{
+    std::lock_guard lock(savingSnapshotMutex_);
+    auto& policy = WSSnapshotPolicy::GetInstance();
+    if (policy.IsFileTracked(path)) {
+        TLOGD(WmsLogTag::WMS_PATTERN, "saved again after eviction was decided, id: %{public}d", persistentId_);
+        return;
+    }
+    remove(path.c_str());
+    auto evictFull = [this, &policy](const std::string& thumbnailPath, SnapshotStatus key, bool freeMultiWindow) {
+        remove(thumbnailPath.c_str());
+        policy.OnFileRemoved(thumbnailPath);
+        if (freeMultiWindow) {
+            SetHasSnapshotFreeMultiWindow(false);
+        } else {
+            SetHasSnapshot(false, key);
+        }
+        if (snapshotEvictedFunc_) {
+            snapshotEvictedFunc_(key, freeMultiWindow);
+        }
+        TLOGI(WmsLogTag::WMS_PATTERN, "evicted, id: %{public}d, key: %{public}u%{public}u, freeMultiWindow: %{public}d",
+            persistentId_, key.first, key.second, freeMultiWindow);
+    };
+    if (path == snapshotFreeMultiWindowPath_) {
+        evictFull(snapshotFreeMultiWindowThumbnailPath_, defaultStatus, true);
+        return;
+    }
+    for (uint32_t screenStatus = SCREEN_UNKNOWN; screenStatus < SCREEN_COUNT; screenStatus++) {
+        for (uint32_t orientation = SNAPSHOT_PORTRAIT; orientation < ORIENTATION_COUNT; orientation++) {
+            if (path == snapshotPath_[screenStatus][orientation]) {
+                evictFull(snapshotThumbnailPath_[screenStatus][orientation], { screenStatus, orientation }, false);
+                return;
+            }
+        }
+    }
+}
+
+void ScenePersistence::SetSnapshotEvictedCallback(std::function<void(SnapshotStatus, bool)>&& func)
+{
+    std::lock_guard lock(savingSnapshotMutex_);
+    snapshotEvictedFunc_ = std::move(func);
+}
+
 void ScenePersistence::SaveSnapshot(const std::shared_ptr<Media::PixelMap>& pixelMap,
     const std::function<void()> resetSnapshotCallback, SnapshotStatus key, DisplayOrientation rotate,
-    bool freeMultiWindow)
+    bool freeMultiWindow, float density)
 {
     savingSnapshotSum_.fetch_add(1);
     SetIsSavingSnapshot(key, freeMultiWindow, true);
     TLOGI(WmsLogTag::WMS_PATTERN, "isSavingSnapshot_%{public}d", isSavingSnapshot_[key.first][key.second].load());
     std::string path = freeMultiWindow ? snapshotFreeMultiWindowPath_ : snapshotPath_[key.first][key.second];
+    std::string thumbnailPath = freeMultiWindow ? snapshotFreeMultiWindowThumbnailPath_ :
+        snapshotThumbnailPath_[key.first][key.second];
     auto task = [weakThis = wptr(this), pixelMap, resetSnapshotCallback,
-        savingSnapshotSum = savingSnapshotSum_.load(), key, rotate, path, freeMultiWindow]() {
+        savingSnapshotSum = savingSnapshotSum_.load(), key, rotate, path, thumbnailPath, freeMultiWindow, density]() {
         auto scenePersistence = weakThis.promote();
         if (scenePersistence == nullptr || pixelMap == nullptr ||
             path.find('/') == std::string::npos) {
@@ -139,33 +257,25 @@ void ScenePersistence::SaveSnapshot(const std::shared_ptr<Media::PixelMap>& pixe
         }
 
         TLOGNI(WmsLogTag::WMS_PATTERN, "Save snapshot begin");
+        auto encodePixelMap = WSSnapshotPipeline::GetInstance().Downscale(pixelMap, GetSnapshotMaxLongSide());
+        SnapshotStageTimer timer(SnapshotStage::ENCODE);
         HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SaveSnapshot %s", path.c_str());
-        OHOS::Media::ImagePacker imagePacker;
-        OHOS::Media::PackOption option;
-        const char *astcImageFormat = scenePersistence->isPcWindow_ ? ASTC_IMAGE_FORMAT_LOW : ASTC_IMAGE_FORMAT_HIGH;
-        option.format = IsAstcEnabled() ? astcImageFormat : IMAGE_FORMAT;
-        option.quality = IsAstcEnabled() ? ASTC_IMAGE_QUALITY : IMAGE_QUALITY;
-        option.numberHint = 1;
-
-        scenePersistence->SetSnapshotSize(key, freeMultiWindow, { pixelMap->GetWidth(), pixelMap->GetHeight() });
-        std::lock_guard lock(scenePersistence->savingSnapshotMutex_);
-        remove(path.c_str());
-        if (imagePacker.StartPacking(path, option)) {
-            TLOGNE(WmsLogTag::WMS_PATTERN, "Save snapshot failed, starting packing error");
-            resetSnapshotCallback();
-            return;
-        }
-        if (imagePacker.AddImage(*pixelMap)) {
-            TLOGNE(WmsLogTag::WMS_PATTERN, "Save snapshot failed, adding image error");
-            resetSnapshotCallback();
-            return;
-        }
+        auto format = WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, IsAstcEnabled(), scenePersistence->isPcWindow_);
+        scenePersistence->SetSnapshotSize(key, freeMultiWindow,
+            { encodePixelMap->GetWidth(), encodePixelMap->GetHeight() });
         int64_t packedSize = 0;
-        if (imagePacker.FinalizePacking(packedSize)) {
-            TLOGNE(WmsLogTag::WMS_PATTERN, "Save snapshot failed, finalizing packing error");
-            resetSnapshotCallback();
-            return;
+        {
+            std::lock_guard lock(scenePersistence->savingSnapshotMutex_);
+            if (!PackSnapshot(path, *encodePixelMap, format, packedSize)) {
+                remove(thumbnailPath.c_str());
+                WSSnapshotPolicy::GetInstance().OnFileRemoved(thumbnailPath);
+                resetSnapshotCallback();
+                return;
+            }
+            WSSnapshotPolicy::GetInstance().OnFileWritten(path, SnapshotTier::FULL, scenePersistence->GetEvictFunc());
+            scenePersistence->SaveSnapshotThumbnail(encodePixelMap, thumbnailPath, density);
         }
+        WSSnapshotPolicy::GetInstance().EnforceDiskBudget();
         // If the current num is equals to the latest num, it is the last saveSnapshot task
         if (savingSnapshotSum == scenePersistence->savingSnapshotSum_.load()) {
             resetSnapshotCallback();
@@ -173,7 +283,11 @@ void ScenePersistence::SaveSnapshot(const std::shared_ptr<Media::PixelMap>& pixe
         scenePersistence->rotate_[key.first][key.second] = rotate;
         TLOGNI(WmsLogTag::WMS_PATTERN, "Save snapshot end, packed size %{public}" PRIu64, packedSize);
     };
-    snapshotFfrtHelper_->SubmitTask(std::move(task), "SaveSnapshot" + path);
+    if (!WSSnapshotPipeline::GetInstance().SubmitTask(SnapshotLane::BACKGROUND, std::move(task),
+        "SaveSnapshot" + path)) {
+        TLOGW(WmsLogTag::WMS_PATTERN, "Save snapshot rejected, id: %{public}d", persistentId_);
+        resetSnapshotCallback();
+    }
 }
 
 bool ScenePersistence::IsSavingSnapshot(SnapshotStatus key, bool freeMultiWindow)
@@ -205,7 +319,7 @@ void ScenePersistence::ResetSnapshotCache()
 
 void ScenePersistence::RenameSnapshotFromOldPersistentId(const int32_t& oldPersistentId)
 {
-    auto task = [weakThis = wptr(this), oldPersistentId]() {
+    std::function<void()> task = [weakThis = wptr(this), oldPersistentId]() {
         auto scenePersistence = weakThis.promote();
         if (scenePersistence == nullptr) {
             TLOGNE(WmsLogTag::WMS_PATTERN, "scenePersistence is nullptr");
@@ -216,39 +330,47 @@ void ScenePersistence::RenameSnapshotFromOldPersistentId(const int32_t& oldPersi
                 scenePersistence->RenameSnapshotFromOldPersistentId(oldPersistentId, { screenStatus, orientation });
             }
         }
-        auto suffix = scenePersistence->isAstcEnabled_ ? ASTC_IMAGE_SUFFIX : IMAGE_SUFFIX;
-        std::string oldSnapshotFreeMultiWindowPath = snapshotDirectory_ + scenePersistence->bundleName_ +
-            UNDERLINE_SEPARATOR + std::to_string(oldPersistentId) + suffix;
-        auto& snapshotPath = scenePersistence->snapshotFreeMultiWindowPath_;
+        auto isPcWindow = scenePersistence->isPcWindow_;
+        std::string oldBasePath = snapshotDirectory_ + scenePersistence->bundleName_ +
+            UNDERLINE_SEPARATOR + std::to_string(oldPersistentId);
         std::lock_guard lock(scenePersistence->savingSnapshotMutex_);
-        int ret = std::rename(oldSnapshotFreeMultiWindowPath.c_str(), snapshotPath.c_str());
-        if (ret == 0) {
-            TLOGNI(WmsLogTag::WMS_PATTERN, "Rename snapshot from %{public}s to %{public}s.",
-                oldSnapshotFreeMultiWindowPath.c_str(), snapshotPath.c_str());
-        } else {
-            TLOGNW(WmsLogTag::WMS_PATTERN, "Failed to rename snapshot from %{public}s to %{public}s.",
-                oldSnapshotFreeMultiWindowPath.c_str(), snapshotPath.c_str());
-        }
+        scenePersistence->RenameSnapshotFile(oldBasePath + WSSnapshotPolicy::GetFormat(SnapshotTier::FULL,
+            isAstcEnabled_, isPcWindow).suffix, scenePersistence->snapshotFreeMultiWindowPath_);
+        scenePersistence->RenameSnapshotFile(oldBasePath + WSSnapshotPolicy::THUMBNAIL_TAG +
+            WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, isAstcEnabled_, isPcWindow).suffix,
+            scenePersistence->snapshotFreeMultiWindowThumbnailPath_);
     };
-    snapshotFfrtHelper_->SubmitTask(std::move(task), "RenameSnapshotFromOldPersistentId"
-        + std::to_string(oldPersistentId));
+    if (!WSSnapshotPipeline::GetInstance().SubmitTask(SnapshotLane::BACKGROUND, std::move(task),
+        "RenameSnapshotFromOldPersistentId" + std::to_string(oldPersistentId))) {
+        // a dropped rename would orphan the snapshot under the old id
+        TLOGW(WmsLogTag::WMS_PATTERN, "background lane full, rename inline, oldId: %{public}d", oldPersistentId);
+        task();
+    }
 }
 
 void ScenePersistence::RenameSnapshotFromOldPersistentId(const int32_t& oldPersistentId, SnapshotStatus key)
 {
-    auto& snapshotPath = snapshotPath_[key.first][key.second];
-    auto suffix = isAstcEnabled_ ? ASTC_IMAGE_SUFFIX : IMAGE_SUFFIX;
-    std::string oldSnapshotPath = snapshotDirectory_ + bundleName_ + UNDERLINE_SEPARATOR +
+    std::string oldBasePath = snapshotDirectory_ + bundleName_ + UNDERLINE_SEPARATOR +
         std::to_string(oldPersistentId) + UNDERLINE_SEPARATOR + std::to_string(key.first) +
-        std::to_string(key.second) + suffix;
+        std::to_string(key.second);
     std::lock_guard lock(savingSnapshotMutex_);
-    int ret = std::rename(oldSnapshotPath.c_str(), snapshotPath.c_str());
+    RenameSnapshotFile(oldBasePath + WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, isAstcEnabled_,
+        isPcWindow_).suffix, snapshotPath_[key.first][key.second]);
+    RenameSnapshotFile(oldBasePath + WSSnapshotPolicy::THUMBNAIL_TAG +
+        WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, isAstcEnabled_, isPcWindow_).suffix,
+        snapshotThumbnailPath_[key.first][key.second]);
+}
+
+void ScenePersistence::RenameSnapshotFile(const std::string& oldPath, const std::string& newPath)
+{
+    int ret = std::rename(oldPath.c_str(), newPath.c_str());
     if (ret == 0) {
+        WSSnapshotPolicy::GetInstance().OnFileRenamed(oldPath, newPath, GetEvictFunc());
         TLOGI(WmsLogTag::WMS_PATTERN, "Rename snapshot from %{public}s to %{public}s.",
-            oldSnapshotPath.c_str(), snapshotPath.c_str());
+            oldPath.c_str(), newPath.c_str());
     } else {
         TLOGW(WmsLogTag::WMS_PATTERN, "Failed to rename snapshot from %{public}s to %{public}s.",
-            oldSnapshotPath.c_str(), snapshotPath.c_str());
+            oldPath.c_str(), newPath.c_str());
     }
 }
 
@@ -374,14 +496,29 @@ std::pair<uint32_t, uint32_t> ScenePersistence::GetSnapshotSize(SnapshotStatus k
 
 void ScenePersistence::SetHasSnapshot(bool hasSnapshot, SnapshotStatus key)
 {
-    std::lock_guard lock(hasSnapshotMutex_);
-    hasSnapshot_[key.first][key.second] = hasSnapshot;
+    {
+        std::lock_guard lock(hasSnapshotMutex_);
+        hasSnapshot_[key.first][key.second] = hasSnapshot;
+    }
+    if (hasSnapshot) {
+        // a session restored on top of files left by a previous run owns them from now on
+        auto& policy = WSSnapshotPolicy::GetInstance();
+        policy.SetFileOwner(snapshotPath_[key.first][key.second], GetEvictFunc());
+        policy.SetFileOwner(snapshotThumbnailPath_[key.first][key.second], GetEvictFunc());
+    }
 }
 
 void ScenePersistence::SetHasSnapshotFreeMultiWindow(bool hasSnapshot)
 {
-    std::lock_guard lock(hasSnapshotMutex_);
-    hasSnapshotFreeMultiWindow_ = hasSnapshot;
+    {
+        std::lock_guard lock(hasSnapshotMutex_);
+        hasSnapshotFreeMultiWindow_ = hasSnapshot;
+    }
+    if (hasSnapshot) {
+        auto& policy = WSSnapshotPolicy::GetInstance();
+        policy.SetFileOwner(snapshotFreeMultiWindowPath_, GetEvictFunc());
+        policy.SetFileOwner(snapshotFreeMultiWindowThumbnailPath_, GetEvictFunc());
+    }
 }
 
 bool ScenePersistence::HasSnapshot() const
@@ -434,9 +571,87 @@ bool ScenePersistence::IsSnapshotExisted(SnapshotStatus key)
     return true;
 }
 
+std::string ScenePersistence::GetSnapshotThumbnailFilePath(SnapshotStatus key, bool freeMultiWindow) const
+{
+    return freeMultiWindow ? snapshotFreeMultiWindowThumbnailPath_ : snapshotThumbnailPath_[key.first][key.second];
+}
+
+/**
+ * Decodes the thumbnail tier when it holds enough pixels for the requested scale, so recents does not decode
+ * the full tier and downscale it.
+ */
+std::shared_ptr<Media::PixelMap> ScenePersistence::GetLocalSnapshotThumbnailPixelMap(const float oriScale,
+    const float newScale, SnapshotStatus key, bool freeMultiWindow)
+{
+    if (newScale >= oriScale) {
+        return nullptr;
+    }
+    auto fullSize = GetSnapshotSize(key, freeMultiWindow);
+    if (std::max(fullSize.first, fullSize.second) == 0) {
+        // the size is only kept in memory, after a restart read it back from the full tier header
+        fullSize = LoadSnapshotSize(key, freeMultiWindow);
+    }
+    uint32_t fullLongSide = std::max(fullSize.first, fullSize.second);
+    if (fullLongSide == 0) {
+        return nullptr;
+    }
+    uint32_t errorCode = 0;
+    Media::SourceOptions sourceOpts;
+    sourceOpts.formatHint = WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, IsAstcEnabled(), isPcWindow_).mimeType;
+    std::string path = GetSnapshotThumbnailFilePath(key, freeMultiWindow);
+    std::lock_guard lock(savingSnapshotMutex_);
+    struct stat buf;
+    if (stat(path.c_str(), &buf) != 0 || !S_ISREG(buf.st_mode)) {
+        return nullptr;
+    }
+    auto imageSource = Media::ImageSource::CreateImageSource(path, sourceOpts, errorCode);
+    if (!imageSource) {
+        return nullptr;
+    }
+    Media::ImageInfo info;
+    if (imageSource->GetImageInfo(info) != Rosen::SUCCESS || info.size.width <= 0 || info.size.height <= 0) {
+        return nullptr;
+    }
+    uint32_t thumbnailLongSide = static_cast<uint32_t>(std::max(info.size.width, info.size.height));
+    if (!WSSnapshotPolicy::IsThumbnailEnough(thumbnailLongSide, fullLongSide, oriScale, newScale)) {
+        return nullptr;
+    }
+    Media::DecodeOptions decodeOpts;
+    decodeOpts.desiredPixelFormat = Media::PixelFormat::RGBA_8888;
+    decodeOpts.desiredSize.width = static_cast<int>(fullSize.first * newScale / oriScale);
+    decodeOpts.desiredSize.height = static_cast<int>(fullSize.second * newScale / oriScale);
+    WSSnapshotPolicy::GetInstance().OnFileAccessed(path);
+    return imageSource->CreatePixelMap(decodeOpts, errorCode);
+}
+
+std::pair<uint32_t, uint32_t> ScenePersistence::LoadSnapshotSize(SnapshotStatus key, bool freeMultiWindow)
+{
+    uint32_t errorCode = 0;
+    Media::SourceOptions sourceOpts;
+    sourceOpts.formatHint = WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, IsAstcEnabled(), isPcWindow_).mimeType;
+    std::string path = freeMultiWindow ? snapshotFreeMultiWindowPath_ : snapshotPath_[key.first][key.second];
+    std::lock_guard lock(savingSnapshotMutex_);
+    struct stat buf;
+    if (stat(path.c_str(), &buf) != 0 || !S_ISREG(buf.st_mode)) {
+        return { 0, 0 };
+    }
+    auto imageSource = Media::ImageSource::CreateImageSource(path, sourceOpts, errorCode);
+    Media::ImageInfo info;
+    if (!imageSource || imageSource->GetImageInfo(info) != Rosen::SUCCESS ||
+        info.size.width <= 0 || info.size.height <= 0) {
+        return { 0, 0 };
+    }
+    std::pair<uint32_t, uint32_t> size = { info.size.width, info.size.height };
+    SetSnapshotSize(key, freeMultiWindow, size);
+    return size;
+}
+
 std::shared_ptr<Media::PixelMap> ScenePersistence::GetLocalSnapshotPixelMap(const float oriScale,
     const float newScale, SnapshotStatus key, bool freeMultiWindow)
 {
+    if (auto thumbnail = GetLocalSnapshotThumbnailPixelMap(oriScale, newScale, key, freeMultiWindow)) {
+        return thumbnail;
+    }
     if (!IsSnapshotExisted(key)) {
         TLOGE(WmsLogTag::WMS_PATTERN, "local snapshot pic is not existed");
         return nullptr;
@@ -444,8 +659,7 @@ std::shared_ptr<Media::PixelMap> ScenePersistence::GetLocalSnapshotPixelMap(cons
 
     uint32_t errorCode = 0;
     Media::SourceOptions sourceOpts;
-    const char *astcImageFormat = this->isPcWindow_ ? ASTC_IMAGE_FORMAT_LOW : ASTC_IMAGE_FORMAT_HIGH;
-    sourceOpts.formatHint = IsAstcEnabled() ? astcImageFormat : IMAGE_FORMAT;
+    sourceOpts.formatHint = WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, IsAstcEnabled(), isPcWindow_).mimeType;
     std::string path = GetSnapshotFilePath(key, true, freeMultiWindow);
     std::lock_guard lock(savingSnapshotMutex_);
     auto imageSource = Media::ImageSource::CreateImageSource(path, sourceOpts, errorCode);
@@ -453,6 +667,7 @@ std::shared_ptr<Media::PixelMap> ScenePersistence::GetLocalSnapshotPixelMap(cons
         TLOGE(WmsLogTag::WMS_PATTERN, "create image source fail, errCode: %{public}u", errorCode);
         return nullptr;
     }
+    WSSnapshotPolicy::GetInstance().OnFileAccessed(path);
 
     Media::ImageInfo info;
     int32_t decoderWidth = 0;
@@ -38,6 +38,7 @@
 #include "proxy/include/window_info.h"
 
 #include "application_context.h"
+#include "common/include/rect_math.h"
 #include "common/include/session_permission.h"
 #ifdef DEVICE_STATUS_ENABLE
 #include "interaction_manager.h"
@@ -2370,33 +2371,26 @@ void SceneSession::CalculateAvoidAreaByType(AvoidAreaType type,
 
 void SceneSession::CalculateAvoidAreaRect(const WSRect& rect, const WSRect& avoidRect, AvoidArea& avoidArea) const
 {
-    if (SessionHelper::IsEmptyRect(rect) || SessionHelper::IsEmptyRect(avoidRect)) {
+    if (RectMath::IsZero(rect) || RectMath::IsZero(avoidRect)) {
         return;
     }
-    Rect avoidAreaRect = SessionHelper::TransferToRect(
-        SessionHelper::GetOverlap(rect, avoidRect, rect.posX_, rect.posY_));
-    if (WindowHelper::IsEmptyRect(avoidAreaRect)) {
+    Rect avoidAreaRect = RectMath::ToRect(RectMath::Overlap(rect, avoidRect, rect.posX_, rect.posY_));
+    if (RectMath::IsZero(avoidAreaRect)) {
         return;
     }
-
-    uint32_t avoidAreaCenterX = static_cast<uint32_t>(avoidAreaRect.posX_) + (avoidAreaRect.width_ >> 1);
-    uint32_t avoidAreaCenterY = static_cast<uint32_t>(avoidAreaRect.posY_) + (avoidAreaRect.height_ >> 1);
-    float res1 = float(avoidAreaCenterY) - float(rect.height_) / float(rect.width_) *
-        float(avoidAreaCenterX);
-    float res2 = float(avoidAreaCenterY) + float(rect.height_) / float(rect.width_) *
-        float(avoidAreaCenterX) - float(rect.height_);
-    if (res1 < 0) {
-        if (res2 < 0) {
+    switch (RectMath::GetAvoidSide(rect, avoidAreaRect)) {
+        case RectMath::AvoidSide::TOP:
             avoidArea.topRect_ = avoidAreaRect;
-        } else {
+            break;
+        case RectMath::AvoidSide::RIGHT:
             avoidArea.rightRect_ = avoidAreaRect;
-        }
-    } else {
-        if (res2 < 0) {
+            break;
+        case RectMath::AvoidSide::LEFT:
             avoidArea.leftRect_ = avoidAreaRect;
-        } else {
+            break;
+        default:
             avoidArea.bottomRect_ = avoidAreaRect;
-        }
+            break;
     }
 }
 
@@ -4620,12 +4614,8 @@ void SceneSession::UpdateNativeVisibility(bool visible)
         int32_t persistentId = session->GetPersistentId();
         TLOGNI(WmsLogTag::WMS_SCB, "%{public}s name: %{public}s, id: %{public}u, visible: %{public}u",
             where, session->sessionInfo_.bundleName_.c_str(), persistentId, visible);
-        SceneSessionChangeInfo changeInfo {
-            .persistentId_ = persistentId,
-            .changeInfo_ = "Visibility change to " + std::to_string(visible),
-            .logTag_ = WmsLogTag::WMS_ATTRIBUTE,
-        };
-        SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::VISIBLE_RECORD, changeInfo);
+        SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::VISIBLE_RECORD, persistentId,
+            WmsLogTag::WMS_ATTRIBUTE, visible);
         bool oldVisibleState = session->isVisible_;
         session->isVisible_ = visible;
         if (session->visibilityChangedDetectFunc_) {
@@ -6237,14 +6227,10 @@ WMError SceneSession::HandleActionUpdateOrientation(const sptr<WindowSessionProp
     WSPropertyChangeAction action)
 {
     SetRequestedOrientation(property->GetRequestedOrientation(), property->GetRequestedAnimation());
-    SceneSessionChangeInfo changeInfo {
-        .persistentId_ = property->GetPersistentId(),
-        .changeInfo_ = "Orientation change to " +
-            std::to_string(static_cast<uint32_t>(property->GetRequestedOrientation())) + ", animation change to "+
-            std::to_string(static_cast<uint32_t>(property->GetRequestedAnimation())),
-        .logTag_ = WmsLogTag::WMS_ROTATION,
-    };
-    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::ORIENTAION_RECORD, changeInfo);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::ORIENTAION_RECORD,
+        property->GetPersistentId(), WmsLogTag::WMS_ROTATION,
+        static_cast<uint32_t>(property->GetRequestedOrientation()),
+        static_cast<uint32_t>(property->GetRequestedAnimation()));
     return WMError::WM_OK;
 }
 
@@ -6254,12 +6240,8 @@ WMError SceneSession::HandleActionUpdatePrivacyMode(const sptr<WindowSessionProp
     bool isPrivacyMode = property->GetPrivacyMode() || property->GetSystemPrivacyMode();
     SetPrivacyMode(isPrivacyMode);
     NotifySessionChangeByActionNotifyManager(property, action);
-    SceneSessionChangeInfo changeInfo {
-        .persistentId_ = property->GetPersistentId(),
-        .changeInfo_ = "Privacy mode change to " + std::to_string(isPrivacyMode),
-        .logTag_ = WmsLogTag::WMS_ATTRIBUTE,
-    };
-    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::PRIVACY_MODE, changeInfo);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::PRIVACY_MODE,
+        property->GetPersistentId(), WmsLogTag::WMS_ATTRIBUTE, isPrivacyMode);
     return WMError::WM_OK;
 }
 
@@ -8042,12 +8024,8 @@ bool SceneSession::UpdateVisibilityInner(bool visibility)
     if (notifyVisibleChangeFunc_ != nullptr) {
         notifyVisibleChangeFunc_(GetPersistentId());
     }
-    SceneSessionChangeInfo changeInfo {
-        .persistentId_ = GetPersistentId(),
-        .changeInfo_ = "Visibility change to " + std::to_string(visibility),
-        .logTag_ = WmsLogTag::WMS_ATTRIBUTE,
-    };
-    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::VISIBLE_RECORD, changeInfo);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::VISIBLE_RECORD, GetPersistentId(),
+        WmsLogTag::WMS_ATTRIBUTE, visibility);
     return true;
 }
 
@@ -8221,6 +8199,7 @@ bool SceneSession::UpdateZOrderInner(uint32_t zOrder)
           GetPersistentId(), zOrder_, zOrder, lastZOrder_);
     lastZOrder_ = zOrder_;
     zOrder_ = zOrder;
+    layoutController_->MarkHitTestDirty();
     return true;
 }
 
@@ -8300,6 +8279,7 @@ void SceneSession::SetDefaultDisplayIdIfNeed()
     if (sessionInfo_.screenId_ == SCREEN_ID_INVALID) {
         auto defaultDisplayId = ScreenSessionManagerClient::GetInstance().GetDefaultScreenId();
         sessionInfo_.screenId_ = defaultDisplayId;
+        screenIdGeneration_.fetch_add(1);
         TLOGI(WmsLogTag::WMS_LIFE, "winId: %{public}d, update screen id %{public}" PRIu64,
             GetPersistentId(), defaultDisplayId);
         auto sessionProperty = GetSessionProperty();
@@ -80,10 +80,54 @@ const bool CORRECTION_ENABLE = system::GetIntParameter<int32_t>("const.system.se
 const uint32_t ROTATION_90 = 90;
 const uint32_t ROTATION_360 = 360;
 const uint32_t ROTATION_LANDSCAPE_INVERTED = 3;
+constexpr int32_t FFRT_SNAPSHOT_TIMEOUT_MS = 5000;
+
+RSSurfaceCaptureConfig GetSnapshotCaptureConfig(float scale, bool useCurWindow, uint32_t backGroundColor)
+{
+    RSSurfaceCaptureConfig config = {
+        .scaleX = scale,
+        .scaleY = scale,
+        .useDma = true,
+        .useCurWindow = useCurWindow,
+        .backGroundColor = backGroundColor,
+    };
+    return config;
+}
+
+/*
+ * Forwards the surface capture result of render service to a snapshot pipeline callback.
+ */
+class SnapshotCaptureNotifier : public SurfaceCaptureCallback {
+public:
+    explicit SnapshotCaptureNotifier(SnapshotCaptureCallback&& onCaptured) : onCaptured_(std::move(onCaptured)) {}
+
+    void OnSurfaceCapture(std::shared_ptr<Media::PixelMap> pixelMap) override
+    {
+        onCaptured_(pixelMap);
+    }
+
+    void OnSurfaceCaptureHDR(std::shared_ptr<Media::PixelMap> pixelMap,
+        std::shared_ptr<Media::PixelMap> hdrPixelMap) override
+    {
+        onCaptured_(pixelMap == nullptr ? hdrPixelMap : pixelMap);
+    }
+
+private:
+    SnapshotCaptureCallback onCaptured_;
+};
+
+/*
+ * Handle of an async capture, guarded by snapshotCaptureMutex_. The capture may complete before its handle is known.
+ */
+struct SnapshotCaptureState {
+    uint64_t handle = 0;
+    bool isCompleted = false;
+};
 } // namespace
 
 std::shared_ptr<AppExecFwk::EventHandler> Session::mainHandler_;
 bool Session::isScbCoreEnabled_ = false;
+std::atomic<uint64_t> Session::screenIdGeneration_ { 0 };
 bool Session::isBackgroundUpdateRectNotifyEnabled_ = false;
 
 Session::Session(const SessionInfo& info) : sessionInfo_(info)
@@ -128,6 +172,7 @@ Session::~Session()
     TLOGI(WmsLogTag::WMS_LIFE, "id:%{public}d", GetPersistentId());
     DeletePersistentImageFit();
     DeleteHasSnapshot();
+    CancelSnapshotCaptures();
     if (mainHandler_) {
         mainHandler_->PostTask([surfaceNode = std::move(surfaceNode_),
                                 shadowSurfaceNode = std::move(shadowSurfaceNode_),
@@ -381,8 +426,16 @@ DisplayId Session::GetScreenId() const
     return sessionInfo_.screenId_;
 }
 
+uint64_t Session::GetScreenIdGeneration()
+{
+    return screenIdGeneration_.load();
+}
+
 void Session::SetScreenId(uint64_t screenId)
 {
+    if (sessionInfo_.screenId_ != screenId) {
+        screenIdGeneration_.fetch_add(1);
+    }
     sessionInfo_.screenId_ = screenId;
     if (sessionStage_) {
         sessionStage_->UpdateDisplayId(screenId);
@@ -2678,23 +2731,102 @@ std::shared_ptr<Media::PixelMap> Session::Snapshot(bool runInFfrt, float scalePa
         return nullptr;
     }
     auto callback = std::make_shared<SurfaceCaptureFuture>();
-    auto scaleValue = (scaleParam < 0.0f || std::fabs(scaleParam) < std::numeric_limits<float>::min()) ?
-        snapshotScale_ : scaleParam;
-    uint32_t backGroundColor = GetBackgroundColor();
-    RSSurfaceCaptureConfig config = {
-        .scaleX = scaleValue,
-        .scaleY = scaleValue,
-        .useDma = true,
-        .useCurWindow = useCurWindow,
-        .backGroundColor = backGroundColor,
-    };
+    auto config = GetSnapshotCaptureConfig(GetSnapshotCaptureScale(scaleParam), useCurWindow, GetBackgroundColor());
+    SnapshotStageTimer timer(SnapshotStage::CAPTURE);
     bool ret = RSInterfaces::GetInstance().TakeSurfaceCapture(surfaceNode, callback, config);
     if (!ret) {
         TLOGE(WmsLogTag::WMS_MAIN, "TakeSurfaceCapture failed");
         return nullptr;
     }
-    constexpr int32_t FFRT_SNAPSHOT_TIMEOUT_MS = 5000;
     auto pixelMap = callback->GetResult(runInFfrt ? FFRT_SNAPSHOT_TIMEOUT_MS : SNAPSHOT_TIMEOUT_MS);
+    return OnSnapshotCaptured(pixelMap, isPersistentImageFit);
+}
+
+uint64_t Session::SnapshotAsync(SnapshotCaptureCallback&& callback, float scaleParam, bool useCurWindow,
+    BackgroundReason reason)
+{
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SnapshotAsync[%d][%s]", persistentId_,
+        sessionInfo_.bundleName_.c_str());
+    if (scenePersistence_ == nullptr || !callback) {
+        return 0;
+    }
+    auto surfaceNode = GetSurfaceNode();
+    auto key = GetSessionSnapshotStatus(reason);
+    auto isPersistentImageFit = IsPersistentImageFit();
+    if (isPersistentImageFit) key = defaultStatus;
+    if (!surfaceNode || !surfaceNode->IsBufferAvailable()) {
+        scenePersistence_->SetHasSnapshot(false, key);
+        scenePersistence_->SetHasSnapshotFreeMultiWindow(false);
+        return 0;
+    }
+    auto scale = GetSnapshotCaptureScale(scaleParam);
+    auto config = GetSnapshotCaptureConfig(scale, useCurWindow, GetBackgroundColor());
+    SnapshotCaptureKey captureKey = {
+        .persistentId = persistentId_,
+        .scale = scale,
+        .useCurWindow = useCurWindow,
+        .screenStatus = key.first,
+        .orientation = key.second,
+        .rotation = GetSnapshotRotation(key),
+    };
+    auto starter = [surfaceNode, config, persistentId = persistentId_](SnapshotCaptureCallback&& onCaptured) {
+        auto captureCallback = std::make_shared<SnapshotCaptureNotifier>(std::move(onCaptured));
+        bool ret = RSInterfaces::GetInstance().TakeSurfaceCapture(surfaceNode, captureCallback, config);
+        if (!ret) {
+            TLOGNE(WmsLogTag::WMS_MAIN, "TakeSurfaceCapture failed, id: %{public}d", persistentId);
+        }
+        return ret;
+    };
+    auto captureState = std::make_shared<SnapshotCaptureState>();
+    auto onCaptured = [weakThis = wptr(this), isPersistentImageFit, callback = std::move(callback), captureState](
+        const std::shared_ptr<Media::PixelMap>& pixelMap) {
+        auto session = weakThis.promote();
+        if (session == nullptr) {
+            TLOGNE(WmsLogTag::WMS_MAIN, "session is null");
+            callback(nullptr);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(session->snapshotCaptureMutex_);
+            captureState->isCompleted = true;
+            session->snapshotCaptureHandles_.erase(captureState->handle);
+        }
+        callback(session->OnSnapshotCaptured(pixelMap, isPersistentImageFit));
+    };
+    uint64_t handle = WSSnapshotPipeline::GetInstance().CaptureAsync(captureKey, std::move(starter),
+        std::move(onCaptured), FFRT_SNAPSHOT_TIMEOUT_MS);
+    std::lock_guard<std::mutex> lock(snapshotCaptureMutex_);
+    if (handle != 0 && !captureState->isCompleted) {
+        captureState->handle = handle;
+        snapshotCaptureHandles_.insert(handle);
+    }
+    return handle;
+}
+
+void Session::CancelSnapshotCaptures()
+{
+    std::unordered_set<uint64_t> handles;
+    {
+        std::lock_guard<std::mutex> lock(snapshotCaptureMutex_);
+        handles.swap(snapshotCaptureHandles_);
+    }
+    for (auto handle : handles) {
+        WSSnapshotPipeline::GetInstance().CancelCapture(handle);
+    }
+    if (!handles.empty()) {
+        TLOGI(WmsLogTag::WMS_PATTERN, "id: %{public}d, cancelled: %{public}zu", persistentId_, handles.size());
+    }
+}
+
+float Session::GetSnapshotCaptureScale(float scaleParam) const
+{
+    return (scaleParam < 0.0f || std::fabs(scaleParam) < std::numeric_limits<float>::min()) ?
+        snapshotScale_ : scaleParam;
+}
+
+std::shared_ptr<Media::PixelMap> Session::OnSnapshotCaptured(std::shared_ptr<Media::PixelMap> pixelMap,
+    bool isPersistentImageFit) const
+{
     if (isPersistentImageFit && GetSnapshot()) {
         TLOGI(WmsLogTag::WMS_PATTERN, "id: %{public}d", persistentId_);
         pixelMap = GetSnapshot();
@@ -2757,28 +2889,18 @@ void Session::SaveSnapshot(bool useFfrt, bool needPersist, std::shared_ptr<Media
         return;
     }
     auto key = GetSessionSnapshotStatus(reason);
-    auto rotation = currentRotation_;
-    if (CORRECTION_ENABLE && key.first == 0) {
-        rotation = (rotation + ROTATION_90) % ROTATION_360;
-    }
-    if (FoldScreenStateInternel::IsSingleDisplayPocketFoldDevice() &&
-        WSSnapshotHelper::GetInstance()->GetScreenStatus() == SCREEN_FOLDED) {
-        rotation = ROTATION_LANDSCAPE_INVERTED;
-    }
-    auto rotate = WSSnapshotHelper::GetDisplayOrientation(rotation);
+    auto rotate = WSSnapshotHelper::GetDisplayOrientation(GetSnapshotRotation(key));
     if (persistentPixelMap) {
         key = defaultStatus;
         rotate = DisplayOrientation::PORTRAIT;
     }
-    auto task = [weakThis = wptr(this), runInFfrt = useFfrt, requirePersist = needPersist, persistentPixelMap,
-        updateSnapshot, key, rotate]() {
+    auto task = [weakThis = wptr(this), requirePersist = needPersist, updateSnapshot, key, rotate](
+        const std::shared_ptr<Media::PixelMap>& pixelMap) {
         auto session = weakThis.promote();
         if (session == nullptr) {
             TLOGNE(WmsLogTag::WMS_LIFE, "session is null");
             return;
         }
-        session->lastLayoutRect_ = session->layoutRect_;
-        auto pixelMap = persistentPixelMap ? persistentPixelMap : session->Snapshot(runInFfrt);
         if (pixelMap == nullptr) {
             return;
         }
@@ -2819,21 +2941,51 @@ void Session::SaveSnapshot(bool useFfrt, bool needPersist, std::shared_ptr<Media
             removeSnapshotCallback = session->removeSnapshotCallback_;
         }
         session->scenePersistence_->SaveSnapshot(pixelMap, removeSnapshotCallback, key, rotate,
-            session->freeMultiWindow_.load());
+            session->freeMultiWindow_.load(), session->GetSnapshotDensity());
         if (updateSnapshot) {
             session->SetExitSplitOnBackground(false);
             session->scenePersistence_->ClearSnapshot(key);
             session->NotifyUpdateSnapshotWindow();
         }
     };
+    lastLayoutRect_ = layoutRect_;
     if (!useFfrt) {
-        task();
+        task(persistentPixelMap ? persistentPixelMap : Snapshot(false));
         return;
     }
-    auto snapshotFfrtHelper = scenePersistence_->GetSnapshotFfrtHelper();
-    std::string taskName = "Session::SaveSnapshot" + std::to_string(persistentId_);
-    snapshotFfrtHelper->CancelTask(taskName);
-    snapshotFfrtHelper->SubmitTask(std::move(task), taskName);
+    if (persistentPixelMap) {
+        auto saveTask = [task = std::move(task), persistentPixelMap] { task(persistentPixelMap); };
+        std::string taskName = "Session::SaveSnapshot" + std::to_string(persistentId_);
+        if (!WSSnapshotPipeline::GetInstance().SubmitTask(SnapshotLane::INTERACTIVE, std::move(saveTask), taskName)) {
+            TLOGW(WmsLogTag::WMS_PATTERN, "save rejected, id: %{public}d", persistentId_);
+        }
+        return;
+    }
+    // the capture result is delivered on the interactive lane, save it there
+    SnapshotAsync(std::move(task), 0.0f, false, reason);
+}
+
+int32_t Session::GetSnapshotRotation(const SnapshotStatus& key) const
+{
+    auto rotation = currentRotation_;
+    if (CORRECTION_ENABLE && key.first == 0) {
+        rotation = (rotation + ROTATION_90) % ROTATION_360;
+    }
+    if (FoldScreenStateInternel::IsSingleDisplayPocketFoldDevice() &&
+        WSSnapshotHelper::GetInstance()->GetScreenStatus() == SCREEN_FOLDED) {
+        rotation = ROTATION_LANDSCAPE_INVERTED;
+    }
+    return rotation;
+}
+
+float Session::GetSnapshotDensity() const
+{
+    auto screenSession = ScreenSessionManagerClient::GetInstance().GetScreenSessionById(
+        GetSessionProperty()->GetDisplayId());
+    if (screenSession == nullptr) {
+        return 1.0f;
+    }
+    return screenSession->GetScreenProperty().GetDensity();
 }
 
 void Session::SetFreeMultiWindow()
@@ -2880,6 +3032,27 @@ void Session::DeleteHasSnapshotFreeMultiWindow()
     }
 }
 
+/**
+ * Drops the persisted flag of a snapshot the disk budget removed, so a restart does not point at the file.
+ */
+void Session::RegisterSnapshotEvictedCallback()
+{
+    if (scenePersistence_ == nullptr) {
+        return;
+    }
+    scenePersistence_->SetSnapshotEvictedCallback([weakThis = wptr(this)](SnapshotStatus key, bool freeMultiWindow) {
+        auto session = weakThis.promote();
+        if (session == nullptr) {
+            return;
+        }
+        if (freeMultiWindow) {
+            session->DeleteHasSnapshotFreeMultiWindow();
+        } else {
+            session->DeleteHasSnapshot(key);
+        }
+    });
+}
+
 bool Session::HasSnapshot(SnapshotStatus key)
 {
     auto hasSnapshot = ScenePersistentStorage::HasKey("Snapshot_" + std::to_string(persistentId_) +
@@ -4053,6 +4226,9 @@ WSError Session::UpdateMaximizeMode(bool isMaximize)
 /** @note @window.hierarchy */
 void Session::SetZOrder(uint32_t zOrder)
 {
+    if (zOrder_ != zOrder) {
+        layoutController_->MarkHitTestDirty();
+    }
     lastZOrder_ = zOrder_;
     zOrder_ = zOrder;
     NotifySessionInfoChange();
@@ -18,6 +18,11 @@
 #include <algorithm>
 #include <charconv>
 #include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include <parameters.h>
 
 #include "window_helper.h"
 #include "zlib.h"
@@ -28,30 +33,202 @@ namespace {
 #define COMPRESS_VERSION 9
 
 constexpr uint32_t MAX_RECORD_TYPE_SIZE = 10;
-constexpr uint32_t MAX_RECORD_LOG_SIZE = 102400;
 constexpr uint32_t MAX_EVENT_DUMP_SIZE = 512 * 1024;
 constexpr int32_t SCHEDULE_SECONDS = 5;
+constexpr uint32_t DEFAULT_SLOT_NUM = 16;
+constexpr uint32_t MAX_SLOT_NUM = 1024;
+constexpr uint32_t DEFAULT_TEXT_SIZE_KB = 64;
+constexpr uint32_t DEFAULT_MAX_RING_NUM = 32;
+constexpr uint32_t MAX_RING_NUM = 128;
+constexpr uint32_t MAX_TEXT_SIZE_KB = 1024;
+constexpr uint32_t BYTES_PER_KB = 1024;
+constexpr uint32_t MAX_TEXT_SHARE = 2; // one record takes at most half of the text ring
+constexpr int64_t NS_PER_SEC = 1000000000;
+constexpr int64_t NS_PER_MS = 1000000;
+constexpr int64_t MS_PER_SEC = 1000;
+
+struct ThreadRings {
+    ~ThreadRings()
+    {
+        // the rings keep their records for the dump and go to the next thread that records
+        for (auto& ring : rings) {
+            if (ring != nullptr) {
+                ring->inUse_.store(false);
+            }
+        }
+    }
+    std::array<std::shared_ptr<SessionChangeRing>, static_cast<uint32_t>(RecordType::RECORD_TYPE_END) + 1> rings;
+    std::array<bool, static_cast<uint32_t>(RecordType::RECORD_TYPE_END) + 1> acquired {};
+};
+thread_local ThreadRings g_threadRings;
+
+int64_t GetSteadyTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t GetWallClockOffsetNs()
+{
+    int64_t wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return wallNs - GetSteadyTimeNs();
+}
 
 // LCOV_EXCL_START
-std::string GetFormattedTime()
+std::string FormatRecordTime(int64_t timeNs, int64_t wallClockOffsetNs)
 {
-    auto now = std::chrono::system_clock::now();
-    std::time_t t = std::chrono::system_clock::to_time_t(now);
+    int64_t wallNs = timeNs + wallClockOffsetNs;
+    std::time_t t = static_cast<std::time_t>(wallNs / NS_PER_SEC);
     struct tm timeBuffer;
     std::tm* tmPtr = localtime_r(&t, &timeBuffer);
-    // 1000：million record
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-    
+    if (tmPtr == nullptr) {
+        return "";
+    }
     std::ostringstream oss;
     const int formatThreeSpace = 3;
-    oss << std::put_time(tmPtr, "%m-%d %H:%M:%S") << "." << std::setw(formatThreeSpace) << ms.count();
+    oss << std::put_time(tmPtr, "%m-%d %H:%M:%S") << "." << std::setw(formatThreeSpace) << std::setfill('0')
+        << (wallNs / NS_PER_MS) % MS_PER_SEC;
     return oss.str();
 }
 // LCOV_EXCL_STOP
+
+std::string FormatChangeInfo(const SessionChangeEntry& entry)
+{
+    const auto& record = entry.first;
+    if (!record.isPacked) {
+        return record.isTextTruncated ? entry.second + "..." : entry.second;
+    }
+    switch (record.recordType) {
+        case RecordType::SESSION_STATE_RECORD:
+            return "Session state change to " + std::to_string(record.args[0]);
+        case RecordType::VISIBLE_RECORD:
+            return "Visibility change to " + std::to_string(record.args[0]);
+        case RecordType::PRIVACY_MODE:
+            return "Privacy mode change to " + std::to_string(record.args[0]);
+        case RecordType::ORIENTAION_RECORD:
+            return "Orientation change to " + std::to_string(record.args[0]) + ", animation change to " +
+                std::to_string(record.args[1]);
+        default:
+            return "Args: " + std::to_string(record.args[0]) + ", " + std::to_string(record.args[1]);
+    }
+}
+
+SceneSessionChangeInfo DecodeRecord(const SessionChangeEntry& entry, int64_t wallClockOffsetNs)
+{
+    return {
+        .persistentId_ = entry.first.persistentId,
+        .changeInfo_ = FormatChangeInfo(entry),
+        .logTag_ = entry.first.logTag,
+        .time_ = FormatRecordTime(entry.first.timeNs, wallClockOffsetNs),
+    };
+}
 } // namespace
 
+SessionChangeRing::SessionChangeRing(uint32_t slotNum, uint32_t textSize)
+    : slotNum_(std::max<uint32_t>(slotNum, 1)), textSize_(std::max<uint32_t>(textSize, 1)),
+      slots_(std::make_unique<Slot[]>(slotNum_))
+{
+}
+
+void SessionChangeRing::CopyText(uint64_t offset, const char* src, uint32_t len)
+{
+    uint32_t pos = static_cast<uint32_t>(offset % textSize_);
+    uint32_t firstLen = std::min(len, textSize_ - pos);
+    std::copy(src, src + firstLen, text_.get() + pos);
+    std::copy(src + firstLen, src + len, text_.get());
+}
+
+void SessionChangeRing::ReadText(uint64_t offset, char* dst, uint32_t len) const
+{
+    uint32_t pos = static_cast<uint32_t>(offset % textSize_);
+    uint32_t firstLen = std::min(len, textSize_ - pos);
+    std::copy(text_.get() + pos, text_.get() + pos + firstLen, dst);
+    std::copy(text_.get(), text_.get() + (len - firstLen), dst + firstLen);
+}
+
+/*
+ * Seqlock per slot: the slot sequence is odd while the record is written.
+ * Text is reserved before it is written, so a reader that copied half written text sees the reservation.
+ * The text arena is allocated before the first record with text is published, and readers only touch it
+ * for such records, so the release of that slot orders the allocation.
+ */
+uint64_t SessionChangeRing::Push(SessionChangeRecord& record, const std::string& text)
+{
+    uint32_t textLen = static_cast<uint32_t>(std::min<size_t>(text.size(), textSize_ / MAX_TEXT_SHARE));
+    uint64_t textOffset = textHead_.load(std::memory_order_relaxed);
+    record.textOffset = textOffset;
+    record.textLen = textLen;
+    record.isTextTruncated = textLen < text.size();
+    if (textLen > 0) {
+        if (text_ == nullptr) {
+            text_ = std::make_unique<char[]>(textSize_);
+        }
+        textHead_.store(textOffset + textLen, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        CopyText(textOffset, text.data(), textLen);
+    }
+    uint64_t seq = head_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[seq % slotNum_];
+    slot.seq.store(seq * 2 + 1, std::memory_order_relaxed); // 2: odd while writing
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.record = record;
+    slot.seq.store(seq * 2 + 2, std::memory_order_release); // 2: even once written
+    head_.store(seq + 1, std::memory_order_release);
+    return seq + 1 - logCursor_.load(std::memory_order_relaxed);
+}
+
+uint64_t SessionChangeRing::Collect(uint64_t fromSeq, std::vector<SessionChangeEntry>& entries) const
+{
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t begin = head > slotNum_ ? std::max(fromSeq, head - slotNum_) : fromSeq;
+    for (uint64_t seq = begin; seq < head; seq++) {
+        const Slot& slot = slots_[seq % slotNum_];
+        uint64_t slotSeq = slot.seq.load(std::memory_order_acquire);
+        if (slotSeq != seq * 2 + 2) { // 2: written by this round
+            continue;
+        }
+        SessionChangeRecord record = slot.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != slotSeq) {
+            continue;
+        }
+        std::string text(record.textLen, '\0');
+        if (record.textLen > 0) {
+            ReadText(record.textOffset, text.data(), record.textLen);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (textHead_.load(std::memory_order_relaxed) - record.textOffset > textSize_) {
+                continue;
+            }
+        }
+        entries.emplace_back(record, std::move(text));
+    }
+    return head;
+}
+
 WM_IMPLEMENT_SINGLE_INSTANCE(SessionChangeRecorder)
 
+SessionChangeRecorder::SessionChangeRecorder()
+{
+    slotNum_ = system::GetUintParameter<uint32_t>(
+        "persist.window.session_change_recorder.slot_num", DEFAULT_SLOT_NUM);
+    if (slotNum_ < MAX_RECORD_TYPE_SIZE) {
+        slotNum_ = DEFAULT_SLOT_NUM;
+    }
+    slotNum_ = std::min(slotNum_, MAX_SLOT_NUM);
+    uint32_t textSizeKb = system::GetUintParameter<uint32_t>(
+        "persist.window.session_change_recorder.text_kb", DEFAULT_TEXT_SIZE_KB);
+    if (textSizeKb == 0 || textSizeKb > MAX_TEXT_SIZE_KB) {
+        textSizeKb = DEFAULT_TEXT_SIZE_KB;
+    }
+    textSize_ = textSizeKb * BYTES_PER_KB;
+    maxRingNum_ = std::min(system::GetUintParameter<uint32_t>(
+        "persist.window.session_change_recorder.max_ring_num", DEFAULT_MAX_RING_NUM), MAX_RING_NUM);
+    for (auto& ring : sharedRings_) {
+        ring = std::make_shared<SessionChangeRing>(slotNum_, textSize_);
+    }
+}
+
 void SessionChangeRecorder::Init()
 {
     TLOGD(WmsLogTag::DEFAULT, "In");
@@ -68,21 +245,18 @@ void SessionChangeRecorder::Init()
     // LCOV_EXCL_START
     stopLogFlag_.store(false);
     mThread = std::thread([this]() {
-        std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> sceneSessionChangeNeedLogMapCopy;
+        std::vector<SessionChangeEntry> entries;
         while (!stopLogFlag_.load()) {
-            {
-                std::lock_guard<std::mutex> lock(sessionChangeRecorderMutex_);
-                if (!sceneSessionChangeNeedLogMap_.empty()) {
-                    sceneSessionChangeNeedLogMapCopy = sceneSessionChangeNeedLogMap_;
-                    sceneSessionChangeNeedLogMap_.clear();
-                    currentLogSize_ = 0;
-                }
+            CollectRecords(true, entries);
+            if (!entries.empty()) {
+                PrintLog(entries);
+                entries.clear();
             }
-            if (!sceneSessionChangeNeedLogMapCopy.empty()) {
-                PrintLog(sceneSessionChangeNeedLogMapCopy);
-                sceneSessionChangeNeedLogMapCopy.clear();
-            }
-            std::this_thread::sleep_for(std::chrono::seconds(SCHEDULE_SECONDS));
+            std::unique_lock<std::mutex> lock(drainMutex_);
+            drainCv_.wait_for(lock, std::chrono::seconds(SCHEDULE_SECONDS), [this] {
+                return isDrainRequested_.load() || stopLogFlag_.load();
+            });
+            isDrainRequested_.store(false);
         }
     });
     // LCOV_EXCL_STOP
@@ -91,7 +265,11 @@ void SessionChangeRecorder::Init()
 SessionChangeRecorder::~SessionChangeRecorder()
 {
     TLOGD(WmsLogTag::DEFAULT, "In");
-    stopLogFlag_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(drainMutex_);
+        stopLogFlag_.store(true);
+    }
+    drainCv_.notify_one();
     if (mThread.joinable()) {
         mThread.join();
     }
@@ -102,18 +280,149 @@ WSError SessionChangeRecorder::RecordSceneSessionChange(RecordType recordType, S
 {
     TLOGD(WmsLogTag::DEFAULT, "In");
     if (changeInfo.logTag_ == WmsLogTag::DEFAULT || changeInfo.logTag_ >= WmsLogTag::END ||
-        changeInfo.changeInfo_ == "") {
+        changeInfo.changeInfo_ == "" || recordType > RecordType::RECORD_TYPE_END) {
         TLOGD(WmsLogTag::DEFAULT, "Invalid log tag");
         return WSError::WS_ERROR_INVALID_PARAM;
     }
-    if (changeInfo.time_ == "") {
-        changeInfo.time_ = GetFormattedTime();
+    SessionChangeRecord record {
+        .timeNs = GetSteadyTimeNs(),
+        .recordType = recordType,
+        .logTag = changeInfo.logTag_,
+        .persistentId = changeInfo.persistentId_,
+    };
+    Record(record, changeInfo.changeInfo_);
+    return WSError::WS_OK;
+}
+
+WSError SessionChangeRecorder::RecordSceneSessionChange(RecordType recordType, int32_t persistentId,
+    WmsLogTag logTag, uint32_t arg0, uint32_t arg1)
+{
+    if (logTag == WmsLogTag::DEFAULT || logTag >= WmsLogTag::END || recordType > RecordType::RECORD_TYPE_END) {
+        TLOGD(WmsLogTag::DEFAULT, "Invalid log tag");
+        return WSError::WS_ERROR_INVALID_PARAM;
     }
-    RecordLog(recordType, changeInfo);
-    RecordDump(recordType, changeInfo);
+    SessionChangeRecord record {
+        .timeNs = GetSteadyTimeNs(),
+        .recordType = recordType,
+        .logTag = logTag,
+        .persistentId = persistentId,
+        .isPacked = true,
+        .args = { arg0, arg1 },
+    };
+    static const std::string emptyText;
+    Record(record, emptyText);
     return WSError::WS_OK;
 }
 
+void SessionChangeRecorder::Record(SessionChangeRecord& record, const std::string& text)
+{
+    uint32_t typeIndex = static_cast<uint32_t>(record.recordType);
+    auto& threadRings = g_threadRings;
+    if (!threadRings.acquired[typeIndex]) {
+        threadRings.rings[typeIndex] = AcquireRing(record.recordType);
+        threadRings.acquired[typeIndex] = true;
+    }
+    const auto& ring = threadRings.rings[typeIndex];
+    if (ring != nullptr) {
+        OnRecordPushed(ring->Push(record, text), ring->GetSlotNum());
+        return;
+    }
+    std::unique_lock<std::mutex> lock(sharedRingMutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        droppedNum_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    OnRecordPushed(sharedRings_[typeIndex]->Push(record, text), slotNum_);
+}
+
+/*
+ * Only the log thread collects records for good, without it a full ring is the expected steady state.
+ * The wake up is not taken under drainMutex_ to keep recording wait free, a missed one waits for the next round.
+ */
+void SessionChangeRecorder::OnRecordPushed(uint64_t pendingNum, uint32_t slotNum)
+{
+    if (pendingNum < slotNum || !isInitFlag_.load(std::memory_order_relaxed) ||
+        stopLogFlag_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (pendingNum > slotNum) {
+        droppedNum_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!isDrainRequested_.exchange(true)) {
+        drainCv_.notify_one();
+    }
+}
+
+std::shared_ptr<SessionChangeRing> SessionChangeRecorder::AcquireRing(RecordType recordType)
+{
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    auto& rings = rings_[static_cast<uint32_t>(recordType)];
+    for (const auto& ring : rings) {
+        bool inUse = false;
+        if (ring->inUse_.compare_exchange_strong(inUse, true)) {
+            return ring;
+        }
+    }
+    if (ringNum_ >= maxRingNum_) {
+        TLOGD(WmsLogTag::DEFAULT, "ring num reach max: %{public}u", maxRingNum_);
+        return nullptr;
+    }
+    auto ring = std::make_shared<SessionChangeRing>(slotNum_, textSize_);
+    ring->inUse_.store(true);
+    rings.push_back(ring);
+    ringNum_++;
+    return ring;
+}
+
+void SessionChangeRecorder::CollectRecords(bool isForLog, std::vector<SessionChangeEntry>& entries)
+{
+    auto collect = [isForLog, &entries](SessionChangeRing& ring) {
+        uint64_t head = ring.Collect(isForLog ? ring.logCursor_.load() : 0, entries);
+        if (isForLog) {
+            ring.logCursor_.store(head);
+        }
+    };
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        for (const auto& rings : rings_) {
+            for (const auto& ring : rings) {
+                collect(*ring);
+            }
+        }
+    }
+    // shared ring writers are serialized by sharedRingMutex_, Collect is safe against a single writer
+    for (const auto& ring : sharedRings_) {
+        collect(*ring);
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first.timeNs < rhs.first.timeNs;
+    });
+}
+
+std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> SessionChangeRecorder::GetDumpMap()
+{
+    std::vector<SessionChangeEntry> entries;
+    CollectRecords(false, entries);
+    std::unordered_map<RecordType, uint32_t> recordSizeMap;
+    {
+        std::lock_guard<std::mutex> lock(sessionChangeRecorderMutex_);
+        recordSizeMap = recordSizeMap_;
+    }
+    int64_t wallClockOffsetNs = GetWallClockOffsetNs();
+    std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> dumpMap;
+    for (const auto& entry : entries) {
+        RecordType recordType = entry.first.recordType;
+        auto& dumpQueue = dumpMap[recordType];
+        dumpQueue.push(DecodeRecord(entry, wallClockOffsetNs));
+        auto iter = recordSizeMap.find(recordType);
+        uint32_t maxRecordTypeSize = iter != recordSizeMap.end() ? iter->second : MAX_RECORD_TYPE_SIZE;
+        while (dumpQueue.size() > maxRecordTypeSize) {
+            dumpQueue.pop();
+        }
+    }
+    return dumpMap;
+}
+
 WSError SessionChangeRecorder::SetRecordSize(RecordType recordType, uint32_t recordSize)
 {
     TLOGD(WmsLogTag::DEFAULT, "recordType: %{public}" PRIu32 ", size: %{public}d", recordType, recordSize);
@@ -132,6 +441,7 @@ void SessionChangeRecorder::GetSceneSessionNeedDumpInfo(
 {
     std::ostringstream oss;
     oss << "Record session change: " << std::endl;
+    oss << "Dropped records: " << GetDroppedNum() << std::endl;
     bool simplifyFlag = false;
     std::vector<std::string> params = dumpParams;
     auto it = std::find(params.begin(), params.end(), "-simplify");
@@ -167,11 +477,7 @@ void SessionChangeRecorder::GetSceneSessionNeedDumpInfo(
             specifiedRecordType = value;
         }
     }
-    std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> sceneSessionChangeNeedDumpMapCopy;
-    {
-        std::lock_guard<std::mutex> lock(sessionChangeRecorderMutex_);
-        sceneSessionChangeNeedDumpMapCopy = sceneSessionChangeNeedDumpMap_;
-    }
+    auto sceneSessionChangeNeedDumpMapCopy = GetDumpMap();
     std::string dumpInfoJsonString = FormatDumpInfoToJsonString(specifiedRecordType, specifiedWindowId,
         sceneSessionChangeNeedDumpMapCopy);
     oss << dumpInfoJsonString;
@@ -268,79 +574,14 @@ int SessionChangeRecorder::CompressString (const char* inStr, size_t inLen, std:
     return Z_OK;
 }
 
-void SessionChangeRecorder::RecordDump(RecordType recordType, SceneSessionChangeInfo& changeInfo)
+void SessionChangeRecorder::PrintLog(const std::vector<SessionChangeEntry>& entries)
 {
     TLOGD(WmsLogTag::DEFAULT, "In");
-    uint32_t maxRecordTypeSize = MAX_RECORD_TYPE_SIZE;
-    uint32_t currentRecordTypeSize = MAX_RECORD_TYPE_SIZE;
-    {
-        std::lock_guard<std::mutex> lock(sessionChangeRecorderMutex_);
-        if (sceneSessionChangeNeedDumpMap_.find(recordType) == sceneSessionChangeNeedDumpMap_.end()) {
-            std::queue<SceneSessionChangeInfo> dumpQueue;
-            dumpQueue.push(changeInfo);
-            sceneSessionChangeNeedDumpMap_[recordType] = dumpQueue;
-        } else {
-            sceneSessionChangeNeedDumpMap_[recordType].push(changeInfo);
-        }
-        maxRecordTypeSize = recordSizeMap_.find(recordType) != recordSizeMap_.end() ?
-            recordSizeMap_[recordType] : MAX_RECORD_TYPE_SIZE;
-        currentRecordTypeSize = sceneSessionChangeNeedDumpMap_[recordType].size();
-    }
-
-    if (currentRecordTypeSize > maxRecordTypeSize) {
-        std::lock_guard<std::mutex> lock(sessionChangeRecorderMutex_);
-        uint32_t diff = sceneSessionChangeNeedDumpMap_[recordType].size() - maxRecordTypeSize;
-        while (diff > 0) {
-            sceneSessionChangeNeedDumpMap_[recordType].pop();
-            diff--;
-        }
-    }
-}
-
-void SessionChangeRecorder::RecordLog(RecordType recordType, SceneSessionChangeInfo& changeInfo)
-{
-    TLOGD(WmsLogTag::DEFAULT, "In");
-    uint32_t maxRecordTypeSize = MAX_RECORD_TYPE_SIZE;
-    uint32_t currentRecordTypeSize = MAX_RECORD_TYPE_SIZE;
-    {
-        std::lock_guard<std::mutex> lock(sessionChangeRecorderMutex_);
-        if (sceneSessionChangeNeedLogMap_.find(recordType) == sceneSessionChangeNeedLogMap_.end()) {
-            std::queue<SceneSessionChangeInfo> logQueue;
-            logQueue.push(changeInfo);
-            sceneSessionChangeNeedLogMap_[recordType] = logQueue;
-        } else {
-            sceneSessionChangeNeedLogMap_[recordType].push(changeInfo);
-        }
-        currentLogSize_ += changeInfo.changeInfo_.size();
-        maxRecordTypeSize = recordSizeMap_.find(recordType) != recordSizeMap_.end() ?
-            recordSizeMap_[recordType] : MAX_RECORD_TYPE_SIZE;
-        currentRecordTypeSize = sceneSessionChangeNeedLogMap_[recordType].size();
-    }
-    if (currentLogSize_ >= MAX_RECORD_LOG_SIZE || currentRecordTypeSize > maxRecordTypeSize) {
-        TLOGD(WmsLogTag::DEFAULT, "currentLogSize: %{public}d", currentLogSize_);
-        std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> sceneSessionChangeNeedLogMapCopy;
-        {
-            std::lock_guard<std::mutex> lock(sessionChangeRecorderMutex_);
-            sceneSessionChangeNeedLogMapCopy = sceneSessionChangeNeedLogMap_;
-            sceneSessionChangeNeedLogMap_.clear();
-            currentLogSize_ = 0;
-        }
-        PrintLog(sceneSessionChangeNeedLogMapCopy);
-    }
-}
-
-void SessionChangeRecorder::PrintLog(
-    std::unordered_map<RecordType, std::queue<SceneSessionChangeInfo>> sceneSessionChangeNeedLogMap)
-{
-    TLOGD(WmsLogTag::DEFAULT, "In");
-    for (const auto& item : sceneSessionChangeNeedLogMap) {
-        std::queue<SceneSessionChangeInfo> logInfoQueue = item.second;
-        while (!logInfoQueue.empty()) {
-            SceneSessionChangeInfo curChange = logInfoQueue.front();
-            TLOGD(curChange.logTag_, "winId: %{public}d, changeInfo: %{public}s, time: %{public}s",
-                curChange.persistentId_, curChange.changeInfo_.c_str(), curChange.time_.c_str());
-            logInfoQueue.pop();
-        }
+    int64_t wallClockOffsetNs = GetWallClockOffsetNs();
+    for (const auto& entry : entries) {
+        SceneSessionChangeInfo curChange = DecodeRecord(entry, wallClockOffsetNs);
+        TLOGD(curChange.logTag_, "winId: %{public}d, changeInfo: %{public}s, time: %{public}s",
+            curChange.persistentId_, curChange.changeInfo_.c_str(), curChange.time_.c_str());
     }
 }
 // LCOV_EXCL_STOP
@@ -15,6 +15,7 @@
 
 #include "session_coordinate_helper.h"
 
+#include "common/include/rect_math.h"
 #include "dm_common.h"
 #include "screen_session_manager_client/include/screen_session_manager_client.h"
 #include "window_manager_hilog.h"
@@ -31,12 +32,7 @@ WSRect SessionCoordinateHelper::RelativeToGlobalDisplayRect(ScreenId screenId, c
         return relativeRect;
     }
     const auto& screenProperty = screenSession->GetScreenProperty();
-    WSRect globalRect {
-        screenProperty.GetX() + relativeRect.posX_,
-        screenProperty.GetY() + relativeRect.posY_,
-        relativeRect.width_,
-        relativeRect.height_
-    };
+    const WSRect globalRect = RectMath::Offset(relativeRect, screenProperty.GetX(), screenProperty.GetY());
     TLOGD(WmsLogTag::WMS_LAYOUT, "screenId: %{public}" PRIu64 ", relativeRect: %{public}s, globalRect: %{public}s",
         screenId, relativeRect.ToString().c_str(), globalRect.ToString().c_str());
     return globalRect;
@@ -98,11 +94,7 @@ WSScreenRelativeRect SessionCoordinateHelper::GlobalToScreenRelativeRect(
     bool hasCandidate = candidateScreenId != SCREEN_ID_INVALID;
     const auto matchedScreenId = hasCandidate ? candidateScreenId : originalScreenId;
     const auto& matchedScreenRect = hasCandidate ? candidateScreenRect : originalScreenRect;
-    const WSRect relativeRect {
-        globalRect.posX_ - matchedScreenRect.posX_,
-        globalRect.posY_ - matchedScreenRect.posY_,
-        globalRect.width_, globalRect.height_
-    };
+    const WSRect relativeRect = RectMath::Offset(globalRect, -matchedScreenRect.posX_, -matchedScreenRect.posY_);
     TLOGD(WmsLogTag::WMS_LAYOUT, "matchedScreenId: %{public}" PRIu64 ", relativeRect: %{public}s",
         matchedScreenId, relativeRect.ToString().c_str());
     return { matchedScreenId, relativeRect };
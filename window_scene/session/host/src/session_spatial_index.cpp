@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "session/host/include/session_spatial_index.h"
+
+#include <algorithm>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int64_t MAX_CELL_NUM_PER_SESSION = 1024;
+constexpr uint32_t CELL_KEY_SHIFT = 32;
+
+uint64_t GetCellKey(int32_t cellX, int32_t cellY)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << CELL_KEY_SHIFT) | static_cast<uint32_t>(cellY);
+}
+
+bool IsPointInEntryRect(const WSRect& rect, int32_t pointX, int32_t pointY)
+{
+    return pointX >= rect.posX_ && static_cast<int64_t>(pointX) < static_cast<int64_t>(rect.posX_) + rect.width_ &&
+        pointY >= rect.posY_ && static_cast<int64_t>(pointY) < static_cast<int64_t>(rect.posY_) + rect.height_;
+}
+} // namespace
+
+SessionSpatialIndex::SessionSpatialIndex(int32_t cellSize)
+    : cellSize_(cellSize > 0 ? cellSize : DEFAULT_CELL_SIZE)
+{
+}
+
+int32_t SessionSpatialIndex::GetCell(int64_t value) const
+{
+    // floor division, so negative positions get their own cells
+    int64_t cell = value / cellSize_;
+    if (value % cellSize_ != 0 && value < 0) {
+        cell--;
+    }
+    return static_cast<int32_t>(cell);
+}
+
+void SessionSpatialIndex::Update(int32_t persistentId, DisplayId displayId, const WSRect& rect, uint32_t zOrder)
+{
+    auto iter = entries_.find(persistentId);
+    if (iter != entries_.end()) {
+        auto& entry = iter->second;
+        if (entry.displayId == displayId && entry.rect == rect) {
+            entry.zOrder = zOrder;
+            return;
+        }
+        Erase(persistentId, entry);
+    }
+    auto& entry = entries_[persistentId];
+    entry.displayId = displayId;
+    entry.rect = rect;
+    entry.zOrder = zOrder;
+    Insert(persistentId, entry);
+}
+
+void SessionSpatialIndex::Remove(int32_t persistentId)
+{
+    auto iter = entries_.find(persistentId);
+    if (iter == entries_.end()) {
+        return;
+    }
+    Erase(persistentId, iter->second);
+    entries_.erase(iter);
+}
+
+void SessionSpatialIndex::Clear()
+{
+    entries_.clear();
+    displayGrids_.clear();
+}
+
+void SessionSpatialIndex::Insert(int32_t persistentId, Entry& entry)
+{
+    auto& grid = displayGrids_[entry.displayId];
+    grid.sessions.insert(persistentId);
+    entry.oversized = false;
+    entry.minCellX = 0;
+    entry.minCellY = 0;
+    entry.maxCellX = -1;
+    entry.maxCellY = -1;
+    if (entry.rect.width_ <= 0 || entry.rect.height_ <= 0) {
+        return;
+    }
+    const int64_t right = static_cast<int64_t>(entry.rect.posX_) + entry.rect.width_ - 1;
+    const int64_t bottom = static_cast<int64_t>(entry.rect.posY_) + entry.rect.height_ - 1;
+    const int32_t minCellX = GetCell(entry.rect.posX_);
+    const int32_t minCellY = GetCell(entry.rect.posY_);
+    const int32_t maxCellX = GetCell(right);
+    const int32_t maxCellY = GetCell(bottom);
+    const int64_t cellNum = (static_cast<int64_t>(maxCellX) - minCellX + 1) *
+        (static_cast<int64_t>(maxCellY) - minCellY + 1);
+    if (cellNum > MAX_CELL_NUM_PER_SESSION) {
+        entry.oversized = true;
+        grid.oversized.push_back(persistentId);
+        return;
+    }
+    entry.minCellX = minCellX;
+    entry.minCellY = minCellY;
+    entry.maxCellX = maxCellX;
+    entry.maxCellY = maxCellY;
+    for (int32_t cellY = minCellY; cellY <= maxCellY; cellY++) {
+        for (int32_t cellX = minCellX; cellX <= maxCellX; cellX++) {
+            grid.cells[GetCellKey(cellX, cellY)].push_back(persistentId);
+        }
+    }
+}
+
+void SessionSpatialIndex::Erase(int32_t persistentId, const Entry& entry)
+{
+    auto gridIter = displayGrids_.find(entry.displayId);
+    if (gridIter == displayGrids_.end()) {
+        return;
+    }
+    auto& grid = gridIter->second;
+    auto eraseId = [persistentId](std::vector<int32_t>& ids) {
+        auto iter = std::find(ids.begin(), ids.end(), persistentId);
+        if (iter != ids.end()) {
+            *iter = ids.back();
+            ids.pop_back();
+        }
+    };
+    if (entry.oversized) {
+        eraseId(grid.oversized);
+    }
+    for (int32_t cellY = entry.minCellY; cellY <= entry.maxCellY; cellY++) {
+        for (int32_t cellX = entry.minCellX; cellX <= entry.maxCellX; cellX++) {
+            auto cellIter = grid.cells.find(GetCellKey(cellX, cellY));
+            if (cellIter == grid.cells.end()) {
+                continue;
+            }
+            eraseId(cellIter->second);
+            if (cellIter->second.empty()) {
+                grid.cells.erase(cellIter);
+            }
+        }
+    }
+    grid.sessions.erase(persistentId);
+    if (grid.sessions.empty()) {
+        displayGrids_.erase(gridIter);
+    }
+}
+
+void SessionSpatialIndex::SortFromTopToBottom(std::vector<int32_t>& persistentIds) const
+{
+    std::sort(persistentIds.begin(), persistentIds.end(), [this](int32_t lhs, int32_t rhs) {
+        uint32_t lhsZOrder = entries_.at(lhs).zOrder;
+        uint32_t rhsZOrder = entries_.at(rhs).zOrder;
+        return lhsZOrder != rhsZOrder ? lhsZOrder > rhsZOrder : lhs > rhs;
+    });
+}
+
+void SessionSpatialIndex::Query(DisplayId displayId, int32_t pointX, int32_t pointY,
+    std::vector<int32_t>& persistentIds) const
+{
+    persistentIds.clear();
+    auto gridIter = displayGrids_.find(displayId);
+    if (gridIter == displayGrids_.end()) {
+        return;
+    }
+    const auto& grid = gridIter->second;
+    auto collect = [this, pointX, pointY, &persistentIds](const std::vector<int32_t>& ids) {
+        for (auto persistentId : ids) {
+            if (IsPointInEntryRect(entries_.at(persistentId).rect, pointX, pointY)) {
+                persistentIds.push_back(persistentId);
+            }
+        }
+    };
+    auto cellIter = grid.cells.find(GetCellKey(GetCell(pointX), GetCell(pointY)));
+    if (cellIter != grid.cells.end()) {
+        collect(cellIter->second);
+    }
+    collect(grid.oversized);
+    SortFromTopToBottom(persistentIds);
+}
+
+void SessionSpatialIndex::QueryDisplay(DisplayId displayId, std::vector<int32_t>& persistentIds) const
+{
+    persistentIds.clear();
+    auto gridIter = displayGrids_.find(displayId);
+    if (gridIter == displayGrids_.end()) {
+        return;
+    }
+    persistentIds.assign(gridIter->second.sessions.begin(), gridIter->second.sessions.end());
+    SortFromTopToBottom(persistentIds);
+}
+} // namespace OHOS::Rosen
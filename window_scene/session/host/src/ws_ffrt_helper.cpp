@@ -30,6 +30,7 @@
 namespace OHOS::Rosen {
 namespace {
 constexpr int32_t FFRT_USER_INTERACTIVE_MAX_THREAD_NUM = 5;
+constexpr uint64_t US_PER_MS = 1000;
 constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WSFFRTHelper"};
 const std::unordered_map<TaskQos, ffrt::qos> FFRT_QOS_MAP = {
     { TaskQos::INHERIT, ffrt_qos_inherit },
@@ -66,6 +67,12 @@ public:
         }
     }
 
+    void EraseTask(const std::string& taskName)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        taskMap_.erase(taskName);
+    }
+
     bool IsTaskExisted(const std::string& taskName)
     {
         std::shared_lock<std::shared_mutex> lock(mutex_);
@@ -84,12 +91,20 @@ private:
     std::shared_mutex mutex_;
 };
 
-WSFFRTHelper::WSFFRTHelper() : taskHandleMap_(std::make_unique<TaskHandleMap>())
+WSFFRTHelper::WSFFRTHelper()
+    : WSFFRTHelper("WSFFRTHelper", TaskQos::USER_INTERACTIVE, FFRT_USER_INTERACTIVE_MAX_THREAD_NUM)
+{
+}
+
+WSFFRTHelper::WSFFRTHelper(const std::string& queueName, TaskQos qos, int32_t maxConcurrency, bool allowInline)
+    : taskHandleMap_(std::make_unique<TaskHandleMap>()), allowInline_(allowInline)
 {
-    ffrtQueue_ = std::make_unique<ffrt::queue>(ffrt::queue_concurrent, "WSFFRTHelper",
-        ffrt::queue_attr().qos(ffrt_qos_user_interactive).max_concurrency(FFRT_USER_INTERACTIVE_MAX_THREAD_NUM));
-    TLOGI(WmsLogTag::WMS_MAIN, "FFRT user interactive qos max queue thread number: %{public}d",
-        FFRT_USER_INTERACTIVE_MAX_THREAD_NUM);
+    auto iter = FFRT_QOS_MAP.find(qos);
+    ffrt::qos queueQos = iter != FFRT_QOS_MAP.end() ? iter->second : ffrt::qos(ffrt_qos_user_interactive);
+    ffrtQueue_ = std::make_unique<ffrt::queue>(ffrt::queue_concurrent, queueName.c_str(),
+        ffrt::queue_attr().qos(queueQos).max_concurrency(maxConcurrency));
+    TLOGI(WmsLogTag::WMS_MAIN, "queue: %{public}s, qos: %{public}d, max queue thread number: %{public}d",
+        queueName.c_str(), static_cast<int32_t>(qos), maxConcurrency);
 }
 
 WSFFRTHelper::~WSFFRTHelper() = default;
@@ -101,11 +116,12 @@ void WSFFRTHelper::SubmitTask(std::function<void()>&& task, const std::string& t
         HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "f:%s", taskName.c_str());
         task();
     };
-    if (delayTime == 0 && ffrt_get_cur_task() != nullptr) {
+    if (allowInline_ && delayTime == 0 && ffrt_get_cur_task() != nullptr) {
         localTask();
         return;
     }
-    ffrt::task_handle handle = ffrtQueue_->submit_h(std::move(localTask));
+    ffrt::task_handle handle = delayTime == 0 ? ffrtQueue_->submit_h(std::move(localTask)) :
+        ffrtQueue_->submit_h(std::move(localTask), ffrt::task_attr().delay(delayTime * US_PER_MS));
     if (handle == nullptr) {
         WLOGE("Failed to post task, taskName=%{public}s", taskName.c_str());
         return;
@@ -118,6 +134,11 @@ void WSFFRTHelper::CancelTask(const std::string& taskName)
     taskHandleMap_->RemoveTask(taskName, ffrtQueue_);
 }
 
+void WSFFRTHelper::ReleaseTask(const std::string& taskName)
+{
+    taskHandleMap_->EraseTask(taskName);
+}
+
 bool WSFFRTHelper::IsTaskExisted(const std::string& taskName) const
 {
     return taskHandleMap_->IsTaskExisted(taskName);
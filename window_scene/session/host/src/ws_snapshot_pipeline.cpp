@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "session/host/include/ws_snapshot_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <iomanip>
+#include <sstream>
+
+#include <hitrace_meter.h>
+#include <pixel_map.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int32_t INTERACTIVE_MAX_THREAD_NUM = 3;
+constexpr int32_t BACKGROUND_MAX_THREAD_NUM = 2;
+constexpr uint32_t INTERACTIVE_DEPTH_LIMIT = 32;
+constexpr uint32_t BACKGROUND_DEPTH_LIMIT = 16;
+// as many running captures as interactive workers, the starts of a full set run in parallel
+constexpr uint32_t MAX_RUNNING_CAPTURE_NUM = INTERACTIVE_MAX_THREAD_NUM;
+const std::string CAPTURE_START_TASK_NAME = "SnapshotCaptureStart";
+const std::string CAPTURE_TIMEOUT_TASK_NAME = "SnapshotCaptureTimeout";
+const std::string CAPTURE_DONE_TASK_NAME = "SnapshotCaptureDone";
+constexpr const char* LANE_NAMES[] = { "interactive", "background" };
+constexpr const char* STAGE_NAMES[] = { "capture", "downscale", "encode" };
+constexpr int32_t DUMP_NAME_WIDTH = 13;
+constexpr int32_t DUMP_COLUMN_WIDTH = 14;
+
+int64_t GetSteadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void DumpRow(std::ostringstream& oss, const std::string& name, std::initializer_list<std::string> columns)
+{
+    oss << std::left << std::setw(DUMP_NAME_WIDTH) << name;
+    for (const auto& column : columns) {
+        oss << std::setw(DUMP_COLUMN_WIDTH) << column;
+    }
+    oss << std::endl;
+}
+} // namespace
+
+WSSnapshotPipeline& WSSnapshotPipeline::GetInstance()
+{
+    static WSSnapshotPipeline instance;
+    return instance;
+}
+
+WSSnapshotPipeline::WSSnapshotPipeline()
+{
+    auto& interactiveLane = lanes_[static_cast<size_t>(SnapshotLane::INTERACTIVE)];
+    interactiveLane.ffrtHelper = std::make_unique<WSFFRTHelper>("WSSnapshotInteractive",
+        TaskQos::USER_INTERACTIVE, INTERACTIVE_MAX_THREAD_NUM, false);
+    interactiveLane.stat.depthLimit = INTERACTIVE_DEPTH_LIMIT;
+    auto& backgroundLane = lanes_[static_cast<size_t>(SnapshotLane::BACKGROUND)];
+    backgroundLane.ffrtHelper = std::make_unique<WSFFRTHelper>("WSSnapshotBackground",
+        TaskQos::BACKGROUND, BACKGROUND_MAX_THREAD_NUM, false);
+    backgroundLane.stat.depthLimit = BACKGROUND_DEPTH_LIMIT;
+    captureConcurrency_ = MAX_RUNNING_CAPTURE_NUM;
+    captureTimer_ = std::make_unique<WSFFRTHelper>("WSSnapshotCaptureTimer", TaskQos::USER_INTERACTIVE, 1, false);
+}
+
+bool WSSnapshotPipeline::SubmitTask(SnapshotLane lane, std::function<void()>&& task, const std::string& taskName)
+{
+    if (lane >= SnapshotLane::COUNT || !task) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    auto& curLane = lanes_[static_cast<size_t>(lane)];
+    auto iter = curLane.pendingTasks.find(taskName);
+    if (iter != curLane.pendingTasks.end()) {
+        curLane.ffrtHelper->CancelTask(taskName);
+        curLane.stat.coalesced++;
+    } else if (curLane.pendingTasks.size() >= curLane.stat.depthLimit) {
+        curLane.stat.rejected++;
+        TLOGW(WmsLogTag::WMS_PATTERN, "%{public}s lane full, depth: %{public}zu, drop: %{public}s",
+            LANE_NAMES[static_cast<size_t>(lane)], curLane.pendingTasks.size(), taskName.c_str());
+        return false;
+    }
+    uint64_t sequence = ++curLane.sequence;
+    curLane.pendingTasks[taskName] = sequence;
+    curLane.stat.submitted++;
+    curLane.stat.depth = static_cast<uint32_t>(curLane.pendingTasks.size());
+    curLane.stat.maxDepth = std::max(curLane.stat.maxDepth, curLane.stat.depth);
+    auto laneTask = [this, lane, taskName, sequence, task = std::move(task)] {
+        OnTaskStart(lane, taskName, sequence);
+        task();
+    };
+    curLane.ffrtHelper->SubmitTask(std::move(laneTask), taskName);
+    return true;
+}
+
+void WSSnapshotPipeline::OnTaskStart(SnapshotLane lane, const std::string& taskName, uint64_t sequence)
+{
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    auto& curLane = lanes_[static_cast<size_t>(lane)];
+    auto iter = curLane.pendingTasks.find(taskName);
+    if (iter != curLane.pendingTasks.end() && iter->second == sequence) {
+        curLane.pendingTasks.erase(iter);
+        curLane.stat.depth = static_cast<uint32_t>(curLane.pendingTasks.size());
+        // capture tasks are named per capture, a started task must not stay in the helper for good
+        curLane.ffrtHelper->ReleaseTask(taskName);
+    }
+}
+
+void WSSnapshotPipeline::CancelTask(SnapshotLane lane, const std::string& taskName)
+{
+    if (lane >= SnapshotLane::COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    auto& curLane = lanes_[static_cast<size_t>(lane)];
+    if (curLane.pendingTasks.erase(taskName) == 0) {
+        return;
+    }
+    curLane.ffrtHelper->CancelTask(taskName);
+    curLane.stat.depth = static_cast<uint32_t>(curLane.pendingTasks.size());
+}
+
+void WSSnapshotPipeline::SetQueueDepthLimit(SnapshotLane lane, uint32_t depthLimit)
+{
+    if (lane >= SnapshotLane::COUNT || depthLimit == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    lanes_[static_cast<size_t>(lane)].stat.depthLimit = depthLimit;
+}
+
+uint32_t WSSnapshotPipeline::GetQueueDepth(SnapshotLane lane) const
+{
+    if (lane >= SnapshotLane::COUNT) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    return static_cast<uint32_t>(lanes_[static_cast<size_t>(lane)].pendingTasks.size());
+}
+
+uint64_t WSSnapshotPipeline::CaptureAsync(const SnapshotCaptureKey& key, SnapshotCaptureStarter&& starter,
+    SnapshotCaptureCallback&& callback, uint32_t timeoutMs)
+{
+    if (!starter || !callback || timeoutMs == 0) {
+        return 0;
+    }
+    std::vector<uint64_t> runCaptures;
+    uint64_t handle = 0;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        handle = ++captureSequence_;
+        captureStat_.requested++;
+        auto iter = keyCaptures_.find(key);
+        // a started capture may already hold an older frame, only a capture still waiting for its start is shared
+        if (iter != keyCaptures_.end() && captures_[iter->second].starter) {
+            captures_[iter->second].callbacks.emplace_back(handle, std::move(callback));
+            handleCaptures_[handle] = iter->second;
+            captureStat_.deduplicated++;
+            return handle;
+        }
+        uint64_t captureId = handle;
+        auto& capture = captures_[captureId];
+        capture.key = key;
+        capture.starter = std::move(starter);
+        capture.callbacks.emplace_back(handle, std::move(callback));
+        capture.timeoutMs = timeoutMs;
+        keyCaptures_[key] = captureId;
+        handleCaptures_[handle] = captureId;
+        waitingCaptures_.push_back(captureId);
+        RunWaitingCapturesLocked(runCaptures);
+    }
+    LaunchCaptures(runCaptures);
+    return handle;
+}
+
+void WSSnapshotPipeline::RunWaitingCapturesLocked(std::vector<uint64_t>& runCaptures)
+{
+    while (captureStat_.running < captureConcurrency_ && !waitingCaptures_.empty()) {
+        uint64_t captureId = waitingCaptures_.front();
+        waitingCaptures_.pop_front();
+        auto iter = captures_.find(captureId);
+        if (iter == captures_.end()) {
+            continue;
+        }
+        auto& capture = iter->second;
+        capture.isRunning = true;
+        capture.startTimeUs = GetSteadyTimeUs();
+        captureStat_.running++;
+        captureTimer_->SubmitTask([this, captureId] { CompleteCapture(captureId, nullptr, true); },
+            CAPTURE_TIMEOUT_TASK_NAME + std::to_string(captureId), capture.timeoutMs);
+        runCaptures.push_back(captureId);
+    }
+    captureStat_.waiting = static_cast<uint32_t>(waitingCaptures_.size());
+}
+
+void WSSnapshotPipeline::LaunchCaptures(const std::vector<uint64_t>& runCaptures)
+{
+    for (auto captureId : runCaptures) {
+        auto task = [this, captureId] { StartCapture(captureId); };
+        if (!SubmitTask(SnapshotLane::INTERACTIVE, std::move(task),
+            CAPTURE_START_TASK_NAME + std::to_string(captureId))) {
+            CompleteCapture(captureId, nullptr, false);
+        }
+    }
+}
+
+void WSSnapshotPipeline::StartCapture(uint64_t captureId)
+{
+    SnapshotCaptureStarter starter;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        auto iter = captures_.find(captureId);
+        if (iter == captures_.end() || !iter->second.starter) {
+            return;
+        }
+        starter = std::move(iter->second.starter);
+        iter->second.starter = nullptr;
+    }
+    bool ret = starter([this, captureId](const std::shared_ptr<Media::PixelMap>& pixelMap) {
+        CompleteCapture(captureId, pixelMap, false);
+    });
+    if (!ret) {
+        TLOGW(WmsLogTag::WMS_PATTERN, "start capture failed, captureId: %{public}" PRIu64, captureId);
+        CompleteCapture(captureId, nullptr, false);
+    }
+}
+
+void WSSnapshotPipeline::CompleteCapture(uint64_t captureId, const std::shared_ptr<Media::PixelMap>& pixelMap,
+    bool isTimeout)
+{
+    std::vector<std::pair<uint64_t, SnapshotCaptureCallback>> callbacks;
+    std::vector<uint64_t> runCaptures;
+    int64_t costUs = 0;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        auto iter = captures_.find(captureId);
+        if (iter == captures_.end()) {
+            return;
+        }
+        auto& capture = iter->second;
+        if (isTimeout) {
+            captureTimer_->ReleaseTask(CAPTURE_TIMEOUT_TASK_NAME + std::to_string(captureId));
+            captureStat_.timeout++;
+            TLOGW(WmsLogTag::WMS_PATTERN, "capture timeout, id: %{public}d", capture.key.persistentId);
+        } else if (capture.isRunning) {
+            captureTimer_->CancelTask(CAPTURE_TIMEOUT_TASK_NAME + std::to_string(captureId));
+        }
+        costUs = GetSteadyTimeUs() - capture.startTimeUs;
+        callbacks = std::move(capture.callbacks);
+        for (const auto& callback : callbacks) {
+            handleCaptures_.erase(callback.first);
+        }
+        auto keyIter = keyCaptures_.find(capture.key);
+        if (keyIter != keyCaptures_.end() && keyIter->second == captureId) {
+            keyCaptures_.erase(keyIter);
+        }
+        if (capture.isRunning) {
+            captureStat_.running--;
+        }
+        captures_.erase(iter);
+        RunWaitingCapturesLocked(runCaptures);
+    }
+    if (pixelMap != nullptr) {
+        RecordStageCost(SnapshotStage::CAPTURE, costUs);
+    }
+    LaunchCaptures(runCaptures);
+    for (const auto& [handle, callback] : callbacks) {
+        NotifyCaptured(handle, callback, pixelMap);
+    }
+}
+
+void WSSnapshotPipeline::NotifyCaptured(uint64_t handle, const SnapshotCaptureCallback& callback,
+    const std::shared_ptr<Media::PixelMap>& pixelMap)
+{
+    // the thread completing a capture may belong to render service or to the timer, keep callers off it
+    if (!SubmitTask(SnapshotLane::INTERACTIVE, [callback, pixelMap] { callback(pixelMap); },
+        CAPTURE_DONE_TASK_NAME + std::to_string(handle))) {
+        callback(pixelMap);
+    }
+}
+
+bool WSSnapshotPipeline::CancelCapture(uint64_t handle)
+{
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    auto handleIter = handleCaptures_.find(handle);
+    if (handleIter == handleCaptures_.end()) {
+        return false;
+    }
+    uint64_t captureId = handleIter->second;
+    handleCaptures_.erase(handleIter);
+    captureStat_.cancelled++;
+    auto iter = captures_.find(captureId);
+    if (iter == captures_.end()) {
+        return true;
+    }
+    auto& capture = iter->second;
+    capture.callbacks.erase(std::remove_if(capture.callbacks.begin(), capture.callbacks.end(),
+        [handle](const auto& callback) { return callback.first == handle; }), capture.callbacks.end());
+    if (!capture.callbacks.empty() || capture.isRunning) {
+        return true;
+    }
+    waitingCaptures_.erase(std::remove(waitingCaptures_.begin(), waitingCaptures_.end(), captureId),
+        waitingCaptures_.end());
+    captureStat_.waiting = static_cast<uint32_t>(waitingCaptures_.size());
+    auto keyIter = keyCaptures_.find(capture.key);
+    if (keyIter != keyCaptures_.end() && keyIter->second == captureId) {
+        keyCaptures_.erase(keyIter);
+    }
+    captures_.erase(iter);
+    return true;
+}
+
+void WSSnapshotPipeline::SetCaptureConcurrency(uint32_t captureConcurrency)
+{
+    if (captureConcurrency == 0) {
+        return;
+    }
+    std::vector<uint64_t> runCaptures;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        captureConcurrency_ = captureConcurrency;
+        RunWaitingCapturesLocked(runCaptures);
+    }
+    LaunchCaptures(runCaptures);
+}
+
+SnapshotCaptureStat WSSnapshotPipeline::GetCaptureStat() const
+{
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    return captureStat_;
+}
+
+std::shared_ptr<Media::PixelMap> WSSnapshotPipeline::Downscale(const std::shared_ptr<Media::PixelMap>& pixelMap,
+    uint32_t maxLongSide)
+{
+    if (pixelMap == nullptr || maxLongSide == 0) {
+        return pixelMap;
+    }
+    int32_t width = pixelMap->GetWidth();
+    int32_t height = pixelMap->GetHeight();
+    int32_t longSide = std::max(width, height);
+    if (width <= 0 || height <= 0 || static_cast<uint32_t>(longSide) <= maxLongSide) {
+        return pixelMap;
+    }
+    SnapshotStageTimer timer(SnapshotStage::DOWNSCALE);
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SnapshotDownscale %dx%d", width, height);
+    float scale = static_cast<float>(maxLongSide) / static_cast<float>(longSide);
+    Media::InitializationOptions opts;
+    opts.size.width = std::max(1, static_cast<int32_t>(width * scale));
+    opts.size.height = std::max(1, static_cast<int32_t>(height * scale));
+    opts.pixelFormat = pixelMap->GetPixelFormat();
+    opts.alphaType = pixelMap->GetAlphaType();
+    opts.scaleMode = Media::ScaleMode::FIT_TARGET_SIZE;
+    std::shared_ptr<Media::PixelMap> scaledPixelMap = Media::PixelMap::Create(*pixelMap, opts);
+    if (scaledPixelMap == nullptr) {
+        TLOGW(WmsLogTag::WMS_PATTERN, "downscale failed, keep %{public}dx%{public}d", width, height);
+        return pixelMap;
+    }
+    return scaledPixelMap;
+}
+
+void WSSnapshotPipeline::RecordStageCost(SnapshotStage stage, int64_t costUs)
+{
+    if (stage >= SnapshotStage::COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(stageStatMutex_);
+    auto& stat = stageStats_[static_cast<size_t>(stage)];
+    stat.count++;
+    stat.totalCostUs += costUs;
+    stat.maxCostUs = std::max(stat.maxCostUs, costUs);
+    stat.lastCostUs = costUs;
+}
+
+SnapshotStageStat WSSnapshotPipeline::GetStageStat(SnapshotStage stage) const
+{
+    if (stage >= SnapshotStage::COUNT) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(stageStatMutex_);
+    return stageStats_[static_cast<size_t>(stage)];
+}
+
+SnapshotLaneStat WSSnapshotPipeline::GetLaneStat(SnapshotLane lane) const
+{
+    if (lane >= SnapshotLane::COUNT) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    return lanes_[static_cast<size_t>(lane)].stat;
+}
+
+void WSSnapshotPipeline::ResetStat()
+{
+    {
+        std::lock_guard<std::mutex> lock(stageStatMutex_);
+        stageStats_.fill({});
+    }
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        uint32_t running = captureStat_.running;
+        uint32_t waiting = captureStat_.waiting;
+        captureStat_ = {};
+        captureStat_.running = running;
+        captureStat_.waiting = waiting;
+    }
+    std::lock_guard<std::mutex> lock(laneMutex_);
+    for (auto& lane : lanes_) {
+        uint32_t depthLimit = lane.stat.depthLimit;
+        lane.stat = {};
+        lane.stat.depthLimit = depthLimit;
+        lane.stat.depth = static_cast<uint32_t>(lane.pendingTasks.size());
+    }
+}
+
+void WSSnapshotPipeline::DumpInfo(std::string& dumpInfo) const
+{
+    std::ostringstream oss;
+    oss << "Snapshot pipeline:" << std::endl;
+    DumpRow(oss, "Lane", { "Submitted", "Coalesced", "Rejected", "Depth", "MaxDepth", "Limit" });
+    for (size_t i = 0; i < lanes_.size(); i++) {
+        auto stat = GetLaneStat(static_cast<SnapshotLane>(i));
+        DumpRow(oss, LANE_NAMES[i], { std::to_string(stat.submitted), std::to_string(stat.coalesced),
+            std::to_string(stat.rejected), std::to_string(stat.depth), std::to_string(stat.maxDepth),
+            std::to_string(stat.depthLimit) });
+    }
+    DumpRow(oss, "Stage", { "Count", "Avg(us)", "Max(us)", "Last(us)" });
+    for (size_t i = 0; i < stageStats_.size(); i++) {
+        auto stat = GetStageStat(static_cast<SnapshotStage>(i));
+        int64_t avg = stat.count == 0 ? 0 : stat.totalCostUs / static_cast<int64_t>(stat.count);
+        DumpRow(oss, STAGE_NAMES[i], { std::to_string(stat.count), std::to_string(avg),
+            std::to_string(stat.maxCostUs), std::to_string(stat.lastCostUs) });
+    }
+    auto captureStat = GetCaptureStat();
+    DumpRow(oss, "Capture", { "Requested", "Deduplicated", "Cancelled", "Timeout", "Running", "Waiting" });
+    DumpRow(oss, "capture", { std::to_string(captureStat.requested), std::to_string(captureStat.deduplicated),
+        std::to_string(captureStat.cancelled), std::to_string(captureStat.timeout), std::to_string(captureStat.running),
+        std::to_string(captureStat.waiting) });
+    dumpInfo.append(oss.str());
+}
+
+SnapshotStageTimer::SnapshotStageTimer(SnapshotStage stage) : stage_(stage), startTimeUs_(GetSteadyTimeUs())
+{
+}
+
+SnapshotStageTimer::~SnapshotStageTimer()
+{
+    WSSnapshotPipeline::GetInstance().RecordStageCost(stage_, GetSteadyTimeUs() - startTimeUs_);
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "session/host/include/ws_snapshot_policy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <parameters.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS::Rosen {
+namespace {
+constexpr const char* ASTC_IMAGE_FORMAT_LOW = "image/astc/8*8";
+constexpr const char* ASTC_IMAGE_FORMAT_HIGH = "image/astc/4*4";
+constexpr const char* ASTC_IMAGE_SUFFIX = ".astc";
+constexpr uint8_t ASTC_IMAGE_QUALITY = 20;
+constexpr const char* IMAGE_FORMAT = "image/png";
+constexpr const char* IMAGE_SUFFIX = ".png";
+constexpr uint8_t IMAGE_QUALITY = 100;
+
+constexpr uint32_t DEFAULT_PHONE_THUMBNAIL_LONG_SIDE_VP = 320;
+constexpr uint32_t DEFAULT_PC_THUMBNAIL_LONG_SIDE_VP = 240;
+constexpr uint64_t DEFAULT_DISK_BUDGET_KB = 128 * 1024;
+constexpr uint64_t KB = 1024;
+
+uint64_t GetFileSize(const std::string& path)
+{
+    struct stat buf;
+    if (stat(path.c_str(), &buf) != 0 || !S_ISREG(buf.st_mode)) {
+        return 0;
+    }
+    return static_cast<uint64_t>(buf.st_size);
+}
+} // namespace
+
+WSSnapshotPolicy& WSSnapshotPolicy::GetInstance()
+{
+    static WSSnapshotPolicy instance;
+    return instance;
+}
+
+WSSnapshotPolicy::WSSnapshotPolicy()
+{
+    phoneThumbnailLongSideVp_ = system::GetUintParameter<uint32_t>(
+        "persist.window.snapshot.thumbnail_vp", DEFAULT_PHONE_THUMBNAIL_LONG_SIDE_VP);
+    pcThumbnailLongSideVp_ = system::GetUintParameter<uint32_t>(
+        "persist.window.snapshot.pc_thumbnail_vp", DEFAULT_PC_THUMBNAIL_LONG_SIDE_VP);
+    diskBudget_ = system::GetUintParameter<uint64_t>(
+        "persist.window.snapshot.disk_budget_kb", DEFAULT_DISK_BUDGET_KB) * KB;
+}
+
+void WSSnapshotPolicy::SetThumbnailLongSideVp(uint32_t phoneLongSideVp, uint32_t pcLongSideVp)
+{
+    phoneThumbnailLongSideVp_ = phoneLongSideVp;
+    pcThumbnailLongSideVp_ = pcLongSideVp;
+}
+
+/** @return thumbnail long side in px, 0 means no thumbnail tier */
+uint32_t WSSnapshotPolicy::GetThumbnailLongSide(bool isPcWindow, float density) const
+{
+    uint32_t longSideVp = isPcWindow ? pcThumbnailLongSideVp_ : phoneThumbnailLongSideVp_;
+    if (density <= 0.0f) {
+        density = 1.0f;
+    }
+    return static_cast<uint32_t>(std::lround(longSideVp * density));
+}
+
+SnapshotFormat WSSnapshotPolicy::GetFormat(SnapshotTier tier, bool isAstcEnabled, bool isPcWindow)
+{
+    if (!isAstcEnabled) {
+        return { IMAGE_FORMAT, IMAGE_SUFFIX, IMAGE_QUALITY };
+    }
+    // thumbnails are viewed small, the low precision block is enough
+    bool useLowFormat = isPcWindow || tier == SnapshotTier::THUMBNAIL;
+    return { useLowFormat ? ASTC_IMAGE_FORMAT_LOW : ASTC_IMAGE_FORMAT_HIGH, ASTC_IMAGE_SUFFIX, ASTC_IMAGE_QUALITY };
+}
+
+/**
+ * Whether the thumbnail has enough pixels for a decode of the full snapshot scaled by newScale / oriScale.
+ */
+bool WSSnapshotPolicy::IsThumbnailEnough(uint32_t thumbnailLongSide, uint32_t fullLongSide,
+    float oriScale, float newScale)
+{
+    if (thumbnailLongSide == 0 || fullLongSide == 0 || oriScale <= 0.0f || newScale >= oriScale) {
+        return false;
+    }
+    float desiredLongSide = fullLongSide * newScale / oriScale;
+    return desiredLongSide <= static_cast<float>(thumbnailLongSide);
+}
+
+void WSSnapshotPolicy::SetDiskBudget(uint64_t budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    diskBudget_ = budgetBytes;
+}
+
+uint64_t WSSnapshotPolicy::GetDiskBudget() const
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    return diskBudget_;
+}
+
+uint64_t WSSnapshotPolicy::GetDiskUsage() const
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    return diskUsage_;
+}
+
+/**
+ * Seeds the usage with files left by a previous run, oldest modification first.
+ */
+void WSSnapshotPolicy::LoadDiskUsage(const std::string& directory)
+{
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        TLOGW(WmsLogTag::WMS_PATTERN, "open dir failed");
+        return;
+    }
+    std::vector<std::pair<time_t, FileEntry>> files;
+    while (struct dirent* ent = readdir(dir)) {
+        std::string name = ent->d_name;
+        std::string path = directory + name;
+        struct stat buf;
+        if (stat(path.c_str(), &buf) != 0 || !S_ISREG(buf.st_mode)) {
+            continue;
+        }
+        SnapshotTier tier = name.find(THUMBNAIL_TAG) != std::string::npos ?
+            SnapshotTier::THUMBNAIL : SnapshotTier::FULL;
+        files.push_back({ buf.st_mtime, { path, tier, static_cast<uint64_t>(buf.st_size), nullptr } });
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    for (const auto& [_, entry] : files) {
+        if (lruMap_.find(entry.path) == lruMap_.end()) {
+            TouchLocked(entry.path, entry.tier, entry.size, nullptr);
+        }
+    }
+    TLOGI(WmsLogTag::WMS_PATTERN, "files: %{public}zu, usage: %{public}" PRIu64 ", budget: %{public}" PRIu64,
+        lruList_.size(), diskUsage_, diskBudget_);
+}
+
+void WSSnapshotPolicy::OnFileWritten(const std::string& path, SnapshotTier tier, const EvictFunc& evictFunc)
+{
+    uint64_t size = GetFileSize(path);
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    TouchLocked(path, tier, size, evictFunc);
+}
+
+void WSSnapshotPolicy::OnFileAccessed(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    auto iter = lruMap_.find(path);
+    if (iter == lruMap_.end()) {
+        return;
+    }
+    lruList_.splice(lruList_.begin(), lruList_, iter->second);
+}
+
+void WSSnapshotPolicy::OnFileRemoved(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    RemoveLocked(path);
+}
+
+void WSSnapshotPolicy::OnFileRenamed(const std::string& oldPath, const std::string& newPath,
+    const EvictFunc& evictFunc)
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    auto iter = lruMap_.find(oldPath);
+    if (iter == lruMap_.end()) {
+        return;
+    }
+    FileEntry entry = *iter->second;
+    RemoveLocked(oldPath);
+    TouchLocked(newPath, entry.tier, entry.size, evictFunc ? evictFunc : entry.evictFunc);
+}
+
+/**
+ * Claims a file found on disk at startup for the session restored on top of it.
+ */
+void WSSnapshotPolicy::SetFileOwner(const std::string& path, const EvictFunc& evictFunc)
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    auto iter = lruMap_.find(path);
+    if (iter == lruMap_.end()) {
+        return;
+    }
+    iter->second->evictFunc = evictFunc;
+}
+
+bool WSSnapshotPolicy::IsFileTracked(const std::string& path) const
+{
+    std::lock_guard<std::mutex> lock(diskMutex_);
+    return lruMap_.find(path) != lruMap_.end();
+}
+
+std::vector<std::string> WSSnapshotPolicy::EnforceDiskBudget()
+{
+    std::vector<FileEntry> victims;
+    {
+        std::lock_guard<std::mutex> lock(diskMutex_);
+        if (diskBudget_ == 0 || diskUsage_ <= diskBudget_) {
+            return {};
+        }
+        for (auto tier : { SnapshotTier::FULL, SnapshotTier::THUMBNAIL }) {
+            // walk from the least recently used end, erasing cur keeps iter valid
+            for (auto iter = lruList_.end(); iter != lruList_.begin() && diskUsage_ > diskBudget_;) {
+                auto cur = std::prev(iter);
+                if (cur->tier != tier) {
+                    iter = cur;
+                    continue;
+                }
+                victims.push_back(*cur);
+                RemoveLocked(victims.back().path);
+            }
+        }
+    }
+    // owners take their own lock, calling them under diskMutex_ would invert the save path lock order
+    std::vector<std::string> evictedPaths;
+    for (const auto& victim : victims) {
+        if (victim.evictFunc) {
+            victim.evictFunc(victim.path);
+        } else {
+            remove(victim.path.c_str());
+        }
+        evictedPaths.push_back(victim.path);
+    }
+    TLOGI(WmsLogTag::WMS_PATTERN, "evicted: %{public}zu, usage: %{public}" PRIu64,
+        evictedPaths.size(), GetDiskUsage());
+    return evictedPaths;
+}
+
+void WSSnapshotPolicy::TouchLocked(const std::string& path, SnapshotTier tier, uint64_t size,
+    const EvictFunc& evictFunc)
+{
+    RemoveLocked(path);
+    if (size == 0) {
+        return;
+    }
+    lruList_.push_front({ path, tier, size, evictFunc });
+    lruMap_[path] = lruList_.begin();
+    diskUsage_ += size;
+}
+
+void WSSnapshotPolicy::RemoveLocked(const std::string& path)
+{
+    auto iter = lruMap_.find(path);
+    if (iter == lruMap_.end()) {
+        return;
+    }
+    diskUsage_ -= std::min(diskUsage_, iter->second->size);
+    lruList_.erase(iter->second);
+    lruMap_.erase(iter);
+}
+} // namespace OHOS::Rosen
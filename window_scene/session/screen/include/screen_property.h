@@ -16,6 +16,8 @@
 #ifndef OHOS_ROSEN_WINDOW_SCENE_SCREEN_PROPERTY_H
 #define OHOS_ROSEN_WINDOW_SCENE_SCREEN_PROPERTY_H
 
+#include <atomic>
+
 #include "common/rs_rect.h"
 #include "dm_common.h"
 #include "class_var_definition.h"
@@ -182,6 +184,7 @@ public:
 
     void SetAvailableArea(DMRect area)
     {
+        generation_ = ++globalGeneration_;
         availableArea_ = area;
     }
 
@@ -202,6 +205,7 @@ public:
 
     void SetCreaseRect(DMRect creaseRect)
     {
+        generation_ = ++globalGeneration_;
         creaseRect_ = creaseRect;
     }
 
@@ -253,11 +257,24 @@ public:
     void SetScreenAreaHeight(uint32_t screenAreaHeight) { screenAreaHeight_ = screenAreaHeight; }
     uint32_t GetScreenAreaHeight() const { return screenAreaHeight_; }
 
+    // restamped from the process wide generation by every setter of a field DisplayInfo or the MMI window
+    // transform is built from
+    uint64_t GetGeneration() const { return generation_; }
+
+    /*
+     * Changes whenever any screen property of the process changes, or a screen is added, replaced or removed.
+     * Values derived from several screens may be cached against it with one load.
+     */
+    static uint64_t GetGlobalGeneration() { return globalGeneration_.load(); }
+    static void BumpGlobalGeneration() { globalGeneration_++; }
+
 private:
     static inline bool IsVertical(Rotation rotation)
     {
         return (rotation == Rotation::ROTATION_0 || rotation == Rotation::ROTATION_180);
     }
+    static std::atomic<uint64_t> globalGeneration_;
+    uint64_t generation_ = 0;
     DisplayGroupId displayGroupId_ = DISPLAY_GROUP_ID_INVALID;
     ScreenId mainDisplayIdOfGroup_ = SCREEN_ID_INVALID;
     float rotation_ { 0.0f };
@@ -111,6 +111,7 @@ public:
     void UnregisterScreenChangeListener(IScreenChangeListener* screenChangeListener);
 
     sptr<DisplayInfo> ConvertToDisplayInfo();
+    sptr<DisplayInfo> GetCachedDisplayInfo();
     sptr<DisplayInfo> ConvertToRealDisplayInfo();
     sptr<ScreenInfo> ConvertToScreenInfo() const;
     sptr<SupportedScreenModes> GetActiveScreenMode() const;
@@ -428,6 +429,16 @@ private:
     void ReportNotifyModeChange(DisplayOrientation displayOrientation);
     sptr<ScreenSession> fakeScreenSession_ = nullptr;
     int32_t GetApiVersion();
+    sptr<DisplayInfo> ConvertToDisplayInfo(bool useDeviceRotation);
+    void InvalidateDisplayInfoCache();
+    struct DisplayInfoCache {
+        sptr<DisplayInfo> displayInfo = nullptr;
+        uint64_t propertyGeneration = 0;
+        uint64_t sessionGeneration = 0;
+    };
+    std::mutex displayInfoCacheMutex_;
+    DisplayInfoCache displayInfoCache_[2]; // 2: device rotation and screen rotation callers
+    std::atomic<uint64_t> displayInfoGeneration_ { 0 };
     void SetScreenSnapshotRect(RSSurfaceCaptureConfig& config);
     bool IsWidthHeightMatch(float width, float height, float targetWidth, float targetHeight);
     std::mutex mirrorScreenRegionMutex_;
@@ -37,8 +37,11 @@ constexpr float EPSILON = 1e-6f;
 constexpr float PPI_TO_DPI = 1.6f;
 }
 
+std::atomic<uint64_t> ScreenProperty::globalGeneration_ { 0 };
+
 void ScreenProperty::SetRotation(float rotation)
 {
+    generation_ = ++globalGeneration_;
     rotation_ = rotation;
 }
 
@@ -49,6 +52,7 @@ float ScreenProperty::GetRotation() const
 
 void ScreenProperty::SetPhysicalRotation(float rotation)
 {
+    generation_ = ++globalGeneration_;
     physicalRotation_ = rotation;
 }
 
@@ -59,6 +63,7 @@ float ScreenProperty::GetPhysicalRotation() const
 
 void ScreenProperty::SetScreenComponentRotation(float rotation)
 {
+    generation_ = ++globalGeneration_;
     screenComponentRotation_ = rotation;
 }
 
@@ -69,6 +74,7 @@ float ScreenProperty::GetScreenComponentRotation() const
 
 void ScreenProperty::SetBounds(const RRect& bounds)
 {
+    generation_ = ++globalGeneration_;
     bounds_ = bounds;
     if (!FoldScreenStateInternel::IsSecondaryDisplayFoldDevice()) {
         physicalTouchBounds_.rect_.width_ = bounds_.rect_.width_;
@@ -107,6 +113,7 @@ bool ScreenProperty::GetIsFakeInUse() const
 
 void ScreenProperty::SetScaleX(float scaleX)
 {
+    generation_ = ++globalGeneration_;
     scaleX_ = scaleX;
 }
 
@@ -117,6 +124,7 @@ float ScreenProperty::GetScaleX() const
 
 void ScreenProperty::SetScaleY(float scaleY)
 {
+    generation_ = ++globalGeneration_;
     scaleY_ = scaleY;
 }
 
@@ -127,6 +135,7 @@ float ScreenProperty::GetScaleY() const
 
 void ScreenProperty::SetPivotX(float pivotX)
 {
+    generation_ = ++globalGeneration_;
     pivotX_ = pivotX;
 }
 
@@ -137,6 +146,7 @@ float ScreenProperty::GetPivotX() const
 
 void ScreenProperty::SetPivotY(float pivotY)
 {
+    generation_ = ++globalGeneration_;
     pivotY_ = pivotY;
 }
 
@@ -147,6 +157,7 @@ float ScreenProperty::GetPivotY() const
 
 void ScreenProperty::SetTranslateX(float translateX)
 {
+    generation_ = ++globalGeneration_;
     translateX_ = translateX;
 }
 
@@ -157,6 +168,7 @@ float ScreenProperty::GetTranslateX() const
 
 void ScreenProperty::SetTranslateY(float translateY)
 {
+    generation_ = ++globalGeneration_;
     translateY_ = translateY;
 }
 
@@ -167,6 +179,7 @@ float ScreenProperty::GetTranslateY() const
 
 void ScreenProperty::SetPhyBounds(const RRect& phyBounds)
 {
+    generation_ = ++globalGeneration_;
     phyBounds_ = phyBounds;
 }
 
@@ -187,6 +200,7 @@ float ScreenProperty::GetDefaultDensity()
 
 void ScreenProperty::SetDefaultDensity(float defaultDensity)
 {
+    generation_ = ++globalGeneration_;
     defaultDensity_ = defaultDensity;
 }
 
@@ -197,6 +211,7 @@ float ScreenProperty::GetDensityInCurResolution() const
 
 void ScreenProperty::SetDensityInCurResolution(float densityInCurResolution)
 {
+    generation_ = ++globalGeneration_;
     densityInCurResolution_ = densityInCurResolution;
 }
 
@@ -248,6 +263,7 @@ void ScreenProperty::SetDpiPhyBounds(uint32_t phyWidth, uint32_t phyHeight)
 
 void ScreenProperty::SetRefreshRate(uint32_t refreshRate)
 {
+    generation_ = ++globalGeneration_;
     refreshRate_ = refreshRate;
 }
 
@@ -278,6 +294,7 @@ std::string ScreenProperty::GetPropertyChangeReason() const
 
 void ScreenProperty::SetVirtualPixelRatio(float virtualPixelRatio)
 {
+    generation_ = ++globalGeneration_;
     virtualPixelRatio_ = virtualPixelRatio;
 }
 
@@ -288,6 +305,7 @@ float ScreenProperty::GetVirtualPixelRatio() const
 
 void ScreenProperty::SetScreenRotation(Rotation rotation)
 {
+    generation_ = ++globalGeneration_;
     bool enableRotation = (system::GetParameter("persist.window.rotation.enabled", "1") == "1");
     if (!enableRotation) {
         return;
@@ -325,6 +343,7 @@ void ScreenProperty::SetScreenRotation(Rotation rotation)
 
 void ScreenProperty::SetRotationAndScreenRotationOnly(Rotation rotation)
 {
+    generation_ = ++globalGeneration_;
     bool enableRotation = (system::GetParameter("persist.window.rotation.enabled", "1") == "1");
     if (!enableRotation) {
         return;
@@ -349,6 +368,7 @@ void ScreenProperty::SetRotationAndScreenRotationOnly(Rotation rotation)
 
 void ScreenProperty::UpdateScreenRotation(Rotation rotation)
 {
+    generation_ = ++globalGeneration_;
     screenRotation_ = rotation;
 }
 
@@ -359,6 +379,7 @@ Rotation ScreenProperty::GetScreenRotation() const
 
 void ScreenProperty::UpdateDeviceRotation(Rotation rotation)
 {
+    generation_ = ++globalGeneration_;
     deviceRotation_ = rotation;
 }
 
@@ -369,6 +390,7 @@ Rotation ScreenProperty::GetDeviceRotation() const
 
 void ScreenProperty::SetOrientation(Orientation orientation)
 {
+    generation_ = ++globalGeneration_;
     orientation_ = orientation;
 }
 
@@ -379,6 +401,7 @@ Orientation ScreenProperty::GetOrientation() const
 
 void ScreenProperty::SetDisplayState(DisplayState displayState)
 {
+    generation_ = ++globalGeneration_;
     displayState_ = displayState;
 }
 
@@ -389,6 +412,7 @@ DisplayState ScreenProperty::GetDisplayState() const
 
 void ScreenProperty::SetDisplayOrientation(DisplayOrientation displayOrientation)
 {
+    generation_ = ++globalGeneration_;
     displayOrientation_ = displayOrientation;
 }
 
@@ -399,6 +423,7 @@ DisplayOrientation ScreenProperty::GetDisplayOrientation() const
 
 void ScreenProperty::SetDeviceOrientation(DisplayOrientation displayOrientation)
 {
+    generation_ = ++globalGeneration_;
     deviceOrientation_ = displayOrientation;
 }
 
@@ -409,6 +434,7 @@ DisplayOrientation ScreenProperty::GetDeviceOrientation() const
 
 void ScreenProperty::UpdateXDpi()
 {
+    generation_ = ++globalGeneration_;
     if (dpiPhyWidth_ != UINT32_MAX) {
         int32_t width = phyBounds_.rect_.width_;
         xDpi_ = width * INCH_2_MM / dpiPhyWidth_;
@@ -418,6 +444,7 @@ void ScreenProperty::UpdateXDpi()
 
 void ScreenProperty::UpdateYDpi()
 {
+    generation_ = ++globalGeneration_;
     if (dpiPhyHeight_ != UINT32_MAX) {
         int32_t height_ = phyBounds_.rect_.height_;
         yDpi_ = height_ * INCH_2_MM / dpiPhyHeight_;
@@ -427,6 +454,7 @@ void ScreenProperty::UpdateYDpi()
 
 void ScreenProperty::UpdateVirtualPixelRatio(const RRect& bounds)
 {
+    generation_ = ++globalGeneration_;
     int32_t width = bounds.rect_.width_;
     int32_t height = bounds.rect_.height_;
 
@@ -440,6 +468,7 @@ void ScreenProperty::UpdateVirtualPixelRatio(const RRect& bounds)
 
 void ScreenProperty::CalcDefaultDisplayOrientation()
 {
+    generation_ = ++globalGeneration_;
     if (bounds_.rect_.width_ > bounds_.rect_.height_) {
         displayOrientation_ = DisplayOrientation::LANDSCAPE;
         deviceOrientation_ = DisplayOrientation::LANDSCAPE;
@@ -451,6 +480,7 @@ void ScreenProperty::CalcDefaultDisplayOrientation()
 
 void ScreenProperty::CalculateXYDpi(uint32_t phyWidth, uint32_t phyHeight)
 {
+    generation_ = ++globalGeneration_;
     if (phyWidth == 0 || phyHeight == 0) {
         return;
     }
@@ -477,6 +507,7 @@ float ScreenProperty::GetYDpi() const
 
 void ScreenProperty::SetOffsetX(int32_t offsetX)
 {
+    generation_ = ++globalGeneration_;
     offsetX_ = offsetX;
 }
 
@@ -487,6 +518,7 @@ int32_t ScreenProperty::GetOffsetX() const
 
 void ScreenProperty::SetOffsetY(int32_t offsetY)
 {
+    generation_ = ++globalGeneration_;
     offsetY_ = offsetY;
 }
 
@@ -517,6 +549,7 @@ uint32_t ScreenProperty::GetMirrorHeight() const
 
 void ScreenProperty::SetOffset(int32_t offsetX, int32_t offsetY)
 {
+    generation_ = ++globalGeneration_;
     offsetX_ = offsetX;
     offsetY_ = offsetY;
 }
@@ -569,6 +602,7 @@ Orientation ScreenProperty::GetScreenRequestedOrientation() const
 
 void ScreenProperty::SetDefaultDeviceRotationOffset(uint32_t defaultRotationOffset)
 {
+    generation_ = ++globalGeneration_;
     defaultDeviceRotationOffset_ = defaultRotationOffset;
 }
 
@@ -579,6 +613,7 @@ uint32_t ScreenProperty::GetDefaultDeviceRotationOffset() const
 
 void ScreenProperty::SetScreenShape(ScreenShape screenShape)
 {
+    generation_ = ++globalGeneration_;
     screenShape_ = screenShape;
 }
 
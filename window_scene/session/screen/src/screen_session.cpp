@@ -328,6 +328,41 @@ void ScreenSession::EnableMirrorScreenRegion()
 }
 
 sptr<DisplayInfo> ScreenSession::ConvertToDisplayInfo()
+{
+    int32_t apiVersion = GetApiVersion();
+    return ConvertToDisplayInfo(apiVersion >= 14 || apiVersion == 0); // 14 is API version
+}
+
+/*
+ * The returned DisplayInfo is shared by all callers until the screen changes, it must not be modified.
+ * Callers below API 14 see the screen rotation instead of the device rotation, so each kind has its own entry.
+ */
+sptr<DisplayInfo> ScreenSession::GetCachedDisplayInfo()
+{
+    int32_t apiVersion = GetApiVersion();
+    bool useDeviceRotation = (apiVersion >= 14 || apiVersion == 0); // 14 is API version
+    // stamps are taken before the build, a change racing with it leaves the entry stale rather than wrong
+    uint64_t propertyGeneration = property_.GetGeneration();
+    uint64_t sessionGeneration = displayInfoGeneration_.load();
+    std::lock_guard<std::mutex> lock(displayInfoCacheMutex_);
+    auto& cache = displayInfoCache_[useDeviceRotation ? 0 : 1];
+    if (cache.displayInfo != nullptr && cache.propertyGeneration == propertyGeneration &&
+        cache.sessionGeneration == sessionGeneration) {
+        return cache.displayInfo;
+    }
+    cache.displayInfo = ConvertToDisplayInfo(useDeviceRotation);
+    cache.propertyGeneration = propertyGeneration;
+    cache.sessionGeneration = sessionGeneration;
+    return cache.displayInfo;
+}
+
+void ScreenSession::InvalidateDisplayInfoCache()
+{
+    displayInfoGeneration_++;
+    ScreenProperty::BumpGlobalGeneration();
+}
+
+sptr<DisplayInfo> ScreenSession::ConvertToDisplayInfo(bool useDeviceRotation)
 {
     sptr<DisplayInfo> displayInfo = new(std::nothrow) DisplayInfo();
     if (displayInfo == nullptr) {
@@ -362,8 +397,7 @@ sptr<DisplayInfo> ScreenSession::ConvertToDisplayInfo()
     displayInfo->SetXDpi(property_.GetXDpi());
     displayInfo->SetYDpi(property_.GetYDpi());
     displayInfo->SetDpi(property_.GetVirtualPixelRatio() * DOT_PER_INCH);
-    int32_t apiVersion = GetApiVersion();
-    if (apiVersion >= 14 || apiVersion == 0) { // 14 is API version
+    if (useDeviceRotation) {
         displayInfo->SetRotation(property_.GetDeviceRotation());
         displayInfo->SetDisplayOrientation(property_.GetDeviceOrientation());
     } else {
@@ -532,6 +566,7 @@ bool ScreenSession::GetIsPcUse()
 void ScreenSession::SetIsFakeSession(bool isFakeSession)
 {
     isFakeSession_ = isFakeSession;
+    InvalidateDisplayInfoCache();
 }
 
 void ScreenSession::SetValidHeight(uint32_t validHeight)
@@ -577,6 +612,7 @@ uint32_t ScreenSession::GetPointerActiveHeight()
 void ScreenSession::SetIsBScreenHalf(bool isBScreenHalf)
 {
     isBScreenHalf_ = isBScreenHalf;
+    InvalidateDisplayInfoCache();
 }
 
 bool ScreenSession::GetIsBScreenHalf() const
@@ -602,6 +638,7 @@ std::string ScreenSession::GetName()
 void ScreenSession::SetName(std::string name)
 {
     name_ = name;
+    InvalidateDisplayInfoCache();
 }
 
 std::string ScreenSession::GetInnerName()
@@ -783,6 +820,7 @@ void ScreenSession::PropertyChange(const ScreenProperty& newProperty, ScreenProp
 {
     std::lock_guard<std::mutex> lock(screenChangeListenerListMutex_);
     property_ = newProperty;
+    InvalidateDisplayInfoCache();
     if (reason == ScreenPropertyChangeReason::VIRTUAL_PIXEL_RATIO_CHANGE) {
         return;
     }
@@ -2219,12 +2257,14 @@ void ScreenSession::SetHdrFormats(std::vector<uint32_t>&& hdrFormats)
 {
     std::unique_lock<std::shared_mutex> lock(hdrFormatsMutex_);
     hdrFormats_ = std::move(hdrFormats);
+    InvalidateDisplayInfoCache();
 }
 
 void ScreenSession::SetColorSpaces(std::vector<uint32_t>&& colorSpaces)
 {
     std::unique_lock<std::shared_mutex> lock(colorSpacesMutex_);
     colorSpaces_ = std::move(colorSpaces);
+    InvalidateDisplayInfoCache();
 }
 
 std::vector<uint32_t> ScreenSession::GetColorSpaces()
@@ -2237,6 +2277,7 @@ void ScreenSession::SetSupportedRefreshRate(std::vector<uint32_t>&& supportedRef
 {
     std::unique_lock<std::shared_mutex> lock(supportedRefreshRateMutex_);
     supportedRefreshRate_ = std::move(supportedRefreshRate);
+    InvalidateDisplayInfoCache();
 }
 
 std::vector<uint32_t> ScreenSession::GetSupportedRefreshRate() const
@@ -2590,6 +2631,7 @@ void ScreenSession::SetScreenProperty(ScreenProperty property)
 {
     std::lock_guard<std::mutex> lock(propertyMutex_);
     property_ = property;
+    InvalidateDisplayInfoCache();
 }
 
 std::vector<sptr<SupportedScreenModes>> ScreenSession::GetScreenModes()
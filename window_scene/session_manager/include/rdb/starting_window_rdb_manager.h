@@ -17,7 +17,9 @@
 #define OHOS_ROSEN_WINDOW_SCENE_STARTING_WINDOW_RDB_MANAGER_H
 
 #include <atomic>
+#include <list>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "rdb_helper.h"
@@ -57,16 +59,45 @@ public:
     bool DeleteDataByBundleName(const std::string& bundleName);
     bool DeleteAllData();
     bool QueryData(const StartingWindowRdbItemKey& key, StartingWindowInfo& value);
+    bool QueryDataByBundleNames(const std::vector<std::string>& bundleNames,
+        std::vector<std::pair<StartingWindowRdbItemKey, StartingWindowInfo>>& outValues);
     std::string GetStartWindowValFromProfile(const AppExecFwk::AbilityInfo& abilityInfo,
         const std::shared_ptr<Global::Resource::ResourceManager>& resourceMgr,
         const std::string& key, const std::string& defaultVal);
 
 private:
+    /*
+     * Cached result of a key lookup, isFound is false for keys known to be absent from the store.
+     */
+    struct CacheItem {
+        std::string bundleName;
+        bool isFound = false;
+        StartingWindowInfo info;
+    };
+    using CacheList = std::list<std::pair<std::string, CacheItem>>;
+
     std::shared_ptr<NativeRdb::RdbStore> GetRdbStore();
-    
+    bool GetFromCache(const StartingWindowRdbItemKey& key, bool& isFound, StartingWindowInfo& value);
+    uint64_t GetCacheGeneration();
+    void PutToCache(uint64_t generation, const StartingWindowRdbItemKey& key, bool isFound,
+        const StartingWindowInfo& value);
+    void EraseCache(const std::vector<std::pair<StartingWindowRdbItemKey, StartingWindowInfo>>& values);
+    void EraseCacheByBundleName(const std::string& bundleName);
+    void ClearCache();
+
     std::mutex rdbMutex_;
     std::shared_ptr<NativeRdb::RdbStore> rdbStore_;
     WmsRdbConfig wmsRdbConfig_;
+
+    /*
+     * Bounded lru cache in front of the store, most recently used first. Writers bump the generation
+     * after changing the store, so that a lookup which read the store before the change does not
+     * cache its stale result.
+     */
+    std::mutex cacheMutex_;
+    CacheList cacheList_;
+    std::unordered_map<std::string, CacheList::iterator> cacheMap_;
+    uint64_t cacheGeneration_ = 0;
 };
 } // namespace Rosen
 } // namespace OHOS
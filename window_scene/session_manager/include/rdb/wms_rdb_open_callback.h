@@ -33,6 +33,7 @@ struct WmsRdbConfig {
     std::string tableName { STARTING_WINDOW_TABLE_NAME };
     std::string createTableSql;
     int32_t version { STARTING_WINDOW_RDB_VERSION };
+    bool isMemoryRdb { false };
 };
 
 class WmsRdbOpenCallback : public NativeRdb::RdbOpenCallback {
@@ -23,6 +23,7 @@
 #include "input_manager.h"
 #include "session/host/include/scene_session.h"
 #include "session/screen/include/screen_property.h"
+#include "window_info_flush_scheduler.h"
 #include "wm_common.h"
 #include "wm_single_instance.h"
 
@@ -34,8 +35,10 @@ class SceneInputManager : public std::enable_shared_from_this<SceneInputManager>
 WM_DECLARE_SINGLE_INSTANCE_BASE(SceneInputManager)
 public:
     void Init();
+    // onFlushed runs on the input thread once the infos were sent to MMI or found unchanged
     void FlushDisplayInfoToMMI(std::vector<MMI::WindowInfo>&& windowInfoList,
-        std::vector<std::shared_ptr<Media::PixelMap>>&& pixelMapList, const bool forceFlush = false);
+        std::vector<std::shared_ptr<Media::PixelMap>>&& pixelMapList, const bool forceFlush = false,
+        std::function<void()>&& onFlushed = nullptr);
     void NotifyWindowInfoChange(const sptr<SceneSession>& scenenSession, const WindowUpdateType& type);
     void NotifyWindowInfoChangeFromSession(const sptr<SceneSession>& sceneSession);
     void NotifyMMIWindowPidChange(const sptr<SceneSession>& sceneSession, const bool startMoving);
@@ -43,11 +46,12 @@ public:
     void UpdateConstrainedModalUIExtInfo(const std::map<uint64_t,
         std::vector<SecSurfaceInfo>>& constrainedModalUIExtInfoMap);
     std::optional<ExtensionWindowEventInfo> GetConstrainedModalExtWindowInfo(const sptr<SceneSession>& sceneSession);
-    using FlushWindowInfoCallback = std::function<void()>;
+    using FlushWindowInfoCallback = std::function<void(WindowInfoFlushUrgency urgency)>;
     void RegisterFlushWindowInfoCallback(FlushWindowInfoCallback&& callback);
     void ResetSessionDirty();
     std::pair<std::vector<MMI::WindowInfo>, std::vector<std::shared_ptr<Media::PixelMap>>>
         GetFullWindowInfoList();
+    void DumpInputLayoutCacheInfo(std::string& dumpInfo);
 
     /*
      * Multi User
@@ -74,6 +78,7 @@ private:
     void PrintScreenInfo(const std::vector<MMI::ScreenInfo>& screenInfos);
     void PrintDisplayInfo(const std::vector<MMI::DisplayInfo>& displayInfos);
     void PrintWindowInfo(const std::vector<MMI::WindowInfo>& windowInfoList);
+    void SendDisplayInfoToMMI(std::vector<MMI::WindowInfo>&& windowInfoList, const bool forceFlush);
     void UpdateDisplayAndWindowInfo(const std::vector<MMI::ScreenInfo>& screenInfos,
         std::map<DisplayGroupId, MMI::DisplayGroupInfo>& displayGroupMap,
         std::vector<MMI::WindowInfo> windowInfoList);
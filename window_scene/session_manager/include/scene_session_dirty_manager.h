@@ -18,6 +18,8 @@
 
 
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 #include "common/rs_vector4.h"
 #include "display_manager.h"
@@ -25,6 +27,7 @@
 #include "session/screen/include/screen_session.h"
 #include "screen_session_manager/include/screen_session_manager.h"
 #include "input_manager.h"
+#include "window_info_flush_scheduler.h"
 
 namespace OHOS::Rosen {
 struct SecSurfaceInfo;
@@ -44,6 +47,55 @@ struct SingleHandData {
     SingleHandMode mode = SingleHandMode::MIDDLE;
 };
 
+/*
+ * Stamps of what the MMI transform, hot areas and pointer change areas of a session are computed from.
+ * Screen properties and the fold display mode are covered by the process wide screen generation, the window
+ * type, mode, limits, display and hot areas by the property generation. The rest are plain session fields.
+ */
+struct InputLayoutKey {
+    WSRect windowRect;
+    WSRect globalRect;
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    float pivotX = 0.f;
+    float pivotY = 0.f;
+    int32_t currentRotation = 0;
+    uint64_t screenGeneration = 0;
+    uint64_t propertyGeneration = 0;
+    SingleHandData singleHandData;
+    bool isRotable = false;
+    bool isSystem = false;
+    bool isDragAccessible = false;
+    bool isMidScene = false;
+    bool isSetPointerAreas = false;
+
+    bool operator==(const InputLayoutKey& other) const;
+};
+
+struct InputLayout {
+    Matrix3f transform;
+    std::vector<float> transformData;
+    std::vector<MMI::Rect> touchHotAreas;
+    std::vector<MMI::Rect> pointerHotAreas;
+    std::vector<int32_t> pointerChangeAreas;
+};
+
+/*
+ * Builds count layouts rebuilt into the cache, uncached ones are the keyboard windows built every flush.
+ */
+struct InputLayoutCacheStat {
+    uint64_t lastWindows = 0;
+    uint64_t lastHits = 0;
+    uint64_t lastBuilds = 0;
+    uint64_t lastUncached = 0;
+    uint64_t lastSwept = 0;
+    uint64_t totalHits = 0;
+    uint64_t totalBuilds = 0;
+    uint64_t totalUncached = 0;
+    uint64_t totalSwept = 0;
+    uint64_t entries = 0;
+};
+
 class SceneSessionDirtyManager {
 private:
     enum WindowAction : uint32_t {
@@ -55,7 +107,7 @@ private:
     };
 
 using ScreenInfoChangeListener = std::function<void(int32_t)>;
-using FlushWindowInfoCallback = std::function<void()>;
+using FlushWindowInfoCallback = std::function<void(WindowInfoFlushUrgency urgency)>;
 public:
     SceneSessionDirtyManager() = default;
     virtual ~SceneSessionDirtyManager() = default;
@@ -71,6 +123,8 @@ public:
         std::vector<SecSurfaceInfo>>& constrainedModalUIExtInfoMap);
     bool GetLastConstrainedModalUIExtInfo(const sptr<SceneSession>& sceneSession,
         SecSurfaceInfo& constrainedModalUIExtInfo);
+    InputLayoutCacheStat GetInputLayoutCacheStat() const;
+    void DumpInputLayoutCacheInfo(std::string& dumpInfo) const;
 
 private:
     std::vector<MMI::WindowInfo> FullSceneSessionInfoUpdate() const;
@@ -107,9 +161,16 @@ private:
     MMI::WindowInfo GetHostComponentWindowInfo(const SecSurfaceInfo& secSurfaceInfo,
         const MMI::WindowInfo& hostWindowinfo, const Matrix3f hostTransform) const;
     MMI::WindowInfo MakeWindowInfoFormHostWindow(const MMI::WindowInfo& hostWindowinfo) const;
-    void ResetFlushWindowInfoTask();
+    void ResetFlushWindowInfoTask(WindowInfoFlushUrgency urgency = WindowInfoFlushUrgency::IMMEDIATE);
     void CheckIfUpdatePointAreas(WindowType windowType, const sptr<SceneSession>& sceneSession,
         const sptr<WindowSessionProperty>& windowSessionProperty, std::vector<int32_t>& pointerChangeAreas) const;
+    std::shared_ptr<const InputLayout> GetInputLayout(const sptr<SceneSession>& sceneSession,
+        const sptr<WindowSessionProperty>& property, const SingleHandData& singleHandData) const;
+    void BuildInputLayout(const sptr<SceneSession>& sceneSession, const sptr<WindowSessionProperty>& property,
+        const SingleHandData& singleHandData, InputLayout& inputLayout) const;
+    InputLayoutKey MakeInputLayoutKey(const sptr<SceneSession>& sceneSession,
+        const sptr<WindowSessionProperty>& property, const SingleHandData& singleHandData) const;
+    void SweepInputLayoutCache(size_t windowNum);
 
     /*
      * Compatible Mode
@@ -121,9 +182,21 @@ private:
     mutable std::shared_mutex constrainedModalUIExtInfoMutex_;
     FlushWindowInfoCallback flushWindowInfoCallback_;
     std::atomic_bool sessionDirty_ { false };
-    std::atomic_bool hasPostTask_ { false };
     std::map<uint64_t, std::vector<SecSurfaceInfo>> secSurfaceInfoMap_;
     std::map<uint64_t, std::vector<SecSurfaceInfo>> constrainedModalUIExtInfoMap_;
+
+    /*
+     * Input layout cache, keyed by persistent id and swept of sessions missing from a full flush
+     */
+    struct InputLayoutCacheEntry {
+        InputLayoutKey key;
+        std::shared_ptr<const InputLayout> inputLayout;
+        uint64_t flushSeq = 0;
+    };
+    mutable std::mutex inputLayoutCacheMutex_;
+    mutable std::unordered_map<int32_t, InputLayoutCacheEntry> inputLayoutCache_;
+    mutable InputLayoutCacheStat inputLayoutCacheStat_;
+    uint64_t inputLayoutFlushSeq_ = 0;
 };
 } //namespace OHOS::Rosen
 
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <shared_mutex>
 
@@ -48,14 +49,20 @@
 #include "session/host/include/keyboard_session.h"
 #include "session/host/include/session.h"
 #include "session/host/include/root_scene_session.h"
+#include "session/host/include/session_spatial_index.h"
 #include "session_listener_controller.h"
 #include "session_manager/include/ffrt_queue_helper.h"
+#include "session_manager/include/window_info_flush_scheduler.h"
+#include "session_manager/include/window_layout_snapshot.h"
+#include "session_manager/include/versioned_map.h"
 #include "session_manager/include/window_manager_lru.h"
 #include "session_manager/include/zidl/scene_session_manager_stub.h"
 #include "thread_safety_annotations.h"
 #include "transaction/rs_interfaces.h"
+#include "window_drawing_content_info.h"
 #include "window_focus_controller.h"
 #include "window_scene_config.h"
+#include "window_visibility_info.h"
 #include "wm_single_instance.h"
 #include "zidl/session_lifecycle_listener_interface.h"
 #include "zidl/session_router_stack_listener.h"
@@ -119,6 +126,20 @@ struct StartingWindowRdbItemKey;
 class IUIEffectController;
 class IUIEffectControllerClient;
 
+/*
+ * State shared by the stages of one RS occlusion callback: every surface id is resolved once
+ * and the listener notifications of all stages are sent together at the end.
+ */
+struct WindowLayerChangeContext {
+    std::unordered_map<uint64_t, sptr<SceneSession>> surfaceSessionMap;
+    std::unordered_map<int32_t, std::vector<sptr<SceneSession>>> subSessionMap;
+    std::unordered_map<int32_t, WindowVisibilityState> currVisibleStateMap;
+    std::unordered_set<int32_t> visibilityChangedWindowIds;
+    std::vector<sptr<WindowVisibilityInfo>> windowVisibilityInfos;
+    std::vector<sptr<WindowDrawingContentInfo>> windowDrawingContentInfos;
+    std::string visibilityInfo = "WindowVisibilityInfos [name, winId, visibleState]: ";
+};
+
 using NotifyCreateSystemSessionFunc = std::function<void(const sptr<SceneSession>& session)>;
 using NotifyCreateKeyboardSessionFunc = std::function<void(const sptr<SceneSession>& keyboardSession,
     const sptr<SceneSession>& panelSession)>;
@@ -273,6 +294,7 @@ public:
     WMError NotifyWatchFocusActiveChange(bool isActive) override;
     void RegisterFlushWindowInfoCallback();
     void FlushWindowInfoToMMI(const bool forceFlush = false);
+    void RequestFlushWindowInfo(WindowInfoFlushUrgency urgency, bool forceFlush = false);
     void SendCancelEventBeforeEraseSession(const sptr<SceneSession>& sceneSession);
     void BuildCancelPointerEvent(const std::shared_ptr<MMI::PointerEvent>& pointerEvent, int32_t fingerId,
                                  int32_t action, int32_t wid);
@@ -485,8 +507,6 @@ public:
     void GetStatusBarAvoidHeight(DisplayId displayId, WSRect& barArea);
 
     WSError NotifyWindowExtensionVisibilityChange(int32_t pid, int32_t uid, bool visible) override;
-    void DealwithVisibilityChange(const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfos,
-    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData);
     void NotifyUpdateRectAfterLayout();
     void FlushUIParams(ScreenId screenId, std::unordered_map<int32_t, SessionUIParam>&& uiParams);
     WSError UpdateSessionWindowVisibilityListener(int32_t persistentId, bool haveListener) override;
@@ -598,7 +618,6 @@ public:
      * Window Property
      */
     WMError UpdateScreenLockStatusForApp(const std::string& bundleName, bool isRelease) override;
-    void DealwithDrawingContentChange(const std::vector<std::pair<uint64_t, bool>>& drawingContentChangeInfo);
     WMError ListWindowInfo(const WindowInfoOption& windowInfoOption, std::vector<sptr<WindowInfo>>& infos) override;
     WMError GetAllWindowLayoutInfo(DisplayId displayId, std::vector<sptr<WindowLayoutInfo>>& infos) override;
     WMError GetGlobalWindowMode(DisplayId displayId, GlobalWindowMode& globalWinMode) override;
@@ -871,16 +890,13 @@ private:
     std::shared_ptr<AppExecFwk::AbilityInfo> QueryAbilityInfoFromBMS(const int32_t uId, const std::string& bundleName,
         const std::string& abilityName, const std::string& moduleName, bool isAtomicServiceFreeInstall = false);
     std::vector<sptr<SceneSession>> GetSubSceneSession(int32_t parentWindowId);
-    void RemoveDuplicateSubSession(const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
-        std::vector<sptr<SceneSession>>& subSessions);
     void SetSessionVisibilityInfo(const sptr<SceneSession>& session, WindowVisibilityState visibleState,
         std::vector<sptr<WindowVisibilityInfo>>& windowVisibilityInfos, std::string& visibilityInfo);
-    void UpdateSubWindowVisibility(const sptr<SceneSession>& session, WindowVisibilityState visibleState,
-        const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
-        std::vector<sptr<WindowVisibilityInfo>>& windowVisibilityInfos, std::string& visibilityInfo,
-        const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData);
-    bool GetSessionRSVisible(const sptr<Session>& session,
-        const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData);
+    void RemoveDuplicateSubSession(const WindowLayerChangeContext& context,
+        std::vector<sptr<SceneSession>>& subSessions);
+    void UpdateSubWindowVisibility(WindowLayerChangeContext& context, const sptr<SceneSession>& session,
+        WindowVisibilityState visibleState);
+    bool GetSessionRSVisible(const WindowLayerChangeContext& context, const sptr<Session>& session);
     std::string GetFloatWidth(const int width, float value);
 
     /*
@@ -983,6 +999,10 @@ private:
     std::string GetAllSessionFocusInfo();
     void RegisterRequestFocusStatusNotifyManagerFunc(const sptr<SceneSession>& sceneSession);
     void ProcessUpdateLastFocusedAppId(const std::vector<std::pair<uint32_t, uint32_t>>& zOrderList);
+    const std::vector<sptr<SceneSession>>& GetSessionsForFlushLocked(ScreenId screenId);
+    bool IsDisplaySessionPartitionValidLocked() const;
+    void RebuildDisplaySessionPartitionLocked();
+    void SyncSessionSpatialIndex();
     WSError ProcessModalTopmostRequestFocusImmediately(const sptr<SceneSession>& sceneSession);
     WSError ProcessSubWindowRequestFocusImmediately(const sptr<SceneSession>& sceneSession);
     WSError ProcessDialogRequestFocusImmediately(const sptr<SceneSession>& sceneSession);
@@ -1049,6 +1069,7 @@ private:
                               std::vector<SessionInfoBean>& sessionInfos);
     int GetRemoteSessionInfo(const std::string& deviceId, int32_t persistentId, SessionInfoBean& sessionInfo);
     WSError GetTotalUITreeInfo(std::string& dumpInfo);
+    WSError GetTaskTimingDumpInfo(const std::vector<std::string>& params, std::string& dumpInfo);
 
     void PerformRegisterInRequestSceneSession(sptr<SceneSession>& sceneSession);
     WSError RequestSceneSessionActivationInner(sptr<SceneSession>& sceneSession, bool isNewActive,
@@ -1066,13 +1087,26 @@ private:
     void NotifyWindowInfoChangeFromSession(int32_t persistentid);
     bool FillWindowInfo(std::vector<sptr<AccessibilityWindowInfo>>& infos,
         const sptr<SceneSession>& sceneSession);
-    std::vector<std::pair<uint64_t, WindowVisibilityState>> GetWindowVisibilityChangeInfo(
-        std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData);
-    void GetWindowLayerChangeInfo(std::shared_ptr<RSOcclusionData> occlusionData,
-        std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData,
-        std::vector<std::pair<uint64_t, bool>>& currDrawingContentData);
     void WindowLayerInfoChangeCallback(std::shared_ptr<RSOcclusionData> occlusiontionData);
     sptr<SceneSession> SelectSesssionFromMap(const uint64_t& surfaceId);
+    void BuildWindowLayerSessionIndex(WindowLayerChangeContext& context);
+    sptr<SceneSession> SelectSessionFromIndex(const WindowLayerChangeContext& context, uint64_t surfaceId) const;
+    void FillWindowLayerVisibleState(WindowLayerChangeContext& context,
+        const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
+        const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData);
+    void GetWindowLayerChangeInfo(const WindowLayerChangeContext& context,
+        std::shared_ptr<RSOcclusionData> occlusionData,
+        std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData,
+        std::vector<std::pair<uint64_t, bool>>& currDrawingContentData);
+    std::vector<std::pair<uint64_t, WindowVisibilityState>> GetWindowVisibilityChangeInfo(
+        const WindowLayerChangeContext& context,
+        std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData);
+    void DealwithVisibilityChange(WindowLayerChangeContext& context,
+        const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
+        const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData);
+    void DealwithDrawingContentChange(WindowLayerChangeContext& context,
+        const std::vector<std::pair<uint64_t, bool>>& drawingContentChangeInfo);
+    void NotifyWindowLayerChange(WindowLayerChangeContext& context);
     void WindowDestroyNotifyVisibility(const sptr<SceneSession>& sceneSession);
     void RegisterSessionSnapshotFunc(const sptr<SceneSession>& sceneSession);
 
@@ -1080,9 +1114,10 @@ private:
      * Window Property
      */
     std::unordered_map<std::string, std::unordered_set<int32_t>> releasedScreenLockMap_;
-    std::vector<std::pair<uint64_t, bool>> GetWindowDrawingContentChangeInfo(
+    std::vector<std::pair<uint64_t, bool>> GetWindowDrawingContentChangeInfo(const WindowLayerChangeContext& context,
         const std::vector<std::pair<uint64_t, bool>>& currDrawingContentData);
-    bool GetPreWindowDrawingState(uint64_t surfaceId, bool currentWindowDrawing, int32_t& pid);
+    bool GetPreWindowDrawingState(const sptr<SceneSession>& session, uint64_t surfaceId, bool currentWindowDrawing,
+        int32_t& pid);
     bool GetProcessDrawingState(uint64_t surfaceId, int32_t pid);
     void UpdateWindowDrawingData(uint64_t surfaceId, int32_t pid, int32_t uid);
     bool GetSpecifiedDrawingData(uint64_t surfaceId, int32_t& pid, int32_t& uid);
@@ -1093,9 +1128,11 @@ private:
         std::vector<sptr<SceneSession>>& sessionsToReleaseScreenLock, const std::string& bundleName);
     bool FilterForListWindowInfo(const WindowInfoOption& windowInfoOption,
         const sptr<SceneSession>& sceneSession) const;
-    void FilterForGetAllWindowLayoutInfo(DisplayId displayId, bool isVirtualDisplay,
-        std::vector<sptr<SceneSession>>& filteredSessions);
     bool IsGetWindowLayoutInfoNeeded(const sptr<SceneSession>& session) const;
+    void PublishWindowLayoutSnapshot();
+    void InvalidateWindowLayoutSnapshot();
+    WindowLayoutSnapshotStamp GetWindowLayoutSnapshotStampLocked() const;
+    std::shared_ptr<const WindowLayoutSnapshot> LoadCurrentWindowLayoutSnapshot();
     int32_t GetFoldLowerScreenPosY() const;
     bool IsSessionInSpecificDisplay(const sptr<SceneSession>& session, DisplayId displayId) const;
     DisplayId UpdateSpecificSessionClientDisplayId(const sptr<WindowSessionProperty>& property);
@@ -1193,11 +1230,13 @@ private:
      */
     NotifyWatchGestureConsumeResultFunc onWatchGestureConsumeResultFunc_;
     NotifyWatchFocusActiveChangeFunc onWatchFocusActiveChangeFunc_;
+    void FlushWindowInfoToMMIInner(bool forceFlush, std::function<void()>&& onFlushed = nullptr);
+    WindowInfoFlushScheduler windowInfoFlushScheduler_;
 
     sptr<RootSceneSession> rootSceneSession_;
     std::weak_ptr<AbilityRuntime::Context> rootSceneContextWeak_;
     mutable std::shared_mutex sceneSessionMapMutex_;
-    std::map<int32_t, sptr<SceneSession>> sceneSessionMap_;
+    VersionedMap<int32_t, sptr<SceneSession>> sceneSessionMap_;
     std::map<int32_t, sptr<SceneSession>> systemTopSceneSessionMap_;
     std::map<int32_t, sptr<SceneSession>> nonSystemFloatSceneSessionMap_;
     sptr<ScbSessionHandler> scbSessionHandler_;
@@ -1384,7 +1423,8 @@ private:
     bool CheckPiPPriority(const PiPTemplateInfo& pipTemplateInfo, DisplayId displayId = 0);
     bool IsEnablePiPCreate(const sptr<WindowSessionProperty>& property);
     bool IsPiPForbidden(const sptr<WindowSessionProperty>& property, const WindowType& type);
-    bool IsLastPiPWindowVisible(uint64_t surfaceId, WindowVisibilityState lastVisibilityState);
+    bool IsLastPiPWindowVisible(const sptr<SceneSession>& session, uint64_t surfaceId,
+        WindowVisibilityState lastVisibilityState);
     void NotifyPiPWindowVisibleChange(bool isScreenLocked);
     void NotifyMulScreenPipStart(const sptr<WindowSessionProperty>& property, WindowType type);
 
@@ -1504,6 +1544,35 @@ private:
     std::unordered_set<std::string> snapshotSkipBundleNameSet_ GUARDED_BY(SCENE_GUARD);
 
     uint32_t sessionMapDirty_ { 0 };
+
+    /*
+     * Display Partition, sessions grouped by screen for FlushUIParams. ONLY Accessed on OS_sceneSession thread
+     */
+    struct DisplaySessionPartition {
+        bool valid = false;
+        uint64_t mapVersion = 0;
+        uint64_t screenIdGeneration = 0;
+        std::unordered_map<ScreenId, std::vector<sptr<SceneSession>>> screenSessions;
+        std::vector<sptr<SceneSession>> unboundSessions;
+    };
+    DisplaySessionPartition displaySessionPartition_;
+
+    /*
+     * Hit-test index over session rects per display, ONLY Accessed in OS_SceneSession
+     */
+    struct SessionSpatialIndexStamp {
+        bool valid = false;
+        uint64_t mapVersion = 0;
+        uint64_t displayIdGeneration = 0;
+    };
+    SessionSpatialIndex sessionSpatialIndex_;
+    SessionSpatialIndexStamp sessionSpatialIndexStamp_;
+
+    /*
+     * Layout read replica, published in OS_SceneSession and read by layout queries from any thread
+     */
+    WindowLayoutSnapshotHolder windowLayoutSnapshotHolder_;
+    std::atomic<uint64_t> windowLayoutGeneration_ { 0 }; // bumped when a flush or visibility change moves windows
     std::condition_variable nextFlushCompletedCV_;
     std::mutex nextFlushCompletedMutex_;
     RootSceneProcessBackEventFunc rootSceneProcessBackEventFunc_ = nullptr;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SCENE_VERSIONED_MAP_H
+#define OHOS_ROSEN_WINDOW_SCENE_VERSIONED_MAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <utility>
+
+namespace OHOS::Rosen {
+/*
+ * std::map whose version is bumped by every insert, emplace, erase, clear, assignment and operator[], so a cache
+ * built from the map is checked with one compare. Only const iterators are handed out, every other write has to
+ * go through one of these mutators.
+ */
+template <typename Key, typename Value>
+class VersionedMap {
+    using Base = std::map<Key, Value>;
+
+public:
+    using key_type = typename Base::key_type;
+    using mapped_type = typename Base::mapped_type;
+    using value_type = typename Base::value_type;
+    using size_type = typename Base::size_type;
+    using iterator = typename Base::const_iterator;
+    using const_iterator = typename Base::const_iterator;
+    using reverse_iterator = typename Base::const_reverse_iterator;
+    using const_reverse_iterator = typename Base::const_reverse_iterator;
+
+    VersionedMap() = default;
+    VersionedMap(const Base& other) : map_(other) {}
+    VersionedMap(Base&& other) : map_(std::move(other)) {}
+    VersionedMap(const VersionedMap& other) : map_(other.map_) {}
+    VersionedMap(VersionedMap&& other) : map_(std::move(other.map_)) { other.version_++; }
+
+    VersionedMap& operator=(const Base& other)
+    {
+        map_ = other;
+        version_++;
+        return *this;
+    }
+
+    VersionedMap& operator=(Base&& other)
+    {
+        map_ = std::move(other);
+        version_++;
+        return *this;
+    }
+
+    VersionedMap& operator=(const VersionedMap& other)
+    {
+        return *this = other.map_;
+    }
+
+    VersionedMap& operator=(VersionedMap&& other)
+    {
+        other.version_++;
+        return *this = std::move(other.map_);
+    }
+
+    operator const Base&() const { return map_; }
+
+    const_iterator begin() const { return map_.begin(); }
+    const_iterator end() const { return map_.end(); }
+    const_iterator cbegin() const { return map_.cbegin(); }
+    const_iterator cend() const { return map_.cend(); }
+    const_reverse_iterator rbegin() const { return map_.rbegin(); }
+    const_reverse_iterator rend() const { return map_.rend(); }
+    bool empty() const { return map_.empty(); }
+    size_type size() const { return map_.size(); }
+    size_type count(const Key& key) const { return map_.count(key); }
+    const_iterator find(const Key& key) const { return map_.find(key); }
+    const_iterator lower_bound(const Key& key) const { return map_.lower_bound(key); }
+    const_iterator upper_bound(const Key& key) const { return map_.upper_bound(key); }
+    const Value& at(const Key& key) const { return map_.at(key); }
+
+    std::pair<const_iterator, bool> insert(const value_type& value)
+    {
+        version_++;
+        return map_.insert(value);
+    }
+
+    std::pair<const_iterator, bool> insert(value_type&& value)
+    {
+        version_++;
+        return map_.insert(std::move(value));
+    }
+
+    template <typename Pair>
+    std::pair<const_iterator, bool> insert(Pair&& value)
+    {
+        version_++;
+        return map_.insert(std::forward<Pair>(value));
+    }
+
+    void insert(std::initializer_list<value_type> values)
+    {
+        version_++;
+        map_.insert(values);
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args&&... args)
+    {
+        version_++;
+        return map_.emplace(std::forward<Args>(args)...);
+    }
+
+    size_type erase(const Key& key)
+    {
+        version_++;
+        return map_.erase(key);
+    }
+
+    const_iterator erase(const_iterator pos)
+    {
+        version_++;
+        return map_.erase(pos);
+    }
+
+    // the reference is only valid for the write that follows the call, do not keep it
+    Value& operator[](const Key& key)
+    {
+        version_++;
+        return map_[key];
+    }
+
+    void clear()
+    {
+        version_++;
+        map_.clear();
+    }
+
+    uint64_t GetVersion() const { return version_.load(); }
+
+private:
+    Base map_;
+    std::atomic<uint64_t> version_ { 0 };
+};
+} // namespace OHOS::Rosen
+
+#endif // OHOS_ROSEN_WINDOW_SCENE_VERSIONED_MAP_H
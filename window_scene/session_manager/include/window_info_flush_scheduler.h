@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_SESSION_MANAGER_WINDOW_INFO_FLUSH_SCHEDULER_H
+#define OHOS_SESSION_MANAGER_WINDOW_INFO_FLUSH_SCHEDULER_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace Rosen {
+/**
+ * @brief How soon a window info change has to reach MMI.
+ * IMMEDIATE: focus, touchability, add and remove, flushed right after the current scene task.
+ * BATCHED: pure geometry, flushed after the adaptive batch delay.
+ */
+enum class WindowInfoFlushUrgency : uint32_t {
+    IMMEDIATE = 0,
+    BATCHED,
+};
+
+struct WindowInfoFlushStat {
+    uint64_t requestCount = 0;
+    uint64_t flushCount = 0;
+    uint64_t immediateFlushCount = 0;
+    uint64_t lastServed = 0;
+    uint64_t maxServed = 0;
+    int64_t totalCostUs = 0;
+    int64_t lastCostUs = 0;
+    int64_t maxCostUs = 0;
+    int64_t batchDelayMs = 0;
+};
+
+/*
+ * Collapses all flush requests that arrive before a flush runs into that one flush.
+ * RequestFlush may be called from any thread, the flush function runs on the thread postTaskFunc posts to.
+ */
+class WindowInfoFlushScheduler {
+public:
+    using PostTaskFunc = std::function<void(std::function<void()>&& task, const std::string& name, int64_t delayMs)>;
+    // onFlushed is called once the infos reached MMI, the flush cost covers the send
+    using FlushFunc = std::function<void(bool forceFlush, std::function<void()>&& onFlushed)>;
+
+    WindowInfoFlushScheduler();
+    void Init(PostTaskFunc&& postTaskFunc, FlushFunc&& flushFunc);
+    void RequestFlush(WindowInfoFlushUrgency urgency, bool forceFlush = false);
+    void SetBatchDelayRange(int64_t minDelayMs, int64_t maxDelayMs);
+    WindowInfoFlushStat GetStat() const;
+    void ResetStat();
+    void DumpInfo(std::string& dumpInfo) const;
+
+private:
+    void OnFlushTask(WindowInfoFlushUrgency urgency);
+    void OnFlushed(WindowInfoFlushUrgency urgency, uint64_t served, int64_t costUs);
+    void AdaptBatchDelayLocked(uint64_t served, int64_t costUs);
+
+    mutable std::mutex mutex_;
+    PostTaskFunc postTaskFunc_;
+    FlushFunc flushFunc_;
+    uint64_t pendingRequests_ = 0;
+    bool pendingForceFlush_ = false;
+    bool hasImmediateTask_ = false;
+    bool hasBatchedTask_ = false;
+    int64_t minBatchDelayMs_;
+    int64_t maxBatchDelayMs_;
+    int64_t batchDelayMs_;
+    WindowInfoFlushStat stat_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_SESSION_MANAGER_WINDOW_INFO_FLUSH_SCHEDULER_H
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SCENE_WINDOW_LAYOUT_SNAPSHOT_H
+#define OHOS_ROSEN_WINDOW_SCENE_WINDOW_LAYOUT_SNAPSHOT_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "dm_common.h"
+#include "interfaces/include/ws_common.h"
+#include "wm_common.h"
+
+namespace OHOS::Rosen {
+struct WindowLayoutSnapshotItem {
+    int32_t persistentId = INVALID_SESSION_ID;
+    DisplayId displayId = DISPLAY_ID_INVALID;
+    uint32_t zOrder = 0;
+    WSRect sessionRect;
+    Rect globalScaledRect;
+    std::string bundleName;
+    bool isMainWindow = false;
+    bool isFullScreenInForceSplit = false;
+
+    bool operator==(const WindowLayoutSnapshotItem& other) const
+    {
+        return persistentId == other.persistentId && displayId == other.displayId && zOrder == other.zOrder &&
+            sessionRect == other.sessionRect && globalScaledRect == other.globalScaledRect &&
+            bundleName == other.bundleName && isMainWindow == other.isMainWindow &&
+            isFullScreenInForceSplit == other.isFullScreenInForceSplit;
+    }
+};
+
+/*
+ * Session map state a snapshot was taken from, readers compare it to tell whether the snapshot is current.
+ */
+struct WindowLayoutSnapshotStamp {
+    uint64_t mapVersion = 0;
+    uint64_t layoutGeneration = 0;
+    uint64_t displayIdGeneration = 0;
+
+    bool operator==(const WindowLayoutSnapshotStamp& other) const
+    {
+        return mapVersion == other.mapVersion && layoutGeneration == other.layoutGeneration &&
+            displayIdGeneration == other.displayIdGeneration;
+    }
+};
+
+/*
+ * Layout of the windows a layout query can report, in descending zOrder.
+ */
+struct WindowLayoutSnapshot {
+    uint64_t version = 0;
+    WindowLayoutSnapshotStamp stamp;
+    std::vector<WindowLayoutSnapshotItem> items;
+};
+
+/*
+ * Holds the latest immutable layout snapshot. Publish is serialized, Load never blocks on a writer
+ * and the snapshot it returns stays valid while the caller holds it.
+ */
+class WindowLayoutSnapshotHolder {
+public:
+    /*
+     * Publishes the snapshot as the next version unless it equals the current one.
+     * Returns the version readers see afterwards.
+     */
+    uint64_t Publish(WindowLayoutSnapshot&& snapshot);
+    std::shared_ptr<const WindowLayoutSnapshot> Load() const;
+    void Reset();
+
+private:
+    std::mutex publishMutex_;
+    uint64_t version_ = 0; // guarded by publishMutex_
+    std::shared_ptr<const WindowLayoutSnapshot> snapshot_; // only accessed through std::atomic_load/store
+};
+} // namespace OHOS::Rosen
+#endif // OHOS_ROSEN_WINDOW_SCENE_WINDOW_LAYOUT_SNAPSHOT_H
@@ -19,6 +19,7 @@
 #include <refbase.h>
 
 #include "xml_config_base.h"
+#include "xml_config_cache.h"
 
 struct _xmlNode;
 typedef struct _xmlNode xmlNode;
@@ -49,6 +50,10 @@ private:
     static std::vector<float> ReadFloatNumbersConfigInfo(const xmlNodePtr& currNode, bool allowNeg);
     static std::string ReadStringConfigInfo(const xmlNodePtr& currNode);
     static void ReadConfig(const xmlNodePtr& rootPtr, std::map<std::string, ConfigItem>& mapValue);
+    static bool LoadConfig(const std::string& configFilePath, const std::string& cachePath);
+    static bool LoadConfigCache(const std::string& cachePath, const XmlConfigSource& source);
+    static uint32_t GetConfigCacheVersion();
+    static bool ParseConfigXml(const std::string& configFilePath);
     static std::string GetConfigPath(const std::string& configFileName);
     static std::vector<std::string> SplitNodeContent(const xmlNodePtr& node, const std::string& pattern = " ");
 };
@@ -58,6 +58,7 @@ constexpr int32_t DB_STARTWINDOW_TYPE_INDEX = 14;
 constexpr const char* PROFILE_PREFIX = "$profile:";
 constexpr uint16_t MAX_JSON_STRING_LENGTH = 4096;
 constexpr int32_t DEFAULT_ROW_COUNT = -1;
+constexpr size_t MAX_CACHE_SIZE = 128;
 
 NativeRdb::ValuesBucket BuildValuesBucket(const StartingWindowRdbItemKey& key, const StartingWindowInfo& value)
 {
@@ -97,6 +98,47 @@ bool CheckRdbResult(int resCode)
     }
     return true;
 }
+
+std::string GetCacheKey(const StartingWindowRdbItemKey& key)
+{
+    return key.bundleName + "#" + key.moduleName + "#" + key.abilityName + "#" + std::to_string(key.darkMode);
+}
+
+bool GetRowKey(NativeRdb::ResultSet& resultSet, StartingWindowRdbItemKey& key)
+{
+    int darkMode = 0;
+    if (!CheckRdbResult(resultSet.GetString(DB_BUNDLE_NAME_INDEX, key.bundleName)) ||
+        !CheckRdbResult(resultSet.GetString(DB_MODULE_NAME_INDEX, key.moduleName)) ||
+        !CheckRdbResult(resultSet.GetString(DB_ABILITY_NAME_INDEX, key.abilityName)) ||
+        !CheckRdbResult(resultSet.GetInt(DB_DARK_MODE_INDEX, darkMode))) {
+        return false;
+    }
+    key.darkMode = darkMode;
+    return true;
+}
+
+bool GetRowValue(NativeRdb::ResultSet& resultSet, StartingWindowInfo& value)
+{
+    int backgroundColorEarlyVersion = 0;
+    int backgroundColor = 0;
+    int configFileEnabled = 0;
+    if (!CheckRdbResult(resultSet.GetInt(DB_BACKGROUND_COLOR_EARLY_VERSION_INDEX, backgroundColorEarlyVersion)) ||
+        !CheckRdbResult(resultSet.GetString(DB_ICON_PATH_EARLY_VERSION_INDEX, value.iconPathEarlyVersion_)) ||
+        !CheckRdbResult(resultSet.GetInt(DB_BACKGROUND_COLOR_INDEX, backgroundColor)) ||
+        !CheckRdbResult(resultSet.GetString(DB_ICON_PATH_INDEX, value.iconPath_)) ||
+        !CheckRdbResult(resultSet.GetInt(DB_CONFIG_FILE_ENABLED_INDEX, configFileEnabled)) ||
+        !CheckRdbResult(resultSet.GetString(DB_ILLUSTRATION_PATH_INDEX, value.illustrationPath_)) ||
+        !CheckRdbResult(resultSet.GetString(DB_BRANDING_PATH_INDEX, value.brandingPath_)) ||
+        !CheckRdbResult(resultSet.GetString(DB_BACKGROUND_IMAGE_PATH_INDEX, value.backgroundImagePath_)) ||
+        !CheckRdbResult(resultSet.GetString(DB_BACKGROUND_IMAGE_FIT_INDEX, value.backgroundImageFit_)) ||
+        !CheckRdbResult(resultSet.GetString(DB_STARTWINDOW_TYPE_INDEX, value.startWindowType_))) {
+        return false;
+    }
+    value.backgroundColorEarlyVersion_ = static_cast<uint32_t>(backgroundColorEarlyVersion);
+    value.backgroundColor_ = static_cast<uint32_t>(backgroundColor);
+    value.configFileEnabled_ = configFileEnabled;
+    return true;
+}
 } // namespace
 
 StartingWindowRdbManager::StartingWindowRdbManager(const WmsRdbConfig& wmsRdbConfig)
@@ -127,6 +169,9 @@ std::shared_ptr<NativeRdb::RdbStore> StartingWindowRdbManager::GetRdbStore()
     }
     NativeRdb::RdbStoreConfig rdbStoreConfig(wmsRdbConfig_.dbPath + wmsRdbConfig_.dbName);
     rdbStoreConfig.SetSecurityLevel(NativeRdb::SecurityLevel::S1);
+    if (wmsRdbConfig_.isMemoryRdb) {
+        rdbStoreConfig.SetStorageMode(NativeRdb::StorageMode::MODE_MEMORY);
+    }
     int32_t resCode = NativeRdb::E_OK;
     WmsRdbOpenCallback wmsCallback(wmsRdbConfig_);
     rdbStore_ = NativeRdb::RdbHelper::GetRdbStore(
@@ -157,7 +202,12 @@ bool StartingWindowRdbManager::InsertData(const StartingWindowRdbItemKey& key, c
     auto valuesBucket = BuildValuesBucket(key, value);
     auto ret = rdbStore->InsertWithConflictResolution(
         rowId, wmsRdbConfig_.tableName, valuesBucket, NativeRdb::ConflictResolution::ON_CONFLICT_REPLACE);
-    return CheckRdbResult(ret);
+    EraseCache({ std::make_pair(key, value) });
+    if (!CheckRdbResult(ret)) {
+        return false;
+    }
+    PutToCache(GetCacheGeneration(), key, true, value);
+    return true;
 }
 
 bool StartingWindowRdbManager::BatchInsert(int64_t& outInsertNum,
@@ -174,6 +224,7 @@ bool StartingWindowRdbManager::BatchInsert(int64_t& outInsertNum,
         valuesBuckets.emplace_back(valuesBucket);
     }
     auto ret = rdbStore->BatchInsert(outInsertNum, wmsRdbConfig_.tableName, valuesBuckets);
+    EraseCache(inputValues);
     return CheckRdbResult(ret);
 }
 
@@ -188,6 +239,7 @@ bool StartingWindowRdbManager::DeleteDataByBundleName(const std::string& bundleN
     NativeRdb::AbsRdbPredicates absRdbPredicates(wmsRdbConfig_.tableName);
     absRdbPredicates.EqualTo(DB_BUNDLE_NAME, bundleName);
     auto ret = rdbStore->Delete(deletedRows, absRdbPredicates);
+    EraseCacheByBundleName(bundleName);
     return CheckRdbResult(ret);
 }
 
@@ -202,51 +254,151 @@ bool StartingWindowRdbManager::DeleteAllData()
     int32_t deletedRows = DEFAULT_ROW_COUNT;
     NativeRdb::AbsRdbPredicates absRdbPredicates(wmsRdbConfig_.tableName);
     auto ret = rdbStore->Delete(deletedRows, absRdbPredicates);
+    ClearCache();
     return CheckRdbResult(ret);
 }
 
 bool StartingWindowRdbManager::QueryData(const StartingWindowRdbItemKey& key, StartingWindowInfo& value)
 {
+    bool isFound = false;
+    if (GetFromCache(key, isFound, value)) {
+        return isFound;
+    }
+    uint64_t generation = GetCacheGeneration();
+    std::vector<std::pair<StartingWindowRdbItemKey, StartingWindowInfo>> bundleValues;
+    if (!QueryDataByBundleNames({ key.bundleName }, bundleValues)) {
+        return false;
+    }
+    for (const auto& [itemKey, itemValue] : bundleValues) {
+        if (itemKey.moduleName == key.moduleName && itemKey.abilityName == key.abilityName &&
+            itemKey.darkMode == key.darkMode) {
+            value = itemValue;
+            return true;
+        }
+    }
+    PutToCache(generation, key, false, value);
+    return false;
+}
+
+bool StartingWindowRdbManager::QueryDataByBundleNames(const std::vector<std::string>& bundleNames,
+    std::vector<std::pair<StartingWindowRdbItemKey, StartingWindowInfo>>& outValues)
+{
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:QueryDataByBundleNames");
+    if (bundleNames.empty()) {
+        return true;
+    }
     auto rdbStore = GetRdbStore();
     if (rdbStore == nullptr) {
         TLOGE(WmsLogTag::WMS_PATTERN, "RdbStore is null");
         return false;
     }
-    auto absRdbPredicates = BuildPredicates(wmsRdbConfig_.tableName, key);
+    uint64_t generation = GetCacheGeneration();
+    NativeRdb::AbsRdbPredicates absRdbPredicates(wmsRdbConfig_.tableName);
+    absRdbPredicates.In(DB_BUNDLE_NAME, bundleNames);
     auto absSharedResultSet = rdbStore->QueryByStep(absRdbPredicates, std::vector<std::string>());
     if (absSharedResultSet == nullptr) {
         TLOGE(WmsLogTag::WMS_PATTERN, "absSharedResultSet failed");
         return false;
     }
     ScopeGuard stateGuard([&] { absSharedResultSet->Close(); });
-    auto ret = absSharedResultSet->GoToFirstRow();
-    if (ret != NativeRdb::E_OK) {
-        TLOGE(WmsLogTag::WMS_PATTERN, "GoToFirstRow failed, ret:%{public}d", ret);
-        return false;
+    size_t startIndex = outValues.size();
+    while (absSharedResultSet->GoToNextRow() == NativeRdb::E_OK) {
+        StartingWindowRdbItemKey itemKey;
+        StartingWindowInfo itemValue;
+        if (!GetRowKey(*absSharedResultSet, itemKey) || !GetRowValue(*absSharedResultSet, itemValue)) {
+            outValues.resize(startIndex);
+            return false;
+        }
+        outValues.emplace_back(std::move(itemKey), std::move(itemValue));
     }
-    int backgroundColorEarlyVersion = 0;
-    int backgroundColor = 0;
-    int configFileEnabled = 0;
-    if (!CheckRdbResult(absSharedResultSet->GetInt(
-            DB_BACKGROUND_COLOR_EARLY_VERSION_INDEX, backgroundColorEarlyVersion)) ||
-        !CheckRdbResult(absSharedResultSet->GetString(
-            DB_ICON_PATH_EARLY_VERSION_INDEX, value.iconPathEarlyVersion_)) ||
-        !CheckRdbResult(absSharedResultSet->GetInt(DB_BACKGROUND_COLOR_INDEX, backgroundColor)) ||
-        !CheckRdbResult(absSharedResultSet->GetString(DB_ICON_PATH_INDEX, value.iconPath_)) ||
-        !CheckRdbResult(absSharedResultSet->GetInt(DB_CONFIG_FILE_ENABLED_INDEX, configFileEnabled)) ||
-        !CheckRdbResult(absSharedResultSet->GetString(DB_ILLUSTRATION_PATH_INDEX, value.illustrationPath_)) ||
-        !CheckRdbResult(absSharedResultSet->GetString(DB_BRANDING_PATH_INDEX, value.brandingPath_)) ||
-        !CheckRdbResult(absSharedResultSet->GetString(DB_BACKGROUND_IMAGE_PATH_INDEX, value.backgroundImagePath_)) ||
-        !CheckRdbResult(absSharedResultSet->GetString(DB_BACKGROUND_IMAGE_FIT_INDEX, value.backgroundImageFit_)) ||
-        !CheckRdbResult(absSharedResultSet->GetString(DB_STARTWINDOW_TYPE_INDEX, value.startWindowType_))) {
+    for (size_t i = startIndex; i < outValues.size(); i++) {
+        PutToCache(generation, outValues[i].first, true, outValues[i].second);
+    }
+    TLOGD(WmsLogTag::WMS_PATTERN, "bundles: %{public}zu, rows: %{public}zu",
+        bundleNames.size(), outValues.size() - startIndex);
+    return true;
+}
+
+bool StartingWindowRdbManager::GetFromCache(const StartingWindowRdbItemKey& key, bool& isFound,
+    StartingWindowInfo& value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    auto iter = cacheMap_.find(GetCacheKey(key));
+    if (iter == cacheMap_.end()) {
         return false;
     }
-    value.backgroundColorEarlyVersion_ = static_cast<uint32_t>(backgroundColorEarlyVersion);
-    value.backgroundColor_ = static_cast<uint32_t>(backgroundColor);
-    value.configFileEnabled_ = configFileEnabled;
+    cacheList_.splice(cacheList_.begin(), cacheList_, iter->second);
+    const auto& item = iter->second->second;
+    isFound = item.isFound;
+    if (isFound) {
+        value = item.info;
+    }
     return true;
 }
 
+uint64_t StartingWindowRdbManager::GetCacheGeneration()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return cacheGeneration_;
+}
+
+void StartingWindowRdbManager::PutToCache(uint64_t generation, const StartingWindowRdbItemKey& key, bool isFound,
+    const StartingWindowInfo& value)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (generation != cacheGeneration_) {
+        return;
+    }
+    auto cacheKey = GetCacheKey(key);
+    CacheItem item = { key.bundleName, isFound, isFound ? value : StartingWindowInfo() };
+    if (auto iter = cacheMap_.find(cacheKey); iter != cacheMap_.end()) {
+        iter->second->second = std::move(item);
+        cacheList_.splice(cacheList_.begin(), cacheList_, iter->second);
+        return;
+    }
+    cacheList_.emplace_front(cacheKey, std::move(item));
+    cacheMap_[cacheKey] = cacheList_.begin();
+    if (cacheList_.size() > MAX_CACHE_SIZE) {
+        cacheMap_.erase(cacheList_.back().first);
+        cacheList_.pop_back();
+    }
+}
+
+void StartingWindowRdbManager::EraseCache(
+    const std::vector<std::pair<StartingWindowRdbItemKey, StartingWindowInfo>>& values)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cacheGeneration_++;
+    for (const auto& pair : values) {
+        if (auto iter = cacheMap_.find(GetCacheKey(pair.first)); iter != cacheMap_.end()) {
+            cacheList_.erase(iter->second);
+            cacheMap_.erase(iter);
+        }
+    }
+}
+
+void StartingWindowRdbManager::EraseCacheByBundleName(const std::string& bundleName)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cacheGeneration_++;
+    for (auto iter = cacheList_.begin(); iter != cacheList_.end();) {
+        if (iter->second.bundleName == bundleName) {
+            cacheMap_.erase(iter->first);
+            iter = cacheList_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void StartingWindowRdbManager::ClearCache()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cacheGeneration_++;
+    cacheList_.clear();
+    cacheMap_.clear();
+}
+
 std::string StartingWindowRdbManager::GetStartWindowValFromProfile(const AppExecFwk::AbilityInfo& abilityInfo,
     const std::shared_ptr<Global::Resource::ResourceManager>& resourceMgr,
     const std::string& key, const std::string& defaultVal)
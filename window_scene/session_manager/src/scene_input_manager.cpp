@@ -233,6 +233,15 @@ auto SceneInputManager::GetFullWindowInfoList() ->
     return sceneSessionDirty_->GetFullWindowInfoList();
 }
 
+void SceneInputManager::DumpInputLayoutCacheInfo(std::string& dumpInfo)
+{
+    if (sceneSessionDirty_ == nullptr) {
+        TLOGE(WmsLogTag::WMS_EVENT, "sceneSessionDirty is nullptr");
+        return;
+    }
+    sceneSessionDirty_->DumpInputLayoutCacheInfo(dumpInfo);
+}
+
 std::vector<MMI::ScreenInfo> SceneInputManager::ConstructScreenInfos(
     std::map<ScreenId, ScreenProperty>& screensProperties)
 {
@@ -727,50 +736,60 @@ void SceneInputManager::UpdateDisplayAndWindowInfo(const std::vector<MMI::Screen
 
 void SceneInputManager::FlushDisplayInfoToMMI(std::vector<MMI::WindowInfo>&& windowInfoList,
                                               std::vector<std::shared_ptr<Media::PixelMap>>&& pixelMapList,
-                                              const bool forceFlush)
+                                              const bool forceFlush,
+                                              std::function<void()>&& onFlushed)
 {
     eventHandler_->PostTask([this, windowInfoList = std::move(windowInfoList),
-                            pixelMapList = std::move(pixelMapList), forceFlush]() {
-        HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "FlushDisplayInfoToMMI");
-        if (isUserBackground_.load()) {
-            TLOGND(WmsLogTag::WMS_MULTI_USER, "User in background, no need to flush display info");
-            return;
-        }
-        if (sceneSessionDirty_ == nullptr) {
-            TLOGNE(WmsLogTag::WMS_EVENT, "sceneSessionDirty_ is nullptr");
-            return;
+                            pixelMapList = std::move(pixelMapList), forceFlush,
+                            onFlushed = std::move(onFlushed)]() mutable {
+        SendDisplayInfoToMMI(std::move(windowInfoList), forceFlush);
+        if (onFlushed) {
+            onFlushed();
         }
-        std::map<ScreenId, ScreenProperty> screensProperties =
-            ScreenSessionManagerClient::GetInstance().GetAllScreensProperties();
-        std::vector<MMI::ScreenInfo> screenInfos = ConstructScreenInfos(screensProperties);
-        std::map<DisplayGroupId, MMI::DisplayGroupInfo> displayGroupMap;
-        ConstructDisplayGroupInfos(screensProperties, displayGroupMap);
-        if (displayGroupMap.empty()) {
-            std::ostringstream oss;
-            oss << "displayInfos flush to MMI is empty!";
-            int32_t ret = WindowInfoReporter::GetInstance().ReportEventDispatchException(
-                static_cast<int32_t>(WindowDFXHelperType::WINDOW_FLUSH_EMPTY_DISPLAY_INFO_TO_MMI_EXCEPTION),
-                getpid(), oss.str()
-            );
-            if (ret != 0) {
-                TLOGNI(WmsLogTag::WMS_EVENT, "ReportEventDispatchException message failed, ret: %{public}d", ret);
-            }
-            return;
-        }
-        std::vector<MMI::DisplayInfo> displayInfos;
-        for (auto& [displayGroupId, displayGroup] : displayGroupMap) {
-            for (auto& displayInfo : displayGroup.displaysInfo) {
-                displayInfos.emplace_back(displayInfo);
-            }
+    });
+}
+
+void SceneInputManager::SendDisplayInfoToMMI(std::vector<MMI::WindowInfo>&& windowInfoList, const bool forceFlush)
+{
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "FlushDisplayInfoToMMI");
+    if (isUserBackground_.load()) {
+        TLOGND(WmsLogTag::WMS_MULTI_USER, "User in background, no need to flush display info");
+        return;
+    }
+    if (sceneSessionDirty_ == nullptr) {
+        TLOGNE(WmsLogTag::WMS_EVENT, "sceneSessionDirty_ is nullptr");
+        return;
+    }
+    std::map<ScreenId, ScreenProperty> screensProperties =
+        ScreenSessionManagerClient::GetInstance().GetAllScreensProperties();
+    std::vector<MMI::ScreenInfo> screenInfos = ConstructScreenInfos(screensProperties);
+    std::map<DisplayGroupId, MMI::DisplayGroupInfo> displayGroupMap;
+    ConstructDisplayGroupInfos(screensProperties, displayGroupMap);
+    if (displayGroupMap.empty()) {
+        std::ostringstream oss;
+        oss << "displayInfos flush to MMI is empty!";
+        int32_t ret = WindowInfoReporter::GetInstance().ReportEventDispatchException(
+            static_cast<int32_t>(WindowDFXHelperType::WINDOW_FLUSH_EMPTY_DISPLAY_INFO_TO_MMI_EXCEPTION),
+            getpid(), oss.str()
+        );
+        if (ret != 0) {
+            TLOGNI(WmsLogTag::WMS_EVENT, "ReportEventDispatchException message failed, ret: %{public}d", ret);
         }
-        if (!forceFlush && !CheckNeedUpdate(screenInfos, displayInfos, windowInfoList)) {
-            return;
+        return;
+    }
+    std::vector<MMI::DisplayInfo> displayInfos;
+    for (auto& [displayGroupId, displayGroup] : displayGroupMap) {
+        for (auto& displayInfo : displayGroup.displaysInfo) {
+            displayInfos.emplace_back(displayInfo);
         }
-        PrintScreenInfo(screenInfos);
-        PrintDisplayInfo(displayInfos);
-        PrintWindowInfo(windowInfoList);
-        UpdateDisplayAndWindowInfo(screenInfos, displayGroupMap, std::move(windowInfoList));
-    });
+    }
+    if (!forceFlush && !CheckNeedUpdate(screenInfos, displayInfos, windowInfoList)) {
+        return;
+    }
+    PrintScreenInfo(screenInfos);
+    PrintDisplayInfo(displayInfos);
+    PrintWindowInfo(windowInfoList);
+    UpdateDisplayAndWindowInfo(screenInfos, displayGroupMap, std::move(windowInfoList));
 }
 
 void SceneInputManager::UpdateSecSurfaceInfo(const std::map<uint64_t, std::vector<SecSurfaceInfo>>& secSurfaceInfoMap)
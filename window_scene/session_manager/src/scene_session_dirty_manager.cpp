@@ -16,7 +16,9 @@
 #include "scene_session_dirty_manager.h"
 
 #include <cmath>
+#include <iomanip>
 #include <parameters.h>
+#include "common/include/rect_math.h"
 #include "screen_session_manager_client/include/screen_session_manager_client.h"
 #include "session_manager/include/scene_session_manager.h"
 #include "window_helper.h"
@@ -35,8 +37,7 @@ constexpr int POINTER_CHANGE_AREA_SIXTEEN = 16;
 constexpr int POINTER_CHANGE_AREA_DEFAULT = 0;
 constexpr int POINTER_CHANGE_AREA_FIVE = 5;
 constexpr unsigned int TRANSFORM_DATA_LEN = 9;
-constexpr int UPDATE_TASK_DURATION = 10;
-const std::string UPDATE_WINDOW_INFO_TASK = "UpdateWindowInfoTask";
+constexpr int32_t DUMP_COLUMN_WIDTH = 12;
 static int32_t g_screenRotationOffset = system::GetIntParameter<int32_t>("const.fold.screen_rotation.offset", 0);
 constexpr float ZORDER_UIEXTENSION_INDEX = 0.1;
 constexpr int WINDOW_NAME_TYPE_UNKNOWN = 0;
@@ -53,25 +54,6 @@ static bool operator==(const MMI::Rect left, const MMI::Rect right)
     return ((left.x == right.x) && (left.y == right.y) && (left.width == right.width) && (left.height == right.height));
 }
 
-struct InputRectHash {
-    std::size_t operator()(const MMI::Rect& r) const
-    {
-        std::size_t h1 = std::hash<int32_t>{}(r.x);
-        std::size_t h2 = std::hash<int32_t>{}(r.y);
-        std::size_t h3 = std::hash<int32_t>{}(r.width);
-        std::size_t h4 = std::hash<int32_t>{}(r.height);
-        return ((h1 * 31 + h2) * 31 + h3) * 31 + h4;
-    }
-};
-
-struct InputRectEqual {
-    bool operator()(const MMI::Rect& left, const MMI::Rect& right) const
-    {
-        return left.x == right.x && left.y == right.y &&
-               left.width == right.width && left.height == right.height;
-    }
-};
-
 MMI::Direction ConvertDegreeToMMIRotation(float degree)
 {
     MMI::Direction rotation = MMI::DIRECTION0;
@@ -404,22 +386,22 @@ void SceneSessionDirtyManager::UpdateHotAreas(const sptr<SceneSession>& sceneSes
         TLOGE(WmsLogTag::WMS_EVENT, "sceneSession is nullptr");
         return;
     }
-    std::unordered_set<MMI::Rect, InputRectHash, InputRectEqual> hotAreaHashSet;
     std::vector<Rect> hotAreas = sceneSession->GetTouchHotAreas();
     if (sceneSession->GetWindowType() == WindowType::WINDOW_TYPE_INPUT_METHOD_FLOAT ||
         sceneSession->GetWindowType() == WindowType::WINDOW_TYPE_KEYBOARD_PANEL) {
         UpdateKeyboardHotAreasInner(sceneSession, hotAreas);
     }
-    for (const auto& area : hotAreas) {
+    for (size_t index = 0; index < hotAreas.size(); index++) {
+        const auto& area = hotAreas[index];
+        // hot areas are few, a scan of the ones before is cheaper than hashing them
+        if (RectMath::FindRect(hotAreas.data(), index, area) != index) {
+            continue;
+        }
         MMI::Rect rect;
         rect.x = area.posX_;
         rect.y = area.posY_;
         rect.width = static_cast<int32_t>(area.width_);
         rect.height = static_cast<int32_t>(area.height_);
-        if (hotAreaHashSet.count(rect)) {
-            continue;
-        }
-        hotAreaHashSet.insert(rect);
         touchHotAreas.emplace_back(rect);
         pointerHotAreas.emplace_back(rect);
         if (touchHotAreas.size() == static_cast<uint32_t>(MMI::WindowInfo::MAX_HOTAREA_COUNT)) {
@@ -580,25 +562,19 @@ void SceneSessionDirtyManager::NotifyWindowInfoChange(const sptr<SceneSession>&
         TLOGD(WmsLogTag::WMS_EVENT, "[EventDispatch] wid=%{public}d, winType=%{public}d",
             sceneSession->GetWindowId(), static_cast<int>(type));
     }
-    ResetFlushWindowInfoTask();
+    // only pure geometry can wait for the batch, focus and touchability changes reach MMI right away
+    ResetFlushWindowInfoTask(type == WindowUpdateType::WINDOW_UPDATE_BOUNDS && !startMoving ?
+        WindowInfoFlushUrgency::BATCHED : WindowInfoFlushUrgency::IMMEDIATE);
 }
 
-void SceneSessionDirtyManager::ResetFlushWindowInfoTask()
+void SceneSessionDirtyManager::ResetFlushWindowInfoTask(WindowInfoFlushUrgency urgency)
 {
     sessionDirty_.store(true);
-    bool hasPostTask = false;
-    if (hasPostTask_.compare_exchange_strong(hasPostTask, true)) {
-        auto task = [this]() {
-            hasPostTask_.store(false);
-            if (!sessionDirty_.load() || flushWindowInfoCallback_ == nullptr) {
-                return;
-            }
-            flushWindowInfoCallback_();
-        };
-        TLOGD(WmsLogTag::WMS_EVENT, "in");
-        SceneSessionManager::GetInstance().PostFlushWindowInfoTask(task,
-            UPDATE_WINDOW_INFO_TASK, UPDATE_TASK_DURATION);
+    if (flushWindowInfoCallback_ == nullptr) {
+        TLOGD(WmsLogTag::WMS_EVENT, "flushWindowInfoCallback_ is nullptr");
+        return;
     }
+    flushWindowInfoCallback_(urgency);
 }
 
 bool SceneSessionDirtyManager::GetLastConstrainedModalUIExtInfo(const sptr<SceneSession>& sceneSession,
@@ -708,6 +684,13 @@ std::pair<std::vector<MMI::WindowInfo>, std::vector<std::shared_ptr<Media::Pixel
     // all input event should trans to dialog window if dialog exists
     const auto dialogMap = GetDialogSessionMap(sceneSessionMap);
     uint32_t maxHotAreasNum = 0;
+    {
+        std::lock_guard<std::mutex> lock(inputLayoutCacheMutex_);
+        inputLayoutFlushSeq_++;
+        inputLayoutCacheStat_.lastHits = 0;
+        inputLayoutCacheStat_.lastBuilds = 0;
+        inputLayoutCacheStat_.lastUncached = 0;
+    }
     for (const auto& sceneSessionValuePair : sceneSessionMap) {
         const auto& sceneSessionValue = sceneSessionValuePair.second;
         if (sceneSessionValue == nullptr) {
@@ -743,9 +726,32 @@ std::pair<std::vector<MMI::WindowInfo>, std::vector<std::shared_ptr<Media::Pixel
     if (maxHotAreasNum > MMI::WindowInfo::DEFAULT_HOTAREA_COUNT) {
         std::sort(windowInfoList.begin(), windowInfoList.end(), CmpMMIWindowInfo);
     }
+    SweepInputLayoutCache(windowInfoList.size());
     return {windowInfoList, pixelMapList};
 }
 
+void SceneSessionDirtyManager::SweepInputLayoutCache(size_t windowNum)
+{
+    std::lock_guard<std::mutex> lock(inputLayoutCacheMutex_);
+    uint64_t sweptNum = 0;
+    for (auto iter = inputLayoutCache_.begin(); iter != inputLayoutCache_.end();) {
+        if (iter->second.flushSeq != inputLayoutFlushSeq_) {
+            iter = inputLayoutCache_.erase(iter);
+            sweptNum++;
+        } else {
+            ++iter;
+        }
+    }
+    auto& stat = inputLayoutCacheStat_;
+    stat.lastWindows = windowNum;
+    stat.lastSwept = sweptNum;
+    stat.totalHits += stat.lastHits;
+    stat.totalBuilds += stat.lastBuilds;
+    stat.totalUncached += stat.lastUncached;
+    stat.totalSwept += sweptNum;
+    stat.entries = inputLayoutCache_.size();
+}
+
 void SceneSessionDirtyManager::UpdatePointerAreas(sptr<SceneSession> sceneSession,
     std::vector<int32_t>& pointerChangeAreas) const
 {
@@ -843,24 +849,17 @@ std::pair<MMI::WindowInfo, std::shared_ptr<Media::PixelMap>> SceneSessionDirtyMa
         TLOGE(WmsLogTag::WMS_EVENT, "GetSessionProperty is nullptr");
         return {};
     }
-    Matrix3f transform;
     WSRect windowRect = sceneSession->GetSessionGlobalRectInMultiScreen();
     auto pid = sceneSession->GetCallingPid();
     auto uid = sceneSession->GetCallingUid();
     auto windowId = sceneSession->GetWindowId();
     auto displayId = windowSessionProperty->GetDisplayId();
     const auto& singleHandData = GetSingleHandData(sceneSession);
-    CalTransform(sceneSession, transform, singleHandData);
-    std::vector<float> transformData(transform.GetData(), transform.GetData() + TRANSFORM_DATA_LEN);
+    auto inputLayout = GetInputLayout(sceneSession, windowSessionProperty, singleHandData);
 
     auto agentWindowId = sceneSession->GetWindowId();
     auto zOrder = sceneSession->GetZOrder();
-    std::vector<int32_t> pointerChangeAreas(POINTER_CHANGE_AREA_COUNT, 0);
     WindowType windowType = windowSessionProperty->GetWindowType();
-    CheckIfUpdatePointAreas(windowType, sceneSession, windowSessionProperty, pointerChangeAreas);
-    std::vector<MMI::Rect> touchHotAreas;
-    std::vector<MMI::Rect> pointerHotAreas;
-    UpdateHotAreas(sceneSession, touchHotAreas, pointerHotAreas);
     int windowNameType = WINDOW_NAME_TYPE_UNKNOWN;
     std::string windowName = sceneSession->GetWindowNameAllType();
     auto startsWith = [](const std::string& str, const std::string& prefix) {
@@ -880,15 +879,15 @@ std::pair<MMI::WindowInfo, std::shared_ptr<Media::PixelMap>> SceneSessionDirtyMa
         .area = { ceil(singleHandData.scaleX * windowRect.posX_ + singleHandData.singleHandX),
                   ceil(singleHandData.scaleX * windowRect.posY_ + singleHandData.singleHandY),
                   windowRect.width_, windowRect.height_ },
-        .defaultHotAreas = std::move(touchHotAreas),
-        .pointerHotAreas = std::move(pointerHotAreas),
+        .defaultHotAreas = inputLayout->touchHotAreas,
+        .pointerHotAreas = inputLayout->pointerHotAreas,
         .agentWindowId = agentWindowId,
         .action = static_cast<MMI::WINDOW_UPDATE_ACTION>(action),
         .displayId = displayId,
         .groupId = SceneSessionManager::GetInstance().GetDisplayGroupId(displayId),
         .zOrder = zOrder,
-        .pointerChangeAreas = std::move(pointerChangeAreas),
-        .transform = transformData,
+        .pointerChangeAreas = inputLayout->pointerChangeAreas,
+        .transform = inputLayout->transformData,
         .pixelMap = pixelMap.get(),
         .windowInputType = static_cast<MMI::WindowInputType>(sceneSession->GetSessionInfo().windowInputType_),
         .windowType = static_cast<int32_t>(windowType),
@@ -900,10 +899,125 @@ std::pair<MMI::WindowInfo, std::shared_ptr<Media::PixelMap>> SceneSessionDirtyMa
         windowInfo.flags |= MMI::WindowInfo::FLAG_BIT_HANDWRITING;
     }
     UpdatePrivacyMode(sceneSession, windowInfo);
-    windowInfo.uiExtentionWindowInfo = GetSecSurfaceWindowinfoList(sceneSession, windowInfo, transform);
+    windowInfo.uiExtentionWindowInfo = GetSecSurfaceWindowinfoList(sceneSession, windowInfo, inputLayout->transform);
     return {windowInfo, pixelMap};
 }
 
+bool InputLayoutKey::operator==(const InputLayoutKey& other) const
+{
+    return windowRect == other.windowRect && globalRect == other.globalRect && scaleX == other.scaleX &&
+        scaleY == other.scaleY && pivotX == other.pivotX && pivotY == other.pivotY &&
+        currentRotation == other.currentRotation && screenGeneration == other.screenGeneration &&
+        propertyGeneration == other.propertyGeneration &&
+        singleHandData.scaleX == other.singleHandData.scaleX && singleHandData.scaleY == other.singleHandData.scaleY &&
+        singleHandData.singleHandX == other.singleHandData.singleHandX &&
+        singleHandData.singleHandY == other.singleHandData.singleHandY &&
+        singleHandData.pivotX == other.singleHandData.pivotX && singleHandData.pivotY == other.singleHandData.pivotY &&
+        singleHandData.mode == other.singleHandData.mode && isRotable == other.isRotable &&
+        isSystem == other.isSystem && isDragAccessible == other.isDragAccessible && isMidScene == other.isMidScene &&
+        isSetPointerAreas == other.isSetPointerAreas;
+}
+
+InputLayoutKey SceneSessionDirtyManager::MakeInputLayoutKey(const sptr<SceneSession>& sceneSession,
+    const sptr<WindowSessionProperty>& property, const SingleHandData& singleHandData) const
+{
+    const auto& sessionInfo = sceneSession->GetSessionInfo();
+    return {
+        .windowRect = sceneSession->GetSessionGlobalRectInMultiScreen(),
+        .globalRect = sceneSession->GetSessionGlobalRect(),
+        .scaleX = sceneSession->GetScaleX(),
+        .scaleY = sceneSession->GetScaleY(),
+        .pivotX = sceneSession->GetPivotX(),
+        .pivotY = sceneSession->GetPivotY(),
+        .currentRotation = sceneSession->GetCurrentRotation(),
+        .screenGeneration = ScreenProperty::GetGlobalGeneration(),
+        .propertyGeneration = property->GetInputLayoutGeneration(),
+        .singleHandData = singleHandData,
+        .isRotable = sessionInfo.isRotable_,
+        .isSystem = sessionInfo.isSystem_,
+        .isDragAccessible = sceneSession->IsDragAccessible(),
+        .isMidScene = sceneSession->GetIsMidScene(),
+        .isSetPointerAreas = sessionInfo.isSetPointerAreas_,
+    };
+}
+
+void SceneSessionDirtyManager::BuildInputLayout(const sptr<SceneSession>& sceneSession,
+    const sptr<WindowSessionProperty>& property, const SingleHandData& singleHandData,
+    InputLayout& inputLayout) const
+{
+    CalTransform(sceneSession, inputLayout.transform, singleHandData);
+    inputLayout.transformData.assign(inputLayout.transform.GetData(),
+        inputLayout.transform.GetData() + TRANSFORM_DATA_LEN);
+    inputLayout.pointerChangeAreas.assign(POINTER_CHANGE_AREA_COUNT, 0);
+    CheckIfUpdatePointAreas(property->GetWindowType(), sceneSession, property, inputLayout.pointerChangeAreas);
+    inputLayout.touchHotAreas.clear();
+    inputLayout.pointerHotAreas.clear();
+    UpdateHotAreas(sceneSession, inputLayout.touchHotAreas, inputLayout.pointerHotAreas);
+}
+
+/*
+ * The transform and area vectors are rebuilt only when their inputs changed since the last flush.
+ * A cached layout is shared, not copied, the window info copies the vectors it owns straight from it.
+ */
+std::shared_ptr<const InputLayout> SceneSessionDirtyManager::GetInputLayout(const sptr<SceneSession>& sceneSession,
+    const sptr<WindowSessionProperty>& property, const SingleHandData& singleHandData) const
+{
+    WindowType windowType = property->GetWindowType();
+    if (windowType == WindowType::WINDOW_TYPE_INPUT_METHOD_FLOAT ||
+        windowType == WindowType::WINDOW_TYPE_KEYBOARD_PANEL) {
+        // keyboard hot areas follow the keyboard session and the screen orientation, they are not cached
+        auto inputLayout = std::make_shared<InputLayout>();
+        BuildInputLayout(sceneSession, property, singleHandData, *inputLayout);
+        std::lock_guard<std::mutex> lock(inputLayoutCacheMutex_);
+        inputLayoutCacheStat_.lastUncached++;
+        return inputLayout;
+    }
+    InputLayoutKey key = MakeInputLayoutKey(sceneSession, property, singleHandData);
+    int32_t persistentId = sceneSession->GetPersistentId();
+    {
+        std::lock_guard<std::mutex> lock(inputLayoutCacheMutex_);
+        auto iter = inputLayoutCache_.find(persistentId);
+        if (iter != inputLayoutCache_.end() && iter->second.key == key) {
+            iter->second.flushSeq = inputLayoutFlushSeq_;
+            inputLayoutCacheStat_.lastHits++;
+            return iter->second.inputLayout;
+        }
+    }
+    // the key is taken first, an input changing meanwhile only costs one more build next flush
+    auto inputLayout = std::make_shared<InputLayout>();
+    BuildInputLayout(sceneSession, property, singleHandData, *inputLayout);
+    std::lock_guard<std::mutex> lock(inputLayoutCacheMutex_);
+    inputLayoutCache_[persistentId] = { key, inputLayout, inputLayoutFlushSeq_ };
+    inputLayoutCacheStat_.lastBuilds++;
+    return inputLayout;
+}
+
+InputLayoutCacheStat SceneSessionDirtyManager::GetInputLayoutCacheStat() const
+{
+    std::lock_guard<std::mutex> lock(inputLayoutCacheMutex_);
+    return inputLayoutCacheStat_;
+}
+
+void SceneSessionDirtyManager::DumpInputLayoutCacheInfo(std::string& dumpInfo) const
+{
+    auto stat = GetInputLayoutCacheStat();
+    std::ostringstream oss;
+    oss << "Input layout cache: " << stat.entries << " entries" << std::endl;
+    // std::setw keeps the columns aligned whatever the width of the counters
+    oss << std::left << std::setw(DUMP_COLUMN_WIDTH) << "" << std::setw(DUMP_COLUMN_WIDTH) << "Windows"
+        << std::setw(DUMP_COLUMN_WIDTH) << "Hits" << std::setw(DUMP_COLUMN_WIDTH) << "Builds"
+        << std::setw(DUMP_COLUMN_WIDTH) << "Uncached" << std::setw(DUMP_COLUMN_WIDTH) << "Swept" << std::endl;
+    oss << std::left << std::setw(DUMP_COLUMN_WIDTH) << "Last" << std::setw(DUMP_COLUMN_WIDTH) << stat.lastWindows
+        << std::setw(DUMP_COLUMN_WIDTH) << stat.lastHits << std::setw(DUMP_COLUMN_WIDTH) << stat.lastBuilds
+        << std::setw(DUMP_COLUMN_WIDTH) << stat.lastUncached << std::setw(DUMP_COLUMN_WIDTH) << stat.lastSwept
+        << std::endl;
+    oss << std::left << std::setw(DUMP_COLUMN_WIDTH) << "Total" << std::setw(DUMP_COLUMN_WIDTH) << "-"
+        << std::setw(DUMP_COLUMN_WIDTH) << stat.totalHits << std::setw(DUMP_COLUMN_WIDTH) << stat.totalBuilds
+        << std::setw(DUMP_COLUMN_WIDTH) << stat.totalUncached << std::setw(DUMP_COLUMN_WIDTH) << stat.totalSwept
+        << std::endl;
+    dumpInfo.append(oss.str());
+}
+
 SingleHandData SceneSessionDirtyManager::GetSingleHandData(const sptr<SceneSession>& sceneSession) const
 {
     SingleHandData singleHandData;
@@ -913,8 +1027,6 @@ SingleHandData SceneSessionDirtyManager::GetSingleHandData(const sptr<SceneSessi
         !sceneSession->SessionIsSingleHandMode()) {
         return singleHandData;
     }
-    const std::map<ScreenId, ScreenProperty>& screensProperties =
-        ScreenSessionManagerClient::GetInstance().GetAllScreensProperties();
     const SingleHandTransform& transform = sceneSession->GetSingleHandTransform();
     const SingleHandScreenInfo& singleHandScreenInfo = SceneSessionManager::GetInstance().GetSingleHandScreenInfo();
     singleHandData.scaleX = transform.scaleX;
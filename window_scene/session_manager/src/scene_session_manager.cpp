@@ -15,6 +15,8 @@
 
 #include "session_manager/include/scene_session_manager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <regex>
 #include <sys/stat.h>
 
@@ -30,6 +32,7 @@
 #include "parameter.h"
 #include "resource_manager.h"
 #include "session/host/include/pc_fold_screen_manager.h"
+#include "common/include/rect_math.h"
 #include "publish/scb_dump_subscriber.h"
 #include <ui/rs_node.h>
 
@@ -138,7 +141,11 @@ const std::string ARG_DUMP_PIPLINE = "-p";
 const std::string ARG_DUMP_SCB = "-b";
 const std::string ARG_DUMP_DETAIL = "-c";
 const std::string ARG_DUMP_RECORD = "-v";
+const std::string ARG_DUMP_SNAPSHOT = "-snapshot";
+const std::string ARG_DUMP_FLUSH_WINDOW_INFO = "-flushinfo";
+const std::string ARG_DUMP_TASK_TIMING = "-tasktiming";
 constexpr uint64_t NANO_SECOND_PER_SEC = 1000000000; // ns
+constexpr int64_t WINDOW_LAYER_CHANGE_SLOW_THRESHOLD_US = 4000;
 const int32_t LOGICAL_DISPLACEMENT_32 = 32;
 constexpr int32_t GET_TOP_WINDOW_DELAY = 100;
 constexpr char SMALL_FOLD_PRODUCT_TYPE = '2';
@@ -213,6 +220,12 @@ int Comp(const std::pair<uint64_t, WindowVisibilityState>& a, const std::pair<ui
     return a.first < b.first;
 }
 
+int64_t GetSteadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 bool GetSingleIntItem(const WindowSceneConfig::ConfigItem& item, int32_t& value)
 {
     if (item.IsInts() && item.intsValue_ && item.intsValue_->size() == 1) {
@@ -368,6 +381,9 @@ SceneSessionManager::SceneSessionManager() : rsInterface_(RSInterfaces::GetInsta
     if (!launcherService_->RegisterCallback(new BundleStatusCallback())) {
         TLOGE(WmsLogTag::DEFAULT, "Failed to register bundle status callback.");
     }
+    if (!SessionPermission::RegisterPermissionStateChangeCallback()) {
+        TLOGW(WmsLogTag::DEFAULT, "Failed to register permission state change callback.");
+    }
 
     collaboratorDeathRecipient_ = sptr<AgentDeathRecipient>::MakeSptr(
         [this](const sptr<IRemoteObject>& remoteObject) { this->ClearAllCollaboratorSessions(); });
@@ -530,8 +546,14 @@ void SceneSessionManager::OnRecoverStateChange(const RecoverState& state)
 
 void SceneSessionManager::RegisterFlushWindowInfoCallback()
 {
-    SceneInputManager::GetInstance().
-        RegisterFlushWindowInfoCallback([this]() { FlushWindowInfoToMMI(); });
+    windowInfoFlushScheduler_.Init([this](std::function<void()>&& task, const std::string& name, int64_t delayMs) {
+        PostFlushWindowInfoTask(std::move(task), name, delayMs);
+    }, [this](bool forceFlush, std::function<void()>&& onFlushed) {
+        FlushWindowInfoToMMIInner(forceFlush, std::move(onFlushed));
+    });
+    SceneInputManager::GetInstance().RegisterFlushWindowInfoCallback([this](WindowInfoFlushUrgency urgency) {
+        windowInfoFlushScheduler_.RequestFlush(urgency);
+    });
 }
 
 void SceneSessionManager::InitVsyncStation()
@@ -3686,6 +3708,10 @@ void SceneSessionManager::EraseSceneSessionAndMarkDirtyLocked(int32_t persistent
         sessionMapDirty_ |= static_cast<uint32_t>(SessionUIDirtyFlag::VISIBLE);
     }
     sceneSessionMap_.erase(persistentId);
+    // all partition readers hold sceneSessionMapMutex_, let go of the erased session now
+    displaySessionPartition_.screenSessions.clear();
+    displaySessionPartition_.unboundSessions.clear();
+    displaySessionPartition_.valid = false;
 }
 
 WSError SceneSessionManager::RequestSceneSessionDestruction(const sptr<SceneSession>& sceneSession,
@@ -4189,7 +4215,9 @@ WSError SceneSessionManager::IsFloatingBallValid(const sptr<SceneSession>& paren
 }
 
 void SceneSessionManager::NotifyPiPWindowVisibleChange(bool screenLocked) {
-    sptr<SceneSession> session = SelectSesssionFromMap(pipWindowSurfaceId_);
+    WindowLayerChangeContext context;
+    BuildWindowLayerSessionIndex(context);
+    sptr<SceneSession> session = SelectSessionFromIndex(context, pipWindowSurfaceId_);
     if (session != nullptr) {
         std::vector<std::pair<uint64_t, WindowVisibilityState>> pipVisibilityChangeInfos;
         if (screenLocked) {
@@ -4197,12 +4225,14 @@ void SceneSessionManager::NotifyPiPWindowVisibleChange(bool screenLocked) {
         } else {
             pipVisibilityChangeInfos.emplace_back(pipWindowSurfaceId_, WINDOW_VISIBILITY_STATE_NO_OCCLUSION);
         }
-        DealwithVisibilityChange(pipVisibilityChangeInfos, lastVisibleData_);
+        DealwithVisibilityChange(context, pipVisibilityChangeInfos, lastVisibleData_);
+        NotifyWindowLayerChange(context);
     }
 }
 
-bool SceneSessionManager::IsLastPiPWindowVisible(uint64_t surfaceId, WindowVisibilityState lastVisibilityState) {
-    sptr<SceneSession> session = SelectSesssionFromMap(surfaceId);
+bool SceneSessionManager::IsLastPiPWindowVisible(const sptr<SceneSession>& session, uint64_t surfaceId,
+    WindowVisibilityState lastVisibilityState)
+{
     if (session == nullptr || session->GetWindowMode() != WindowMode::WINDOW_MODE_PIP) {
         TLOGD(WmsLogTag::WMS_PIP, "session is null or windowMode is not PIP");
         return false;
@@ -5892,6 +5922,7 @@ void SceneSessionManager::ClearStartWindowColorFollowApp(const std::string& bund
 
 void SceneSessionManager::OnBundleUpdated(const std::string& bundleName, int userId)
 {
+    SessionPermission::ClearCallerCache();
     taskScheduler_->PostAsyncTask([this, bundleName, where = __func__]() {
         ClearStartWindowColorFollowApp(bundleName);
         if (startingWindowRdbMgr_ == nullptr || bundleMgr_ == nullptr) {
@@ -7179,9 +7210,39 @@ WSError SceneSessionManager::GetSessionDumpInfo(const std::vector<std::string>&
         SessionChangeRecorder::GetInstance().GetSceneSessionNeedDumpInfo(resetParams, dumpInfo);
         return WSError::WS_OK;
     }
+    if (params.size() == 1 && params[0] == ARG_DUMP_SNAPSHOT) { // 1: params num
+        WSSnapshotPipeline::GetInstance().DumpInfo(dumpInfo);
+        return WSError::WS_OK;
+    }
+    if (params.size() == 1 && params[0] == ARG_DUMP_FLUSH_WINDOW_INFO) { // 1: params num
+        windowInfoFlushScheduler_.DumpInfo(dumpInfo);
+        SceneInputManager::GetInstance().DumpInputLayoutCacheInfo(dumpInfo);
+        return WSError::WS_OK;
+    }
+    if (params.size() >= 1 && params[0] == ARG_DUMP_TASK_TIMING) { // 1: params num
+        return GetTaskTimingDumpInfo(params, dumpInfo);
+    }
     return WSError::WS_ERROR_INVALID_OPERATION;
 }
 
+WSError SceneSessionManager::GetTaskTimingDumpInfo(const std::vector<std::string>& params, std::string& dumpInfo)
+{
+    if (params.size() == 2) { // 2: params num
+        if (params[1] == "on") {
+            taskScheduler_->SetTimingEnabled(true);
+        } else if (params[1] == "off") {
+            taskScheduler_->SetTimingEnabled(false);
+        } else if (params[1] == "reset") {
+            taskScheduler_->ResetTimingStat();
+        } else {
+            return WSError::WS_ERROR_INVALID_PARAM;
+        }
+    }
+    taskScheduler_->DumpTimingInfo(dumpInfo);
+    taskScheduler_->DumpExportTaskInfo(dumpInfo);
+    return WSError::WS_OK;
+}
+
 WSError SceneSessionManager::GetTotalUITreeInfo(std::string& dumpInfo)
 {
     TLOGI(WmsLogTag::WMS_PIPELINE, "begin");
@@ -8827,12 +8888,8 @@ __attribute__((no_sanitize("cfi"))) void SceneSessionManager::OnSessionStateChan
 {
     HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:OnSessionStateChange%d", persistentId);
     TLOGD(WmsLogTag::DEFAULT, "id: %{public}d, state:%{public}u", persistentId, state);
-    SceneSessionChangeInfo changeInfo {
-        .persistentId_ = persistentId,
-        .changeInfo_ = "Session state change to " + std::to_string(static_cast<uint32_t>(state)),
-        .logTag_ = WmsLogTag::WMS_LIFE,
-    };
-    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::SESSION_STATE_RECORD, changeInfo);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::SESSION_STATE_RECORD, persistentId,
+        WmsLogTag::WMS_LIFE, static_cast<uint32_t>(state));
     auto sceneSession = GetSceneSession(persistentId);
     if (sceneSession == nullptr) {
         TLOGD(WmsLogTag::DEFAULT, "session is nullptr");
@@ -9545,7 +9602,7 @@ WSError SceneSessionManager::GetSessionInfos(const std::string& deviceId, int32_
                 return WSError::WS_OK;
             }
         }
-        std::map<int32_t, sptr<SceneSession>>::iterator iter;
+        std::map<int32_t, sptr<SceneSession>>::const_iterator iter;
         std::vector<sptr<SceneSession>> sceneSessionInfos;
         std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
         for (const auto& [_, sceneSession] : sceneSessionMap_) {
@@ -10397,7 +10454,7 @@ WMError SceneSessionManager::GetSurfaceNodeIdsFromMissionIds(std::vector<uint64_
         return WMError::WM_ERROR_INVALID_PERMISSION;
     }
     auto task = [this, &missionIds, &surfaceNodeIds, isBlackList]() {
-        std::map<int32_t, sptr<SceneSession>>::iterator iter;
+        std::map<int32_t, sptr<SceneSession>>::const_iterator iter;
         std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
         for (auto missionId : missionIds) {
             iter = sceneSessionMap_.find(static_cast<int32_t>(missionId));
@@ -10969,7 +11026,7 @@ WMError SceneSessionManager::GetAccessibilityWindowInfo(std::vector<sptr<Accessi
     }
     auto task = [this, &infos]() {
         HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:GetAccessibilityWindowInfo");
-        std::map<int32_t, sptr<SceneSession>>::iterator iter;
+        std::map<int32_t, sptr<SceneSession>>::const_iterator iter;
         std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
         for (iter = sceneSessionMap_.begin(); iter != sceneSessionMap_.end(); iter++) {
             sptr<SceneSession> sceneSession = iter->second;
@@ -11219,44 +11276,118 @@ void SceneSessionManager::WindowLayerInfoChangeCallback(std::shared_ptr<RSOcclus
             TLOGNE(WmsLogTag::WMS_ATTRIBUTE, "weak occlusionData is nullptr");
             return;
         }
+        HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "ssm:WindowLayerInfoChange size:%zu",
+            weakOcclusionData->GetVisibleData().size());
+        int64_t startUs = GetSteadyTimeUs();
+        WindowLayerChangeContext context;
+        BuildWindowLayerSessionIndex(context);
         std::vector<std::pair<uint64_t, WindowVisibilityState>> currVisibleData;
         std::vector<std::pair<uint64_t, bool>> currDrawingContentData;
-        GetWindowLayerChangeInfo(weakOcclusionData, currVisibleData, currDrawingContentData);
+        GetWindowLayerChangeInfo(context, weakOcclusionData, currVisibleData, currDrawingContentData);
+        int64_t resolveEndUs = GetSteadyTimeUs();
+
         std::vector<std::pair<uint64_t, WindowVisibilityState>> visibilityChangeInfos;
         if (currVisibleData.size() != 0) {
-            visibilityChangeInfos = GetWindowVisibilityChangeInfo(currVisibleData);
-        }
-        if (visibilityChangeInfos.size() != 0) {
-            DealwithVisibilityChange(visibilityChangeInfos, currVisibleData);
-            CacVisibleWindowNum();
+            visibilityChangeInfos = GetWindowVisibilityChangeInfo(context, currVisibleData);
         }
-
         std::vector<std::pair<uint64_t, bool>> drawingContentChangeInfos;
         if (currDrawingContentData.size() != 0) {
-            drawingContentChangeInfos = GetWindowDrawingContentChangeInfo(currDrawingContentData);
+            drawingContentChangeInfos = GetWindowDrawingContentChangeInfo(context, currDrawingContentData);
+        }
+        int64_t diffEndUs = GetSteadyTimeUs();
+
+        if (visibilityChangeInfos.size() != 0) {
+            DealwithVisibilityChange(context, visibilityChangeInfos, currVisibleData);
+            CacVisibleWindowNum();
         }
         if (drawingContentChangeInfos.size() != 0) {
-            DealwithDrawingContentChange(drawingContentChangeInfos);
+            DealwithDrawingContentChange(context, drawingContentChangeInfos);
+        }
+        int64_t applyEndUs = GetSteadyTimeUs();
+
+        NotifyWindowLayerChange(context);
+        int64_t endUs = GetSteadyTimeUs();
+        if (endUs - startUs > WINDOW_LAYER_CHANGE_SLOW_THRESHOLD_US) {
+            TLOGNW(WmsLogTag::WMS_ATTRIBUTE, "slow, sessions:%{public}zu, visible:%{public}zu, drawing:%{public}zu, "
+                "resolve:%{public}" PRId64 "us, diff:%{public}" PRId64 "us, apply:%{public}" PRId64 "us, "
+                "notify:%{public}" PRId64 "us", context.surfaceSessionMap.size(), visibilityChangeInfos.size(),
+                drawingContentChangeInfos.size(), resolveEndUs - startUs, diffEndUs - resolveEndUs,
+                applyEndUs - diffEndUs, endUs - applyEndUs);
+        } else {
+            TLOGND(WmsLogTag::WMS_ATTRIBUTE, "resolve:%{public}" PRId64 "us, diff:%{public}" PRId64 "us, "
+                "apply:%{public}" PRId64 "us, notify:%{public}" PRId64 "us", resolveEndUs - startUs,
+                diffEndUs - resolveEndUs, applyEndUs - diffEndUs, endUs - applyEndUs);
         }
     };
     taskScheduler_->PostVoidSyncTask(task, "WindowLayerInfoChangeCallback");
 }
 
-void SceneSessionManager::GetWindowLayerChangeInfo(std::shared_ptr<RSOcclusionData> occlusiontionData,
+void SceneSessionManager::BuildWindowLayerSessionIndex(WindowLayerChangeContext& context)
+{
+    std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
+    context.surfaceSessionMap.reserve(sceneSessionMap_.size());
+    for (const auto& [_, sceneSession] : sceneSessionMap_) {
+        if (sceneSession == nullptr) {
+            continue;
+        }
+        auto surfaceNode = sceneSession->GetSurfaceNode();
+        if (surfaceNode != nullptr) {
+            // the first session in id order wins, as in SelectSesssionFromMap
+            context.surfaceSessionMap.emplace(surfaceNode->GetId(), sceneSession);
+        }
+        if (WindowHelper::IsMainWindow(sceneSession->GetWindowType())) {
+            continue;
+        }
+        const auto& mainOrFloatSession = sceneSession->GetMainOrFloatSession();
+        if (mainOrFloatSession != nullptr) {
+            context.subSessionMap[mainOrFloatSession->GetWindowId()].push_back(sceneSession);
+        }
+    }
+}
+
+sptr<SceneSession> SceneSessionManager::SelectSessionFromIndex(const WindowLayerChangeContext& context,
+    uint64_t surfaceId) const
+{
+    auto iter = context.surfaceSessionMap.find(surfaceId);
+    return iter != context.surfaceSessionMap.end() ? iter->second : nullptr;
+}
+
+void SceneSessionManager::FillWindowLayerVisibleState(WindowLayerChangeContext& context,
+    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
+    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData)
+{
+    for (const auto& [surfaceId, visibleState] : currVisibleData) {
+        sptr<SceneSession> session = SelectSessionFromIndex(context, surfaceId);
+        if (session != nullptr) {
+            context.currVisibleStateMap.emplace(session->GetWindowId(), visibleState);
+        }
+    }
+    for (const auto& [surfaceId, _] : visibilityChangeInfo) {
+        sptr<SceneSession> session = SelectSessionFromIndex(context, surfaceId);
+        if (session != nullptr) {
+            context.visibilityChangedWindowIds.insert(session->GetWindowId());
+        }
+    }
+}
+
+void SceneSessionManager::GetWindowLayerChangeInfo(const WindowLayerChangeContext& context,
+    std::shared_ptr<RSOcclusionData> occlusiontionData,
     std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData,
     std::vector<std::pair<uint64_t, bool>>& currDrawingContentData)
 {
     VisibleData& rsVisibleData = occlusiontionData->GetVisibleData();
+    currVisibleData.reserve(rsVisibleData.size());
     for (auto iter = rsVisibleData.begin(); iter != rsVisibleData.end(); iter++) {
         WindowLayerState windowLayerState = static_cast<WindowLayerState>(iter->second);
         auto visibilityState = static_cast<WindowVisibilityState>(iter->second);
-        sptr<SceneSession> session = SelectSesssionFromMap(iter->first);
+        sptr<SceneSession> session = nullptr;
         switch (windowLayerState) {
             case WINDOW_ALL_VISIBLE:
             case WINDOW_SEMI_VISIBLE:
                 currVisibleData.emplace_back(iter->first, static_cast<WindowVisibilityState>(iter->second));
                 break;
             case WINDOW_IN_VISIBLE:
+                session = SelectSessionFromIndex(context, iter->first);
                 if (session != nullptr && session->GetHidingStartingWindow()) {
                     TLOGI(WmsLogTag::WMS_ATTRIBUTE, "change to visible: %{public}d", session->GetPersistentId());
                     visibilityState = WINDOW_VISIBILITY_STATE_NO_OCCLUSION;
@@ -11275,51 +11406,40 @@ void SceneSessionManager::GetWindowLayerChangeInfo(std::shared_ptr<RSOcclusionDa
     }
 }
 
-void SceneSessionManager::UpdateSubWindowVisibility(const sptr<SceneSession>& session,
-    WindowVisibilityState visibleState,
-    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
-    std::vector<sptr<WindowVisibilityInfo>>& windowVisibilityInfos, std::string& visibilityInfo,
-    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData)
+void SceneSessionManager::UpdateSubWindowVisibility(WindowLayerChangeContext& context,
+    const sptr<SceneSession>& session, WindowVisibilityState visibleState)
 {
     if (WindowHelper::IsMainWindow(session->GetWindowType()) &&
             visibleState < WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION) {
-        auto subSessions = GetSubSceneSession(session->GetWindowId());
-        if (subSessions.empty()) {
+        auto iter = context.subSessionMap.find(session->GetWindowId());
+        if (iter == context.subSessionMap.end() || iter->second.empty()) {
             return;
         }
+        auto subSessions = iter->second;
 
-        RemoveDuplicateSubSession(visibilityChangeInfo, subSessions);
+        RemoveDuplicateSubSession(context, subSessions);
 
         for (const auto& subSession : subSessions) {
             if (subSession == nullptr) {
                 continue;
             }
-            if (GetSessionRSVisible(subSession, currVisibleData)) {
+            if (GetSessionRSVisible(context, subSession)) {
                 TLOGI(WmsLogTag::WMS_ATTRIBUTE, "Update subwindow visibility for winId: %{public}d",
                     subSession->GetWindowId());
-                SetSessionVisibilityInfo(subSession, visibleState, windowVisibilityInfos, visibilityInfo);
+                SetSessionVisibilityInfo(subSession, visibleState, context.windowVisibilityInfos,
+                    context.visibilityInfo);
             }
         }
     }
 }
 
-bool SceneSessionManager::GetSessionRSVisible(const sptr<Session>& session,
-    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData)
+bool SceneSessionManager::GetSessionRSVisible(const WindowLayerChangeContext& context, const sptr<Session>& session)
 {
-    bool sessionRSVisible = false;
-    for (const auto& [surfaceId, visibleState] : currVisibleData) {
-        sptr<SceneSession> visibilitySession = SelectSesssionFromMap(surfaceId);
-        if (visibilitySession == nullptr) {
-            continue;
-        }
-        if (session->GetWindowId() == visibilitySession->GetWindowId()) {
-            if (visibleState < WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION) {
-                sessionRSVisible = true;
-            }
-            break;
-        }
+    if (session == nullptr) {
+        return false;
     }
-    return sessionRSVisible;
+    auto iter = context.currVisibleStateMap.find(session->GetWindowId());
+    return iter != context.currVisibleStateMap.end() && iter->second < WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION;
 }
 
 void SceneSessionManager::SetSessionVisibilityInfo(const sptr<SceneSession>& session,
@@ -11358,25 +11478,15 @@ void SceneSessionManager::SetSessionVisibilityInfo(const sptr<SceneSession>& ses
         "[" + session->GetWindowName() + ", " + std::to_string(windowId) + ", " + std::to_string(visibleState) + "], ";
 }
 
-void SceneSessionManager::RemoveDuplicateSubSession(
-    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
+void SceneSessionManager::RemoveDuplicateSubSession(const WindowLayerChangeContext& context,
     std::vector<sptr<SceneSession>>& subSessions)
 {
-    for (const auto& elem : visibilityChangeInfo) {
-        uint64_t surfaceId = elem.first;
-        sptr<SceneSession> session = SelectSesssionFromMap(surfaceId);
-        if (session == nullptr) {
-            continue;
-        }
-        for (auto iterator = subSessions.begin(); iterator != subSessions.end();) {
-            auto subSession = *iterator;
-            if (subSession && subSession->GetWindowId() == session->GetWindowId()) {
-                iterator = subSessions.erase(iterator);
-            } else {
-                ++iterator;
-            }
-        }
-    }
+    subSessions.erase(std::remove_if(subSessions.begin(), subSessions.end(),
+        [&context](const sptr<SceneSession>& subSession) {
+            return subSession != nullptr &&
+                context.visibilityChangedWindowIds.find(subSession->GetWindowId()) !=
+                context.visibilityChangedWindowIds.end();
+        }), subSessions.end());
 }
 
 std::vector<sptr<SceneSession>> SceneSessionManager::GetSubSceneSession(int32_t parentWindowId)
@@ -11400,15 +11510,18 @@ std::vector<sptr<SceneSession>> SceneSessionManager::GetSubSceneSession(int32_t
 }
 
 std::vector<std::pair<uint64_t, WindowVisibilityState>> SceneSessionManager::GetWindowVisibilityChangeInfo(
-    std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData)
+    const WindowLayerChangeContext& context, std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData)
 {
+    auto isLastPiPWindowVisible = [this, &context](uint64_t surfaceId, WindowVisibilityState lastVisibilityState) {
+        return IsLastPiPWindowVisible(SelectSessionFromIndex(context, surfaceId), surfaceId, lastVisibilityState);
+    };
     std::vector<std::pair<uint64_t, WindowVisibilityState>> visibilityChangeInfo;
     std::sort(currVisibleData.begin(), currVisibleData.end(), Comp);
     uint32_t i, j;
     i = j = 0;
     for (; i < lastVisibleData_.size() && j < currVisibleData.size();) {
         if (lastVisibleData_[i].first < currVisibleData[j].first) {
-            if (IsLastPiPWindowVisible(lastVisibleData_[i].first, lastVisibleData_[i].second)) {
+            if (isLastPiPWindowVisible(lastVisibleData_[i].first, lastVisibleData_[i].second)) {
                 i++;
                 continue;
             }
@@ -11423,7 +11536,7 @@ std::vector<std::pair<uint64_t, WindowVisibilityState>> SceneSessionManager::Get
             j++;
         } else {
             if (lastVisibleData_[i].second != currVisibleData[j].second &&
-                !IsLastPiPWindowVisible(lastVisibleData_[i].first, lastVisibleData_[i].second)) {
+                !isLastPiPWindowVisible(lastVisibleData_[i].first, lastVisibleData_[i].second)) {
                 visibilityChangeInfo.emplace_back(currVisibleData[j].first, currVisibleData[j].second);
             }
             i++;
@@ -11431,7 +11544,7 @@ std::vector<std::pair<uint64_t, WindowVisibilityState>> SceneSessionManager::Get
         }
     }
     for (; i < lastVisibleData_.size(); ++i) {
-        if (IsLastPiPWindowVisible(lastVisibleData_[i].first, lastVisibleData_[i].second)) {
+        if (isLastPiPWindowVisible(lastVisibleData_[i].first, lastVisibleData_[i].second)) {
             continue;
         }
         if (lastVisibleData_[i].second != WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION) {
@@ -11447,20 +11560,21 @@ std::vector<std::pair<uint64_t, WindowVisibilityState>> SceneSessionManager::Get
     return visibilityChangeInfo;
 }
 
-void SceneSessionManager::DealwithVisibilityChange(const std::vector<std::pair<uint64_t, WindowVisibilityState>>&
-    visibilityChangeInfo, const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData)
+void SceneSessionManager::DealwithVisibilityChange(WindowLayerChangeContext& context,
+    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& visibilityChangeInfo,
+    const std::vector<std::pair<uint64_t, WindowVisibilityState>>& currVisibleData)
 {
-    std::vector<sptr<WindowVisibilityInfo>> windowVisibilityInfos;
 #ifdef MEMMGR_WINDOW_ENABLE
     std::vector<sptr<Memory::MemMgrWindowInfo>> memMgrWindowInfos;
 #endif
 
-    std::string visibilityInfo = "WindowVisibilityInfos [name, winId, visibleState]: ";
+    FillWindowLayerVisibleState(context, visibilityChangeInfo, currVisibleData);
+    bool hasVisibilityChanged = false;
     for (const auto& elem : visibilityChangeInfo) {
         uint64_t surfaceId = elem.first;
         WindowVisibilityState visibleState = elem.second;
         bool isVisible = visibleState < WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION;
-        sptr<SceneSession> session = SelectSesssionFromMap(surfaceId);
+        sptr<SceneSession> session = SelectSessionFromIndex(context, surfaceId);
         if (session == nullptr) {
             continue;
         }
@@ -11468,44 +11582,44 @@ void SceneSessionManager::DealwithVisibilityChange(const std::vector<std::pair<u
             session->GetWindowType() == WindowType::WINDOW_TYPE_DIALOG) && isVisible == true) {
             if (session->GetParentSession() != nullptr &&
                 !session->GetParentSession()->IsSessionForeground() &&
-                !GetSessionRSVisible(session->GetParentSession(), currVisibleData)) {
+                !GetSessionRSVisible(context, session->GetParentSession())) {
                 continue;
             }
         }
-        SetSessionVisibilityInfo(session, visibleState, windowVisibilityInfos, visibilityInfo);
-        UpdateSubWindowVisibility(session, visibleState, visibilityChangeInfo, windowVisibilityInfos, visibilityInfo, currVisibleData);
+        SetSessionVisibilityInfo(session, visibleState, context.windowVisibilityInfos, context.visibilityInfo);
+        UpdateSubWindowVisibility(context, session, visibleState);
 #ifdef MEMMGR_WINDOW_ENABLE
         memMgrWindowInfos.emplace_back(new Memory::MemMgrWindowInfo(session->GetWindowId(), session->GetCallingPid(),
             session->GetCallingUid(), isVisible));
 #endif
-        CheckAndNotifyWaterMarkChangedResult();
+        hasVisibilityChanged = true;
     }
-    if (windowVisibilityInfos.size() != 0) {
-        TLOGNI(WmsLogTag::WMS_ATTRIBUTE, "Visibility changed, size: %{public}zu, %{public}s", windowVisibilityInfos.size(),
-            visibilityInfo.c_str());
-        SessionManagerAgentController::GetInstance().UpdateWindowVisibilityInfo(windowVisibilityInfos);
+    if (hasVisibilityChanged) {
+        // the water mark state only depends on the final visibility, check it once for the whole batch
+        CheckAndNotifyWaterMarkChangedResult();
+        InvalidateWindowLayoutSnapshot();
     }
     ProcessWindowModeType();
 #ifdef MEMMGR_WINDOW_ENABLE
     if (memMgrWindowInfos.size() != 0) {
         TLOGND(WmsLogTag::WMS_ATTRIBUTE, "Notify memMgrWindowInfos changed start");
-        taskScheduler_ ->AddExportTask("notifyMemMgr", [memMgrWindowInfos = std::move(memMgrWindowInfos)]() {
-            Memory::MemMgrClient::GetInstance().OnWindowVisibilityChanged(memMgrWindowInfos);
-        });
+        taskScheduler_->AddExportTask(ExportTaskId::NOTIFY_MEM_MGR,
+            [memMgrWindowInfos = std::move(memMgrWindowInfos)]() {
+                Memory::MemMgrClient::GetInstance().OnWindowVisibilityChanged(memMgrWindowInfos);
+            });
     }
 #endif
 }
 
-void SceneSessionManager::DealwithDrawingContentChange(const std::vector<std::pair<uint64_t, bool>>&
-    drawingContentChangeInfo)
+void SceneSessionManager::DealwithDrawingContentChange(WindowLayerChangeContext& context,
+    const std::vector<std::pair<uint64_t, bool>>& drawingContentChangeInfo)
 {
-    std::vector<sptr<WindowDrawingContentInfo>> windowDrawingContenInfos;
     for (const auto& [surfaceId, drawingState] : drawingContentChangeInfo) {
         int32_t windowId = 0;
         int32_t pid = 0;
         int32_t uid = 0;
         WindowType type = WindowType::APP_WINDOW_BASE;
-        sptr<SceneSession> session = SelectSesssionFromMap(surfaceId);
+        sptr<SceneSession> session = SelectSessionFromIndex(context, surfaceId);
         if (session == nullptr) {
             if (!GetSpecifiedDrawingData(surfaceId, pid, uid)) {
                 continue;
@@ -11517,7 +11631,8 @@ void SceneSessionManager::DealwithDrawingContentChange(const std::vector<std::pa
             uid = session->GetCallingUid();
             type = session->GetWindowType();
         }
-        windowDrawingContenInfos.emplace_back(new WindowDrawingContentInfo(windowId, pid, uid, drawingState, type));
+        context.windowDrawingContentInfos.emplace_back(
+            new WindowDrawingContentInfo(windowId, pid, uid, drawingState, type));
         if (openDebugTrace_) {
             HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "Drawing status changed pid:(%d ) surfaceId:(%" PRIu64 ")"
                 "drawingState:(%d )", pid, surfaceId, drawingState);
@@ -11525,9 +11640,19 @@ void SceneSessionManager::DealwithDrawingContentChange(const std::vector<std::pa
         TLOGD(WmsLogTag::DEFAULT, "drawing status changed pid:%{public}d, "
             "surfaceId:%{public}" PRIu64 ", drawingState:%{public}d", pid, surfaceId, drawingState);
     }
-    if (windowDrawingContenInfos.size() != 0) {
+}
+
+void SceneSessionManager::NotifyWindowLayerChange(WindowLayerChangeContext& context)
+{
+    if (context.windowVisibilityInfos.size() != 0) {
+        TLOGI(WmsLogTag::WMS_ATTRIBUTE, "Visibility changed, size: %{public}zu, %{public}s",
+            context.windowVisibilityInfos.size(), context.visibilityInfo.c_str());
+        SessionManagerAgentController::GetInstance().UpdateWindowVisibilityInfo(context.windowVisibilityInfos);
+    }
+    if (context.windowDrawingContentInfos.size() != 0) {
         TLOGD(WmsLogTag::DEFAULT, "Notify WindowDrawingContenInfo changed start");
-        SessionManagerAgentController::GetInstance().UpdateWindowDrawingContentInfo(windowDrawingContenInfos);
+        SessionManagerAgentController::GetInstance().UpdateWindowDrawingContentInfo(
+            context.windowDrawingContentInfos);
     }
 }
 
@@ -11656,14 +11781,15 @@ void SceneSessionManager::RemoveSpecifiedDrawingData(uint64_t surfaceId)
 }
 
 std::vector<std::pair<uint64_t, bool>> SceneSessionManager::GetWindowDrawingContentChangeInfo(
-    const std::vector<std::pair<uint64_t, bool>>& currDrawingContentData)
+    const WindowLayerChangeContext& context, const std::vector<std::pair<uint64_t, bool>>& currDrawingContentData)
 {
     std::vector<std::pair<uint64_t, bool>> processDrawingContentChangeInfo;
     for (const auto& [surfaceId, isWindowDrawing] : currDrawingContentData) {
         int32_t pid = 0;
-        sptr<SceneSession> session = SelectSesssionFromMap(surfaceId);
+        sptr<SceneSession> session = SelectSessionFromIndex(context, surfaceId);
         bool isDrawingStateChanged =
-            session == nullptr || (GetPreWindowDrawingState(surfaceId, isWindowDrawing, pid) != isWindowDrawing &&
+            session == nullptr ||
+            (GetPreWindowDrawingState(session, surfaceId, isWindowDrawing, pid) != isWindowDrawing &&
                                    GetProcessDrawingState(surfaceId, pid));
         if (isDrawingStateChanged) {
             processDrawingContentChangeInfo.emplace_back(surfaceId, isWindowDrawing);
@@ -11672,9 +11798,9 @@ std::vector<std::pair<uint64_t, bool>> SceneSessionManager::GetWindowDrawingCont
     return processDrawingContentChangeInfo;
 }
 
-bool SceneSessionManager::GetPreWindowDrawingState(uint64_t surfaceId, bool currentWindowDrawing, int32_t& pid)
+bool SceneSessionManager::GetPreWindowDrawingState(const sptr<SceneSession>& session, uint64_t surfaceId,
+    bool currentWindowDrawing, int32_t& pid)
 {
-    sptr<SceneSession> session = SelectSesssionFromMap(surfaceId);
     if (session == nullptr) {
         return false;
     }
@@ -13368,14 +13494,7 @@ void SceneSessionManager::FlushUIParams(ScreenId screenId, std::unordered_map<in
         auto keyboardSession = GetKeyboardSession(screenId, false);
         {
             std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
-            for (const auto& [_, sceneSession] : sceneSessionMap_) {
-                if (sceneSession == nullptr) {
-                    continue;
-                }
-                if (isNotCurrentScreen(sceneSession, screenId)) {
-                    TLOGND(WmsLogTag::WMS_PIPELINE, "%{public}s The screenId of this Scenesession is invalid", where);
-                    continue;
-                }
+            for (const auto& sceneSession : GetSessionsForFlushLocked(screenId)) {
                 if (auto iter = uiParams.find(sceneSession->GetPersistentId()); iter != uiParams.end()) {
                     if (sceneSession->IsAppSession()) {
                         if (!sceneSession->IsVisible()) {
@@ -13415,17 +13534,14 @@ void SceneSessionManager::FlushUIParams(ScreenId screenId, std::unordered_map<in
         }
         FlushWindowInfoToMMI();
         NotifyWindowPropertyChange(screenId);
+        if ((sessionMapDirty_ & (~static_cast<uint32_t>(SessionUIDirtyFlag::AVOID_AREA))) !=
+            static_cast<uint32_t>(SessionUIDirtyFlag::NONE)) {
+            InvalidateWindowLayoutSnapshot();
+        }
         sessionMapDirty_ = 0;
         {
             std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
-            for (const auto& [_, sceneSession] : sceneSessionMap_) {
-                if (sceneSession == nullptr) {
-                    continue;
-                }
-                if (isNotCurrentScreen(sceneSession, screenId)) {
-                    TLOGND(WmsLogTag::WMS_PIPELINE, "%{public}s The screenId of this Scenesession is invalid", where);
-                    continue;
-                }
+            for (const auto& sceneSession : GetSessionsForFlushLocked(screenId)) {
                 sceneSession->ResetSizeChangeReasonIfDirty();
                 sceneSession->ResetDirtyFlags();
                 if (WindowHelper::IsMainWindow(sceneSession->GetWindowType())) {
@@ -13442,6 +13558,58 @@ void SceneSessionManager::FlushUIParams(ScreenId screenId, std::unordered_map<in
     }, __func__);
 }
 
+/**
+ * Sessions of screenId in sceneSessionMap_ order, including sessions not bound to any screen.
+ * The partition is rebuilt only when the map or a session's screen changed, so a flush of one screen
+ * no longer scans the sessions of the other screens.
+ * Must be called on OS_sceneSession thread with sceneSessionMapMutex_ held.
+ */
+const std::vector<sptr<SceneSession>>& SceneSessionManager::GetSessionsForFlushLocked(ScreenId screenId)
+{
+    if (!IsDisplaySessionPartitionValidLocked()) {
+        RebuildDisplaySessionPartitionLocked();
+    }
+    const auto& partition = displaySessionPartition_;
+    auto iter = partition.screenSessions.find(screenId);
+    return iter != partition.screenSessions.end() ? iter->second : partition.unboundSessions;
+}
+
+bool SceneSessionManager::IsDisplaySessionPartitionValidLocked() const
+{
+    const auto& partition = displaySessionPartition_;
+    return partition.valid && partition.mapVersion == sceneSessionMap_.GetVersion() &&
+        partition.screenIdGeneration == Session::GetScreenIdGeneration();
+}
+
+void SceneSessionManager::RebuildDisplaySessionPartitionLocked()
+{
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SceneSessionManager::RebuildDisplaySessionPartition");
+    auto& partition = displaySessionPartition_;
+    partition.screenSessions.clear();
+    partition.unboundSessions.clear();
+    for (const auto& [_, sceneSession] : sceneSessionMap_) {
+        if (sceneSession == nullptr) {
+            continue;
+        }
+        ScreenId sessionScreenId = sceneSession->GetSessionInfo().screenId_;
+        if (sessionScreenId == SCREEN_ID_INVALID) {
+            partition.unboundSessions.push_back(sceneSession);
+            for (auto& [__, screenSessions] : partition.screenSessions) {
+                screenSessions.push_back(sceneSession);
+            }
+            continue;
+        }
+        // a new screen starts with the unbound sessions seen so far to keep the map order
+        auto iter = partition.screenSessions.try_emplace(sessionScreenId, partition.unboundSessions).first;
+        iter->second.push_back(sceneSession);
+    }
+    partition.mapVersion = sceneSessionMap_.GetVersion();
+    partition.screenIdGeneration = Session::GetScreenIdGeneration();
+    partition.valid = true;
+    TLOGD(WmsLogTag::WMS_PIPELINE, "screens: %{public}zu, unbound: %{public}zu",
+        partition.screenSessions.size(), partition.unboundSessions.size());
+}
+
 void SceneSessionManager::ProcessUpdateLastFocusedAppId(const std::vector<std::pair<uint32_t, uint32_t>>& zOrderList)
 {
     auto focusGroup = windowFocusController_->GetFocusGroup(DEFAULT_DISPLAY_ID);
@@ -13922,71 +14090,119 @@ bool SceneSessionManager::FilterForListWindowInfo(const WindowInfoOption& window
 WMError SceneSessionManager::GetAllWindowLayoutInfo(DisplayId displayId,
     std::vector<sptr<WindowLayoutInfo>>& infos)
 {
-    auto task = [this, displayId, &infos, funcName = __func__]() mutable {
-        bool isVirtualDisplay = false;
-        if (displayId == VIRTUAL_DISPLAY_ID) {
-            displayId = DEFAULT_DISPLAY_ID;
-            isVirtualDisplay = true;
+    auto snapshot = LoadCurrentWindowLayoutSnapshot();
+    if (snapshot == nullptr) {
+        TLOGE(WmsLogTag::WMS_LAYOUT, "no layout snapshot");
+        return WMError::WM_ERROR_NULLPTR;
+    }
+    bool isVirtualDisplay = false;
+    if (displayId == VIRTUAL_DISPLAY_ID) {
+        displayId = DEFAULT_DISPLAY_ID;
+        isVirtualDisplay = true;
+    }
+    const int32_t foldLowerScreenPosY = GetFoldLowerScreenPosY();
+    for (const auto& item : snapshot->items) {
+        if (item.displayId != displayId) {
+            continue;
         }
-        std::vector<sptr<SceneSession>> filteredSessions;
-        FilterForGetAllWindowLayoutInfo(displayId, isVirtualDisplay, filteredSessions);
-        for (const auto& session : filteredSessions) {
-            Rect globalScaledRect;
-            session->GetGlobalScaledRect(globalScaledRect);
-            if (isVirtualDisplay) {
-                globalScaledRect.posY_ -= GetFoldLowerScreenPosY();
+        if (displayId == DEFAULT_DISPLAY_ID &&
+            PcFoldScreenManager::GetInstance().IsHalfFoldedOnMainDisplay(item.displayId)) {
+            if (isVirtualDisplay && item.sessionRect.posY_ + item.sessionRect.height_ < foldLowerScreenPosY) {
+                continue;
             }
-            HookWindowInfo hookWindowInfo = GetAppHookWindowInfo(session->GetSessionInfo().bundleName_);
-            if (hookWindowInfo.enableHookWindow && !session->IsFullScreenInForceSplit() &&
-                WindowHelper::IsMainWindow(session->GetWindowType()) &&
-                !MathHelper::NearEqual(hookWindowInfo.widthHookRatio, HookWindowInfo::DEFAULT_WINDOW_SIZE_HOOK_RATIO)) {
-                globalScaledRect.width_ =
-                    static_cast<uint32_t>(globalScaledRect.width_ * hookWindowInfo.widthHookRatio);
-                TLOGD(WmsLogTag::WMS_LAYOUT, "%{public}s: id:%{public}u, hook window width, hooked width:%{public}u, "
-                    "widthHookRatio:%{public}f.", funcName, session->GetPersistentId(), globalScaledRect.width_,
-                    hookWindowInfo.widthHookRatio);
+            if (!isVirtualDisplay && item.sessionRect.posY_ >= foldLowerScreenPosY) {
+                continue;
             }
-            auto windowLayoutInfo = sptr<WindowLayoutInfo>::MakeSptr();
-            windowLayoutInfo->rect = globalScaledRect;
-            infos.emplace_back(windowLayoutInfo);
         }
-        return WMError::WM_OK;
-    };
-    return taskScheduler_->PostSyncTask(task, __func__);
+        Rect globalScaledRect = item.globalScaledRect;
+        if (isVirtualDisplay) {
+            globalScaledRect.posY_ -= foldLowerScreenPosY;
+        }
+        HookWindowInfo hookWindowInfo = GetAppHookWindowInfo(item.bundleName);
+        if (hookWindowInfo.enableHookWindow && !item.isFullScreenInForceSplit && item.isMainWindow &&
+            !MathHelper::NearEqual(hookWindowInfo.widthHookRatio, HookWindowInfo::DEFAULT_WINDOW_SIZE_HOOK_RATIO)) {
+            globalScaledRect.width_ = static_cast<uint32_t>(globalScaledRect.width_ * hookWindowInfo.widthHookRatio);
+            TLOGD(WmsLogTag::WMS_LAYOUT, "id:%{public}d, hook window width, hooked width:%{public}u, "
+                "widthHookRatio:%{public}f.", item.persistentId, globalScaledRect.width_,
+                hookWindowInfo.widthHookRatio);
+        }
+        auto windowLayoutInfo = sptr<WindowLayoutInfo>::MakeSptr();
+        windowLayoutInfo->rect = globalScaledRect;
+        infos.emplace_back(windowLayoutInfo);
+    }
+    return WMError::WM_OK;
+}
+
+/**
+ * Returns a layout snapshot of the current session map. The snapshot is rebuilt on the scene thread by
+ * the first query after sessions were added or removed or a flush changed the layout, later queries
+ * reuse it without waiting.
+ */
+std::shared_ptr<const WindowLayoutSnapshot> SceneSessionManager::LoadCurrentWindowLayoutSnapshot()
+{
+    auto snapshot = windowLayoutSnapshotHolder_.Load();
+    if (snapshot != nullptr) {
+        std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
+        if (snapshot->stamp == GetWindowLayoutSnapshotStampLocked()) {
+            return snapshot;
+        }
+    }
+    return taskScheduler_->PostSyncTask([this] {
+        PublishWindowLayoutSnapshot();
+        return windowLayoutSnapshotHolder_.Load();
+    }, __func__);
+}
+
+WindowLayoutSnapshotStamp SceneSessionManager::GetWindowLayoutSnapshotStampLocked() const
+{
+    WindowLayoutSnapshotStamp stamp;
+    stamp.mapVersion = sceneSessionMap_.GetVersion();
+    stamp.layoutGeneration = windowLayoutGeneration_.load();
+    stamp.displayIdGeneration = WindowSessionProperty::GetDisplayIdGeneration();
+    return stamp;
+}
+
+void SceneSessionManager::InvalidateWindowLayoutSnapshot()
+{
+    windowLayoutGeneration_.fetch_add(1);
 }
 
-void SceneSessionManager::FilterForGetAllWindowLayoutInfo(DisplayId displayId, bool isVirtualDisplay,
-    std::vector<sptr<SceneSession>>& filteredSessions)
+/**
+ * Publishes the layout of the sessions a layout query may report. Display, fold screen and hook
+ * filtering depend on the query and are left to the reader.
+ */
+void SceneSessionManager::PublishWindowLayoutSnapshot()
 {
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SceneSessionManager::PublishWindowLayoutSnapshot");
+    WindowLayoutSnapshot snapshot;
     {
         std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
-        for (const auto& [_, session] : sceneSessionMap_) {
-            if (session == nullptr) {
+        // stamps are taken first, a change racing with the build leaves the snapshot stale rather than wrong
+        snapshot.stamp = GetWindowLayoutSnapshotStampLocked();
+        snapshot.items.reserve(sceneSessionMap_.size());
+        for (const auto& [persistentId, session] : sceneSessionMap_) {
+            if (session == nullptr || session->GetSessionGlobalRect().IsInvalid() ||
+                session->GetVisibilityState() == WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION ||
+                !IsGetWindowLayoutInfoNeeded(session)) {
                 continue;
             }
-            if (session->GetSessionGlobalRect().IsInvalid()) {
-                continue;
-            }
-            if (PcFoldScreenManager::GetInstance().IsHalfFoldedOnMainDisplay(session->GetSessionProperty()->GetDisplayId()) &&
-                displayId == DEFAULT_DISPLAY_ID) {
-                if (isVirtualDisplay &&
-                    session->GetSessionRect().posY_ + session->GetSessionRect().height_ < GetFoldLowerScreenPosY()) {
-                    continue;
-                }
-                if (!isVirtualDisplay && session->GetSessionRect().posY_ >= GetFoldLowerScreenPosY()) {
-                    continue;
-                }
-            }
-            if (IsGetWindowLayoutInfoNeeded(session) && session->GetSessionProperty()->GetDisplayId() == displayId &&
-                session->GetVisibilityState() != WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION) {
-                filteredSessions.emplace_back(session);
-            }
-        }
-    }
-    std::sort(filteredSessions.begin(), filteredSessions.end(),
-              [](const sptr<SceneSession>& lhs, const sptr<SceneSession>& rhs) {
-                  return lhs->GetZOrder() > rhs->GetZOrder();
-              });
+            WindowLayoutSnapshotItem item;
+            item.persistentId = persistentId;
+            item.displayId = session->GetSessionProperty()->GetDisplayId();
+            item.zOrder = session->GetZOrder();
+            item.sessionRect = session->GetSessionRect();
+            session->GetGlobalScaledRect(item.globalScaledRect);
+            item.bundleName = session->GetSessionInfo().bundleName_;
+            item.isMainWindow = WindowHelper::IsMainWindow(session->GetWindowType());
+            item.isFullScreenInForceSplit = session->IsFullScreenInForceSplit();
+            snapshot.items.emplace_back(std::move(item));
+        }
+    }
+    std::stable_sort(snapshot.items.begin(), snapshot.items.end(),
+        [](const WindowLayoutSnapshotItem& lhs, const WindowLayoutSnapshotItem& rhs) {
+            return lhs.zOrder > rhs.zOrder;
+        });
+    windowLayoutSnapshotHolder_.Publish(std::move(snapshot));
 }
 
 int32_t SceneSessionManager::GetFoldLowerScreenPosY() const
@@ -14166,26 +14382,40 @@ void SceneSessionManager::GetAllWindowVisibilityInfos(std::vector<std::pair<int3
 
 void SceneSessionManager::FlushWindowInfoToMMI(const bool forceFlush)
 {
-    auto task = [this, forceFlush] {
-        if (isUserBackground_) {
-            TLOGND(WmsLogTag::WMS_MULTI_USER, "The user is in the background, no need to flush info to MMI");
-            return;
+    RequestFlushWindowInfo(WindowInfoFlushUrgency::IMMEDIATE, forceFlush);
+}
+
+void SceneSessionManager::RequestFlushWindowInfo(WindowInfoFlushUrgency urgency, bool forceFlush)
+{
+    TLOGD(WmsLogTag::WMS_EVENT, "urgency: %{public}u", static_cast<uint32_t>(urgency));
+    windowInfoFlushScheduler_.RequestFlush(urgency, forceFlush);
+}
+
+void SceneSessionManager::FlushWindowInfoToMMIInner(bool forceFlush, std::function<void()>&& onFlushed)
+{
+    if (isUserBackground_) {
+        TLOGD(WmsLogTag::WMS_MULTI_USER, "The user is in the background, no need to flush info to MMI");
+        if (onFlushed) {
+            onFlushed();
         }
-        HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SceneSessionManager::FlushWindowInfoToMMI");
-        SceneInputManager::GetInstance().ResetSessionDirty();
-        auto [windowInfoList, pixelMapList] = SceneInputManager::GetInstance().GetFullWindowInfoList();
-        TLOGND(WmsLogTag::WMS_EVENT, "windowInfoList size: %{public}d", static_cast<int32_t>(windowInfoList.size()));
-        SceneInputManager::GetInstance().
-            FlushDisplayInfoToMMI(std::move(windowInfoList), std::move(pixelMapList), forceFlush);
-    };
-    TLOGD(WmsLogTag::WMS_EVENT, "in");
-    taskScheduler_->PostAsyncTask(task, __func__);
+        return;
+    }
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SceneSessionManager::FlushWindowInfoToMMI");
+    SceneInputManager::GetInstance().ResetSessionDirty();
+    auto [windowInfoList, pixelMapList] = SceneInputManager::GetInstance().GetFullWindowInfoList();
+    TLOGD(WmsLogTag::WMS_EVENT, "windowInfoList size: %{public}d", static_cast<int32_t>(windowInfoList.size()));
+    SceneInputManager::GetInstance().
+        FlushDisplayInfoToMMI(std::move(windowInfoList), std::move(pixelMapList), forceFlush, std::move(onFlushed));
 }
 
+/*
+ * Queued behind the current scene task even when requested from it, so every request raised while
+ * that task runs joins the same flush.
+ */
 void SceneSessionManager::PostFlushWindowInfoTask(FlushWindowInfoTask&& task,
     const std::string& taskName, const int delayTime)
 {
-    taskScheduler_->PostAsyncTask(std::move(task), taskName, delayTime);
+    taskScheduler_->PostQueuedTask(std::move(task), taskName, delayTime);
 }
 
 bool SceneSessionManager::GetExtensionWindowIds(const sptr<IRemoteObject>& token, int32_t& persistentId,
@@ -14999,17 +15229,11 @@ bool SceneSessionManager::SubtractIntersectArea(std::shared_ptr<SkRegion>& unacc
     }
     auto hotAreas = sceneSession->GetTouchHotAreas();
     WSRect wsRect = sceneSession->GetSessionRect();
-    for (auto& rect : hotAreas) {
-        TLOGD(WmsLogTag::WMS_ATTRIBUTE, "id=%{public}d, rect=%{public}s, hotArea=%{public}s",
-            static_cast<int32_t>(sceneSession->GetPersistentId()), wsRect.ToString().c_str(), rect.ToString().c_str());
-        if (rect != Rect::EMPTY_RECT) {
-            rect.posX_ += wsRect.posX_;
-            rect.posY_ += wsRect.posY_;
-        }
-    }
+    TLOGD(WmsLogTag::WMS_ATTRIBUTE, "id=%{public}d, rect=%{public}s, hotAreas=%{public}zu",
+        static_cast<int32_t>(sceneSession->GetPersistentId()), wsRect.ToString().c_str(), hotAreas.size());
+    RectMath::OffsetRects(hotAreas.data(), hotAreas.size(), wsRect.posX_, wsRect.posY_);
     if (hotAreas.empty()) {
-        hotAreas.push_back({.posX_ = wsRect.posX_, .posY_ = wsRect.posY_,
-                            .width_ = wsRect.width_, .height_ = wsRect.height_});
+        hotAreas.push_back(RectMath::ToRect(wsRect));
     }
     bool hasIntersectArea = false;
     for (const auto& rect : hotAreas) {
@@ -15316,36 +15540,75 @@ WMError SceneSessionManager::GetWindowIdsByCoordinate(DisplayId displayId, int32
     std::string callerBundleName = SessionPermission::GetCallingBundleName();
     ChangeWindowRectYInVirtualDisplay(displayId, y);
     bool checkPoint = (x >= 0 && y >= 0);
-    auto func = [displayId, callerBundleName = std::move(callerBundleName), checkPoint, x, y,
-        findAllWindow, &windowNumber, &windowIds](const sptr<SceneSession>& session) {
-        if (session == nullptr) {
-            return false;
-        }
-        if (!findAllWindow && windowNumber == 0) {
-            return true;
+    return taskScheduler_->PostSyncTask([this, displayId, callerBundleName = std::move(callerBundleName), checkPoint,
+        x, y, findAllWindow, windowNumber, &windowIds]() mutable {
+        SyncSessionSpatialIndex();
+        std::vector<int32_t> candidateIds;
+        if (checkPoint) {
+            sessionSpatialIndex_.Query(displayId, x, y, candidateIds);
+        } else {
+            sessionSpatialIndex_.QueryDisplay(displayId, candidateIds);
         }
-        bool isSameBundleName = session->GetSessionInfo().bundleName_ == callerBundleName;
-        bool isSameDisplayId = session->GetSessionProperty()->GetDisplayId() == displayId;
-        bool isRsVisible = session->GetRSVisible();
-        WSRect windowRect = session->GetSessionRect();
-        bool isPointInWindowRect = SessionHelper::IsPointInRect(x, y, SessionHelper::TransferToRect(windowRect));
-        TLOGND(WmsLogTag::DEFAULT, "persistentId %{public}d bundleName %{public}s displayId %{public}" PRIu64
-               " isRsVisible %{public}d checkPoint %{public}d isPointInWindowRect %{public}d",
-               session->GetPersistentId(), session->GetSessionInfo().bundleName_.c_str(),
-               session->GetSessionProperty()->GetDisplayId(), isRsVisible, checkPoint, isPointInWindowRect);
-        if (!isSameBundleName || !isSameDisplayId || !isRsVisible || (checkPoint && !isPointInWindowRect)) {
-            return false;
+        for (auto persistentId : candidateIds) {
+            if (!findAllWindow && windowNumber == 0) {
+                break;
+            }
+            auto session = GetSceneSession(persistentId);
+            if (session == nullptr) {
+                continue;
+            }
+            bool isSameBundleName = session->GetSessionInfo().bundleName_ == callerBundleName;
+            bool isSameDisplayId = session->GetSessionProperty()->GetDisplayId() == displayId;
+            bool isRsVisible = session->GetRSVisible();
+            WSRect windowRect = session->GetSessionRect();
+            bool isPointInWindowRect = SessionHelper::IsPointInRect(x, y, SessionHelper::TransferToRect(windowRect));
+            TLOGND(WmsLogTag::DEFAULT, "persistentId %{public}d bundleName %{public}s displayId %{public}" PRIu64
+                   " isRsVisible %{public}d checkPoint %{public}d isPointInWindowRect %{public}d",
+                   session->GetPersistentId(), session->GetSessionInfo().bundleName_.c_str(),
+                   session->GetSessionProperty()->GetDisplayId(), isRsVisible, checkPoint, isPointInWindowRect);
+            if (!isSameBundleName || !isSameDisplayId || !isRsVisible || (checkPoint && !isPointInWindowRect)) {
+                continue;
+            }
+            windowIds.emplace_back(session->GetPersistentId());
+            windowNumber--;
         }
-        windowIds.emplace_back(session->GetPersistentId());
-        windowNumber--;
-        return false;
-    };
-    return taskScheduler_->PostSyncTask([this, func = std::move(func)] {
-        TraverseSessionTree(func, true);
         return WMError::WM_OK;
     }, __func__);
 }
 
+/**
+ * Brings the hit-test index up to date. Only the sessions whose rect or zOrder changed are updated,
+ * the index is rebuilt when sessions were added or removed or a display id changed.
+ */
+void SceneSessionManager::SyncSessionSpatialIndex()
+{
+    std::shared_lock<std::shared_mutex> lock(sceneSessionMapMutex_);
+    auto& stamp = sessionSpatialIndexStamp_;
+    bool needRebuild = !stamp.valid || stamp.mapVersion != sceneSessionMap_.GetVersion() ||
+        stamp.displayIdGeneration != WindowSessionProperty::GetDisplayIdGeneration();
+    if (needRebuild) {
+        HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "SceneSessionManager::RebuildSessionSpatialIndex");
+        stamp.mapVersion = sceneSessionMap_.GetVersion();
+        stamp.displayIdGeneration = WindowSessionProperty::GetDisplayIdGeneration();
+        sessionSpatialIndex_.Clear();
+    }
+    for (const auto& [persistentId, sceneSession] : sceneSessionMap_) {
+        if (sceneSession == nullptr) {
+            continue;
+        }
+        // the flag is taken before the rect is read, a change racing with the update is applied next time
+        bool isDirty = sceneSession->GetLayoutController()->TakeHitTestDirty();
+        if (isDirty || needRebuild) {
+            sessionSpatialIndex_.Update(persistentId, sceneSession->GetSessionProperty()->GetDisplayId(),
+                sceneSession->GetSessionRect(), sceneSession->GetZOrder());
+        }
+    }
+    stamp.valid = true;
+    if (needRebuild) {
+        TLOGD(WmsLogTag::DEFAULT, "sessions: %{public}zu", sessionSpatialIndex_.GetSize());
+    }
+}
+
 void SceneSessionManager::ChangeWindowRectYInVirtualDisplay(DisplayId& displayId, int32_t& y)
 {
     if (displayId != VIRTUAL_DISPLAY_ID) {
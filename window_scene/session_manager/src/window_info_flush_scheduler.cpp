@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_info_flush_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include <hitrace_meter.h>
+#include <parameters.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+const std::string IMMEDIATE_FLUSH_TASK = "FlushWindowInfoImmediate";
+const std::string BATCHED_FLUSH_TASK = "FlushWindowInfoBatched";
+constexpr int64_t DEFAULT_BATCH_DELAY_MS = 10;
+constexpr int64_t DEFAULT_MIN_BATCH_DELAY_MS = 4;
+constexpr int64_t DEFAULT_MAX_BATCH_DELAY_MS = 32;
+constexpr uint64_t BUSY_SERVED_THRESHOLD = 8;
+constexpr int64_t US_PER_MS = 1000;
+
+int64_t GetSteadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+WindowInfoFlushScheduler::WindowInfoFlushScheduler()
+{
+    minBatchDelayMs_ = system::GetIntParameter<int64_t>(
+        "persist.window.input.flush_min_delay_ms", DEFAULT_MIN_BATCH_DELAY_MS);
+    maxBatchDelayMs_ = system::GetIntParameter<int64_t>(
+        "persist.window.input.flush_max_delay_ms", DEFAULT_MAX_BATCH_DELAY_MS);
+    if (minBatchDelayMs_ < 0 || maxBatchDelayMs_ < minBatchDelayMs_) {
+        minBatchDelayMs_ = DEFAULT_MIN_BATCH_DELAY_MS;
+        maxBatchDelayMs_ = DEFAULT_MAX_BATCH_DELAY_MS;
+    }
+    batchDelayMs_ = std::clamp(DEFAULT_BATCH_DELAY_MS, minBatchDelayMs_, maxBatchDelayMs_);
+}
+
+void WindowInfoFlushScheduler::Init(PostTaskFunc&& postTaskFunc, FlushFunc&& flushFunc)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    postTaskFunc_ = std::move(postTaskFunc);
+    flushFunc_ = std::move(flushFunc);
+}
+
+void WindowInfoFlushScheduler::RequestFlush(WindowInfoFlushUrgency urgency, bool forceFlush)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!postTaskFunc_) {
+        TLOGW(WmsLogTag::WMS_EVENT, "not init");
+        return;
+    }
+    pendingRequests_++;
+    pendingForceFlush_ = pendingForceFlush_ || forceFlush;
+    stat_.requestCount++;
+    int64_t delayMs = 0;
+    if (urgency == WindowInfoFlushUrgency::IMMEDIATE) {
+        if (hasImmediateTask_) {
+            return;
+        }
+        hasImmediateTask_ = true;
+    } else {
+        // an immediate flush already pending serves this request as well
+        if (hasImmediateTask_ || hasBatchedTask_) {
+            return;
+        }
+        hasBatchedTask_ = true;
+        delayMs = batchDelayMs_;
+    }
+    auto postTaskFunc = postTaskFunc_;
+    lock.unlock();
+    postTaskFunc([this, urgency] { OnFlushTask(urgency); },
+        urgency == WindowInfoFlushUrgency::IMMEDIATE ? IMMEDIATE_FLUSH_TASK : BATCHED_FLUSH_TASK, delayMs);
+}
+
+void WindowInfoFlushScheduler::OnFlushTask(WindowInfoFlushUrgency urgency)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (urgency == WindowInfoFlushUrgency::IMMEDIATE) {
+        hasImmediateTask_ = false;
+    } else {
+        hasBatchedTask_ = false;
+    }
+    if (pendingRequests_ == 0 || !flushFunc_) {
+        return;
+    }
+    uint64_t served = pendingRequests_;
+    bool forceFlush = pendingForceFlush_;
+    pendingRequests_ = 0;
+    pendingForceFlush_ = false;
+    auto flushFunc = flushFunc_;
+    lock.unlock();
+
+    HITRACE_METER_FMT(HITRACE_TAG_WINDOW_MANAGER, "FlushWindowInfo served:%" PRIu64, served);
+    int64_t startTimeUs = GetSteadyTimeUs();
+    flushFunc(forceFlush, [this, urgency, served, startTimeUs] {
+        OnFlushed(urgency, served, GetSteadyTimeUs() - startTimeUs);
+    });
+}
+
+void WindowInfoFlushScheduler::OnFlushed(WindowInfoFlushUrgency urgency, uint64_t served, int64_t costUs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stat_.flushCount++;
+    if (urgency == WindowInfoFlushUrgency::IMMEDIATE) {
+        stat_.immediateFlushCount++;
+    }
+    stat_.lastServed = served;
+    stat_.maxServed = std::max(stat_.maxServed, served);
+    stat_.totalCostUs += costUs;
+    stat_.lastCostUs = costUs;
+    stat_.maxCostUs = std::max(stat_.maxCostUs, costUs);
+    AdaptBatchDelayLocked(served, costUs);
+}
+
+/*
+ * A busy flush, many requests or a cost close to the window itself, stretches the batch window,
+ * a flush that served a single request shrinks it back.
+ */
+void WindowInfoFlushScheduler::AdaptBatchDelayLocked(uint64_t served, int64_t costUs)
+{
+    if (served >= BUSY_SERVED_THRESHOLD || costUs * 2 > batchDelayMs_ * US_PER_MS) { // 2: half of the window
+        batchDelayMs_ = std::min(std::max<int64_t>(batchDelayMs_ * 2, 1), maxBatchDelayMs_); // 2: double
+    } else if (served <= 1) {
+        batchDelayMs_ = std::max(batchDelayMs_ / 2, minBatchDelayMs_); // 2: half
+    }
+    stat_.batchDelayMs = batchDelayMs_;
+}
+
+void WindowInfoFlushScheduler::SetBatchDelayRange(int64_t minDelayMs, int64_t maxDelayMs)
+{
+    if (minDelayMs < 0 || maxDelayMs < minDelayMs) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    minBatchDelayMs_ = minDelayMs;
+    maxBatchDelayMs_ = maxDelayMs;
+    batchDelayMs_ = std::clamp(batchDelayMs_, minBatchDelayMs_, maxBatchDelayMs_);
+}
+
+WindowInfoFlushStat WindowInfoFlushScheduler::GetStat() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    WindowInfoFlushStat stat = stat_;
+    stat.batchDelayMs = batchDelayMs_;
+    return stat;
+}
+
+void WindowInfoFlushScheduler::ResetStat()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stat_ = {};
+}
+
+void WindowInfoFlushScheduler::DumpInfo(std::string& dumpInfo) const
+{
+    auto stat = GetStat();
+    int64_t avgCostUs = stat.flushCount == 0 ? 0 : stat.totalCostUs / static_cast<int64_t>(stat.flushCount);
+    double avgServed = stat.flushCount == 0 ? 0.0 :
+        static_cast<double>(stat.requestCount) / static_cast<double>(stat.flushCount);
+    std::ostringstream oss;
+    oss << "Flush window info:" << std::endl;
+    oss << "Requests  Flushes  Immediate  AvgServed  LastServed  MaxServed" << std::endl;
+    oss << stat.requestCount << "  " << stat.flushCount << "  " << stat.immediateFlushCount << "  "
+        << avgServed << "  " << stat.lastServed << "  " << stat.maxServed << std::endl;
+    oss << "AvgCost(us)  LastCost(us)  MaxCost(us)  BatchDelay(ms)" << std::endl;
+    oss << avgCostUs << "  " << stat.lastCostUs << "  " << stat.maxCostUs << "  " << stat.batchDelayMs << std::endl;
+    dumpInfo.append(oss.str());
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "session_manager/include/window_layout_snapshot.h"
+
+#include <atomic>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS::Rosen {
+uint64_t WindowLayoutSnapshotHolder::Publish(WindowLayoutSnapshot&& snapshot)
+{
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    auto current = std::atomic_load(&snapshot_);
+    if (current != nullptr && current->stamp == snapshot.stamp && current->items == snapshot.items) {
+        return current->version;
+    }
+    snapshot.version = ++version_;
+    TLOGD(WmsLogTag::WMS_LAYOUT, "version: %{public}" PRIu64 ", items: %{public}zu",
+        snapshot.version, snapshot.items.size());
+    std::atomic_store(&snapshot_, std::shared_ptr<const WindowLayoutSnapshot>(
+        std::make_shared<WindowLayoutSnapshot>(std::move(snapshot))));
+    return version_;
+}
+
+std::shared_ptr<const WindowLayoutSnapshot> WindowLayoutSnapshotHolder::Load() const
+{
+    return std::atomic_load(&snapshot_);
+}
+
+void WindowLayoutSnapshotHolder::Reset()
+{
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    std::atomic_store(&snapshot_, std::shared_ptr<const WindowLayoutSnapshot>());
+}
+} // namespace OHOS::Rosen
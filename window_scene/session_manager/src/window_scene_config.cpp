@@ -20,11 +20,15 @@
 #include "libxml/tree.h"
 #include "window_helper.h"
 #include "window_manager_hilog.h"
+#include "xml_config_cache.h"
 
 namespace OHOS {
 namespace Rosen {
 namespace {
 constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowSceneConfig"};
+constexpr const char* CONFIG_CACHE_PATH = "/data/service/el1/public/window/window_manager_config.cache";
+// bump when ReadConfig produces a different tree for the same xml
+constexpr uint32_t CONFIG_CACHE_VERSION = 1;
 }
 
 WindowSceneConfig::ConfigItem WindowSceneConfig::config_;
@@ -192,6 +196,55 @@ void WindowSceneConfig::ReadConfig(const xmlNodePtr& rootPtr, std::map<std::stri
 bool WindowSceneConfig::LoadConfigXml()
 {
     auto configFilePath = GetConfigPath("etc/window/resources/window_manager_config.xml");
+    return LoadConfig(configFilePath, CONFIG_CACHE_PATH);
+}
+
+bool WindowSceneConfig::LoadConfig(const std::string& configFilePath, const std::string& cachePath)
+{
+    XmlConfigSource source;
+    bool hasSource = XmlConfigCache::GetSource(configFilePath, source);
+    if (hasSource && LoadConfigCache(cachePath, source)) {
+        WLOGI("filePath: %{public}s, loaded from cache", configFilePath.c_str());
+        return true;
+    }
+    if (!ParseConfigXml(configFilePath)) {
+        return false;
+    }
+    if (hasSource) {
+        XmlConfigCacheWriter writer;
+        writer.WriteConfigItem(config_);
+        XmlConfigCache::Store(cachePath, source, GetConfigCacheVersion(), writer);
+    }
+    return true;
+}
+
+bool WindowSceneConfig::LoadConfigCache(const std::string& cachePath, const XmlConfigSource& source)
+{
+    ConfigItem config;
+    bool ret = XmlConfigCache::Load(cachePath, source, GetConfigCacheVersion(),
+        [&config](XmlConfigCacheReader& reader) {
+            return reader.ReadConfigItem(config) && config.IsMap();
+        });
+    if (ret) {
+        config_ = std::move(config);
+    }
+    return ret;
+}
+
+uint32_t WindowSceneConfig::GetConfigCacheVersion()
+{
+    // the parsed tree depends on the known items, a changed item table invalidates the cache by itself
+    XmlConfigCacheWriter writer;
+    writer.WriteUint32(CONFIG_CACHE_VERSION);
+    for (const auto& [name, type] : configItemTypeMap_) {
+        writer.WriteString(name);
+        writer.WriteUint32(static_cast<uint32_t>(type));
+    }
+    return static_cast<uint32_t>(XmlConfigCache::Hash(writer.GetData().data(), writer.GetData().size()));
+}
+
+bool WindowSceneConfig::ParseConfigXml(const std::string& configFilePath)
+{
     xmlDocPtr docPtr = nullptr;
     {
         std::lock_guard<std::recursive_mutex> lock(mutex_);
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "fold_screen_controller/posture_sample_filter.h"
+#include "fold_screen_controller/sensor_fold_state_manager/single_display_sensor_fold_state_manager.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+class PostureSampleFilterTest : public testing::Test {
+};
+
+namespace {
+constexpr int64_t SAMPLE_INTERVAL_MS = 10;
+constexpr uint16_t HALL_FOLDED = 0;
+constexpr uint16_t HALL_EXPANDED = 1;
+
+struct PostureSample {
+    int64_t timestampMs = 0;
+    float angle = 0.0F;
+    uint16_t hall = HALL_EXPANDED;
+};
+
+struct ReplayResult {
+    std::vector<int64_t> transitionMs;
+    FoldStatus finalState = FoldStatus::UNKNOWN;
+};
+
+/*
+ * Deterministic jitter of at most 0.2 degree, below the default deadband.
+ */
+float Jitter(int64_t index)
+{
+    return static_cast<float>(index * 7 % 5 - 2) * 0.1F;
+}
+
+std::vector<float> GetSingleDisplayThresholds()
+{
+    return SingleDisplaySensorFoldStateManager().GetAngleThresholds();
+}
+
+/*
+ * Replays the trace into a single display fold state manager, through the filter when one is given.
+ * Flush timers fire settleMs after the filter asked for them, the last one after the trace ends.
+ */
+ReplayResult Replay(const std::vector<PostureSample>& trace, PostureSampleFilter* filter)
+{
+    sptr<SingleDisplaySensorFoldStateManager> manager = sptr<SingleDisplaySensorFoldStateManager>::MakeSptr();
+    ReplayResult result;
+    auto classify = [&manager, &result](float angle, uint16_t hall, int64_t timestampMs) {
+        FoldStatus previousState = manager->GetCurrentState();
+        manager->HandleAngleChange(angle, hall, nullptr);
+        if (manager->GetCurrentState() != previousState) {
+            result.transitionMs.push_back(timestampMs);
+        }
+    };
+    std::vector<int64_t> flushMs;
+    auto fireFlushTimers = [&filter, &classify, &flushMs](int64_t nowMs) {
+        while (!flushMs.empty() && flushMs.front() <= nowMs) {
+            std::vector<float> angles;
+            std::vector<uint16_t> halls;
+            if (filter->Flush(angles, halls, flushMs.front())) {
+                classify(angles[0], halls[0], flushMs.front());
+            }
+            flushMs.erase(flushMs.begin());
+        }
+    };
+    for (const auto& sample : trace) {
+        if (filter == nullptr) {
+            classify(sample.angle, sample.hall, sample.timestampMs);
+            continue;
+        }
+        fireFlushTimers(sample.timestampMs);
+        bool needFlush = false;
+        if (filter->Accept({ sample.angle }, { sample.hall }, sample.timestampMs, needFlush)) {
+            classify(sample.angle, sample.hall, sample.timestampMs);
+        } else if (needFlush) {
+            flushMs.push_back(sample.timestampMs + filter->GetSettleMs());
+        }
+    }
+    if (filter != nullptr) {
+        fireFlushTimers(INT64_MAX);
+    }
+    result.finalState = manager->GetCurrentState();
+    return result;
+}
+
+/**
+ * @tc.name: NoisyHoldNearThreshold
+ * @tc.desc: jitter inside the hysteresis band is mostly dropped and does not change the transitions
+ * @tc.type: FUNC
+ */
+HWTEST_F(PostureSampleFilterTest, NoisyHoldNearThreshold, TestSize.Level1)
+{
+    std::vector<PostureSample> trace;
+    for (int64_t i = 0; i < 210; i++) {
+        float angle = i < 10 ? 20.0F : 30.0F;
+        trace.push_back({ i * SAMPLE_INTERVAL_MS, angle + Jitter(i), HALL_FOLDED });
+    }
+    PostureSampleFilter filter;
+    filter.SetAngleThresholds(GetSingleDisplayThresholds());
+    ReplayResult filtered = Replay(trace, &filter);
+    ReplayResult unfiltered = Replay(trace, nullptr);
+    EXPECT_EQ(filtered.transitionMs, unfiltered.transitionMs);
+    EXPECT_EQ(filtered.finalState, FoldStatus::FOLDED);
+    EXPECT_EQ(filter.GetReceivedCount(), trace.size());
+    EXPECT_LE(filter.GetForwardedCount(), trace.size() / 5);
+}
+
+/**
+ * @tc.name: SlowOpen
+ * @tc.desc: a slow open crosses the same states at the same samples as without the filter
+ * @tc.type: FUNC
+ */
+HWTEST_F(PostureSampleFilterTest, SlowOpen, TestSize.Level1)
+{
+    std::vector<PostureSample> trace;
+    for (int64_t i = 0; i <= 600; i++) {
+        float angle = static_cast<float>(i) * 0.3F;
+        trace.push_back({ i * SAMPLE_INTERVAL_MS, angle + Jitter(i), i < 10 ? HALL_FOLDED : HALL_EXPANDED });
+    }
+    PostureSampleFilter filter;
+    filter.SetAngleThresholds(GetSingleDisplayThresholds());
+    ReplayResult filtered = Replay(trace, &filter);
+    ReplayResult unfiltered = Replay(trace, nullptr);
+    EXPECT_EQ(filtered.transitionMs.size(), 3);
+    EXPECT_EQ(filtered.transitionMs, unfiltered.transitionMs);
+    EXPECT_EQ(filtered.finalState, FoldStatus::EXPAND);
+    EXPECT_LT(filter.GetForwardedCount(), filter.GetReceivedCount());
+}
+
+/**
+ * @tc.name: ThresholdCrossingForwardedAtOnce
+ * @tc.desc: a change below the deadband is forwarded at once when it crosses a threshold
+ * @tc.type: FUNC
+ */
+HWTEST_F(PostureSampleFilterTest, ThresholdCrossingForwardedAtOnce, TestSize.Level1)
+{
+    PostureSampleFilter filter;
+    filter.SetAngleThresholds(GetSingleDisplayThresholds());
+    bool needFlush = false;
+    EXPECT_TRUE(filter.Accept({ 139.8F }, { HALL_EXPANDED }, 0, needFlush));
+    EXPECT_FALSE(filter.Accept({ 139.9F }, { HALL_EXPANDED }, 10, needFlush));
+    EXPECT_TRUE(needFlush);
+    EXPECT_TRUE(filter.Accept({ 140.0F }, { HALL_EXPANDED }, 20, needFlush));
+    EXPECT_FALSE(needFlush);
+
+    PostureSampleFilter unknownThresholds;
+    EXPECT_TRUE(unknownThresholds.Accept({ 139.8F }, { HALL_EXPANDED }, 0, needFlush));
+    EXPECT_TRUE(unknownThresholds.Accept({ 139.9F }, { HALL_EXPANDED }, 10, needFlush));
+}
+
+/**
+ * @tc.name: FinalAngleFlushed
+ * @tc.desc: the last held back angle of a movement is delivered by the flush timer
+ * @tc.type: FUNC
+ */
+HWTEST_F(PostureSampleFilterTest, FinalAngleFlushed, TestSize.Level1)
+{
+    PostureSampleFilter filter;
+    filter.SetAngleThresholds(GetSingleDisplayThresholds());
+    bool needFlush = false;
+    EXPECT_TRUE(filter.Accept({ 100.0F }, { HALL_EXPANDED }, 0, needFlush));
+    EXPECT_FALSE(filter.Accept({ 100.2F }, { HALL_EXPANDED }, 10, needFlush));
+    EXPECT_TRUE(needFlush);
+    EXPECT_FALSE(filter.Accept({ 100.4F }, { HALL_EXPANDED }, 20, needFlush));
+    EXPECT_FALSE(needFlush);
+
+    std::vector<float> angles;
+    std::vector<uint16_t> halls;
+    ASSERT_TRUE(filter.Flush(angles, halls, 110));
+    ASSERT_EQ(angles.size(), 1);
+    EXPECT_FLOAT_EQ(angles[0], 100.4F);
+    EXPECT_EQ(halls, std::vector<uint16_t>({ HALL_EXPANDED }));
+    EXPECT_FALSE(filter.Flush(angles, halls, 120));
+
+    // a held back change that returns to the forwarded angle leaves nothing to flush
+    EXPECT_FALSE(filter.Accept({ 100.6F }, { HALL_EXPANDED }, 130, needFlush));
+    EXPECT_FALSE(filter.Accept({ 100.4F }, { HALL_EXPANDED }, 140, needFlush));
+    EXPECT_FALSE(filter.Flush(angles, halls, 230));
+    EXPECT_EQ(filter.GetForwardedCount(), 2);
+}
+
+/**
+ * @tc.name: HallChangeForwardedAtOnce
+ * @tc.desc: a hall change is forwarded even inside the min interval
+ * @tc.type: FUNC
+ */
+HWTEST_F(PostureSampleFilterTest, HallChangeForwardedAtOnce, TestSize.Level1)
+{
+    PostureSampleFilterConfig config;
+    config.minIntervalMs = 50;
+    PostureSampleFilter filter(config);
+    filter.SetAngleThresholds(GetSingleDisplayThresholds());
+    bool needFlush = false;
+    EXPECT_TRUE(filter.Accept({ 100.0F }, { HALL_EXPANDED }, 0, needFlush));
+    EXPECT_FALSE(filter.Accept({ 120.0F }, { HALL_EXPANDED }, 10, needFlush));
+    EXPECT_TRUE(filter.Accept({ 120.0F }, { HALL_FOLDED }, 20, needFlush));
+    EXPECT_FALSE(filter.Accept({ 120.0F }, { HALL_FOLDED }, 200, needFlush));
+
+    filter.Reset();
+    EXPECT_TRUE(filter.Accept({ 120.0F }, { HALL_FOLDED }, 210, needFlush));
+    EXPECT_EQ(filter.GetForwardedCount(), 3);
+}
+
+/**
+ * @tc.name: StaleSampleNotApplied
+ * @tc.desc: a forwarded sample applied after a newer flushed one is rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(PostureSampleFilterTest, StaleSampleNotApplied, TestSize.Level1)
+{
+    PostureSampleFilter filter;
+    filter.SetAngleThresholds(GetSingleDisplayThresholds());
+    bool needFlush = false;
+    uint64_t forwardedSequence = 0;
+    EXPECT_TRUE(filter.Accept({ 100.0F }, { HALL_EXPANDED }, 0, needFlush, forwardedSequence));
+    uint64_t heldSequence = 0;
+    EXPECT_FALSE(filter.Accept({ 100.2F }, { HALL_EXPANDED }, 10, needFlush, heldSequence));
+    EXPECT_EQ(heldSequence, 0);
+
+    std::vector<float> angles;
+    std::vector<uint16_t> halls;
+    uint64_t flushedSequence = 0;
+    ASSERT_TRUE(filter.Flush(angles, halls, 110, flushedSequence));
+    EXPECT_GT(flushedSequence, forwardedSequence);
+
+    // the flush task ran before the task carrying the earlier forwarded sample
+    EXPECT_TRUE(filter.MarkApplied(flushedSequence));
+    EXPECT_FALSE(filter.MarkApplied(forwardedSequence));
+    EXPECT_FALSE(filter.MarkApplied(flushedSequence));
+
+    filter.Reset();
+    uint64_t nextSequence = 0;
+    EXPECT_TRUE(filter.Accept({ 100.0F }, { HALL_EXPANDED }, 120, needFlush, nextSequence));
+    EXPECT_TRUE(filter.MarkApplied(nextSequence));
+}
+
+/**
+ * @tc.name: Decimation
+ * @tc.desc: a fast moving hinge is forwarded at most once per min interval, threshold crossings excepted
+ * @tc.type: FUNC
+ */
+HWTEST_F(PostureSampleFilterTest, Decimation, TestSize.Level1)
+{
+    PostureSampleFilterConfig config;
+    config.minIntervalMs = 50;
+    std::vector<PostureSample> trace;
+    for (int64_t i = 0; i < 90; i++) {
+        trace.push_back({ i * SAMPLE_INTERVAL_MS, static_cast<float>(i) * 2.0F, i < 5 ? HALL_FOLDED : HALL_EXPANDED });
+    }
+    PostureSampleFilter filter(config);
+    filter.SetAngleThresholds(GetSingleDisplayThresholds());
+    ReplayResult filtered = Replay(trace, &filter);
+    ReplayResult unfiltered = Replay(trace, nullptr);
+    EXPECT_LT(filter.GetForwardedCount(), trace.size() / 2);
+    EXPECT_EQ(filtered.transitionMs, unfiltered.transitionMs);
+    EXPECT_EQ(filtered.finalState, FoldStatus::EXPAND);
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
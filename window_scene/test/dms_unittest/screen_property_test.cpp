@@ -970,6 +970,24 @@ HWTEST_F(ScreenPropertyTest, SetPhysicalTouchBounds, TestSize.Level1)
     EXPECT_EQ(property->physicalTouchBounds_.rect_.width_, 100);
     EXPECT_EQ(property->physicalTouchBounds_.rect_.height_, 200);
 }
+
+/**
+ * @tc.name: GetGeneration
+ * @tc.desc: setters of display info fields bump the generation, others leave it
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenPropertyTest, GetGeneration, TestSize.Level1)
+{
+    ScreenProperty property;
+    uint64_t generation = property.GetGeneration();
+    property.SetScreenRealWidth(100);
+    EXPECT_EQ(generation, property.GetGeneration());
+    property.UpdateDeviceRotation(Rotation::ROTATION_90);
+    EXPECT_NE(generation, property.GetGeneration());
+    generation = property.GetGeneration();
+    property.SetAvailableArea({ 0, 0, 100, 100 });
+    EXPECT_NE(generation, property.GetGeneration());
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
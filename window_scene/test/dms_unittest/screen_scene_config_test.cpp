@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
 #include <libxml/globals.h>
 #include <libxml/xmlstring.h>
 
@@ -24,6 +26,7 @@
 #include "screen_session_manager.h"
 #include "scene_board_judgement.h"
 #include "fold_screen_state_internel.h"
+#include "xml_config_cache.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -1274,6 +1277,118 @@ HWTEST_F(ScreenSceneConfigTest, IsSupportDuringCall02, TestSize.Level1)
     bool res = ScreenSceneConfig::IsSupportDuringCall();
     EXPECT_FALSE(res);
 }
+
+const std::string CACHE_TEST_XML = R"(<?xml version='1.0' encoding="utf-8"?>
+<Configs>
+    <dpi>480</dpi>
+    <isWaterfallDisplay enable="true"></isWaterfallDisplay>
+    <curvedScreenBoundary>104 0 104 0</curvedScreenBoundary>
+    <defaultDisplayCutoutPath>M 100,100 L 200,100 L 200,150 L 100,150 Z</defaultDisplayCutoutPath>
+    <hallSwitchApp>
+        <packageName>com.example.first</packageName>
+        <packageName>com.example.second</packageName>
+    </hallSwitchApp>
+    <physicalDisplayResolution displayMode="FOLD_DISPLAY_MODE_FULL">2224:2496</physicalDisplayResolution>
+    <scrollableParam displayMode="FOLD_DISPLAY_MODE_MAIN">1.0:0.6</scrollableParam>
+    <displays>
+        <display>
+            <physicalId>0</physicalId>
+            <logicalId>0</logicalId>
+            <name>main</name>
+            <dpi>480</dpi>
+            <flags><flag type="builtin" value="1"/></flags>
+        </display>
+    </displays>
+</Configs>
+)";
+
+void ClearScreenSceneConfig()
+{
+    ScreenSceneConfig::enableConfig_.clear();
+    ScreenSceneConfig::intNumbersConfig_.clear();
+    ScreenSceneConfig::stringConfig_.clear();
+    ScreenSceneConfig::stringListConfig_.clear();
+    ScreenSceneConfig::displaysConfigs_.clear();
+    ScreenSceneConfig::displayPhysicalResolution_.clear();
+    ScreenSceneConfig::scrollableParams_.clear();
+    ScreenSceneConfig::cutoutSvgBoundaryRects_.clear();
+    ScreenSceneConfig::isWaterfallDisplay_ = false;
+}
+
+std::vector<uint8_t> EncodeScreenSceneConfig()
+{
+    XmlConfigCacheWriter writer;
+    ScreenSceneConfig::WriteConfigCache(writer);
+    return writer.GetData();
+}
+
+/**
+ * @tc.name: ConfigCacheParity
+ * @tc.desc: the config loaded from the cache equals the config parsed from the xml
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenSceneConfigTest, ConfigCacheParity, TestSize.Level1)
+{
+    const std::string xmlPath = "/data/test/screen_scene_config_cache_test.xml";
+    const std::string cachePath = "/data/test/screen_scene_config_cache_test.cache";
+    {
+        std::ofstream file(xmlPath, std::ios::trunc);
+        file << CACHE_TEST_XML;
+    }
+    std::remove(cachePath.c_str());
+    ClearScreenSceneConfig();
+    ASSERT_TRUE(ScreenSceneConfig::LoadConfig(xmlPath, cachePath));
+    EXPECT_EQ(ScreenSceneConfig::displaysConfigs_.size(), 1);
+    EXPECT_EQ(ScreenSceneConfig::displayPhysicalResolution_.size(), 1);
+    auto parsed = EncodeScreenSceneConfig();
+
+    XmlConfigSource source;
+    ASSERT_TRUE(XmlConfigCache::GetSource(xmlPath, source));
+    ClearScreenSceneConfig();
+    ASSERT_TRUE(XmlConfigCache::Load(cachePath, source, ScreenSceneConfig::GetConfigCacheVersion(),
+        ScreenSceneConfig::ReadConfigCache));
+    EXPECT_EQ(parsed, EncodeScreenSceneConfig());
+    EXPECT_TRUE(ScreenSceneConfig::IsWaterfallDisplay());
+    EXPECT_EQ(ScreenSceneConfig::GetStringListConfig().at("hallSwitchApp").size(), 2);
+    EXPECT_EQ(ScreenSceneConfig::GetFoldDisplayMode(2496, 2224), FoldDisplayMode::FULL);
+    ScreenSceneConfig::SetCutoutSvgPath(0, ScreenSceneConfig::GetStringConfig().at("defaultDisplayCutoutPath"));
+    DMRect expectedRect = { 100, 100, 100, 50 };
+    EXPECT_EQ(ScreenSceneConfig::GetCutoutBoundaryRect(0).front(), expectedRect);
+
+    {
+        std::ofstream file(xmlPath, std::ios::app);
+        file << "<!-- changed -->";
+    }
+    ASSERT_TRUE(XmlConfigCache::GetSource(xmlPath, source));
+    ClearScreenSceneConfig();
+    EXPECT_FALSE(XmlConfigCache::Load(cachePath, source, ScreenSceneConfig::GetConfigCacheVersion(),
+        ScreenSceneConfig::ReadConfigCache));
+    EXPECT_TRUE(ScreenSceneConfig::displaysConfigs_.empty());
+    ClearScreenSceneConfig();
+    std::remove(xmlPath.c_str());
+    std::remove(cachePath.c_str());
+}
+
+/**
+ * @tc.name: ParseConfigXmlOnce
+ * @tc.desc: every node outside displays is parsed once, list configs are not duplicated
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenSceneConfigTest, ParseConfigXmlOnce, TestSize.Level1)
+{
+    const std::string xmlPath = "/data/test/screen_scene_config_parse_test.xml";
+    {
+        std::ofstream file(xmlPath, std::ios::trunc);
+        file << CACHE_TEST_XML;
+    }
+    ClearScreenSceneConfig();
+    ASSERT_TRUE(ScreenSceneConfig::ParseConfigXml(xmlPath));
+    EXPECT_EQ(ScreenSceneConfig::displayPhysicalResolution_.size(), 1);
+    EXPECT_EQ(ScreenSceneConfig::displaysConfigs_.size(), 1);
+    EXPECT_EQ(ScreenSceneConfig::GetStringListConfig().at("hallSwitchApp").size(), 2);
+    ClearScreenSceneConfig();
+    std::remove(xmlPath.c_str());
+}
 }
 } // namespace Rosen
 } // namespace OHOS
@@ -3632,6 +3632,28 @@ HWTEST_F(ScreenSessionManagerTest, GetDisplayInfoById01, Function | SmallTest |
     ssm->screenSessionMap_.erase(50);
 }
 
+/**
+ * @tc.name: GetDisplayInfoById02
+ * @tc.desc: GetDisplayInfoById returns the cached info of the screen session
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenSessionManagerTest, GetDisplayInfoById02, Function | SmallTest | Level3)
+{
+    ScreenSessionManager* ssm = new ScreenSessionManager();
+    ASSERT_NE(ssm, nullptr);
+    DisplayId id = 51;
+    ScreenProperty property;
+    sptr<ScreenSession> screenSession = sptr<ScreenSession>::MakeSptr(id, property, 0);
+    ssm->screenSessionMap_.insert(std::make_pair(id, screenSession));
+    auto res = ssm->GetDisplayInfoById(id);
+    ASSERT_NE(res, nullptr);
+    EXPECT_EQ(res->GetDisplayId(), id);
+    EXPECT_EQ(res, ssm->GetDisplayInfoById(id));
+    screenSession->UpdateRefreshRate(60);
+    EXPECT_NE(res, ssm->GetDisplayInfoById(id));
+    ssm->screenSessionMap_.erase(id);
+}
+
 /**
  * @tc.name: GetVisibleAreaDisplayInfoById01
  * @tc.desc: GetVisibleAreaDisplayInfoById01
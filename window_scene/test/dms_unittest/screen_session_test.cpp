@@ -1340,6 +1340,35 @@ HWTEST_F(ScreenSessionTest, ConvertToDisplayInfo, TestSize.Level1)
     GTEST_LOG_(INFO) << "ScreenSessionTest: ConvertToDisplayInfo end";
 }
 
+/**
+ * @tc.name: GetCachedDisplayInfo
+ * @tc.desc: cached display info is reused until the property or the session changes
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenSessionTest, GetCachedDisplayInfo, TestSize.Level1)
+{
+    sptr<ScreenSession> session = sptr<ScreenSession>::MakeSptr();
+    sptr<DisplayInfo> displayInfo = session->GetCachedDisplayInfo();
+    ASSERT_NE(nullptr, displayInfo);
+    EXPECT_EQ(displayInfo, session->GetCachedDisplayInfo());
+
+    session->UpdateRefreshRate(120);
+    sptr<DisplayInfo> refreshedInfo = session->GetCachedDisplayInfo();
+    ASSERT_NE(nullptr, refreshedInfo);
+    EXPECT_NE(displayInfo, refreshedInfo);
+    EXPECT_EQ(120, refreshedInfo->GetRefreshRate());
+
+    session->SetName("GetCachedDisplayInfo");
+    sptr<DisplayInfo> renamedInfo = session->GetCachedDisplayInfo();
+    ASSERT_NE(nullptr, renamedInfo);
+    EXPECT_NE(refreshedInfo, renamedInfo);
+    EXPECT_EQ("GetCachedDisplayInfo", renamedInfo->GetName());
+
+    ScreenProperty property = session->GetScreenProperty();
+    session->SetScreenProperty(property);
+    EXPECT_NE(renamedInfo, session->GetCachedDisplayInfo());
+}
+
 /**
  * @tc.name: SetMirrorScreenRegion
  * @tc.desc: SetMirrorScreenRegion test
@@ -140,6 +140,57 @@ HWTEST_F(SceneSessionDirtyManagerTest, GetFullWindowInfoList, TestSize.Level0)
     ASSERT_EQ(windowInfoList.size() + 3, windowInfoList1.size());
 }
 
+/**
+ * @tc.name: GetInputLayoutCache
+ * @tc.desc: unchanged sessions reuse the cached input layout, changed hot areas rebuild it
+ * @tc.type: FUNC
+ */
+HWTEST_F(SceneSessionDirtyManagerTest, GetInputLayoutCache, TestSize.Level1)
+{
+    SessionInfo info;
+    info.abilityName_ = "GetInputLayoutCache";
+    info.bundleName_ = "GetInputLayoutCache";
+    sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(info, nullptr);
+    ASSERT_NE(sceneSession, nullptr);
+    sceneSession->UpdateVisibilityInner(true);
+    ssm_->sceneSessionMap_.insert({ sceneSession->GetPersistentId(), sceneSession });
+
+    manager_->GetFullWindowInfoList();
+    manager_->GetFullWindowInfoList();
+    auto stat = manager_->GetInputLayoutCacheStat();
+    EXPECT_GE(stat.lastHits, 1u);
+    EXPECT_GE(stat.totalBuilds, 1u);
+
+    uint64_t generation = sceneSession->GetSessionProperty()->GetInputLayoutGeneration();
+    std::vector<Rect> touchHotAreas = { { 0, 0, 100, 100 } };
+    sceneSession->GetSessionProperty()->SetTouchHotAreas(touchHotAreas);
+    EXPECT_NE(generation, sceneSession->GetSessionProperty()->GetInputLayoutGeneration());
+    manager_->GetFullWindowInfoList();
+    stat = manager_->GetInputLayoutCacheStat();
+    EXPECT_GE(stat.lastBuilds, 1u);
+
+    generation = sceneSession->GetSessionProperty()->GetInputLayoutGeneration();
+    sceneSession->GetSessionProperty()->SetWindowLimits({ 100, 100, 50, 50, 0.0f, 0.0f });
+    EXPECT_NE(generation, sceneSession->GetSessionProperty()->GetInputLayoutGeneration());
+
+    uint64_t screenGeneration = ScreenProperty::GetGlobalGeneration();
+    ScreenProperty screenProperty;
+    screenProperty.SetRotation(90.0f);
+    EXPECT_NE(screenGeneration, ScreenProperty::GetGlobalGeneration());
+    manager_->GetFullWindowInfoList();
+    stat = manager_->GetInputLayoutCacheStat();
+    EXPECT_GE(stat.lastBuilds, 1u);
+    ssm_->sceneSessionMap_.erase(sceneSession->GetPersistentId());
+    manager_->GetFullWindowInfoList();
+    stat = manager_->GetInputLayoutCacheStat();
+    EXPECT_GE(stat.totalSwept, 1u);
+
+    std::string dumpInfo;
+    manager_->DumpInputLayoutCacheInfo(dumpInfo);
+    EXPECT_NE(dumpInfo.find("Input layout cache"), std::string::npos);
+    EXPECT_NE(dumpInfo.find("Uncached"), std::string::npos);
+}
+
 /**
  * @tc.name: IsFilterSession
  * @tc.desc: IsFilterSession
@@ -638,8 +689,9 @@ HWTEST_F(SceneSessionDirtyManagerTest, ResetFlushWindowInfoTask, TestSize.Level1
 {
     auto preFlushWindowInfoCallback = manager_->flushWindowInfoCallback_;
     manager_->flushWindowInfoCallback_ = nullptr;
+    manager_->ResetSessionDirty();
     manager_->ResetFlushWindowInfoTask();
-    EXPECT_TRUE(manager_->hasPostTask_.load());
+    EXPECT_TRUE(manager_->sessionDirty_.load());
     manager_->flushWindowInfoCallback_ = preFlushWindowInfoCallback;
 }
 
@@ -650,8 +702,21 @@ HWTEST_F(SceneSessionDirtyManagerTest, ResetFlushWindowInfoTask, TestSize.Level1
  */
 HWTEST_F(SceneSessionDirtyManagerTest, ResetFlushWindowInfoTask1, TestSize.Level1)
 {
+    auto preFlushWindowInfoCallback = manager_->flushWindowInfoCallback_;
+    std::vector<WindowInfoFlushUrgency> urgencies;
+    manager_->flushWindowInfoCallback_ = [&urgencies](WindowInfoFlushUrgency urgency) {
+        urgencies.push_back(urgency);
+    };
     manager_->ResetFlushWindowInfoTask();
-    EXPECT_TRUE(manager_->hasPostTask_.load());
+    SessionInfo info;
+    sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(info, nullptr);
+    manager_->NotifyWindowInfoChange(sceneSession, WindowUpdateType::WINDOW_UPDATE_BOUNDS);
+    manager_->NotifyWindowInfoChange(sceneSession, WindowUpdateType::WINDOW_UPDATE_FOCUSED);
+    ASSERT_EQ(3, urgencies.size());
+    EXPECT_EQ(WindowInfoFlushUrgency::IMMEDIATE, urgencies[0]);
+    EXPECT_EQ(WindowInfoFlushUrgency::BATCHED, urgencies[1]);
+    EXPECT_EQ(WindowInfoFlushUrgency::IMMEDIATE, urgencies[2]);
+    manager_->flushWindowInfoCallback_ = preFlushWindowInfoCallback;
 }
 
 /**
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "session_manager/include/window_info_flush_scheduler.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int64_t MIN_DELAY_MS = 4;
+constexpr int64_t MAX_DELAY_MS = 32;
+constexpr int32_t BUSY_REQUEST_NUM = 8;
+} // namespace
+
+class WindowInfoFlushSchedulerTest : public testing::Test {
+protected:
+    struct PostedTask {
+        std::function<void()> task;
+        std::string name;
+        int64_t delayMs = 0;
+    };
+
+    void SetUp() override;
+    void RunPostedTasks();
+
+    WindowInfoFlushScheduler scheduler_;
+    std::vector<PostedTask> postedTasks_;
+    std::vector<bool> flushes_;
+    bool holdFlushed_ = false;
+    std::vector<std::function<void()>> pendingFlushed_;
+};
+
+void WindowInfoFlushSchedulerTest::SetUp()
+{
+    // tasks are held until the test runs them, like the scene thread finishing its current task
+    scheduler_.Init([this](std::function<void()>&& task, const std::string& name, int64_t delayMs) {
+        postedTasks_.push_back({ std::move(task), name, delayMs });
+    }, [this](bool forceFlush, std::function<void()>&& onFlushed) {
+        flushes_.push_back(forceFlush);
+        if (holdFlushed_) {
+            pendingFlushed_.push_back(std::move(onFlushed));
+            return;
+        }
+        onFlushed();
+    });
+    scheduler_.SetBatchDelayRange(MIN_DELAY_MS, MAX_DELAY_MS);
+}
+
+void WindowInfoFlushSchedulerTest::RunPostedTasks()
+{
+    auto postedTasks = std::move(postedTasks_);
+    postedTasks_.clear();
+    for (auto& postedTask : postedTasks) {
+        postedTask.task();
+    }
+}
+
+namespace {
+/**
+ * @tc.name: RequestFlush
+ * @tc.desc: requests raised before the flush runs share one flush
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowInfoFlushSchedulerTest, RequestFlush, TestSize.Level1)
+{
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE);
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE, true);
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::BATCHED);
+    ASSERT_EQ(1, postedTasks_.size());
+    EXPECT_EQ(0, postedTasks_[0].delayMs);
+    RunPostedTasks();
+    ASSERT_EQ(1, flushes_.size());
+    EXPECT_TRUE(flushes_[0]);
+
+    auto stat = scheduler_.GetStat();
+    EXPECT_EQ(3, stat.requestCount);
+    EXPECT_EQ(1, stat.flushCount);
+    EXPECT_EQ(1, stat.immediateFlushCount);
+    EXPECT_EQ(3, stat.lastServed);
+
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE);
+    RunPostedTasks();
+    ASSERT_EQ(2, flushes_.size());
+    EXPECT_FALSE(flushes_[1]);
+}
+
+/**
+ * @tc.name: BatchedFlush
+ * @tc.desc: geometry waits for the batch delay, an immediate request in between takes its requests along
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowInfoFlushSchedulerTest, BatchedFlush, TestSize.Level1)
+{
+    int64_t batchDelayMs = scheduler_.GetStat().batchDelayMs;
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::BATCHED);
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::BATCHED);
+    ASSERT_EQ(1, postedTasks_.size());
+    EXPECT_EQ(batchDelayMs, postedTasks_[0].delayMs);
+
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE);
+    ASSERT_EQ(2, postedTasks_.size());
+    postedTasks_[1].task();
+    postedTasks_[0].task();
+    postedTasks_.clear();
+    EXPECT_EQ(1, flushes_.size());
+    EXPECT_EQ(3, scheduler_.GetStat().lastServed);
+}
+
+/**
+ * @tc.name: AdaptBatchDelay
+ * @tc.desc: busy flushes stretch the batch delay up to the max, single requests shrink it to the min
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowInfoFlushSchedulerTest, AdaptBatchDelay, TestSize.Level1)
+{
+    for (int32_t round = 0; round < BUSY_REQUEST_NUM; round++) {
+        for (int32_t i = 0; i < BUSY_REQUEST_NUM; i++) {
+            scheduler_.RequestFlush(WindowInfoFlushUrgency::BATCHED);
+        }
+        RunPostedTasks();
+    }
+    EXPECT_EQ(MAX_DELAY_MS, scheduler_.GetStat().batchDelayMs);
+
+    for (int32_t round = 0; round < BUSY_REQUEST_NUM; round++) {
+        scheduler_.RequestFlush(WindowInfoFlushUrgency::BATCHED);
+        RunPostedTasks();
+    }
+    EXPECT_EQ(MIN_DELAY_MS, scheduler_.GetStat().batchDelayMs);
+    EXPECT_EQ(BUSY_REQUEST_NUM, scheduler_.GetStat().maxServed);
+}
+
+/**
+ * @tc.name: FlushCostIncludesSend
+ * @tc.desc: a flush is only counted once the infos were sent to MMI on the input thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowInfoFlushSchedulerTest, FlushCostIncludesSend, TestSize.Level1)
+{
+    holdFlushed_ = true;
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE);
+    RunPostedTasks();
+    ASSERT_EQ(1, flushes_.size());
+    ASSERT_EQ(1, pendingFlushed_.size());
+    EXPECT_EQ(0, scheduler_.GetStat().flushCount);
+
+    // a new request while the send is in flight gets its own flush
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE);
+    EXPECT_EQ(1, postedTasks_.size());
+
+    pendingFlushed_[0]();
+    auto stat = scheduler_.GetStat();
+    EXPECT_EQ(1, stat.flushCount);
+    EXPECT_EQ(1, stat.lastServed);
+    EXPECT_GE(stat.lastCostUs, 0);
+}
+
+/**
+ * @tc.name: DumpInfo
+ * @tc.desc: stats are dumped and reset
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowInfoFlushSchedulerTest, DumpInfo, TestSize.Level1)
+{
+    WindowInfoFlushScheduler scheduler;
+    scheduler.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE);
+    EXPECT_EQ(0, scheduler.GetStat().requestCount);
+
+    scheduler_.RequestFlush(WindowInfoFlushUrgency::IMMEDIATE);
+    RunPostedTasks();
+    std::string dumpInfo;
+    scheduler_.DumpInfo(dumpInfo);
+    EXPECT_NE(std::string::npos, dumpInfo.find("Flush window info"));
+    scheduler_.ResetStat();
+    EXPECT_EQ(0, scheduler_.GetStat().flushCount);
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
@@ -177,6 +177,24 @@ HWTEST_F(LayoutControllerTest, SetSystemConfigFunc, TestSize.Level1)
     EXPECT_EQ(layoutController_->GetSessionRect(), rect);
 }
 
+/**
+ * @tc.name: TakeHitTestDirty
+ * @tc.desc: a changed rect marks the session dirty for the hit-test index once
+ * @tc.type: FUNC
+ */
+HWTEST_F(LayoutControllerTest, TakeHitTestDirty, TestSize.Level1)
+{
+    WSRect rect = { 10, 20, 200, 200 };
+    layoutController_->TakeHitTestDirty();
+    layoutController_->SetSessionRect(rect);
+    EXPECT_TRUE(layoutController_->TakeHitTestDirty());
+    EXPECT_FALSE(layoutController_->TakeHitTestDirty());
+    layoutController_->SetSessionRect(rect);
+    EXPECT_FALSE(layoutController_->TakeHitTestDirty());
+    layoutController_->MarkHitTestDirty();
+    EXPECT_TRUE(layoutController_->TakeHitTestDirty());
+}
+
 /**
  * @tc.name: TestAdjustRectByAspectRatioAbnormalCases
  * @tc.desc: Verify AdjustRectByAspectRatio handles abnormal cases correctly
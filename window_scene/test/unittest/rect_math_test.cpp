@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include "common/include/rect_math.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+class RectMathTest : public testing::Test {
+public:
+    void SetUp() override;
+
+protected:
+    WSRect RandomWSRect();
+    Rect RandomRect();
+
+    std::mt19937 engine_;
+};
+
+namespace {
+constexpr uint32_t ROUND_NUM = 10000;
+constexpr uint32_t RANDOM_SEED = 20251019;
+constexpr int32_t POS_RANGE = 3000;
+constexpr int32_t SIZE_RANGE = 2000;
+
+/*
+ * Reference implementations, kept as they were before the rect math module replaced them.
+ */
+WSRect RefGetOverlap(const WSRect& rect1, const WSRect& rect2, int offsetX, int offsetY)
+{
+    int32_t x_begin = std::max(rect1.posX_, rect2.posX_);
+    int32_t x_end = std::min(rect1.posX_ + static_cast<int32_t>(rect1.width_),
+        rect2.posX_ + static_cast<int32_t>(rect2.width_));
+    int32_t y_begin = std::max(rect1.posY_, rect2.posY_);
+    int32_t y_end = std::min(rect1.posY_ + static_cast<int32_t>(rect1.height_),
+        rect2.posY_ + static_cast<int32_t>(rect2.height_));
+    if (y_begin >= y_end || x_begin >= x_end) {
+        return { 0, 0, 0, 0 };
+    }
+    return { x_begin - offsetX, y_begin - offsetY, x_end - x_begin, y_end - y_begin };
+}
+
+RectMath::AvoidSide RefGetAvoidSide(const WSRect& rect, const Rect& avoidAreaRect)
+{
+    uint32_t avoidAreaCenterX = static_cast<uint32_t>(avoidAreaRect.posX_) + (avoidAreaRect.width_ >> 1);
+    uint32_t avoidAreaCenterY = static_cast<uint32_t>(avoidAreaRect.posY_) + (avoidAreaRect.height_ >> 1);
+    float res1 = float(avoidAreaCenterY) - float(rect.height_) / float(rect.width_) *
+        float(avoidAreaCenterX);
+    float res2 = float(avoidAreaCenterY) + float(rect.height_) / float(rect.width_) *
+        float(avoidAreaCenterX) - float(rect.height_);
+    if (res1 < 0) {
+        return res2 < 0 ? RectMath::AvoidSide::TOP : RectMath::AvoidSide::RIGHT;
+    }
+    return res2 < 0 ? RectMath::AvoidSide::LEFT : RectMath::AvoidSide::BOTTOM;
+}
+
+struct RectHash {
+    std::size_t operator()(const Rect& r) const
+    {
+        return ((std::hash<int32_t>{}(r.posX_) * 31 + std::hash<int32_t>{}(r.posY_)) * 31 +
+            std::hash<uint32_t>{}(r.width_)) * 31 + std::hash<uint32_t>{}(r.height_);
+    }
+};
+
+static_assert(RectMath::Right(WSRect { 10, 20, 30, 40 }) == 40);
+static_assert(RectMath::Bottom(WSRect { 10, 20, 30, 40 }) == 60);
+static_assert(RectMath::IsZero(WSRect { 0, 0, 0, 0 }));
+static_assert(RectMath::Contains(WSRect { 0, 0, 10, 10 }, 10, 10));
+static_assert(!RectMath::IsOverlap(WSRect { 0, 0, 10, 10 }, WSRect { 10, 0, 10, 10 }));
+static_assert(RectMath::Overlap(WSRect { 0, 0, 10, 10 }, WSRect { 5, 5, 10, 10 }, 5, 5).width_ == 5);
+} // namespace
+
+void RectMathTest::SetUp()
+{
+    engine_.seed(RANDOM_SEED);
+}
+
+WSRect RectMathTest::RandomWSRect()
+{
+    std::uniform_int_distribution<int32_t> pos(-POS_RANGE, POS_RANGE);
+    std::uniform_int_distribution<int32_t> size(0, SIZE_RANGE);
+    return { pos(engine_), pos(engine_), size(engine_), size(engine_) };
+}
+
+Rect RectMathTest::RandomRect()
+{
+    // a small value range makes duplicates and zero rects likely
+    std::uniform_int_distribution<int32_t> value(0, 3);
+    return { value(engine_), value(engine_), static_cast<uint32_t>(value(engine_)),
+        static_cast<uint32_t>(value(engine_)) };
+}
+
+namespace {
+/**
+ * @tc.name: OverlapMatchesReference
+ * @tc.desc: Overlap and IsOverlap agree with the previous GetOverlap and WSRect::IsOverlap
+ * @tc.type: FUNC
+ */
+HWTEST_F(RectMathTest, OverlapMatchesReference, TestSize.Level1)
+{
+    std::uniform_int_distribution<int32_t> offset(-POS_RANGE, POS_RANGE);
+    for (uint32_t round = 0; round < ROUND_NUM; round++) {
+        WSRect lhs = RandomWSRect();
+        WSRect rhs = RandomWSRect();
+        int32_t offsetX = offset(engine_);
+        int32_t offsetY = offset(engine_);
+        ASSERT_EQ(RectMath::Overlap(lhs, rhs, offsetX, offsetY), RefGetOverlap(lhs, rhs, offsetX, offsetY));
+        ASSERT_EQ(RectMath::IsOverlap(lhs, rhs), lhs.IsOverlap(rhs));
+    }
+}
+
+/**
+ * @tc.name: ContainsMatchesReference
+ * @tc.desc: Contains agrees with WSRect::IsInRegion, edges included
+ * @tc.type: FUNC
+ */
+HWTEST_F(RectMathTest, ContainsMatchesReference, TestSize.Level1)
+{
+    std::uniform_int_distribution<int32_t> point(-POS_RANGE - SIZE_RANGE, POS_RANGE + SIZE_RANGE);
+    for (uint32_t round = 0; round < ROUND_NUM; round++) {
+        WSRect rect = RandomWSRect();
+        int32_t pointX = point(engine_);
+        int32_t pointY = point(engine_);
+        ASSERT_EQ(RectMath::Contains(rect, pointX, pointY), rect.IsInRegion(pointX, pointY));
+        ASSERT_TRUE(RectMath::Contains(rect, RectMath::Right(rect), RectMath::Bottom(rect)));
+    }
+}
+
+/**
+ * @tc.name: ConvertAndOffset
+ * @tc.desc: Rect conversions round trip and Offset moves only the position
+ * @tc.type: FUNC
+ */
+HWTEST_F(RectMathTest, ConvertAndOffset, TestSize.Level1)
+{
+    for (uint32_t round = 0; round < ROUND_NUM; round++) {
+        WSRect rect = RandomWSRect();
+        EXPECT_EQ(RectMath::ToWSRect(RectMath::ToRect(rect)), rect);
+        WSRect moved = RectMath::Offset(rect, rect.width_, -rect.height_);
+        ASSERT_EQ(moved.posX_, rect.posX_ + rect.width_);
+        ASSERT_EQ(moved.posY_, rect.posY_ - rect.height_);
+        ASSERT_EQ(moved.width_, rect.width_);
+        ASSERT_EQ(moved.height_, rect.height_);
+        ASSERT_EQ(RectMath::Offset(moved, -rect.width_, rect.height_), rect);
+    }
+}
+
+/**
+ * @tc.name: AvoidSideMatchesReference
+ * @tc.desc: GetAvoidSide picks the same side as the previous CalculateAvoidAreaRect
+ * @tc.type: FUNC
+ */
+HWTEST_F(RectMathTest, AvoidSideMatchesReference, TestSize.Level1)
+{
+    uint32_t checkedNum = 0;
+    for (uint32_t round = 0; round < ROUND_NUM; round++) {
+        WSRect windowRect = RandomWSRect();
+        WSRect avoidRect = RandomWSRect();
+        if (windowRect.width_ == 0 || windowRect.height_ == 0) {
+            continue;
+        }
+        Rect avoidAreaRect = RectMath::ToRect(
+            RectMath::Overlap(windowRect, avoidRect, windowRect.posX_, windowRect.posY_));
+        if (RectMath::IsZero(avoidAreaRect)) {
+            continue;
+        }
+        ASSERT_EQ(RectMath::GetAvoidSide(windowRect, avoidAreaRect), RefGetAvoidSide(windowRect, avoidAreaRect));
+        checkedNum++;
+    }
+    EXPECT_GT(checkedNum, 0);
+    WSRect windowRect { 0, 0, 1000, 2000 };
+    EXPECT_EQ(RectMath::GetAvoidSide(windowRect, { 0, 0, 1000, 100 }), RectMath::AvoidSide::TOP);
+    EXPECT_EQ(RectMath::GetAvoidSide(windowRect, { 0, 1900, 1000, 100 }), RectMath::AvoidSide::BOTTOM);
+    EXPECT_EQ(RectMath::GetAvoidSide(windowRect, { 0, 0, 100, 2000 }), RectMath::AvoidSide::LEFT);
+    EXPECT_EQ(RectMath::GetAvoidSide(windowRect, { 900, 0, 100, 2000 }), RectMath::AvoidSide::RIGHT);
+}
+
+/**
+ * @tc.name: FindRectDeduplicates
+ * @tc.desc: deduplicating by FindRect keeps the same rects, in order, as a hash set did
+ * @tc.type: FUNC
+ */
+HWTEST_F(RectMathTest, FindRectDeduplicates, TestSize.Level1)
+{
+    constexpr size_t maxRectNum = 40;
+    std::uniform_int_distribution<size_t> rectNum(0, maxRectNum);
+    for (uint32_t round = 0; round < ROUND_NUM / 10; round++) {
+        std::vector<Rect> rects(rectNum(engine_));
+        for (auto& rect : rects) {
+            rect = RandomRect();
+        }
+        std::vector<Rect> expected;
+        std::unordered_set<Rect, RectHash> seen;
+        for (const auto& rect : rects) {
+            if (seen.insert(rect).second) {
+                expected.push_back(rect);
+            }
+        }
+        std::vector<Rect> result;
+        for (size_t index = 0; index < rects.size(); index++) {
+            if (RectMath::FindRect(rects.data(), index, rects[index]) == index) {
+                result.push_back(rects[index]);
+            }
+        }
+        ASSERT_EQ(result, expected);
+    }
+    Rect target { 1, 2, 3, 4 };
+    EXPECT_EQ(RectMath::FindRect(nullptr, 0, target), 0);
+}
+
+/**
+ * @tc.name: OffsetRectsSkipsZeroRects
+ * @tc.desc: OffsetRects moves every rect but the zero ones, as the hot area loop did
+ * @tc.type: FUNC
+ */
+HWTEST_F(RectMathTest, OffsetRectsSkipsZeroRects, TestSize.Level1)
+{
+    std::uniform_int_distribution<int32_t> offset(-POS_RANGE, POS_RANGE);
+    for (uint32_t round = 0; round < ROUND_NUM / 10; round++) {
+        std::vector<Rect> rects(round % 17);
+        for (auto& rect : rects) {
+            rect = RandomRect();
+        }
+        int32_t offsetX = offset(engine_);
+        int32_t offsetY = offset(engine_);
+        std::vector<Rect> expected = rects;
+        for (auto& rect : expected) {
+            if (rect != Rect::EMPTY_RECT) {
+                rect.posX_ += offsetX;
+                rect.posY_ += offsetY;
+            }
+        }
+        RectMath::OffsetRects(rects.data(), rects.size(), offsetX, offsetY);
+        ASSERT_EQ(rects, expected);
+    }
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
@@ -584,6 +584,31 @@ HWTEST_F(SceneSessionManagerTest10, GetWindowIdsByCoordinate05, TestSize.Level1)
     ssm_->sceneSessionMap_.clear();
 }
 
+/**
+ * @tc.name: GetWindowIdsByCoordinate06
+ * @tc.desc: GetWindowIdsByCoordinate, a moved or restacked session is found where it is now
+ * @tc.type: FUNC
+ */
+HWTEST_F(SceneSessionManagerTest10, GetWindowIdsByCoordinate06, TestSize.Level1)
+{
+    ssm_->sceneSessionMap_.clear();
+    InitTestSceneSession(1, 141, 11, true, { 100, 100, 200, 200 });
+    InitTestSceneSession(1, 142, 12, true, { 500, 500, 600, 600 });
+    std::vector<int32_t> windowIds;
+    EXPECT_EQ(WMError::WM_OK, ssm_->GetWindowIdsByCoordinate(1, 0, 180, 180, windowIds));
+    EXPECT_EQ(std::vector<int32_t>({ 141 }), windowIds);
+
+    ssm_->sceneSessionMap_.at(142)->GetLayoutController()->SetSessionRect({ 100, 100, 200, 200 });
+    ssm_->sceneSessionMap_.at(141)->SetZOrder(13);
+    windowIds.clear();
+    EXPECT_EQ(WMError::WM_OK, ssm_->GetWindowIdsByCoordinate(1, 0, 180, 180, windowIds));
+    EXPECT_EQ(std::vector<int32_t>({ 141, 142 }), windowIds);
+    windowIds.clear();
+    EXPECT_EQ(WMError::WM_OK, ssm_->GetWindowIdsByCoordinate(1, 0, 550, 550, windowIds));
+    EXPECT_TRUE(windowIds.empty());
+    ssm_->sceneSessionMap_.clear();
+}
+
 /**
  * @tc.name: ChangeWindowRectYInVirtualDisplay
  * @tc.desc: ChangeWindowRectYInVirtualDisplay
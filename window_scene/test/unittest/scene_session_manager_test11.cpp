@@ -439,16 +439,13 @@ HWTEST_F(SceneSessionManagerTest11, DestroyUIServiceExtensionSubWindow, TestSize
 }
 
 /**
- * @tc.name: FilterForGetAllWindowLayoutInfo
- * @tc.desc: SceneSesionManager test FilterForGetAllWindowLayoutInfo
+ * @tc.name: PublishWindowLayoutSnapshot
+ * @tc.desc: SceneSesionManager test PublishWindowLayoutSnapshot
  * @tc.type: FUNC
  */
-HWTEST_F(SceneSessionManagerTest11, FilterForGetAllWindowLayoutInfo, TestSize.Level1)
+HWTEST_F(SceneSessionManagerTest11, PublishWindowLayoutSnapshot, TestSize.Level1)
 {
     ASSERT_NE(ssm_, nullptr);
-    DisplayId displayId = 0;
-    bool isVirtualDisplay = true;
-    std::vector<sptr<SceneSession>> filteredSessions{};
     SessionInfo info;
     info.bundleName_ = BUNDLE_NAME;
     info.appInstanceKey_ = "instanceKey";
@@ -458,9 +455,17 @@ HWTEST_F(SceneSessionManagerTest11, FilterForGetAllWindowLayoutInfo, TestSize.Le
     ssm_->sceneSessionMap_.clear();
     auto ret = ssm_->sceneSessionMap_.size();
     ASSERT_EQ(ret, 0);
-    ssm_->FilterForGetAllWindowLayoutInfo(displayId, isVirtualDisplay, filteredSessions);
+    ssm_->PublishWindowLayoutSnapshot();
+    auto snapshot = ssm_->windowLayoutSnapshotHolder_.Load();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_TRUE(snapshot->items.empty());
     ssm_->sceneSessionMap_.insert({ 1, sceneSession });
-    ssm_->FilterForGetAllWindowLayoutInfo(displayId, isVirtualDisplay, filteredSessions);
+    EXPECT_FALSE(snapshot->stamp == ssm_->GetWindowLayoutSnapshotStampLocked());
+    ssm_->PublishWindowLayoutSnapshot();
+    snapshot = ssm_->windowLayoutSnapshotHolder_.Load();
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_TRUE(snapshot->stamp == ssm_->GetWindowLayoutSnapshotStampLocked());
+    ssm_->sceneSessionMap_.clear();
 }
 
 /**
@@ -728,7 +733,7 @@ HWTEST_F(SceneSessionManagerTest11, IsLastPiPWindowVisible, TestSize.Level1)
     uint64_t surfaceId = 1;
     WindowVisibilityState lastVisibilityState = WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION;
     ssm_->sceneSessionMap_.clear();
-    auto res = ssm_->IsLastPiPWindowVisible(surfaceId, lastVisibilityState);
+    auto res = ssm_->IsLastPiPWindowVisible(nullptr, surfaceId, lastVisibilityState);
     ASSERT_EQ(res, false);
 }
 
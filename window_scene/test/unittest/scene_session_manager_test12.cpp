@@ -1285,11 +1285,11 @@ HWTEST_F(SceneSessionManagerTest12, GetAllWindowLayoutInfo01, TestSize.Level0)
 }
 
 /**
- * @tc.name: FilterForGetAllWindowLayoutInfo01
+ * @tc.name: GetAllWindowLayoutInfo02
  * @tc.desc: test return by zOrder
  * @tc.type: FUNC
  */
-HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo01, TestSize.Level0)
+HWTEST_F(SceneSessionManagerTest12, GetAllWindowLayoutInfo02, TestSize.Level0)
 {
     SessionInfo sessionInfo;
     sessionInfo.isSystem_ = false;
@@ -1313,19 +1313,19 @@ HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo01, TestSize.
     ssm_->sceneSessionMap_.insert({ sceneSession2->GetPersistentId(), sceneSession2 });
 
     constexpr DisplayId DEFAULT_DISPLAY_ID = 0;
-    std::vector<sptr<SceneSession>> filteredSessions;
-    ssm_->FilterForGetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, false, filteredSessions);
+    std::vector<sptr<WindowLayoutInfo>> infos;
+    ssm_->GetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, infos);
     ssm_->sceneSessionMap_.clear();
-    ASSERT_NE(filteredSessions.size(), 0);
-    ASSERT_EQ(130, filteredSessions[0]->GetSessionRect().posY_);
+    ASSERT_NE(infos.size(), 0);
+    ASSERT_EQ(130, infos[0]->rect.posY_);
 }
 
 /**
- * @tc.name: FilterForGetAllWindowLayoutInfo02
+ * @tc.name: GetAllWindowLayoutInfo03
  * @tc.desc: test system window
  * @tc.type: FUNC
  */
-HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo02, TestSize.Level0)
+HWTEST_F(SceneSessionManagerTest12, GetAllWindowLayoutInfo03, TestSize.Level0)
 {
     SessionInfo sessionInfo;
     sessionInfo.isSystem_ = false;
@@ -1360,18 +1360,18 @@ HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo02, TestSize.
     ssm_->sceneSessionMap_.insert({ sceneSession3->GetPersistentId(), sceneSession3 });
 
     constexpr DisplayId DEFAULT_DISPLAY_ID = 0;
-    std::vector<sptr<SceneSession>> filteredSessions;
-    ssm_->FilterForGetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, false, filteredSessions);
+    std::vector<sptr<WindowLayoutInfo>> infos;
+    ssm_->GetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, infos);
     ssm_->sceneSessionMap_.clear();
-    ASSERT_EQ(2, filteredSessions.size());
+    ASSERT_EQ(2, infos.size());
 }
 
 /**
- * @tc.name: FilterForGetAllWindowLayoutInfo03
+ * @tc.name: GetAllWindowLayoutInfo04
  * @tc.desc: test VisibilityState
  * @tc.type: FUNC
  */
-HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo03, TestSize.Level0)
+HWTEST_F(SceneSessionManagerTest12, GetAllWindowLayoutInfo04, TestSize.Level0)
 {
     SessionInfo sessionInfo;
     sessionInfo.isSystem_ = false;
@@ -1403,18 +1403,18 @@ HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo03, TestSize.
     ssm_->sceneSessionMap_.insert({ sceneSession3->GetPersistentId(), sceneSession3 });
 
     constexpr DisplayId DEFAULT_DISPLAY_ID = 0;
-    std::vector<sptr<SceneSession>> filteredSessions;
-    ssm_->FilterForGetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, false, filteredSessions);
+    std::vector<sptr<WindowLayoutInfo>> infos;
+    ssm_->GetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, infos);
     ssm_->sceneSessionMap_.clear();
-    ASSERT_EQ(2, filteredSessions.size());
+    ASSERT_EQ(2, infos.size());
 }
 
 /**
- * @tc.name: FilterForGetAllWindowLayoutInfo04
+ * @tc.name: GetAllWindowLayoutInfo05
  * @tc.desc: HALF_FOLDED
  * @tc.type: FUNC
  */
-HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo04, TestSize.Level0)
+HWTEST_F(SceneSessionManagerTest12, GetAllWindowLayoutInfo05, TestSize.Level0)
 {
     PcFoldScreenManager::GetInstance().UpdateFoldScreenStatus(
         0, SuperFoldStatus::HALF_FOLDED, { 0, 0, 2472, 1648 }, { 0, 1648, 2472, 1648 }, { 0, 1624, 2472, 1648 });
@@ -1449,29 +1449,30 @@ HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo04, TestSize.
     ssm_->sceneSessionMap_.insert({ sceneSession3->GetPersistentId(), sceneSession3 });
 
     constexpr DisplayId DEFAULT_DISPLAY_ID = 0;
-    std::vector<sptr<SceneSession>> filteredSessions1;
-    ssm_->FilterForGetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, false, filteredSessions1);
-    EXPECT_EQ(2, filteredSessions1.size());
-    std::vector<sptr<SceneSession>> filteredSessions2;
-    ssm_->FilterForGetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, true, filteredSessions2);
+    constexpr DisplayId VIRTUAL_DISPLAY_ID = 999;
+    std::vector<sptr<WindowLayoutInfo>> infos1;
+    ssm_->GetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, infos1);
+    EXPECT_EQ(2, infos1.size());
+    std::vector<sptr<WindowLayoutInfo>> infos2;
+    ssm_->GetAllWindowLayoutInfo(VIRTUAL_DISPLAY_ID, infos2);
     ssm_->sceneSessionMap_.clear();
-    ASSERT_EQ(2, filteredSessions2.size());
+    ASSERT_EQ(2, infos2.size());
 }
 
 /**
- * @tc.name: FilterForGetAllWindowLayoutInfo05
+ * @tc.name: GetAllWindowLayoutInfo06
  * @tc.desc: session is nullptr
  * @tc.type: FUNC
  */
-HWTEST_F(SceneSessionManagerTest12, FilterForGetAllWindowLayoutInfo05, TestSize.Level0)
+HWTEST_F(SceneSessionManagerTest12, GetAllWindowLayoutInfo06, TestSize.Level0)
 {
     sptr<SceneSession> sceneSession = nullptr;
     ssm_->sceneSessionMap_.insert({ 1, sceneSession });
     constexpr DisplayId DEFAULT_DISPLAY_ID = 0;
-    std::vector<sptr<SceneSession>> filteredSessions;
-    ssm_->FilterForGetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, false, filteredSessions);
+    std::vector<sptr<WindowLayoutInfo>> infos;
+    ssm_->GetAllWindowLayoutInfo(DEFAULT_DISPLAY_ID, infos);
     ssm_->sceneSessionMap_.clear();
-    ASSERT_EQ(0, filteredSessions.size());
+    ASSERT_EQ(0, infos.size());
 }
 
 /**
@@ -981,7 +981,10 @@ HWTEST_F(SceneSessionManagerTest4, GetPreWindowDrawingState, TestSize.Level1)
     ASSERT_NE(nullptr, ssm_);
     uint64_t surfaceId = 0;
     int32_t pid = 10;
-    bool result = ssm_->GetPreWindowDrawingState(surfaceId, true, pid);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    bool result =
+        ssm_->GetPreWindowDrawingState(ssm_->SelectSessionFromIndex(context, surfaceId), surfaceId, true, pid);
     EXPECT_EQ(result, false);
 
     SessionInfo info;
@@ -994,7 +997,9 @@ HWTEST_F(SceneSessionManagerTest4, GetPreWindowDrawingState, TestSize.Level1)
     ASSERT_NE(sceneSession01->surfaceNode_, nullptr);
     sceneSession01->surfaceNode_->id_ = 10;
     surfaceId = 10;
-    result = ssm_->GetPreWindowDrawingState(surfaceId, true, pid);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    result = ssm_->GetPreWindowDrawingState(ssm_->SelectSessionFromIndex(context, surfaceId), surfaceId, true, pid);
     EXPECT_EQ(result, false);
 }
 
@@ -1024,11 +1029,13 @@ HWTEST_F(SceneSessionManagerTest4, GetWindowDrawingContentChangeInfo, TestSize.L
     sceneSession->SetCallingPid(0);
     sceneSession->SetDrawingContentState(true);
 
-    auto result = ssm_->GetWindowDrawingContentChangeInfo(currDrawingContentData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    auto result = ssm_->GetWindowDrawingContentChangeInfo(context, currDrawingContentData);
     EXPECT_EQ(result, currDrawingContentData);
 
     sceneSession->SetCallingPid(2);
-    result = ssm_->GetWindowDrawingContentChangeInfo(currDrawingContentData);
+    result = ssm_->GetWindowDrawingContentChangeInfo(context, currDrawingContentData);
     EXPECT_NE(result, currDrawingContentData);
 }
 
@@ -1050,7 +1057,9 @@ HWTEST_F(SceneSessionManagerTest4, GetWindowDrawingContentChangeInfo02, TestSize
     currDrawingContentData.push_back(std::make_pair(0, false));
     currDrawingContentData.push_back(std::make_pair(1, true));
 
-    auto result = ssm_->GetWindowDrawingContentChangeInfo(currDrawingContentData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    auto result = ssm_->GetWindowDrawingContentChangeInfo(context, currDrawingContentData);
     EXPECT_EQ(result, currDrawingContentData);
 }
 
@@ -1071,17 +1080,23 @@ HWTEST_F(SceneSessionManagerTest4, DealwithDrawingContentChange, TestSize.Level1
     std::vector<std::pair<uint64_t, bool>> drawingContentChangeInfo;
     drawingContentChangeInfo.push_back(std::make_pair(0, true));
     drawingContentChangeInfo.push_back(std::make_pair(1, true));
-    ssm_->DealwithDrawingContentChange(drawingContentChangeInfo);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->DealwithDrawingContentChange(context, drawingContentChangeInfo);
 
     ssm_->sceneSessionMap_.insert(std::make_pair(1, sceneSession));
     struct RSSurfaceNodeConfig config;
     sceneSession->surfaceNode_ = RSSurfaceNode::Create(config);
     ASSERT_NE(sceneSession->surfaceNode_, nullptr);
     sceneSession->surfaceNode_->id_ = 1;
-    ssm_->DealwithDrawingContentChange(drawingContentChangeInfo);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->DealwithDrawingContentChange(context, drawingContentChangeInfo);
 
     ssm_->openDebugTrace_ = true;
-    ssm_->DealwithDrawingContentChange(drawingContentChangeInfo);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->DealwithDrawingContentChange(context, drawingContentChangeInfo);
     EXPECT_EQ(WSError::WS_ERROR_INVALID_SESSION, ssm_->HandleSecureSessionShouldHide(nullptr));
 }
 
@@ -1152,14 +1167,20 @@ HWTEST_F(SceneSessionManagerTest4, RemoveDuplicateSubSession, TestSize.Level1)
     sceneSession01->surfaceNode_->id_ = 0;
 
     ssm_->sceneSessionMap_.insert(std::make_pair(0, nullptr));
-    ssm_->RemoveDuplicateSubSession(visibilityChangeInfo, subSessions);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->FillWindowLayerVisibleState(context, visibilityChangeInfo, {});
+    ssm_->RemoveDuplicateSubSession(context, subSessions);
 
     ssm_->sceneSessionMap_.insert(std::make_pair(1, sceneSession01));
     sceneSession02->persistentId_ = 2;
     subSessions.push_back(sceneSession01);
     subSessions.push_back(sceneSession02);
     subSessions.push_back(sceneSession03);
-    ssm_->RemoveDuplicateSubSession(visibilityChangeInfo, subSessions);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->FillWindowLayerVisibleState(context, visibilityChangeInfo, {});
+    ssm_->RemoveDuplicateSubSession(context, subSessions);
     EXPECT_EQ(WSError::WS_ERROR_INVALID_SESSION, ssm_->HandleSecureSessionShouldHide(nullptr));
 }
 
@@ -1176,23 +1197,22 @@ HWTEST_F(SceneSessionManagerTest4, UpdateSubWindowVisibility, TestSize.Level1)
     sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(info, nullptr);
     ASSERT_NE(sceneSession, nullptr);
     WindowVisibilityState visibleState = WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION;
-    std::vector<std::pair<uint64_t, WindowVisibilityState>> visibilityChangeInfo;
-    std::vector<sptr<WindowVisibilityInfo>> windowVisibilityInfos;
-    std::string visibilityInfo = "";
-    std::vector<std::pair<uint64_t, WindowVisibilityState>> currVisibleData;
-    ssm_->UpdateSubWindowVisibility(
-        sceneSession, visibleState, visibilityChangeInfo, windowVisibilityInfos, visibilityInfo, currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->UpdateSubWindowVisibility(context, sceneSession, visibleState);
 
     ASSERT_NE(sceneSession->property_, nullptr);
     sceneSession->property_->SetWindowType(WindowType::APP_MAIN_WINDOW_END);
-    ssm_->UpdateSubWindowVisibility(
-        sceneSession, visibleState, visibilityChangeInfo, windowVisibilityInfos, visibilityInfo, currVisibleData);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->UpdateSubWindowVisibility(context, sceneSession, visibleState);
 
     sceneSession->property_->SetWindowType(WindowType::APP_MAIN_WINDOW_BASE);
     visibleState = WINDOW_VISIBILITY_STATE_PARTICALLY_OCCLUSION;
     ssm_->sceneSessionMap_.insert(std::make_pair(0, nullptr));
-    ssm_->UpdateSubWindowVisibility(
-        sceneSession, visibleState, visibilityChangeInfo, windowVisibilityInfos, visibilityInfo, currVisibleData);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->UpdateSubWindowVisibility(context, sceneSession, visibleState);
 
     sptr<SceneSession> sceneSession01 = sptr<SceneSession>::MakeSptr(info, nullptr);
     sptr<SceneSession> sceneSession02 = sptr<SceneSession>::MakeSptr(info, nullptr);
@@ -1211,8 +1231,9 @@ HWTEST_F(SceneSessionManagerTest4, UpdateSubWindowVisibility, TestSize.Level1)
     ssm_->sceneSessionMap_.insert(std::make_pair(1, sceneSession01));
     ssm_->sceneSessionMap_.insert(std::make_pair(2, sceneSession02));
     ssm_->sceneSessionMap_.insert(std::make_pair(3, sceneSession03));
-    ssm_->UpdateSubWindowVisibility(
-        sceneSession, visibleState, visibilityChangeInfo, windowVisibilityInfos, visibilityInfo, currVisibleData);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->UpdateSubWindowVisibility(context, sceneSession, visibleState);
     EXPECT_EQ(WSError::WS_ERROR_INVALID_SESSION, ssm_->HandleSecureSessionShouldHide(nullptr));
 }
 
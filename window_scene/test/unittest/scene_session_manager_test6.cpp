@@ -198,7 +198,9 @@ HWTEST_F(SceneSessionManagerTest6, GetWindowLayerChangeInfo, TestSize.Level1)
     auto oldSessionMap = ssm_->sceneSessionMap_;
     ssm_->sceneSessionMap_.clear();
     ssm_->sceneSessionMap_.insert(std::make_pair(2, sceneSession02));
-    ssm_->GetWindowLayerChangeInfo(occlusionDataPtr, currVisibleData, currDrawingContentData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->GetWindowLayerChangeInfo(context, occlusionDataPtr, currVisibleData, currDrawingContentData);
     ASSERT_EQ(currVisibleData.size(), 7);
     ASSERT_EQ(currDrawingContentData.size(), 4);
     ssm_->sceneSessionMap_ = oldSessionMap;
@@ -219,7 +221,9 @@ HWTEST_F(SceneSessionManagerTest6, GetWindowVisibilityChangeInfo01, TestSize.Lev
     currVisibleData.push_back(std::make_pair(2, WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION));
     currVisibleData.push_back(std::make_pair(3, WindowVisibilityState::WINDOW_LAYER_STATE_MAX));
     ssm_->lastVisibleData_.push_back(std::make_pair(0, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
-    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(context, currVisibleData);
     ASSERT_EQ(visibilityChangeInfos.size(), 3);
 }
 
@@ -236,7 +240,9 @@ HWTEST_F(SceneSessionManagerTest6, GetWindowVisibilityChangeInfo02, TestSize.Lev
     std::vector<std::pair<uint64_t, WindowVisibilityState>> visibilityChangeInfos;
     currVisibleData.push_back(std::make_pair(0, WindowVisibilityState::WINDOW_VISIBILITY_STATE_PARTICALLY_OCCLUSION));
     ssm_->lastVisibleData_.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
-    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(context, currVisibleData);
     ASSERT_EQ(visibilityChangeInfos.size(), 2);
 }
 
@@ -257,13 +263,15 @@ HWTEST_F(SceneSessionManagerTest6, GetWindowVisibilityChangeInfo03, TestSize.Lev
         std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_PARTICALLY_OCCLUSION));
     ssm_->lastVisibleData_.push_back(
         std::make_pair(2, WindowVisibilityState::WINDOW_VISIBILITY_STATE_PARTICALLY_OCCLUSION));
-    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(context, currVisibleData);
     ASSERT_EQ(visibilityChangeInfos.size(), 1);
     currVisibleData.clear();
     ssm_->lastVisibleData_.clear();
     currVisibleData.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION));
     ssm_->lastVisibleData_.push_back(std::make_pair(2, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
-    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(currVisibleData);
+    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(context, currVisibleData);
     ASSERT_EQ(visibilityChangeInfos.size(), 1);
     ASSERT_EQ(visibilityChangeInfos[0].first, 2);
 }
@@ -282,12 +290,14 @@ HWTEST_F(SceneSessionManagerTest6, GetWindowVisibilityChangeInfo04, TestSize.Lev
     ssm_->lastVisibleData_.push_back(std::make_pair(0, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
     currVisibleData.push_back(std::make_pair(0, WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION));
     currVisibleData.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION));
-    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(context, currVisibleData);
     ASSERT_EQ(visibilityChangeInfos.size(), 1);
 
     currVisibleData.clear();
     currVisibleData.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION));
-    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(currVisibleData);
+    visibilityChangeInfos = ssm_->GetWindowVisibilityChangeInfo(context, currVisibleData);
     ASSERT_EQ(visibilityChangeInfos.size(), 0);
 }
 
@@ -331,17 +341,68 @@ HWTEST_F(SceneSessionManagerTest6, DealwithVisibilityChange01, TestSize.Level0)
     visibilityChangeInfos.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
     std::vector<std::pair<uint64_t, WindowVisibilityState>> currVisibleData;
     currVisibleData.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
-    ssm_->DealwithVisibilityChange(visibilityChangeInfos, currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->DealwithVisibilityChange(context, visibilityChangeInfos, currVisibleData);
     ASSERT_EQ(sceneSession1->GetRSVisible(), true);
     ASSERT_EQ(sceneSession2->GetRSVisible(), false);
     sceneSession2->SetSessionState(SessionState::STATE_BACKGROUND);
     sceneSession1->SetRSVisible(false);
     sceneSession2->SetRSVisible(false);
-    ssm_->DealwithVisibilityChange(visibilityChangeInfos, currVisibleData);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->DealwithVisibilityChange(context, visibilityChangeInfos, currVisibleData);
     ASSERT_EQ(sceneSession1->GetRSVisible(), true);
     ASSERT_EQ(sceneSession2->GetRSVisible(), false);
 }
 
+/**
+ * @tc.name: BuildWindowLayerSessionIndex
+ * @tc.desc: surface ids and sub windows are resolved once for a layer change
+ * @tc.type: FUNC
+ */
+HWTEST_F(SceneSessionManagerTest6, BuildWindowLayerSessionIndex, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, ssm_);
+    ssm_->sceneSessionMap_.clear();
+    SessionInfo sessionInfo;
+    sptr<SceneSession> sceneSession1 = sptr<SceneSession>::MakeSptr(sessionInfo, nullptr);
+    sptr<SceneSession> sceneSession2 = sptr<SceneSession>::MakeSptr(sessionInfo, nullptr);
+    ssm_->sceneSessionMap_.insert(std::make_pair(sceneSession1->GetPersistentId(), sceneSession1));
+    ssm_->sceneSessionMap_.insert(std::make_pair(sceneSession2->GetPersistentId(), sceneSession2));
+    struct RSSurfaceNodeConfig config;
+    std::shared_ptr<RSSurfaceNode> surfaceNode1 = RSSurfaceNode::Create(config);
+    std::shared_ptr<RSSurfaceNode> surfaceNode2 = RSSurfaceNode::Create(config);
+    ASSERT_NE(nullptr, surfaceNode1);
+    ASSERT_NE(nullptr, surfaceNode2);
+    surfaceNode1->SetId(1);
+    surfaceNode2->SetId(2);
+    sceneSession1->surfaceNode_ = surfaceNode1;
+    sceneSession2->surfaceNode_ = surfaceNode2;
+    sceneSession1->property_->SetWindowType(WindowType::APP_MAIN_WINDOW_BASE);
+    sceneSession2->property_->SetWindowType(WindowType::APP_SUB_WINDOW_BASE);
+    sceneSession2->SetParentSession(sceneSession1);
+
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    EXPECT_EQ(ssm_->SelectSessionFromIndex(context, 1), sceneSession1);
+    EXPECT_EQ(ssm_->SelectSessionFromIndex(context, 2), sceneSession2);
+    EXPECT_EQ(ssm_->SelectSessionFromIndex(context, 3), nullptr);
+    ASSERT_EQ(context.subSessionMap[sceneSession1->GetWindowId()].size(), 1);
+    EXPECT_EQ(context.subSessionMap[sceneSession1->GetWindowId()][0], sceneSession2);
+
+    std::vector<std::pair<uint64_t, WindowVisibilityState>> visibilityChangeInfos;
+    visibilityChangeInfos.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
+    std::vector<std::pair<uint64_t, WindowVisibilityState>> currVisibleData;
+    currVisibleData.push_back(std::make_pair(1, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
+    currVisibleData.push_back(std::make_pair(2, WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION));
+    ssm_->FillWindowLayerVisibleState(context, visibilityChangeInfos, currVisibleData);
+    EXPECT_TRUE(ssm_->GetSessionRSVisible(context, sceneSession1));
+    EXPECT_FALSE(ssm_->GetSessionRSVisible(context, sceneSession2));
+    EXPECT_EQ(context.visibilityChangedWindowIds.count(sceneSession1->GetWindowId()), 1);
+    ssm_->sceneSessionMap_.clear();
+}
+
 /**
  * @tc.name: DealwithVisibilityChange02
  * @tc.desc: DealwithVisibilityChange02
@@ -381,13 +442,17 @@ HWTEST_F(SceneSessionManagerTest6, DealwithVisibilityChange02, TestSize.Level0)
     std::vector<std::pair<uint64_t, WindowVisibilityState>> currVisibleData;
     currVisibleData.push_back(std::make_pair(3, WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION));
     sceneSession1->SetRSVisible(true);
-    ssm_->DealwithVisibilityChange(visibilityChangeInfos, currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->DealwithVisibilityChange(context, visibilityChangeInfos, currVisibleData);
     ASSERT_EQ(sceneSession2->GetRSVisible(), true);
     sceneSession2->SetSessionState(SessionState::STATE_BACKGROUND);
     sceneSession1->SetRSVisible(false);
     sceneSession2->SetRSVisible(false);
     sceneSession1->SetSessionState(SessionState::STATE_BACKGROUND);
-    ssm_->DealwithVisibilityChange(visibilityChangeInfos, currVisibleData);
+    context = WindowLayerChangeContext();
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->DealwithVisibilityChange(context, visibilityChangeInfos, currVisibleData);
     ASSERT_EQ(sceneSession2->GetRSVisible(), false);
 }
 
@@ -337,6 +337,132 @@ HWTEST_F(SceneSessionManagerTest7, FlushUIParams03, Function | SmallTest | Level
     EXPECT_EQ(true, keyboardSession->stateChanged_);
 }
 
+/**
+ * @tc.name: GetSessionsForFlushLocked
+ * @tc.desc: sessions are partitioned by screen, unbound sessions belong to every screen
+ * @tc.type: FUNC
+ */
+HWTEST_F(SceneSessionManagerTest7, GetSessionsForFlushLocked, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, ssm_);
+    ssm_->sceneSessionMap_.clear();
+    SessionInfo sessionInfo;
+    sessionInfo.bundleName_ = "SceneSessionManagerTest7";
+    sessionInfo.abilityName_ = "GetSessionsForFlushLocked";
+    for (int32_t id = 1; id <= 4; id++) {
+        sessionInfo.screenId_ = (id == 3) ? SCREEN_ID_INVALID : static_cast<ScreenId>(id % 2);
+        sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(sessionInfo, nullptr);
+        sceneSession->persistentId_ = id;
+        ssm_->sceneSessionMap_.insert({ id, sceneSession });
+    }
+    auto screen0Sessions = ssm_->GetSessionsForFlushLocked(0);
+    ASSERT_EQ(2, screen0Sessions.size());
+    EXPECT_EQ(3, screen0Sessions[0]->GetPersistentId());
+    EXPECT_EQ(4, screen0Sessions[1]->GetPersistentId());
+    auto screen1Sessions = ssm_->GetSessionsForFlushLocked(1);
+    ASSERT_EQ(2, screen1Sessions.size());
+    EXPECT_EQ(1, screen1Sessions[0]->GetPersistentId());
+    EXPECT_EQ(3, screen1Sessions[1]->GetPersistentId());
+    EXPECT_EQ(1, ssm_->GetSessionsForFlushLocked(2).size());
+
+    ssm_->sceneSessionMap_[4]->SetScreenId(1);
+    EXPECT_EQ(1, ssm_->GetSessionsForFlushLocked(0).size());
+    EXPECT_EQ(3, ssm_->GetSessionsForFlushLocked(1).size());
+
+    ssm_->EraseSceneSessionAndMarkDirtyLocked(1);
+    EXPECT_TRUE(ssm_->displaySessionPartition_.screenSessions.empty());
+    EXPECT_EQ(2, ssm_->GetSessionsForFlushLocked(1).size());
+
+    sessionInfo.screenId_ = 1;
+    sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(sessionInfo, nullptr);
+    sceneSession->persistentId_ = 5;
+    ssm_->sceneSessionMap_.insert({ 5, sceneSession });
+    EXPECT_EQ(3, ssm_->GetSessionsForFlushLocked(1).size());
+    ssm_->sceneSessionMap_.erase(5);
+    EXPECT_EQ(2, ssm_->GetSessionsForFlushLocked(1).size());
+    ssm_->sceneSessionMap_.clear();
+}
+
+/**
+ * @tc.name: GetSessionsForFlushLockedMatchesScan
+ * @tc.desc: per-screen session lookup with 3 x 40 windows returns what the full map scan returns
+ * @tc.type: FUNC
+ */
+HWTEST_F(SceneSessionManagerTest7, GetSessionsForFlushLockedMatchesScan, TestSize.Level1)
+{
+    constexpr int32_t screenCount = 3;
+    constexpr int32_t windowsPerScreen = 40;
+    ASSERT_NE(nullptr, ssm_);
+    ssm_->sceneSessionMap_.clear();
+    SessionInfo sessionInfo;
+    sessionInfo.bundleName_ = "SceneSessionManagerTest7";
+    sessionInfo.abilityName_ = "GetSessionsForFlushLockedMatchesScan";
+    for (int32_t id = 1; id <= screenCount * windowsPerScreen; id++) {
+        sessionInfo.screenId_ = static_cast<ScreenId>(id % screenCount);
+        sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(sessionInfo, nullptr);
+        sceneSession->persistentId_ = id;
+        ssm_->sceneSessionMap_.insert({ id, sceneSession });
+    }
+    auto checkPartition = [this] {
+        for (ScreenId screenId = 0; screenId < screenCount; screenId++) {
+            std::vector<sptr<SceneSession>> scanned;
+            for (const auto& [_, sceneSession] : ssm_->sceneSessionMap_) {
+                if (!SceneSessionManager::isNotCurrentScreen(sceneSession, screenId)) {
+                    scanned.push_back(sceneSession);
+                }
+            }
+            EXPECT_EQ(scanned, ssm_->GetSessionsForFlushLocked(screenId));
+        }
+    };
+    checkPartition();
+    EXPECT_EQ(windowsPerScreen, ssm_->GetSessionsForFlushLocked(0).size());
+
+    ssm_->sceneSessionMap_.at(1)->SetScreenId(0);
+    ssm_->sceneSessionMap_.erase(2);
+    ssm_->sceneSessionMap_.erase(ssm_->sceneSessionMap_.find(3));
+    checkPartition();
+    EXPECT_EQ(windowsPerScreen, ssm_->GetSessionsForFlushLocked(0).size());
+    ssm_->sceneSessionMap_.clear();
+}
+
+/**
+ * @tc.name: SceneSessionMapVersion
+ * @tc.desc: every mutation of sceneSessionMap_ bumps its version, reads do not
+ * @tc.type: FUNC
+ */
+HWTEST_F(SceneSessionManagerTest7, SceneSessionMapVersion, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, ssm_);
+    auto& sessionMap = ssm_->sceneSessionMap_;
+    sessionMap.clear();
+    SessionInfo sessionInfo;
+    sessionInfo.bundleName_ = "SceneSessionManagerTest7";
+    sessionInfo.abilityName_ = "SceneSessionMapVersion";
+    sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(sessionInfo, nullptr);
+    uint64_t version = sessionMap.GetVersion();
+
+    sessionMap.insert({ 1, sceneSession });
+    sessionMap.insert(std::make_pair(2, sceneSession));
+    sessionMap.emplace(3, sceneSession);
+    sessionMap[4] = sceneSession;
+    EXPECT_EQ(version + 4, sessionMap.GetVersion());
+
+    version = sessionMap.GetVersion();
+    EXPECT_EQ(4, sessionMap.size());
+    EXPECT_EQ(1, sessionMap.count(1));
+    EXPECT_NE(sessionMap.end(), sessionMap.find(2));
+    EXPECT_EQ(sceneSession, sessionMap.at(3));
+    std::map<int32_t, sptr<SceneSession>> copiedMap = sessionMap;
+    EXPECT_EQ(4, copiedMap.size());
+    EXPECT_EQ(version, sessionMap.GetVersion());
+
+    sessionMap.erase(1);
+    sessionMap.erase(sessionMap.find(2));
+    sessionMap = copiedMap;
+    sessionMap.clear();
+    EXPECT_EQ(version + 4, sessionMap.GetVersion());
+}
+
 /**
  * @tc.name: RegisterIAbilityManagerCollaborator
  * @tc.desc: RegisterIAbilityManagerCollaborator
@@ -1104,7 +1230,9 @@ HWTEST_F(SceneSessionManagerTest7, GetWindowVisibilityChangeInfo, TestSize.Level
     ssm_->lastVisibleData_.emplace_back(4, WindowVisibilityState::WINDOW_VISIBILITY_STATE_PARTICALLY_OCCLUSION);
     ssm_->lastVisibleData_.emplace_back(5, WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION);
     ssm_->lastVisibleData_.emplace_back(6, WindowVisibilityState::WINDOW_LAYER_STATE_MAX);
-    visibilitychangeInfos = ssm_->GetWindowVisibilityChangeInfo(currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    visibilitychangeInfos = ssm_->GetWindowVisibilityChangeInfo(context, currVisibleData);
     ASSERT_EQ(visibilitychangeInfos.size(), 7);
 }
 
@@ -385,10 +385,6 @@ HWTEST_F(SceneSessionManagerTest8, UpdateSubWindowVisibility, TestSize.Level1)
     sptr<SceneSession> sceneSession = sptr<SceneSession>::MakeSptr(sessionInfo, nullptr);
     EXPECT_NE(nullptr, sceneSession);
     WindowVisibilityState visibleState = WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION;
-    std::vector<std::pair<uint64_t, WindowVisibilityState>> visibilityChangeInfo;
-    std::vector<sptr<WindowVisibilityInfo>> windowVisibilityInfos;
-    std::string visibilityInfo = "";
-    std::vector<std::pair<uint64_t, WindowVisibilityState>> currVisibleData;
     sceneSession->persistentId_ = 1998;
     sceneSession->SetCallingUid(1998);
     SessionState state = SessionState::STATE_CONNECT;
@@ -416,8 +412,9 @@ HWTEST_F(SceneSessionManagerTest8, UpdateSubWindowVisibility, TestSize.Level1)
     sceneSession2->SetParentSession(sceneSession2);
     EXPECT_EQ(1998, sceneSession2->GetParentSession()->GetWindowId());
     ssm_->sceneSessionMap_.emplace(0, sceneSession2);
-    ssm_->UpdateSubWindowVisibility(
-        sceneSession, visibleState, visibilityChangeInfo, windowVisibilityInfos, visibilityInfo, currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->UpdateSubWindowVisibility(context, sceneSession, visibleState);
 }
 
 /**
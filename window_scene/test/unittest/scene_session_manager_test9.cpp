@@ -1256,7 +1256,10 @@ HWTEST_F(SceneSessionManagerTest9, GetSessionRSVisible, TestSize.Level1)
     sceneSession02->persistentId_ = windowId;
     ssm_->sceneSessionMap_.insert(std::make_pair(0, sceneSession02));
 
-    bool actual = ssm_->GetSessionRSVisible(sceneSession01, currVisibleData);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    ssm_->FillWindowLayerVisibleState(context, {}, currVisibleData);
+    bool actual = ssm_->GetSessionRSVisible(context, sceneSession01);
     EXPECT_EQ(actual, true);
 }
 
@@ -1495,7 +1498,7 @@ HWTEST_F(SceneSessionManagerTest9, IsLastPiPWindowVisible, TestSize.Level1)
     uint64_t surfaceId = 0;
     WindowVisibilityState lastVisibilityState = WindowVisibilityState::WINDOW_VISIBILITY_STATE_NO_OCCLUSION;
     ssm_->sceneSessionMap_.insert(std::pair<int32_t, sptr<SceneSession>>(0, nullptr));
-    auto ret = ssm_->IsLastPiPWindowVisible(surfaceId, lastVisibilityState);
+    auto ret = ssm_->IsLastPiPWindowVisible(nullptr, surfaceId, lastVisibilityState);
     ASSERT_EQ(ret, false);
 }
 
@@ -1522,13 +1525,16 @@ HWTEST_F(SceneSessionManagerTest9, IsLastPiPWindowVisible01, TestSize.Level1)
     sptr<WindowSessionProperty> property = sceneSession->GetSessionProperty();
     property->SetWindowMode(WindowMode::WINDOW_MODE_PIP);
 
-    auto ret = ssm_->IsLastPiPWindowVisible(surfaceId, lastVisibilityState);
+    WindowLayerChangeContext context;
+    ssm_->BuildWindowLayerSessionIndex(context);
+    sptr<SceneSession> pipSession = ssm_->SelectSessionFromIndex(context, surfaceId);
+    auto ret = ssm_->IsLastPiPWindowVisible(pipSession, surfaceId, lastVisibilityState);
     ASSERT_EQ(ret, false);
     ssm_->isScreenLocked_ = true;
-    ret = ssm_->IsLastPiPWindowVisible(surfaceId, lastVisibilityState);
+    ret = ssm_->IsLastPiPWindowVisible(pipSession, surfaceId, lastVisibilityState);
     ASSERT_EQ(ret, false);
     lastVisibilityState = WindowVisibilityState::WINDOW_VISIBILITY_STATE_TOTALLY_OCCUSION;
-    ret = ssm_->IsLastPiPWindowVisible(surfaceId, lastVisibilityState);
+    ret = ssm_->IsLastPiPWindowVisible(pipSession, surfaceId, lastVisibilityState);
     ASSERT_EQ(ret, false);
 }
 
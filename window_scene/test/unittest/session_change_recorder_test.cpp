@@ -14,6 +14,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "session/host/include/session_change_recorder.h"
 
@@ -106,9 +107,6 @@ HWTEST_F(SessionChangeRecorderTest, SetRecordSize, TestSize.Level1)
  */
 HWTEST_F(SessionChangeRecorderTest, GetSceneSessionNeedDumpInfo, TestSize.Level1)
 {
-    SessionChangeRecorder::GetInstance().sceneSessionChangeNeedLogMap_.clear();
-    SessionChangeRecorder::GetInstance().sceneSessionChangeNeedDumpMap_.clear();
-
     std::vector<std::string> params;
     std::string dumpInfo;
     SessionChangeRecorder::GetInstance().GetSceneSessionNeedDumpInfo(params, dumpInfo);
@@ -160,80 +158,171 @@ HWTEST_F(SessionChangeRecorderTest, GetSceneSessionNeedDumpInfo, TestSize.Level1
     EXPECT_TRUE(result4);
 }
 
+/**
+ * @tc.name: RecordPacked
+ * @tc.desc: packed arguments are formatted by record type at dump time
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionChangeRecorderTest, RecordPacked, TestSize.Level1)
+{
+    auto result1 = SessionChangeRecorder::GetInstance().RecordSceneSessionChange(
+        RecordType::ORIENTAION_RECORD, 126, WmsLogTag::DEFAULT, 1);
+    EXPECT_EQ(result1, WSError::WS_ERROR_INVALID_PARAM);
+
+    auto result2 = SessionChangeRecorder::GetInstance().RecordSceneSessionChange(
+        RecordType::ORIENTAION_RECORD, 126, WmsLogTag::WMS_ROTATION, 1, 2);
+    EXPECT_EQ(result2, WSError::WS_OK);
+
+    std::vector<std::string> params = { "126" };
+    std::string dumpInfo;
+    SessionChangeRecorder::GetInstance().GetSceneSessionNeedDumpInfo(params, dumpInfo);
+    EXPECT_NE(dumpInfo.find("Orientation change to 1, animation change to 2"), std::string::npos);
+}
+
 /**
  * @tc.name: RecordDump
- * @tc.desc: RecordDump
+ * @tc.desc: dump keeps the latest records of each type within the record size
  * @tc.type: FUNC
  */
 HWTEST_F(SessionChangeRecorderTest, RecordDump, TestSize.Level1)
 {
-    SessionChangeRecorder::GetInstance().sceneSessionChangeNeedDumpMap_.clear();
     SceneSessionChangeInfo changeInfo1 {
         .persistentId_ = 123,
         .changeInfo_ = "changeInfo1",
         .logTag_ = WmsLogTag::WMS_MAIN,
     };
-    SessionChangeRecorder::GetInstance().RecordDump(RecordType::RECORD_TYPE_BEGIN, changeInfo1);
-    auto result1 = SessionChangeRecorder::GetInstance().sceneSessionChangeNeedDumpMap_;
-    EXPECT_EQ(result1[RecordType::RECORD_TYPE_BEGIN].size(), 1);
-
     SceneSessionChangeInfo changeInfo2 {
         .persistentId_ = 123,
         .changeInfo_ = "changeInfo2",
         .logTag_ = WmsLogTag::WMS_MAIN,
     };
-    SessionChangeRecorder::GetInstance().RecordDump(RecordType::RECORD_TYPE_BEGIN, changeInfo2);
-    auto result2 = SessionChangeRecorder::GetInstance().sceneSessionChangeNeedDumpMap_;
-    EXPECT_EQ(result2[RecordType::RECORD_TYPE_BEGIN].size(), 2);
-
     SceneSessionChangeInfo changeInfo3 {
         .persistentId_ = 123,
         .changeInfo_ = "changeInfo3",
         .logTag_ = WmsLogTag::WMS_MAIN,
     };
     SessionChangeRecorder::GetInstance().SetRecordSize(RecordType::RECORD_TYPE_BEGIN, 2);
-    SessionChangeRecorder::GetInstance().RecordDump(RecordType::RECORD_TYPE_BEGIN, changeInfo3);
-    auto result3 = SessionChangeRecorder::GetInstance().sceneSessionChangeNeedDumpMap_;
-    EXPECT_EQ(result3[RecordType::RECORD_TYPE_BEGIN].size(), 2);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::RECORD_TYPE_BEGIN, changeInfo1);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::RECORD_TYPE_BEGIN, changeInfo2);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::RECORD_TYPE_BEGIN, changeInfo3);
+    auto result = SessionChangeRecorder::GetInstance().GetDumpMap();
+    ASSERT_EQ(result[RecordType::RECORD_TYPE_BEGIN].size(), 2);
+    EXPECT_EQ(result[RecordType::RECORD_TYPE_BEGIN].front().changeInfo_, "changeInfo2");
+    EXPECT_EQ(result[RecordType::RECORD_TYPE_BEGIN].back().changeInfo_, "changeInfo3");
+    EXPECT_NE(result[RecordType::RECORD_TYPE_BEGIN].back().time_, "");
     SessionChangeRecorder::GetInstance().SetRecordSize(RecordType::RECORD_TYPE_BEGIN, MAX_RECORD_TYPE_SIZE);
 }
 
 /**
  * @tc.name: RecordLog
- * @tc.desc: RecordLog
+ * @tc.desc: the log drain returns each record once
  * @tc.type: FUNC
  */
 HWTEST_F(SessionChangeRecorderTest, RecordLog, TestSize.Level1)
 {
-    SessionChangeRecorder::GetInstance().sceneSessionChangeNeedLogMap_.clear();
+    std::vector<SessionChangeEntry> entries;
+    SessionChangeRecorder::GetInstance().CollectRecords(true, entries);
+    entries.clear();
+    SessionChangeRecorder::GetInstance().CollectRecords(true, entries);
+    EXPECT_EQ(entries.size(), 0);
+
     SceneSessionChangeInfo changeInfo1 {
         .persistentId_ = 123,
         .changeInfo_ = "changeInfo1",
         .logTag_ = WmsLogTag::WMS_MAIN,
     };
-    SessionChangeRecorder::GetInstance().RecordLog(RecordType::RECORD_TYPE_BEGIN, changeInfo1);
-    auto result1 = SessionChangeRecorder::GetInstance().sceneSessionChangeNeedLogMap_;
-    EXPECT_EQ(result1[RecordType::RECORD_TYPE_BEGIN].size(), 1);
+    SessionChangeRecorder::GetInstance().RecordSceneSessionChange(RecordType::RECORD_TYPE_BEGIN, changeInfo1);
+    SessionChangeRecorder::GetInstance().CollectRecords(true, entries);
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries[0].second, "changeInfo1");
+    SessionChangeRecorder::GetInstance().PrintLog(entries);
+}
 
-    SceneSessionChangeInfo changeInfo2 {
-        .persistentId_ = 123,
-        .changeInfo_ = "changeInfo2",
-        .logTag_ = WmsLogTag::WMS_MAIN,
-    };
-    SessionChangeRecorder::GetInstance().RecordLog(RecordType::RECORD_TYPE_BEGIN, changeInfo2);
-    auto result2 = SessionChangeRecorder::GetInstance().sceneSessionChangeNeedLogMap_;
-    EXPECT_EQ(result2[RecordType::RECORD_TYPE_BEGIN].size(), 2);
+/**
+ * @tc.name: SessionChangeRing
+ * @tc.desc: overwritten records and text are skipped, long text is truncated
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionChangeRecorderTest, SessionChangeRing, TestSize.Level1)
+{
+    constexpr uint32_t slotNum = 2;
+    constexpr uint32_t textSize = 8;
+    SessionChangeRing ring(slotNum, textSize);
+    SessionChangeRecord record;
+    EXPECT_EQ(ring.Push(record, "abc"), 1);
+    EXPECT_EQ(ring.Push(record, "def"), 2);
+    EXPECT_EQ(ring.Push(record, "ghijklmn"), 3);
+
+    std::vector<SessionChangeEntry> entries;
+    EXPECT_EQ(ring.Collect(0, entries), 3);
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].second, "def");
+    EXPECT_FALSE(entries[0].first.isTextTruncated);
+    EXPECT_EQ(entries[1].second, "ghij");
+    EXPECT_TRUE(entries[1].first.isTextTruncated);
+
+    entries.clear();
+    EXPECT_EQ(ring.Collect(3, entries), 3);
+    EXPECT_EQ(entries.size(), 0);
+
+    ring.logCursor_.store(3);
+    EXPECT_EQ(ring.Push(record, ""), 1);
+}
 
-    SceneSessionChangeInfo changeInfo3 {
-        .persistentId_ = 123,
-        .changeInfo_ = "changeInfo3",
-        .logTag_ = WmsLogTag::WMS_MAIN,
-    };
-    SessionChangeRecorder::GetInstance().SetRecordSize(RecordType::RECORD_TYPE_BEGIN, 2);
-    SessionChangeRecorder::GetInstance().RecordLog(RecordType::RECORD_TYPE_BEGIN, changeInfo3);
-    auto result3 = SessionChangeRecorder::GetInstance().sceneSessionChangeNeedLogMap_;
-    EXPECT_EQ(result3[RecordType::RECORD_TYPE_BEGIN].size(), 0);
-    SessionChangeRecorder::GetInstance().SetRecordSize(RecordType::RECORD_TYPE_BEGIN, MAX_RECORD_TYPE_SIZE);
+/**
+ * @tc.name: SessionChangeRingLazyText
+ * @tc.desc: a ring of packed records never allocates its text arena
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionChangeRecorderTest, SessionChangeRingLazyText, TestSize.Level1)
+{
+    constexpr uint32_t slotNum = 4;
+    constexpr uint32_t textSize = 1024;
+    SessionChangeRing ring(slotNum, textSize);
+    SessionChangeRecord record { .isPacked = true, .args = { 1, 2 } };
+    ring.Push(record, "");
+    EXPECT_FALSE(ring.HasText());
+
+    SessionChangeRecord textRecord;
+    ring.Push(textRecord, "text");
+    EXPECT_TRUE(ring.HasText());
+    std::vector<SessionChangeEntry> entries;
+    ring.Collect(0, entries);
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].second, "");
+    EXPECT_EQ(entries[1].second, "text");
+}
+
+/**
+ * @tc.name: RecordDropped
+ * @tc.desc: a record is dropped instead of waiting when the shared ring is busy
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionChangeRecorderTest, RecordDropped, TestSize.Level1)
+{
+    auto& recorder = SessionChangeRecorder::GetInstance();
+    uint32_t maxRingNum = recorder.maxRingNum_;
+    {
+        std::lock_guard<std::mutex> lock(recorder.ringMutex_);
+        recorder.maxRingNum_ = 0;
+    }
+    uint64_t droppedNum = recorder.GetDroppedNum();
+    std::thread([&recorder] {
+        std::lock_guard<std::mutex> lock(recorder.sharedRingMutex_);
+        std::thread([&recorder] {
+            recorder.RecordSceneSessionChange(RecordType::PRIVACY_MODE, 127, WmsLogTag::WMS_ATTRIBUTE, 1);
+        }).join();
+    }).join();
+    EXPECT_EQ(recorder.GetDroppedNum(), droppedNum + 1);
+    {
+        std::lock_guard<std::mutex> lock(recorder.ringMutex_);
+        recorder.maxRingNum_ = maxRingNum;
+    }
+
+    std::vector<std::string> params = { "all" };
+    std::string dumpInfo;
+    recorder.GetSceneSessionNeedDumpInfo(params, dumpInfo);
+    EXPECT_NE(dumpInfo.find("Dropped records: "), std::string::npos);
 }
 
 /**
@@ -14,6 +14,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
+#include <ipc_skeleton.h>
 #include <libxml/globals.h>
 #include <libxml/xmlstring.h>
 #include "window_scene_config.h"
@@ -200,6 +202,101 @@ HWTEST_F(SessionPermissionTest, IsFoundationCall, TestSize.Level1)
     ASSERT_EQ(false, result);
 }
 
+/**
+ * @tc.name: CallerResultCacheHit
+ * @tc.desc: cached results are returned until they expire
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionPermissionTest, CallerResultCacheHit, TestSize.Level1)
+{
+    CallerResultCache<int32_t, std::string> cache(2, 100);
+    std::string value;
+    EXPECT_FALSE(cache.Get(1, value, 0));
+    cache.Put(1, "first", 0, cache.GetGeneration());
+    ASSERT_TRUE(cache.Get(1, value, 99));
+    EXPECT_EQ(value, "first");
+    EXPECT_FALSE(cache.Get(1, value, 100));
+    EXPECT_EQ(cache.GetSize(), 0);
+
+    cache.Put(1, "first", 0, cache.GetGeneration());
+    cache.Put(2, "second", 10, cache.GetGeneration());
+    cache.Put(3, "third", 20, cache.GetGeneration());
+    EXPECT_EQ(cache.GetSize(), 2);
+    EXPECT_FALSE(cache.Get(1, value, 30));
+    EXPECT_TRUE(cache.Get(3, value, 30));
+}
+
+/**
+ * @tc.name: CallerResultCacheInvalidation
+ * @tc.desc: erased results are dropped and a lookup started before the erase is not cached
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionPermissionTest, CallerResultCacheInvalidation, TestSize.Level1)
+{
+    constexpr uint32_t tokenId = 100;
+    auto& cache = SessionPermission::permissionCache_;
+    cache.Clear();
+    cache.Put({ tokenId, PermissionConstants::PERMISSION_MANAGE_MISSION }, true, 0, cache.GetGeneration());
+    cache.Put({ tokenId + 1, PermissionConstants::PERMISSION_MANAGE_MISSION }, true, 0, cache.GetGeneration());
+    uint64_t generation = cache.GetGeneration();
+    SessionPermission::OnPermissionStateChanged(tokenId);
+    EXPECT_EQ(cache.GetSize(), 1);
+    cache.Put({ tokenId, PermissionConstants::PERMISSION_MANAGE_MISSION }, true, 0, generation);
+    bool isGranted = false;
+    EXPECT_FALSE(cache.Get({ tokenId, PermissionConstants::PERMISSION_MANAGE_MISSION }, isGranted, 0));
+
+    SessionPermission::isPermissionCacheEnabled_.store(true);
+    cache.Put({ tokenId, PermissionConstants::PERMISSION_MANAGE_MISSION }, true, 0, cache.GetGeneration());
+    EXPECT_TRUE(SessionPermission::VerifyPermissionByCallerToken(tokenId,
+        PermissionConstants::PERMISSION_MANAGE_MISSION));
+    SessionPermission::OnPermissionStateChanged(tokenId);
+    EXPECT_FALSE(SessionPermission::VerifyPermissionByCallerToken(tokenId,
+        PermissionConstants::PERMISSION_MANAGE_MISSION));
+    SessionPermission::isPermissionCacheEnabled_.store(false);
+
+    SessionPermission::bundleNameCache_.Put(IPCSkeleton::GetCallingUid(), "cached.bundle", 0,
+        SessionPermission::bundleNameCache_.GetGeneration());
+    EXPECT_EQ(SessionPermission::GetCallingBundleName(), "cached.bundle");
+    SessionPermission::ClearCallerCache();
+    EXPECT_NE(SessionPermission::GetCallingBundleName(), "cached.bundle");
+    EXPECT_EQ(cache.GetSize(), 0);
+}
+
+/**
+ * @tc.name: CallerResultCacheConcurrentAccess
+ * @tc.desc: concurrent lookups, puts and erases keep the cache bounded and consistent
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionPermissionTest, CallerResultCacheConcurrentAccess, TestSize.Level1)
+{
+    constexpr size_t maxSize = 16;
+    constexpr int32_t threadCount = 4;
+    constexpr int32_t loopCount = 1000;
+    CallerResultCache<std::pair<uint32_t, std::string>, bool> cache(maxSize, 1000);
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < threadCount; i++) {
+        threads.emplace_back([&cache, i] {
+            for (int32_t j = 0; j < loopCount; j++) {
+                uint32_t tokenId = static_cast<uint32_t>(j % 32);
+                bool isGranted = false;
+                if (cache.Get({ tokenId, "permission" }, isGranted, j)) {
+                    EXPECT_EQ(isGranted, tokenId % 2 == 0);
+                }
+                cache.Put({ tokenId, "permission" }, tokenId % 2 == 0, j, cache.GetGeneration());
+                if (j % 100 == i) {
+                    cache.EraseIf([tokenId](const std::pair<uint32_t, std::string>& key) {
+                        return key.first == tokenId;
+                    });
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(cache.GetSize(), maxSize);
+}
+
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
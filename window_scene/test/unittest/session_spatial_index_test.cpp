@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "session/host/include/session_spatial_index.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+class SessionSpatialIndexTest : public testing::Test {
+public:
+    struct Layout {
+        DisplayId displayId = 0;
+        WSRect rect;
+        uint32_t zOrder = 0;
+    };
+
+    void SetUp() override;
+
+protected:
+    Layout RandomLayout();
+    void CheckQueries(const SessionSpatialIndex& index, const std::map<int32_t, Layout>& layouts);
+
+    std::mt19937 engine_;
+};
+
+namespace {
+constexpr uint32_t RANDOM_SEED = 20251019;
+constexpr uint32_t ROUND_NUM = 50;
+constexpr uint32_t QUERY_NUM = 200;
+constexpr int32_t SESSION_NUM = 120;
+constexpr uint32_t DISPLAY_NUM = 3;
+constexpr int32_t POS_MIN = -500;
+constexpr int32_t POS_MAX = 3000;
+constexpr int32_t RECT_SIZE_MAX = 1500;
+constexpr uint32_t ZORDER_MAX = 20;
+
+/*
+ * Reference scan over every session, the way GetWindowIdsByCoordinate walked the session tree.
+ */
+std::vector<int32_t> BruteForceQuery(const std::map<int32_t, SessionSpatialIndexTest::Layout>& layouts,
+    DisplayId displayId, int32_t pointX, int32_t pointY, bool checkPoint)
+{
+    std::vector<std::pair<int32_t, SessionSpatialIndexTest::Layout>> sorted(layouts.begin(), layouts.end());
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.zOrder < rhs.second.zOrder;
+    });
+    std::vector<int32_t> result;
+    for (auto iter = sorted.rbegin(); iter != sorted.rend(); ++iter) {
+        const auto& layout = iter->second;
+        if (layout.displayId != displayId) {
+            continue;
+        }
+        const auto& rect = layout.rect;
+        bool isInRect = pointX >= rect.posX_ && pointX < rect.posX_ + rect.width_ &&
+            pointY >= rect.posY_ && pointY < rect.posY_ + rect.height_;
+        if (checkPoint && !isInRect) {
+            continue;
+        }
+        result.push_back(iter->first);
+    }
+    return result;
+}
+} // namespace
+
+void SessionSpatialIndexTest::SetUp()
+{
+    engine_.seed(RANDOM_SEED);
+}
+
+SessionSpatialIndexTest::Layout SessionSpatialIndexTest::RandomLayout()
+{
+    std::uniform_int_distribution<uint32_t> display(0, DISPLAY_NUM - 1);
+    std::uniform_int_distribution<int32_t> pos(POS_MIN, POS_MAX);
+    std::uniform_int_distribution<int32_t> size(0, RECT_SIZE_MAX);
+    std::uniform_int_distribution<uint32_t> zOrder(0, ZORDER_MAX);
+    Layout layout;
+    layout.displayId = display(engine_);
+    layout.rect = { pos(engine_), pos(engine_), size(engine_), size(engine_) };
+    layout.zOrder = zOrder(engine_);
+    return layout;
+}
+
+void SessionSpatialIndexTest::CheckQueries(const SessionSpatialIndex& index,
+    const std::map<int32_t, Layout>& layouts)
+{
+    std::uniform_int_distribution<uint32_t> display(0, DISPLAY_NUM);
+    std::uniform_int_distribution<int32_t> point(POS_MIN - RECT_SIZE_MAX, POS_MAX + RECT_SIZE_MAX);
+    std::vector<int32_t> result;
+    for (uint32_t query = 0; query < QUERY_NUM; query++) {
+        DisplayId displayId = display(engine_);
+        int32_t pointX = point(engine_);
+        int32_t pointY = point(engine_);
+        index.Query(displayId, pointX, pointY, result);
+        ASSERT_EQ(result, BruteForceQuery(layouts, displayId, pointX, pointY, true));
+        index.QueryDisplay(displayId, result);
+        ASSERT_EQ(result, BruteForceQuery(layouts, displayId, pointX, pointY, false));
+    }
+}
+
+namespace {
+/**
+ * @tc.name: QueryMatchesBruteForce
+ * @tc.desc: point and display queries agree with a full scan on randomized layouts
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionSpatialIndexTest, QueryMatchesBruteForce, TestSize.Level1)
+{
+    for (uint32_t round = 0; round < ROUND_NUM; round++) {
+        SessionSpatialIndex index;
+        std::map<int32_t, Layout> layouts;
+        for (int32_t persistentId = 1; persistentId <= SESSION_NUM; persistentId++) {
+            auto layout = RandomLayout();
+            index.Update(persistentId, layout.displayId, layout.rect, layout.zOrder);
+            layouts[persistentId] = layout;
+        }
+        ASSERT_EQ(index.GetSize(), layouts.size());
+        CheckQueries(index, layouts);
+    }
+}
+
+/**
+ * @tc.name: IncrementalUpdate
+ * @tc.desc: moving, restacking and removing sessions keeps queries equal to a full scan
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionSpatialIndexTest, IncrementalUpdate, TestSize.Level1)
+{
+    SessionSpatialIndex index(128);
+    std::map<int32_t, Layout> layouts;
+    std::uniform_int_distribution<int32_t> sessionId(1, SESSION_NUM);
+    std::uniform_int_distribution<uint32_t> action(0, 3);
+    std::uniform_int_distribution<uint32_t> zOrder(0, ZORDER_MAX);
+    for (uint32_t round = 0; round < ROUND_NUM * 10; round++) {
+        int32_t persistentId = sessionId(engine_);
+        switch (action(engine_)) {
+            case 0: {
+                index.Remove(persistentId);
+                layouts.erase(persistentId);
+                break;
+            }
+            case 1: {
+                if (layouts.count(persistentId) == 0) {
+                    break;
+                }
+                auto& layout = layouts[persistentId];
+                layout.zOrder = zOrder(engine_);
+                index.Update(persistentId, layout.displayId, layout.rect, layout.zOrder);
+                break;
+            }
+            default: {
+                auto layout = RandomLayout();
+                index.Update(persistentId, layout.displayId, layout.rect, layout.zOrder);
+                layouts[persistentId] = layout;
+                break;
+            }
+        }
+        ASSERT_EQ(index.GetSize(), layouts.size());
+        if (round % 10 == 0) {
+            CheckQueries(index, layouts);
+        }
+    }
+    CheckQueries(index, layouts);
+    index.Clear();
+    std::vector<int32_t> result;
+    index.QueryDisplay(0, result);
+    EXPECT_TRUE(result.empty());
+}
+
+/**
+ * @tc.name: OversizedRect
+ * @tc.desc: a rect spanning too many cells is still found
+ * @tc.type: FUNC
+ */
+HWTEST_F(SessionSpatialIndexTest, OversizedRect, TestSize.Level1)
+{
+    SessionSpatialIndex index(1);
+    index.Update(1, 0, { -100000, -100000, 200000, 200000 }, 1);
+    index.Update(2, 0, { 10, 10, 2, 2 }, 2);
+    std::vector<int32_t> result;
+    index.Query(0, 11, 11, result);
+    EXPECT_EQ(result, std::vector<int32_t>({ 2, 1 }));
+    index.Update(1, 0, { 0, 0, 0, 0 }, 1);
+    index.Query(0, 11, 11, result);
+    EXPECT_EQ(result, std::vector<int32_t>({ 2 }));
+    index.Remove(2);
+    index.Query(0, 11, 11, result);
+    EXPECT_TRUE(result.empty());
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/include/task_batcher.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class TaskBatcherTest : public testing::Test {
+public:
+    void SetUp() override;
+
+    /*
+     * Stands in for the main runner: posted events run in posting order when RunEvents is called.
+     */
+    bool PostEvent(TaskBatcher::Task&& task);
+    void RunEvents();
+
+    std::mutex eventMutex_;
+    std::vector<TaskBatcher::Task> events_;
+    size_t eventCount_ = 0;
+    size_t runIndex_ = 0;
+    bool isPostFailed_ = false;
+};
+
+void TaskBatcherTest::SetUp()
+{
+    events_.clear();
+    eventCount_ = 0;
+    runIndex_ = 0;
+    isPostFailed_ = false;
+}
+
+bool TaskBatcherTest::PostEvent(TaskBatcher::Task&& task)
+{
+    std::lock_guard<std::mutex> lock(eventMutex_);
+    if (isPostFailed_) {
+        return false;
+    }
+    events_.push_back(std::move(task));
+    eventCount_++;
+    return true;
+}
+
+void TaskBatcherTest::RunEvents()
+{
+    while (true) {
+        TaskBatcher::Task event;
+        {
+            std::lock_guard<std::mutex> lock(eventMutex_);
+            if (runIndex_ >= events_.size()) {
+                return;
+            }
+            event = std::move(events_[runIndex_++]);
+        }
+        event();
+    }
+}
+
+namespace {
+/**
+ * @tc.name: BatchOrder
+ * @tc.desc: tasks run once each in the order they were added, no batch exceeds the cap
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskBatcherTest, BatchOrder, TestSize.Level1)
+{
+    TaskBatcher batcher("test", [this](TaskBatcher::Task&& task) { return PostEvent(std::move(task)); });
+    constexpr size_t taskNum = TaskBatcher::MAX_BATCH_SIZE * 2 + 3;
+    std::vector<size_t> order;
+    for (size_t i = 0; i < taskNum; i++) {
+        batcher.AddTask([&order, i] { order.push_back(i); }, "task");
+    }
+    // the first task goes out alone, each full batch is posted at once, the rest waits for the runner
+    EXPECT_EQ(eventCount_, 3);
+    RunEvents();
+    EXPECT_EQ(eventCount_, 4);
+    ASSERT_EQ(order.size(), taskNum);
+    for (size_t i = 0; i < taskNum; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+/**
+ * @tc.name: BatchClosedOncePosted
+ * @tc.desc: tasks added while a batch runs go to a new batch behind it
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskBatcherTest, BatchClosedOncePosted, TestSize.Level1)
+{
+    TaskBatcher batcher("test", [this](TaskBatcher::Task&& task) { return PostEvent(std::move(task)); });
+    std::vector<int> order;
+    batcher.AddTask([&order, &batcher] {
+        order.push_back(0);
+        batcher.AddTask([&order] { order.push_back(2); }, "task");
+    }, "task");
+    batcher.AddTask([&order] { order.push_back(1); }, "task");
+    RunEvents();
+    EXPECT_EQ(eventCount_, 3);
+    EXPECT_EQ(order, std::vector<int>({ 0, 1, 2 }));
+}
+
+/**
+ * @tc.name: BatchOrderMultiThread
+ * @tc.desc: tasks of each thread keep their order when threads add concurrently
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskBatcherTest, BatchOrderMultiThread, TestSize.Level1)
+{
+    TaskBatcher batcher("test", [this](TaskBatcher::Task&& task) { return PostEvent(std::move(task)); });
+    constexpr int threadNum = 4;
+    constexpr int taskNum = 500;
+    std::vector<std::vector<int>> orders(threadNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.emplace_back([&batcher, &orders, t] {
+            for (int i = 0; i < taskNum; i++) {
+                batcher.AddTask([&orders, t, i] { orders[t].push_back(i); }, "task");
+            }
+        });
+    }
+    std::thread runner([this] {
+        for (int round = 0; round < taskNum; round++) {
+            RunEvents();
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    runner.join();
+    RunEvents();
+    for (int t = 0; t < threadNum; t++) {
+        ASSERT_EQ(orders[t].size(), taskNum);
+        for (int i = 0; i < taskNum; i++) {
+            EXPECT_EQ(orders[t][i], i);
+        }
+    }
+}
+
+/**
+ * @tc.name: RemoveTask
+ * @tc.desc: removed tasks are dropped from queued and open batches
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskBatcherTest, RemoveTask, TestSize.Level1)
+{
+    TaskBatcher batcher("test", [this](TaskBatcher::Task&& task) { return PostEvent(std::move(task)); });
+    std::vector<int> order;
+    batcher.AddTask([&order] { order.push_back(0); }, "removed");
+    batcher.AddTask([&order] { order.push_back(1); }, "kept");
+    batcher.AddTask([&order] { order.push_back(2); }, "removed");
+    batcher.RemoveTask("removed");
+    RunEvents();
+    EXPECT_EQ(order, std::vector<int>({ 1 }));
+}
+
+/**
+ * @tc.name: PostFailed
+ * @tc.desc: tasks of a batch that failed to post go out with the next post
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskBatcherTest, PostFailed, TestSize.Level1)
+{
+    TaskBatcher batcher("test", [this](TaskBatcher::Task&& task) { return PostEvent(std::move(task)); });
+    std::vector<int> order;
+    isPostFailed_ = true;
+    batcher.AddTask([&order] { order.push_back(0); }, "task");
+    EXPECT_EQ(eventCount_, 0);
+    isPostFailed_ = false;
+    batcher.AddTask([&order] { order.push_back(1); }, "task");
+    EXPECT_EQ(eventCount_, 1);
+    RunEvents();
+    EXPECT_EQ(order, std::vector<int>({ 0, 1 }));
+}
+}
+} // namespace OHOS::Rosen
@@ -15,6 +15,9 @@
 
 #include "common/include/task_scheduler.h"
 #include <gtest/gtest.h>
+#include <future>
+#include <thread>
+#include <vector>
 
 using namespace testing;
 using namespace testing::ext;
@@ -27,6 +30,8 @@ public:
 };
 
 namespace {
+constexpr int32_t INLINE_TASK_COST_MS = 20;
+
 /**
  * @tc.name: task_scheduler_test001
  * @tc.desc: normal function
@@ -93,10 +98,10 @@ HWTEST_F(TaskSchedulerTest, AddExportTask1, TestSize.Level1)
         taskTid = gettid();
     };
     ASSERT_NE(taskScheduler, nullptr);
-    ASSERT_EQ(taskScheduler->exportFuncMap_.size(), 0);
-    taskScheduler->AddExportTask(funcName, taskFunc);
+    ASSERT_FALSE(taskScheduler->hasExportTask_);
+    taskScheduler->AddExportTask(ExportTaskId::NOTIFY_MEM_MGR, taskFunc);
     ASSERT_EQ(taskTid, gettid());
-    ASSERT_EQ(taskScheduler->exportFuncMap_.size(), 0);
+    ASSERT_FALSE(taskScheduler->hasExportTask_);
 }
 
 HWTEST_F(TaskSchedulerTest, AddExportTask2, TestSize.Level1)
@@ -110,14 +115,14 @@ HWTEST_F(TaskSchedulerTest, AddExportTask2, TestSize.Level1)
         taskTid = gettid();
     };
     ASSERT_NE(taskScheduler, nullptr);
-    ASSERT_EQ(taskScheduler->exportFuncMap_.size(), 0);
-    auto testTask = [taskScheduler, funcName, taskFunc] {
-        taskScheduler->AddExportTask(funcName, taskFunc);
+    ASSERT_FALSE(taskScheduler->hasExportTask_);
+    auto testTask = [taskScheduler, taskFunc] {
+        taskScheduler->AddExportTask(ExportTaskId::NOTIFY_MEM_MGR, taskFunc);
         return 0;
     };
     taskScheduler->PostSyncTask(testTask);
     ASSERT_EQ(taskTid, 0);
-    ASSERT_NE(taskScheduler->exportFuncMap_.size(), 0);
+    ASSERT_TRUE(taskScheduler->hasExportTask_);
 }
 
 HWTEST_F(TaskSchedulerTest, SetExportHandler, TestSize.Level1)
@@ -141,12 +146,12 @@ HWTEST_F(TaskSchedulerTest, ExecuteExportTask, TestSize.Level1)
         GTEST_LOG_(INFO) << "START_TASK";
         executed = true;
     };
-    ASSERT_EQ(taskScheduler->exportFuncMap_.size(), 0);
+    ASSERT_FALSE(taskScheduler->hasExportTask_);
     taskScheduler->ExecuteExportTask();
-    ASSERT_EQ(taskScheduler->exportFuncMap_.size(), 0);
+    ASSERT_FALSE(taskScheduler->hasExportTask_);
     ASSERT_EQ(executed, false);
-    taskScheduler->exportFuncMap_["taskFunc"] = taskFunc;
-    ASSERT_EQ(taskScheduler->exportFuncMap_.size(), 1);
+    taskScheduler->exportTasks_[static_cast<size_t>(ExportTaskId::NOTIFY_MEM_MGR)] = taskFunc;
+    taskScheduler->hasExportTask_ = true;
     taskScheduler->ExecuteExportTask();
 
     std::string exportThreadName = "exportThread";
@@ -154,7 +159,182 @@ HWTEST_F(TaskSchedulerTest, ExecuteExportTask, TestSize.Level1)
     auto eventHandler = std::make_shared<AppExecFwk::EventHandler>(eventRunner);
     taskScheduler->SetExportHandler(eventHandler);
     taskScheduler->ExecuteExportTask();
-    ASSERT_EQ(taskScheduler->exportFuncMap_.size(), 0);
+    ASSERT_FALSE(taskScheduler->hasExportTask_);
+}
+
+/**
+ * @tc.name: ExportTaskCoalesce
+ * @tc.desc: export tasks with the same id added in one scene task run once
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, ExportTaskCoalesce, TestSize.Level1)
+{
+    std::string exportThreadName = "exportThread";
+    auto eventRunner = AppExecFwk::EventRunner::Create(exportThreadName);
+    auto eventHandler = std::make_shared<AppExecFwk::EventHandler>(eventRunner);
+    std::string threadName = "threadName";
+    std::shared_ptr<TaskScheduler> taskScheduler = std::make_shared<TaskScheduler>(threadName);
+    taskScheduler->SetExportHandler(eventHandler);
+    auto executedValues = std::make_shared<std::vector<int32_t>>();
+    auto testTask = [taskScheduler, executedValues] {
+        taskScheduler->AddExportTask(ExportTaskId::NOTIFY_MEM_MGR, [executedValues] { executedValues->push_back(1); });
+        taskScheduler->AddExportTask(ExportTaskId::NOTIFY_MEM_MGR, [executedValues] { executedValues->push_back(2); });
+        return 0;
+    };
+    taskScheduler->PostSyncTask(testTask);
+    eventHandler->PostSyncTask([] {}, "waitExportTask");
+    ASSERT_EQ(executedValues->size(), 1);
+    EXPECT_EQ(executedValues->front(), 2);
+    auto stat = taskScheduler->GetExportTaskStat(ExportTaskId::NOTIFY_MEM_MGR);
+    EXPECT_EQ(stat.added, 2);
+    EXPECT_EQ(stat.coalesced, 1);
+    EXPECT_EQ(stat.posted, 1);
+    std::string dumpInfo;
+    taskScheduler->DumpExportTaskInfo(dumpInfo);
+    EXPECT_NE(dumpInfo.find("notifyMemMgr"), std::string::npos);
+}
+
+/**
+ * @tc.name: TaskTiming
+ * @tc.desc: sync tasks record wait, cost and block time only while timing is on
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskTiming, TestSize.Level1)
+{
+    std::string threadName = "threadName";
+    std::shared_ptr<TaskScheduler> taskScheduler = std::make_shared<TaskScheduler>(threadName);
+    taskScheduler->SetTimingEnabled(false);
+    auto taskFunc = [] { return 0; };
+    TaskTimingStat stat;
+    taskScheduler->PostSyncTask(taskFunc, "timingTask");
+    EXPECT_FALSE(taskScheduler->GetTaskTimingStat("timingTask", stat));
+
+    taskScheduler->SetTimingEnabled(true);
+    taskScheduler->PostSyncTask(taskFunc, "timingTask");
+    taskScheduler->PostVoidSyncTask([] {}, "timingTask");
+    ASSERT_TRUE(taskScheduler->GetTaskTimingStat("timingTask", stat));
+    EXPECT_EQ(stat.count, 2);
+    EXPECT_EQ(stat.syncCount, 2);
+    EXPECT_GE(stat.totalBlockUs, stat.totalCostUs);
+
+    std::string dumpInfo;
+    taskScheduler->DumpTimingInfo(dumpInfo);
+    EXPECT_NE(dumpInfo.find("timingTask"), std::string::npos);
+
+    taskScheduler->ResetTimingStat();
+    EXPECT_FALSE(taskScheduler->GetTaskTimingStat("timingTask", stat));
+}
+
+/**
+ * @tc.name: TaskTimingAsync
+ * @tc.desc: async tasks record cost without sync block time
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskTimingAsync, TestSize.Level1)
+{
+    std::string threadName = "threadName";
+    std::shared_ptr<TaskScheduler> taskScheduler = std::make_shared<TaskScheduler>(threadName);
+    taskScheduler->SetTimingEnabled(true);
+    taskScheduler->PostAsyncTask([] {}, "asyncTimingTask");
+    // a sync task behind the async one makes sure the async one has run
+    taskScheduler->PostVoidSyncTask([] {}, "flushTask");
+    TaskTimingStat stat;
+    ASSERT_TRUE(taskScheduler->GetTaskTimingStat("asyncTimingTask", stat));
+    EXPECT_EQ(stat.count, 1);
+    EXPECT_EQ(stat.syncCount, 0);
+}
+
+/**
+ * @tc.name: TaskTimingInline
+ * @tc.desc: a task run inline is recorded under its own name and not counted in the task that ran it
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskTimingInline, TestSize.Level1)
+{
+    std::string threadName = "threadName";
+    std::shared_ptr<TaskScheduler> taskScheduler = std::make_shared<TaskScheduler>(threadName);
+    taskScheduler->SetTimingEnabled(true);
+    taskScheduler->PostVoidSyncTask([&taskScheduler] {
+        taskScheduler->PostAsyncTask([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(INLINE_TASK_COST_MS));
+        }, "inlineTask");
+    }, "outerTask");
+    TaskTimingStat outerStat;
+    TaskTimingStat inlineStat;
+    ASSERT_TRUE(taskScheduler->GetTaskTimingStat("outerTask", outerStat));
+    ASSERT_TRUE(taskScheduler->GetTaskTimingStat("inlineTask", inlineStat));
+    EXPECT_GE(inlineStat.totalCostUs, INLINE_TASK_COST_MS * 1000);
+    EXPECT_LT(outerStat.totalCostUs, inlineStat.totalCostUs);
+    // the sync poster still blocks for the inline task
+    EXPECT_GE(outerStat.totalBlockUs, inlineStat.totalCostUs);
+}
+
+/**
+ * @tc.name: TaskTimingBudgetOff
+ * @tc.desc: a budget of 0 turns off the over budget check
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskTimingBudgetOff, TestSize.Level1)
+{
+    std::string threadName = "threadName";
+    std::shared_ptr<TaskScheduler> taskScheduler = std::make_shared<TaskScheduler>(threadName);
+    taskScheduler->SetTimingEnabled(true);
+    taskScheduler->budgetUs_ = 0;
+    taskScheduler->PostVoidSyncTask([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }, "slowTask");
+    TaskTimingStat stat;
+    ASSERT_TRUE(taskScheduler->GetTaskTimingStat("slowTask", stat));
+    EXPECT_EQ(stat.overBudgetCount, 0);
+    std::string dumpInfo;
+    taskScheduler->DumpTimingInfo(dumpInfo);
+    EXPECT_NE(dumpInfo.find("budget(us): off"), std::string::npos);
+
+    taskScheduler->budgetUs_ = 1;
+    taskScheduler->PostVoidSyncTask([] { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }, "slowTask");
+    ASSERT_TRUE(taskScheduler->GetTaskTimingStat("slowTask", stat));
+    EXPECT_EQ(stat.overBudgetCount, 1);
+}
+
+/**
+ * @tc.name: PostQueuedTask
+ * @tc.desc: a queued task posted from the scheduler thread runs after the current task instead of inline
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, PostQueuedTask, TestSize.Level1)
+{
+    std::string threadName = "threadName";
+    std::shared_ptr<TaskScheduler> taskScheduler = std::make_shared<TaskScheduler>(threadName);
+    std::vector<int> order;
+    std::promise<void> queuedPromise;
+    taskScheduler->PostVoidSyncTask([&taskScheduler, &order, &queuedPromise] {
+        taskScheduler->PostQueuedTask([&order, &queuedPromise] {
+            order.push_back(2);
+            queuedPromise.set_value();
+        }, "queuedTask");
+        taskScheduler->PostAsyncTask([&order] { order.push_back(1); }, "inlineTask");
+    }, "outerTask");
+    ASSERT_EQ(queuedPromise.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    ASSERT_EQ(order.size(), 2);
+    EXPECT_EQ(order[0], 1);
+    EXPECT_EQ(order[1], 2);
+}
+
+/**
+ * @tc.name: GetTimingPercentileUs
+ * @tc.desc: percentile is the upper bound of the bucket holding its rank, capped by max
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, GetTimingPercentileUs, TestSize.Level1)
+{
+    std::array<uint32_t, TASK_TIMING_BUCKET_NUM> buckets {};
+    EXPECT_EQ(TaskScheduler::GetTimingPercentileUs(buckets, 0, 0, 99), 0);
+    // 99 samples in [64, 128) and one in [4096, 8192)
+    buckets[7] = 99;
+    buckets[13] = 1;
+    EXPECT_EQ(TaskScheduler::GetTimingPercentileUs(buckets, 100, 5000, 99), 127);
+    EXPECT_EQ(TaskScheduler::GetTimingPercentileUs(buckets, 100, 5000, 100), 5000);
+    buckets[7] = 98;
+    buckets[13] = 2;
+    EXPECT_EQ(TaskScheduler::GetTimingPercentileUs(buckets, 100, 5000, 99), 5000);
 }
 } // namespace
 } // namespace Rosen
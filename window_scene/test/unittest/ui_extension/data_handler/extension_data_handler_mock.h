@@ -39,6 +39,8 @@ public:
 
     // Helper methods to expose protected methods for testing
     using DataHandler::NotifyDataConsumer;
+    using DataHandler::WriteWant;
+    using DataHandler::ReadWant;
 };
 } // namespace OHOS::Rosen::Extension
 #endif // OHOS_ROSEN_EXTENSION_DATA_HANDLE_MOCK_H
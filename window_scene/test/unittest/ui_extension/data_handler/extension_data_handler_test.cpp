@@ -25,6 +25,16 @@ using namespace testing;
 using namespace testing::ext;
 
 namespace OHOS::Rosen::Extension {
+namespace {
+constexpr size_t SMALL_PAYLOAD_SIZE = 4 * 1024;
+constexpr size_t MEDIUM_PAYLOAD_SIZE = 256 * 1024;
+constexpr size_t LARGE_PAYLOAD_SIZE = 4 * 1024 * 1024;
+constexpr size_t BELOW_THRESHOLD_PAYLOAD_SIZE = 60 * 1024; // the want moves to ashmem from 64KB on
+// payload type header written by DataHandler::WriteWant
+constexpr uint32_t INLINE_PAYLOAD = 0;
+constexpr uint32_t SHARED_MEMORY_PAYLOAD = 1;
+}
+
 class ExtensionDataHandlerTest : public testing::Test {
 public:
     static void SetUpTestCase() {}
@@ -263,4 +273,83 @@ HWTEST_F(ExtensionDataHandlerTest, NotifyDataConsumer03, TestSize.Level1)
     auto ret = handler.NotifyDataConsumer(std::move(data), reply, config);
     ASSERT_EQ(DataHandlerErr::NO_CONSUME_CALLBACK, ret);
 }
+
+/**
+ * @tc.name: WriteWant01
+ * @tc.desc: Test small want stays inline in the parcel
+ * @tc.type: FUNC
+ */
+HWTEST_F(ExtensionDataHandlerTest, WriteWant01, TestSize.Level1)
+{
+    AAFwk::Want want;
+    want.SetParam("data", std::string(SMALL_PAYLOAD_SIZE, 'a'));
+    MessageParcel parcel;
+    ASSERT_TRUE(MockDataHandler::WriteWant(parcel, want));
+    EXPECT_GT(parcel.GetDataSize(), SMALL_PAYLOAD_SIZE);
+
+    sptr<AAFwk::Want> result = MockDataHandler::ReadWant(parcel);
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(SMALL_PAYLOAD_SIZE, result->GetStringParam("data").size());
+}
+
+/**
+ * @tc.name: WriteWant02
+ * @tc.desc: Test large want moves to shared memory and only the header stays in the parcel
+ * @tc.type: FUNC
+ */
+HWTEST_F(ExtensionDataHandlerTest, WriteWant02, TestSize.Level1)
+{
+    AAFwk::Want want;
+    want.SetParam("data", std::string(LARGE_PAYLOAD_SIZE, 'b'));
+    want.SetParam("id", 7);
+    MessageParcel parcel;
+    ASSERT_TRUE(MockDataHandler::WriteWant(parcel, want));
+    EXPECT_LT(parcel.GetDataSize(), SMALL_PAYLOAD_SIZE);
+
+    sptr<AAFwk::Want> result = MockDataHandler::ReadWant(parcel);
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(want.GetStringParam("data"), result->GetStringParam("data"));
+    EXPECT_EQ(7, result->GetIntParam("id", 0));
+}
+
+/**
+ * @tc.name: ReadWant01
+ * @tc.desc: Test unknown payload type is refused
+ * @tc.type: FUNC
+ */
+HWTEST_F(ExtensionDataHandlerTest, ReadWant01, TestSize.Level1)
+{
+    MessageParcel parcel;
+    parcel.WriteUint32(100);
+    EXPECT_EQ(nullptr, MockDataHandler::ReadWant(parcel));
+
+    MessageParcel emptyParcel;
+    EXPECT_EQ(nullptr, MockDataHandler::ReadWant(emptyParcel));
+}
+
+/**
+ * @tc.name: WriteWantThreshold
+ * @tc.desc: Test a want below 64KB stays inline and one above it takes the shared memory path
+ * @tc.type: FUNC
+ */
+HWTEST_F(ExtensionDataHandlerTest, WriteWantThreshold, TestSize.Level1)
+{
+    std::vector<std::pair<size_t, uint32_t>> cases = {
+        { BELOW_THRESHOLD_PAYLOAD_SIZE, INLINE_PAYLOAD },
+        { MEDIUM_PAYLOAD_SIZE, SHARED_MEMORY_PAYLOAD },
+    };
+    for (const auto& [payloadSize, payloadType] : cases) {
+        AAFwk::Want want;
+        want.SetParam("data", std::string(payloadSize, 'c'));
+        MessageParcel parcel;
+        ASSERT_TRUE(MockDataHandler::WriteWant(parcel, want));
+        EXPECT_EQ(payloadType, parcel.ReadUint32());
+        EXPECT_EQ(payloadType == INLINE_PAYLOAD, parcel.GetDataSize() > payloadSize);
+
+        parcel.RewindRead(0);
+        sptr<AAFwk::Want> result = MockDataHandler::ReadWant(parcel);
+        ASSERT_NE(nullptr, result);
+        EXPECT_EQ(payloadSize, result->GetStringParam("data").size());
+    }
+}
 } // namespace OHOS::Rosen::Extension
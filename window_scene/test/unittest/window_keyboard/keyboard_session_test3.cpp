@@ -816,6 +816,139 @@ HWTEST_F(KeyboardSessionTest3, NotifyOccupiedAreaChanged, Function | SmallTest |
     keyboardSession->NotifyOccupiedAreaChanged(callingSession, occupiedAreaInfo, true, nullptr);
     EXPECT_TRUE(g_logMsg.find("size of avoidAreas: 5") != std::string::npos);
 }
+
+/**
+ * @tc.name: OccupiedAreaNotifyDuringAnimation
+ * @tc.desc: panel rect updates inside a sync transaction notify the calling window once, unchanged ones never
+ * @tc.type: FUNC
+ */
+HWTEST_F(KeyboardSessionTest3, OccupiedAreaNotifyDuringAnimation, TestSize.Level1)
+{
+    auto keyboardSession = GetKeyboardSession("OccupiedAreaNotifyDuringAnimation",
+        "OccupiedAreaNotifyDuringAnimation");
+    ASSERT_NE(keyboardSession, nullptr);
+    keyboardSession->state_ = SessionState::STATE_FOREGROUND;
+    keyboardSession->isVisible_ = true;
+    sptr<SceneSession> callingSession = GetSceneSession("CallingSession", "CallingSession");
+    ASSERT_NE(callingSession, nullptr);
+    constexpr uint32_t callingId = 86;
+    callingSession->persistentId_ = callingId;
+    callingSession->GetSessionProperty()->SetWindowMode(WindowMode::WINDOW_MODE_FULLSCREEN);
+    callingSession->SetSessionRect({ 0, 0, 1000, 2000 });
+    sptr<SessionStageMocker> mockSessionStage = sptr<SessionStageMocker>::MakeSptr();
+    callingSession->sessionStage_ = mockSessionStage;
+    uint32_t notifyCount = 0;
+    EXPECT_CALL(*mockSessionStage, NotifyOccupiedAreaChangeInfo(_, _, _, _))
+        .WillRepeatedly(InvokeWithoutArgs([&notifyCount] { notifyCount++; }));
+    keyboardSession->keyboardCallback_->onGetSceneSession =
+        [callingSession](uint32_t persistentId) -> sptr<SceneSession> {
+        if (persistentId != callingId) {
+            return nullptr;
+        }
+        return callingSession;
+    };
+    keyboardSession->GetSessionProperty()->SetCallingSessionId(callingId);
+    auto panelSession = keyboardSession->GetKeyboardPanelSession();
+    ASSERT_NE(panelSession, nullptr);
+    auto refreshFrame = [&keyboardSession, &panelSession](int32_t panelPosY) {
+        panelSession->SetSessionRect({ 0, panelPosY, 1000, 800 });
+        keyboardSession->dirtyFlags_ |= static_cast<uint32_t>(SessionUIDirtyFlag::RECT);
+        keyboardSession->CalculateOccupiedAreaAfterUIRefresh();
+        keyboardSession->dirtyFlags_ = 0;
+    };
+
+    // show animation: the panel slides up while the sync transaction is open
+    constexpr int32_t animationStep = 100;
+    keyboardSession->isKeyboardSyncTransactionOpen_ = true;
+    for (int32_t panelPosY = 2000; panelPosY >= 1200; panelPosY -= animationStep) {
+        refreshFrame(panelPosY);
+    }
+    EXPECT_EQ(notifyCount, 0);
+    EXPECT_TRUE(keyboardSession->isOccupiedAreaPending_);
+    keyboardSession->ProcessKeyboardOccupiedAreaInfo(callingId, true, true);
+    EXPECT_EQ(notifyCount, 1);
+    EXPECT_FALSE(keyboardSession->isOccupiedAreaPending_);
+    EXPECT_FALSE(keyboardSession->isKeyboardSyncTransactionOpen_);
+
+    // frames after the animation keep the same intersection
+    for (uint32_t frame = 0; frame < 5; frame++) {
+        refreshFrame(1200);
+    }
+    EXPECT_EQ(notifyCount, 1);
+
+    refreshFrame(1100);
+    EXPECT_EQ(notifyCount, 2);
+
+    // a transaction closed without a recalculation still delivers the pending area, if it changed
+    keyboardSession->isKeyboardSyncTransactionOpen_ = true;
+    refreshFrame(1000);
+    refreshFrame(1100);
+    EXPECT_EQ(notifyCount, 2);
+    keyboardSession->CloseRSTransaction();
+    EXPECT_EQ(notifyCount, 2);
+    EXPECT_FALSE(keyboardSession->isOccupiedAreaPending_);
+    keyboardSession->isKeyboardSyncTransactionOpen_ = true;
+    refreshFrame(1000);
+    keyboardSession->CloseRSTransaction();
+    EXPECT_EQ(notifyCount, 3);
+}
+
+/**
+ * @tc.name: OccupiedAreaNotifyAfterSyncTimeout
+ * @tc.desc: a timed out sync transaction delivers the pending area and later panel moves notify at once
+ * @tc.type: FUNC
+ */
+HWTEST_F(KeyboardSessionTest3, OccupiedAreaNotifyAfterSyncTimeout, TestSize.Level1)
+{
+    auto keyboardSession = GetKeyboardSession("OccupiedAreaNotifyAfterSyncTimeout",
+        "OccupiedAreaNotifyAfterSyncTimeout");
+    ASSERT_NE(keyboardSession, nullptr);
+    keyboardSession->state_ = SessionState::STATE_FOREGROUND;
+    keyboardSession->isVisible_ = true;
+    sptr<SceneSession> callingSession = GetSceneSession("CallingSession", "CallingSession");
+    ASSERT_NE(callingSession, nullptr);
+    constexpr uint32_t callingId = 87;
+    callingSession->persistentId_ = callingId;
+    callingSession->GetSessionProperty()->SetWindowMode(WindowMode::WINDOW_MODE_FULLSCREEN);
+    callingSession->SetSessionRect({ 0, 0, 1000, 2000 });
+    sptr<SessionStageMocker> mockSessionStage = sptr<SessionStageMocker>::MakeSptr();
+    callingSession->sessionStage_ = mockSessionStage;
+    uint32_t notifyCount = 0;
+    EXPECT_CALL(*mockSessionStage, NotifyOccupiedAreaChangeInfo(_, _, _, _))
+        .WillRepeatedly(InvokeWithoutArgs([&notifyCount] { notifyCount++; }));
+    keyboardSession->keyboardCallback_->onGetSceneSession =
+        [callingSession](uint32_t persistentId) -> sptr<SceneSession> {
+        if (persistentId != callingId) {
+            return nullptr;
+        }
+        return callingSession;
+    };
+    keyboardSession->GetSessionProperty()->SetCallingSessionId(callingId);
+    auto panelSession = keyboardSession->GetKeyboardPanelSession();
+    ASSERT_NE(panelSession, nullptr);
+    auto refreshFrame = [&keyboardSession, &panelSession](int32_t panelPosY) {
+        panelSession->SetSessionRect({ 0, panelPosY, 1000, 800 });
+        keyboardSession->dirtyFlags_ |= static_cast<uint32_t>(SessionUIDirtyFlag::RECT);
+        keyboardSession->CalculateOccupiedAreaAfterUIRefresh();
+        keyboardSession->dirtyFlags_ = 0;
+    };
+
+    keyboardSession->isKeyboardSyncTransactionOpen_ = true;
+    refreshFrame(1200);
+    EXPECT_EQ(notifyCount, 0);
+    EXPECT_TRUE(keyboardSession->isOccupiedAreaPending_);
+    keyboardSession->OnKeyboardAnimationSyncTimeout();
+    EXPECT_EQ(notifyCount, 1);
+    EXPECT_FALSE(keyboardSession->isOccupiedAreaPending_);
+    EXPECT_FALSE(keyboardSession->isKeyboardSyncTransactionOpen_);
+
+    // the panel moves after the timeout are no longer deferred
+    refreshFrame(1100);
+    EXPECT_EQ(notifyCount, 2);
+    EXPECT_FALSE(keyboardSession->isOccupiedAreaPending_);
+    keyboardSession->OnKeyboardAnimationSyncTimeout();
+    EXPECT_EQ(notifyCount, 2);
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
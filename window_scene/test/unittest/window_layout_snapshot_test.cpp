@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "session_manager/include/window_layout_snapshot.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+class WindowLayoutSnapshotTest : public testing::Test {
+};
+
+namespace {
+constexpr int32_t ITEM_NUM = 64;
+constexpr int32_t WRITER_ROUND_NUM = 2000;
+constexpr uint32_t READER_NUM = 4;
+
+/*
+ * Every item of the snapshot written in a round carries the round, so a torn snapshot is detectable.
+ */
+WindowLayoutSnapshot MakeSnapshot(int32_t round)
+{
+    WindowLayoutSnapshot snapshot;
+    snapshot.stamp.mapVersion = static_cast<uint64_t>(round);
+    for (int32_t persistentId = ITEM_NUM; persistentId > 0; persistentId--) {
+        WindowLayoutSnapshotItem item;
+        item.persistentId = persistentId;
+        item.zOrder = static_cast<uint32_t>(persistentId);
+        item.sessionRect = { round, round, persistentId, persistentId };
+        item.globalScaledRect = { round, round, static_cast<uint32_t>(persistentId),
+            static_cast<uint32_t>(persistentId) };
+        snapshot.items.emplace_back(item);
+    }
+    return snapshot;
+}
+
+/**
+ * @tc.name: PublishAndLoad
+ * @tc.desc: versions advance only when the published layout changes
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutSnapshotTest, PublishAndLoad, TestSize.Level1)
+{
+    WindowLayoutSnapshotHolder holder;
+    EXPECT_EQ(holder.Load(), nullptr);
+    EXPECT_EQ(holder.Publish(MakeSnapshot(1)), 1);
+    auto first = holder.Load();
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->items.size(), ITEM_NUM);
+
+    EXPECT_EQ(holder.Publish(MakeSnapshot(1)), 1);
+    EXPECT_EQ(holder.Load(), first);
+
+    auto snapshot = MakeSnapshot(1);
+    snapshot.items.front().globalScaledRect.width_++;
+    EXPECT_EQ(holder.Publish(std::move(snapshot)), 2);
+    snapshot = MakeSnapshot(1);
+    snapshot.stamp.layoutGeneration++;
+    EXPECT_EQ(holder.Publish(std::move(snapshot)), 3);
+    EXPECT_EQ(first->version, 1);
+    EXPECT_EQ(first->items.front().globalScaledRect.width_, ITEM_NUM);
+
+    holder.Reset();
+    EXPECT_EQ(holder.Load(), nullptr);
+    EXPECT_EQ(holder.Publish(MakeSnapshot(1)), 4);
+}
+
+/**
+ * @tc.name: ConcurrentReadersAndWriter
+ * @tc.desc: readers always see a whole snapshot and versions never go back while layouts are published
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutSnapshotTest, ConcurrentReadersAndWriter, TestSize.Level1)
+{
+    WindowLayoutSnapshotHolder holder;
+    holder.Publish(MakeSnapshot(0));
+    std::atomic<bool> stop { false };
+    std::atomic<uint32_t> failureNum { 0 };
+    std::atomic<uint64_t> loadNum { 0 };
+    std::vector<std::thread> readers;
+    for (uint32_t reader = 0; reader < READER_NUM; reader++) {
+        readers.emplace_back([&holder, &stop, &failureNum, &loadNum] {
+            uint64_t lastVersion = 0;
+            while (!stop.load()) {
+                auto snapshot = holder.Load();
+                loadNum++;
+                if (snapshot == nullptr || snapshot->version < lastVersion ||
+                    snapshot->items.size() != ITEM_NUM ||
+                    snapshot->version != snapshot->stamp.mapVersion + 1) {
+                    failureNum++;
+                    continue;
+                }
+                lastVersion = snapshot->version;
+                const auto round = static_cast<int32_t>(snapshot->stamp.mapVersion);
+                uint32_t lastZOrder = UINT32_MAX;
+                for (const auto& item : snapshot->items) {
+                    if (item.sessionRect.posX_ != round || item.globalScaledRect.posY_ != round ||
+                        item.zOrder >= lastZOrder) {
+                        failureNum++;
+                        break;
+                    }
+                    lastZOrder = item.zOrder;
+                }
+            }
+        });
+    }
+    for (int32_t round = 1; round <= WRITER_ROUND_NUM; round++) {
+        EXPECT_EQ(holder.Publish(MakeSnapshot(round)), static_cast<uint64_t>(round) + 1);
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(failureNum.load(), 0);
+    EXPECT_GT(loadNum.load(), 0);
+    EXPECT_EQ(holder.Load()->version, WRITER_ROUND_NUM + 1);
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
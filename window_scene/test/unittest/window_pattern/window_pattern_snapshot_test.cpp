@@ -13,10 +13,14 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <bundle_mgr_interface.h>
 #include <bundlemgr/launcher_service.h>
+#include <future>
 #include <gtest/gtest.h>
 #include <regex>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "application_info.h"
 #include "context.h"
@@ -29,6 +33,8 @@
 #include "session/host/include/scene_persistent_storage.h"
 #include "session/host/include/scene_session.h"
 #include "session/host/include/main_session.h"
+#include "session/host/include/ws_snapshot_pipeline.h"
+#include "session/host/include/ws_snapshot_policy.h"
 #include "session_manager.h"
 #include "session_manager/include/scene_session_manager.h"
 #include "mock/mock_session_stage.h"
@@ -187,6 +193,65 @@ HWTEST_F(WindowPatternSnapshotTest, RenameSnapshotFromOldPersistentId, TestSize.
     EXPECT_TRUE(g_logMsg.find("snapshot from") != std::string::npos);
 }
 
+/**
+ * @tc.name: RenameSnapshotWhenLaneFull
+ * @tc.desc: the rename runs inline instead of being dropped when the background lane is full
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternSnapshotTest, RenameSnapshotWhenLaneFull, TestSize.Level1)
+{
+    constexpr uint32_t backgroundDepthLimit = 16;
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    for (int32_t i = 0; i < 3; i++) {
+        pipeline.SubmitTask(SnapshotLane::BACKGROUND, [released] { released.wait(); },
+            "RenameSnapshotWhenLaneFull" + std::to_string(i));
+    }
+    usleep(WAIT_SYNC_IN_NS);
+    pipeline.SetQueueDepthLimit(SnapshotLane::BACKGROUND, 1);
+
+    g_logMsg.clear();
+    LOG_SetCallback(MyLogCallback);
+    sptr<ScenePersistence> scenePersistence = sptr<ScenePersistence>::MakeSptr("testBundleName", 1425);
+    scenePersistence->RenameSnapshotFromOldPersistentId(1426);
+    EXPECT_TRUE(g_logMsg.find("rename inline") != std::string::npos);
+    EXPECT_TRUE(g_logMsg.find("snapshot from") != std::string::npos);
+
+    release.set_value();
+    pipeline.SetQueueDepthLimit(SnapshotLane::BACKGROUND, backgroundDepthLimit);
+    usleep(WAIT_SYNC_IN_NS);
+}
+
+/**
+ * @tc.name: CancelSnapshotCapturesOnDestroy
+ * @tc.desc: captures not completed yet are cancelled when the session is destroyed
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternSnapshotTest, CancelSnapshotCapturesOnDestroy, TestSize.Level1)
+{
+    constexpr uint32_t captureTimeoutMs = 50;
+    SessionInfo info;
+    info.abilityName_ = "CancelSnapshotCapturesOnDestroy";
+    info.bundleName_ = "CancelSnapshotCapturesOnDestroy";
+    sptr<Session> session = sptr<Session>::MakeSptr(info);
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    SnapshotCaptureKey key;
+    key.persistentId = session->GetPersistentId();
+    auto callbackCount = std::make_shared<std::atomic<uint32_t>>(0);
+    uint64_t handle = pipeline.CaptureAsync(key, [](SnapshotCaptureCallback&&) { return true; },
+        [callbackCount](const std::shared_ptr<Media::PixelMap>&) { (*callbackCount)++; }, captureTimeoutMs);
+    ASSERT_NE(0, handle);
+    session->snapshotCaptureHandles_.insert(handle);
+
+    uint64_t cancelled = pipeline.GetCaptureStat().cancelled;
+    session = nullptr;
+    EXPECT_EQ(cancelled + 1, pipeline.GetCaptureStat().cancelled);
+    EXPECT_FALSE(pipeline.CancelCapture(handle));
+    usleep(WAIT_SYNC_IN_NS);
+    EXPECT_EQ(0, callbackCount->load());
+}
+
 /**
  * @tc.name: IsSnapshotExisted
  * @tc.desc: test function : IsSnapshotExisted
@@ -982,6 +1047,166 @@ HWTEST_F(WindowPatternSnapshotTest, FindClosestFormSnapshot, TestSize.Level1)
     ret = scenePersistence->FindClosestFormSnapshot(key);
     EXPECT_EQ(ret, false);
 }
+/**
+ * @tc.name: SnapshotPolicyFormat
+ * @tc.desc: thumbnail tier uses the low precision astc block, png without astc
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternSnapshotTest, SnapshotPolicyFormat, TestSize.Level1)
+{
+    EXPECT_EQ(std::string("image/astc/4*4"),
+        WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, true, false).mimeType);
+    EXPECT_EQ(std::string("image/astc/8*8"),
+        WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, true, true).mimeType);
+    EXPECT_EQ(std::string("image/astc/8*8"),
+        WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, true, false).mimeType);
+    EXPECT_EQ(std::string("image/png"),
+        WSSnapshotPolicy::GetFormat(SnapshotTier::THUMBNAIL, false, false).mimeType);
+    EXPECT_EQ(std::string(".png"), WSSnapshotPolicy::GetFormat(SnapshotTier::FULL, false, true).suffix);
+}
+
+/**
+ * @tc.name: SnapshotPolicySizeClass
+ * @tc.desc: thumbnail size follows window mode and density, decode picks the thumbnail only when large enough
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternSnapshotTest, SnapshotPolicySizeClass, TestSize.Level1)
+{
+    auto& policy = WSSnapshotPolicy::GetInstance();
+    policy.SetThumbnailLongSideVp(320, 240);
+    EXPECT_EQ(960, policy.GetThumbnailLongSide(false, 3.0f));
+    EXPECT_EQ(480, policy.GetThumbnailLongSide(true, 2.0f));
+    EXPECT_EQ(320, policy.GetThumbnailLongSide(false, 0.0f));
+
+    EXPECT_TRUE(WSSnapshotPolicy::IsThumbnailEnough(960, 2400, 0.5f, 0.2f));
+    EXPECT_FALSE(WSSnapshotPolicy::IsThumbnailEnough(960, 2400, 0.5f, 0.3f));
+    EXPECT_FALSE(WSSnapshotPolicy::IsThumbnailEnough(960, 2400, 0.5f, 0.5f));
+    EXPECT_FALSE(WSSnapshotPolicy::IsThumbnailEnough(0, 2400, 0.5f, 0.1f));
+    EXPECT_FALSE(WSSnapshotPolicy::IsThumbnailEnough(960, 0, 0.5f, 0.1f));
+}
+
+/**
+ * @tc.name: SnapshotPolicyDiskBudget
+ * @tc.desc: least recently used full tier files are removed before thumbnails
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternSnapshotTest, SnapshotPolicyDiskBudget, TestSize.Level1)
+{
+    auto& policy = WSSnapshotPolicy::GetInstance();
+    uint64_t oldBudget = policy.GetDiskBudget();
+    const std::vector<std::pair<std::string, SnapshotTier>> files = {
+        { "/data/test/SnapshotPolicy_1_00.png", SnapshotTier::FULL },
+        { "/data/test/SnapshotPolicy_1_00_thumb.png", SnapshotTier::THUMBNAIL },
+        { "/data/test/SnapshotPolicy_2_00.png", SnapshotTier::FULL },
+        { "/data/test/SnapshotPolicy_2_00_thumb.png", SnapshotTier::THUMBNAIL },
+    };
+    constexpr size_t fileSize = 1024;
+    for (const auto& [path, tier] : files) {
+        FILE* file = fopen(path.c_str(), "w");
+        ASSERT_NE(nullptr, file);
+        std::string content(fileSize, 'a');
+        fwrite(content.data(), 1, content.size(), file);
+        fclose(file);
+        policy.OnFileWritten(path, tier);
+    }
+    uint64_t usage = policy.GetDiskUsage();
+    EXPECT_GE(usage, fileSize * files.size());
+    policy.OnFileAccessed(files[0].first);
+
+    policy.SetDiskBudget(usage - fileSize);
+    auto evicted = policy.EnforceDiskBudget();
+    ASSERT_EQ(1, evicted.size());
+    EXPECT_EQ(files[2].first, evicted[0]);
+
+    policy.SetDiskBudget(usage - fileSize * 3);
+    evicted = policy.EnforceDiskBudget();
+    ASSERT_EQ(2, evicted.size());
+    EXPECT_EQ(files[0].first, evicted[0]);
+    EXPECT_EQ(files[1].first, evicted[1]);
+    EXPECT_EQ(usage - fileSize * 3, policy.GetDiskUsage());
+
+    policy.SetDiskBudget(oldBudget);
+    for (const auto& [path, _] : files) {
+        remove(path.c_str());
+        policy.OnFileRemoved(path);
+    }
+    EXPECT_EQ(usage - fileSize * files.size(), policy.GetDiskUsage());
+}
+
+/**
+ * @tc.name: SnapshotPolicyEvictThroughOwner
+ * @tc.desc: an evicted full tier is removed by its owner together with the thumbnail and clears the flags
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternSnapshotTest, SnapshotPolicyEvictThroughOwner, TestSize.Level1)
+{
+    auto& policy = WSSnapshotPolicy::GetInstance();
+    uint64_t oldBudget = policy.GetDiskBudget();
+    std::string oldDirectory = ScenePersistence::snapshotDirectory_;
+    ScenePersistence::snapshotDirectory_ = "/data/test/";
+    auto owner = sptr<ScenePersistence>::MakeSptr("SnapshotPolicyOwner", 1);
+    ScenePersistence::snapshotDirectory_ = oldDirectory;
+    SnapshotStatus key = { SCREEN_UNKNOWN, SNAPSHOT_PORTRAIT };
+    std::string path = owner->snapshotPath_[key.first][key.second];
+    std::string thumbnailPath = owner->snapshotThumbnailPath_[key.first][key.second];
+    for (const auto& file : { path, thumbnailPath }) {
+        FILE* fp = fopen(file.c_str(), "w");
+        ASSERT_NE(nullptr, fp);
+        std::string content(1024, 'a');
+        fwrite(content.data(), 1, content.size(), fp);
+        fclose(fp);
+    }
+    // files found at startup have no owner until a session is restored on top of them
+    policy.OnFileWritten(thumbnailPath, SnapshotTier::THUMBNAIL);
+    policy.OnFileWritten(path, SnapshotTier::FULL);
+    owner->SetHasSnapshot(true, key);
+    int evictedCount = 0;
+    owner->SetSnapshotEvictedCallback([&evictedCount, key](SnapshotStatus evictedKey, bool freeMultiWindow) {
+        EXPECT_EQ(key, evictedKey);
+        EXPECT_FALSE(freeMultiWindow);
+        evictedCount++;
+    });
+
+    policy.SetDiskBudget(policy.GetDiskUsage() - 1);
+    auto evicted = policy.EnforceDiskBudget();
+    ASSERT_EQ(1, evicted.size());
+    EXPECT_EQ(path, evicted[0]);
+    EXPECT_EQ(1, evictedCount);
+    EXPECT_FALSE(owner->HasSnapshot(key));
+    EXPECT_NE(0, access(path.c_str(), F_OK));
+    EXPECT_NE(0, access(thumbnailPath.c_str(), F_OK));
+    EXPECT_FALSE(policy.IsFileTracked(thumbnailPath));
+    policy.SetDiskBudget(oldBudget);
+}
+
+/**
+ * @tc.name: CreateSnapshotDirLoadsDiskUsage
+ * @tc.desc: snapshots left in an existing directory count against the disk budget
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternSnapshotTest, CreateSnapshotDirLoadsDiskUsage, TestSize.Level1)
+{
+    auto& policy = WSSnapshotPolicy::GetInstance();
+    std::string oldDirectory = ScenePersistence::snapshotDirectory_;
+    std::string directory = "/data/test/CreateSnapshotDirLoadsDiskUsage";
+    mkdir(directory.c_str(), S_IRWXU);
+    ScenePersistence::CreateSnapshotDir(directory);
+    std::string path = ScenePersistence::snapshotDirectory_ + "CreateSnapshotDirLoadsDiskUsage_1_00.jpeg";
+    FILE* fp = fopen(path.c_str(), "w");
+    ASSERT_NE(nullptr, fp);
+    std::string content(1024, 'a');
+    fwrite(content.data(), 1, content.size(), fp);
+    fclose(fp);
+
+    uint64_t usage = policy.GetDiskUsage();
+    EXPECT_FALSE(ScenePersistence::CreateSnapshotDir(directory));
+    EXPECT_TRUE(policy.IsFileTracked(path));
+    EXPECT_EQ(usage + content.size(), policy.GetDiskUsage());
+
+    remove(path.c_str());
+    policy.OnFileRemoved(path);
+    ScenePersistence::snapshotDirectory_ = oldDirectory;
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -27,6 +27,22 @@ namespace {
 const std::string TEST_RDB_PATH = "/data/test/";
 const std::string TEST_INVALID_PATH = "";
 const std::string TEST_RDB_NAME = "starting_window_config_test.db";
+const std::string TEST_MEMORY_RDB_NAME = "starting_window_config_memory_test.db";
+constexpr size_t TEST_MAX_CACHE_SIZE = 128;
+
+std::shared_ptr<StartingWindowRdbManager> CreateMemoryRdbManager()
+{
+    WmsRdbConfig config;
+    config.dbName = TEST_MEMORY_RDB_NAME;
+    config.dbPath = TEST_RDB_PATH;
+    config.isMemoryRdb = true;
+    return std::make_shared<StartingWindowRdbManager>(config);
+}
+
+StartingWindowRdbItemKey MakeItemKey(const std::string& bundleName, const std::string& abilityName, bool darkMode)
+{
+    return { .bundleName = bundleName, .moduleName = "entry", .abilityName = abilityName, .darkMode = darkMode };
+}
 } // namespace
 
 class WindowPatternStartingWindowRdbTest : public testing::Test {
@@ -242,6 +258,106 @@ HWTEST_F(WindowPatternStartingWindowRdbTest, OnUpgrade, TestSize.Level1)
     res = wmsCallback.OnUpgrade(*rdbStore, 1, 2);
     EXPECT_EQ(res, NativeRdb::E_OK);
 }
+
+/**
+ * @tc.name: QueryDataByBundleNames
+ * @tc.desc: all records of the requested bundles are read in one query
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternStartingWindowRdbTest, QueryDataByBundleNames, TestSize.Level1)
+{
+    auto rdbMgr = CreateMemoryRdbManager();
+    ASSERT_TRUE(rdbMgr->Init());
+    StartingWindowInfo info;
+    std::vector<std::pair<StartingWindowRdbItemKey, StartingWindowInfo>> inputValues;
+    for (const std::string bundleName : { "first", "second", "third" }) {
+        for (bool darkMode : { false, true }) {
+            info.backgroundColor_ = darkMode ? 0xff000000 : 0xffffffff;
+            info.iconPath_ = bundleName + "_icon";
+            inputValues.emplace_back(MakeItemKey(bundleName, "MainAbility", darkMode), info);
+        }
+    }
+    int64_t outInsertNum = -1;
+    ASSERT_TRUE(rdbMgr->BatchInsert(outInsertNum, inputValues));
+
+    std::vector<std::pair<StartingWindowRdbItemKey, StartingWindowInfo>> outValues;
+    ASSERT_TRUE(rdbMgr->QueryDataByBundleNames({ "first", "third", "unknown" }, outValues));
+    ASSERT_EQ(outValues.size(), 4);
+    for (const auto& [itemKey, itemValue] : outValues) {
+        EXPECT_NE(itemKey.bundleName, "second");
+        EXPECT_EQ(itemKey.abilityName, "MainAbility");
+        EXPECT_EQ(itemValue.iconPath_, itemKey.bundleName + "_icon");
+        EXPECT_EQ(itemValue.backgroundColor_, itemKey.darkMode ? 0xff000000 : 0xffffffff);
+    }
+    outValues.clear();
+    EXPECT_TRUE(rdbMgr->QueryDataByBundleNames({}, outValues));
+    EXPECT_TRUE(outValues.empty());
+}
+
+/**
+ * @tc.name: QueryDataCache
+ * @tc.desc: positive and negative lookups are served from the cache until the store is changed
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternStartingWindowRdbTest, QueryDataCache, TestSize.Level1)
+{
+    auto rdbMgr = CreateMemoryRdbManager();
+    ASSERT_TRUE(rdbMgr->Init());
+    auto itemKey = MakeItemKey("testName", "MainAbility", false);
+    StartingWindowInfo inputInfo, resInfo;
+    inputInfo.backgroundColor_ = 1;
+    EXPECT_FALSE(rdbMgr->QueryData(itemKey, resInfo));
+    bool isFound = true;
+    ASSERT_TRUE(rdbMgr->GetFromCache(itemKey, isFound, resInfo));
+    EXPECT_FALSE(isFound);
+
+    ASSERT_TRUE(rdbMgr->InsertData(itemKey, inputInfo));
+    ASSERT_TRUE(rdbMgr->QueryData(itemKey, resInfo));
+    EXPECT_EQ(resInfo.backgroundColor_, inputInfo.backgroundColor_);
+
+    int32_t deletedRows = -1;
+    NativeRdb::AbsRdbPredicates absRdbPredicates(rdbMgr->wmsRdbConfig_.tableName);
+    ASSERT_EQ(rdbMgr->GetRdbStore()->Delete(deletedRows, absRdbPredicates), NativeRdb::E_OK);
+    resInfo.backgroundColor_ = 0;
+    ASSERT_TRUE(rdbMgr->QueryData(itemKey, resInfo));
+    EXPECT_EQ(resInfo.backgroundColor_, inputInfo.backgroundColor_);
+
+    ASSERT_TRUE(rdbMgr->DeleteDataByBundleName("testName"));
+    EXPECT_FALSE(rdbMgr->GetFromCache(itemKey, isFound, resInfo));
+    EXPECT_FALSE(rdbMgr->QueryData(itemKey, resInfo));
+}
+
+/**
+ * @tc.name: QueryDataCacheInvalidation
+ * @tc.desc: batch inserts and bundle deletes invalidate cached entries, the cache stays bounded
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowPatternStartingWindowRdbTest, QueryDataCacheInvalidation, TestSize.Level1)
+{
+    auto rdbMgr = CreateMemoryRdbManager();
+    ASSERT_TRUE(rdbMgr->Init());
+    auto firstKey = MakeItemKey("first", "MainAbility", false);
+    auto secondKey = MakeItemKey("second", "MainAbility", false);
+    StartingWindowInfo info;
+    EXPECT_FALSE(rdbMgr->QueryData(firstKey, info));
+    ASSERT_TRUE(rdbMgr->InsertData(secondKey, info));
+    ASSERT_TRUE(rdbMgr->QueryData(secondKey, info));
+
+    int64_t outInsertNum = -1;
+    ASSERT_TRUE(rdbMgr->BatchInsert(outInsertNum, { std::make_pair(firstKey, info) }));
+    EXPECT_TRUE(rdbMgr->QueryData(firstKey, info));
+    ASSERT_TRUE(rdbMgr->DeleteDataByBundleName("first"));
+    EXPECT_FALSE(rdbMgr->QueryData(firstKey, info));
+    EXPECT_TRUE(rdbMgr->QueryData(secondKey, info));
+
+    for (size_t i = 0; i < TEST_MAX_CACHE_SIZE * 2; i++) {
+        rdbMgr->QueryData(MakeItemKey("absent", "Ability" + std::to_string(i), false), info);
+    }
+    EXPECT_EQ(rdbMgr->cacheList_.size(), TEST_MAX_CACHE_SIZE);
+    EXPECT_EQ(rdbMgr->cacheMap_.size(), TEST_MAX_CACHE_SIZE);
+    ASSERT_TRUE(rdbMgr->DeleteAllData());
+    EXPECT_TRUE(rdbMgr->cacheList_.empty());
+}
 } // namespace
 } // namespace Rosen
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -14,10 +14,13 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
 #include <libxml/globals.h>
 #include <libxml/xmlstring.h>
 #include "window_scene_config.h"
 #include "window_manager_hilog.h"
+#include "xml_config_cache.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -427,6 +430,84 @@ HWTEST_F(WindowSceneConfigTest, MaxMidSceneNumConfig01, Function | SmallTest | L
     ASSERT_EQ(3, value[0]);
 }
 
+std::vector<uint8_t> EncodeConfig(const ConfigItem& config)
+{
+    XmlConfigCacheWriter writer;
+    writer.WriteConfigItem(config);
+    return writer.GetData();
+}
+
+void WriteFile(const std::string& path, const std::string& content)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << content;
+}
+
+/**
+ * @tc.name: ConfigCacheParity
+ * @tc.desc: the config loaded from the cache equals the config parsed from the xml
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowSceneConfigTest, ConfigCacheParity, TestSize.Level1)
+{
+    const std::string xmlPath = "/data/test/window_scene_config_cache_test.xml";
+    const std::string cachePath = "/data/test/window_scene_config_cache_test.cache";
+    WriteFile(xmlPath, XML_STR);
+    std::remove(cachePath.c_str());
+    ASSERT_EQ(true, WindowSceneConfig::LoadConfig(xmlPath, cachePath));
+    auto parsed = EncodeConfig(WindowSceneConfig::config_);
+    ASSERT_EQ(parsed, EncodeConfig(ReadConfig(XML_STR)));
+
+    XmlConfigSource source;
+    ASSERT_EQ(true, XmlConfigCache::GetSource(xmlPath, source));
+    WindowSceneConfig::config_ = ConfigItem();
+    ASSERT_EQ(true, WindowSceneConfig::LoadConfigCache(cachePath, source));
+    EXPECT_EQ(parsed, EncodeConfig(WindowSceneConfig::config_));
+    EXPECT_EQ("easeOut", WindowSceneConfig::config_["windowAnimation"]["timing"]["curve"].GetProp("name").stringValue_);
+    std::remove(xmlPath.c_str());
+    std::remove(cachePath.c_str());
+}
+
+/**
+ * @tc.name: ConfigCacheInvalidation
+ * @tc.desc: a changed xml is parsed again and replaces the cache
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowSceneConfigTest, ConfigCacheInvalidation, TestSize.Level1)
+{
+    const std::string xmlPath = "/data/test/window_scene_config_cache_test.xml";
+    const std::string cachePath = "/data/test/window_scene_config_cache_test.cache";
+    std::string xmlStr =
+        "<?xml version='1.0' encoding=\"utf-8\"?>"
+        "<Configs>"
+        "<maxMidSceneNum>3</maxMidSceneNum>"
+        "</Configs>";
+    WriteFile(xmlPath, xmlStr);
+    std::remove(cachePath.c_str());
+    ASSERT_EQ(true, WindowSceneConfig::LoadConfig(xmlPath, cachePath));
+    XmlConfigSource oldSource;
+    ASSERT_EQ(true, XmlConfigCache::GetSource(xmlPath, oldSource));
+
+    xmlStr =
+        "<?xml version='1.0' encoding=\"utf-8\"?>"
+        "<Configs>"
+        "<maxMidSceneNum>4</maxMidSceneNum>"
+        "</Configs>";
+    WriteFile(xmlPath, xmlStr);
+    XmlConfigSource newSource;
+    ASSERT_EQ(true, XmlConfigCache::GetSource(xmlPath, newSource));
+    EXPECT_NE(oldSource.hash, newSource.hash);
+    EXPECT_EQ(false, WindowSceneConfig::LoadConfigCache(cachePath, newSource));
+
+    ASSERT_EQ(true, WindowSceneConfig::LoadConfig(xmlPath, cachePath));
+    WindowSceneConfig::config_ = ConfigItem();
+    ASSERT_EQ(true, WindowSceneConfig::LoadConfigCache(cachePath, newSource));
+    ASSERT_EQ(true, WindowSceneConfig::config_["maxMidSceneNum"].IsInts());
+    EXPECT_EQ(4, (*WindowSceneConfig::config_["maxMidSceneNum"].intsValue_)[0]);
+    EXPECT_EQ(false, WindowSceneConfig::LoadConfigCache(cachePath, oldSource));
+    std::remove(xmlPath.c_str());
+    std::remove(cachePath.c_str());
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <image_type.h>
+#include <pixel_map.h>
+
+#include "ws_snapshot_pipeline.h"
+
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr uint32_t WAIT_TASK_START_US = 1000;
+constexpr uint32_t WAIT_TASK_START_RETRY = 2000;
+constexpr uint32_t BACKGROUND_DEPTH_LIMIT = 16;
+constexpr uint32_t CAPTURE_CONCURRENCY = 3;
+constexpr uint32_t CAPTURE_TIMEOUT_MS = 1000;
+
+bool WaitUntil(const std::function<bool()>& condition)
+{
+    for (uint32_t i = 0; i < WAIT_TASK_START_RETRY; i++) {
+        if (condition()) {
+            return true;
+        }
+        usleep(WAIT_TASK_START_US);
+    }
+    return condition();
+}
+
+/*
+ * Fake capture backend, records every started capture and completes it only when the test says so.
+ */
+class FakeCaptureBackend {
+public:
+    static SnapshotCaptureStarter MakeStarter(const std::shared_ptr<FakeCaptureBackend>& backend,
+        bool startResult = true)
+    {
+        return [backend, startResult](SnapshotCaptureCallback&& onCaptured) {
+            std::lock_guard<std::mutex> lock(backend->mutex_);
+            backend->captures_.push_back(std::move(onCaptured));
+            return startResult;
+        };
+    }
+
+    size_t GetStartCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return captures_.size();
+    }
+
+    void Complete(size_t index, const std::shared_ptr<Media::PixelMap>& pixelMap)
+    {
+        SnapshotCaptureCallback onCaptured;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            onCaptured = captures_[index];
+        }
+        onCaptured(pixelMap);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<SnapshotCaptureCallback> captures_;
+};
+
+struct CaptureResult {
+    std::atomic<uint32_t> count { 0 };
+    std::shared_ptr<Media::PixelMap> pixelMap;
+};
+
+SnapshotCaptureCallback MakeCallback(const std::shared_ptr<CaptureResult>& result)
+{
+    return [result](const std::shared_ptr<Media::PixelMap>& pixelMap) {
+        result->pixelMap = pixelMap;
+        result->count++;
+    };
+}
+
+SnapshotCaptureKey MakeKey(int32_t persistentId, float scale = 1.0f)
+{
+    SnapshotCaptureKey key;
+    key.persistentId = persistentId;
+    key.scale = scale;
+    return key;
+}
+
+std::shared_ptr<Media::PixelMap> CreatePixelMap()
+{
+    Media::InitializationOptions opts;
+    opts.size.width = 2;
+    opts.size.height = 2;
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    return Media::PixelMap::Create(opts);
+}
+} // namespace
+
+class WSSnapshotPipelineTest : public testing::Test {
+protected:
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void WSSnapshotPipelineTest::SetUp()
+{
+    WSSnapshotPipeline::GetInstance().ResetStat();
+}
+
+void WSSnapshotPipelineTest::TearDown()
+{
+    WSSnapshotPipeline::GetInstance().SetQueueDepthLimit(SnapshotLane::BACKGROUND, BACKGROUND_DEPTH_LIMIT);
+    WSSnapshotPipeline::GetInstance().SetCaptureConcurrency(CAPTURE_CONCURRENCY);
+    WaitUntil([] { return WSSnapshotPipeline::GetInstance().GetQueueDepth(SnapshotLane::BACKGROUND) == 0; });
+}
+
+/**
+ * @tc.name: SubmitTask
+ * @tc.desc: task runs on the lane and leaves the pending queue
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, SubmitTask, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    std::atomic<int32_t> runCount { 0 };
+    EXPECT_TRUE(pipeline.SubmitTask(SnapshotLane::INTERACTIVE, [&runCount] { runCount++; }, "SubmitTask"));
+    EXPECT_TRUE(WaitUntil([&runCount] { return runCount.load() == 1; }));
+    EXPECT_TRUE(WaitUntil([&pipeline] { return pipeline.GetQueueDepth(SnapshotLane::INTERACTIVE) == 0; }));
+    EXPECT_EQ(1, pipeline.GetLaneStat(SnapshotLane::INTERACTIVE).submitted);
+    EXPECT_FALSE(pipeline.SubmitTask(SnapshotLane::COUNT, [] {}, "SubmitTask"));
+    EXPECT_FALSE(pipeline.SubmitTask(SnapshotLane::INTERACTIVE, nullptr, "SubmitTask"));
+}
+
+/**
+ * @tc.name: Backpressure
+ * @tc.desc: pending tasks with the same name coalesce, new names are rejected over the depth limit
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, Backpressure, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int32_t> started { 0 };
+    auto blockTask = [&started, released] {
+        started++;
+        released.wait();
+    };
+    // occupy both background workers so later tasks stay pending
+    EXPECT_TRUE(pipeline.SubmitTask(SnapshotLane::BACKGROUND, blockTask, "Backpressure_block0"));
+    EXPECT_TRUE(pipeline.SubmitTask(SnapshotLane::BACKGROUND, blockTask, "Backpressure_block1"));
+    ASSERT_TRUE(WaitUntil([&started] { return started.load() == 2; }));
+
+    pipeline.SetQueueDepthLimit(SnapshotLane::BACKGROUND, 2);
+    std::atomic<int32_t> taskA { 0 };
+    EXPECT_TRUE(pipeline.SubmitTask(SnapshotLane::BACKGROUND, [&taskA] { taskA++; }, "Backpressure_a"));
+    EXPECT_TRUE(pipeline.SubmitTask(SnapshotLane::BACKGROUND, [] {}, "Backpressure_b"));
+    EXPECT_FALSE(pipeline.SubmitTask(SnapshotLane::BACKGROUND, [] {}, "Backpressure_c"));
+    EXPECT_TRUE(pipeline.SubmitTask(SnapshotLane::BACKGROUND, [&taskA] { taskA++; }, "Backpressure_a"));
+    EXPECT_EQ(2, pipeline.GetQueueDepth(SnapshotLane::BACKGROUND));
+
+    auto stat = pipeline.GetLaneStat(SnapshotLane::BACKGROUND);
+    EXPECT_EQ(1, stat.coalesced);
+    EXPECT_EQ(1, stat.rejected);
+    EXPECT_EQ(2, stat.depthLimit);
+
+    release.set_value();
+    EXPECT_TRUE(WaitUntil([&pipeline] { return pipeline.GetQueueDepth(SnapshotLane::BACKGROUND) == 0; }));
+    EXPECT_TRUE(WaitUntil([&taskA] { return taskA.load() >= 1; }));
+}
+
+/**
+ * @tc.name: CancelTask
+ * @tc.desc: cancel removes the pending task
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CancelTask, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    pipeline.CancelTask(SnapshotLane::INTERACTIVE, "CancelTask_notExist");
+    pipeline.CancelTask(SnapshotLane::COUNT, "CancelTask_notExist");
+    EXPECT_EQ(0, pipeline.GetQueueDepth(SnapshotLane::COUNT));
+    EXPECT_TRUE(pipeline.SubmitTask(SnapshotLane::INTERACTIVE, [] {}, "CancelTask"));
+    pipeline.CancelTask(SnapshotLane::INTERACTIVE, "CancelTask");
+    EXPECT_TRUE(WaitUntil([&pipeline] { return pipeline.GetQueueDepth(SnapshotLane::INTERACTIVE) == 0; }));
+}
+
+/**
+ * @tc.name: StageStat
+ * @tc.desc: stage cost is aggregated and dumped
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, StageStat, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    pipeline.RecordStageCost(SnapshotStage::ENCODE, 100);
+    pipeline.RecordStageCost(SnapshotStage::ENCODE, 300);
+    pipeline.RecordStageCost(SnapshotStage::COUNT, 300);
+    {
+        SnapshotStageTimer timer(SnapshotStage::CAPTURE);
+    }
+    auto stat = pipeline.GetStageStat(SnapshotStage::ENCODE);
+    EXPECT_EQ(2, stat.count);
+    EXPECT_EQ(400, stat.totalCostUs);
+    EXPECT_EQ(300, stat.maxCostUs);
+    EXPECT_EQ(300, stat.lastCostUs);
+    EXPECT_EQ(1, pipeline.GetStageStat(SnapshotStage::CAPTURE).count);
+
+    std::string dumpInfo;
+    pipeline.DumpInfo(dumpInfo);
+    EXPECT_NE(std::string::npos, dumpInfo.find("encode"));
+    EXPECT_NE(std::string::npos, dumpInfo.find("background"));
+    EXPECT_NE(std::string::npos, dumpInfo.find("Capture      Requested     Deduplicated  "));
+}
+
+/**
+ * @tc.name: Downscale
+ * @tc.desc: downscale returns a scaled copy over the limit and the input itself otherwise
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, Downscale, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    EXPECT_EQ(nullptr, pipeline.Downscale(nullptr, 100));
+
+    Media::InitializationOptions opts;
+    opts.size.width = 200;
+    opts.size.height = 100;
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    std::shared_ptr<Media::PixelMap> pixelMap = Media::PixelMap::Create(opts);
+    ASSERT_NE(nullptr, pixelMap);
+    EXPECT_EQ(pixelMap, pipeline.Downscale(pixelMap, 0));
+    EXPECT_EQ(pixelMap, pipeline.Downscale(pixelMap, 200));
+    auto scaledPixelMap = pipeline.Downscale(pixelMap, 50);
+    ASSERT_NE(nullptr, scaledPixelMap);
+    EXPECT_EQ(50, scaledPixelMap->GetWidth());
+    EXPECT_EQ(25, scaledPixelMap->GetHeight());
+    EXPECT_EQ(200, pixelMap->GetWidth());
+}
+
+/**
+ * @tc.name: CaptureDedup
+ * @tc.desc: requests of the same session share one capture waiting for its start
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CaptureDedup, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    pipeline.SetCaptureConcurrency(1);
+    auto backend = std::make_shared<FakeCaptureBackend>();
+    auto result1 = std::make_shared<CaptureResult>();
+    auto result2 = std::make_shared<CaptureResult>();
+    auto blockResult = std::make_shared<CaptureResult>();
+    EXPECT_EQ(0, pipeline.CaptureAsync(MakeKey(1), nullptr, MakeCallback(result1), CAPTURE_TIMEOUT_MS));
+    EXPECT_EQ(0, pipeline.CaptureAsync(MakeKey(1), FakeCaptureBackend::MakeStarter(backend), nullptr, CAPTURE_TIMEOUT_MS));
+
+    // keeps the only slot busy so the captures of key 1 wait
+    pipeline.CaptureAsync(MakeKey(2), FakeCaptureBackend::MakeStarter(backend), MakeCallback(blockResult),
+        CAPTURE_TIMEOUT_MS);
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == 1; }));
+    uint64_t handle1 = pipeline.CaptureAsync(MakeKey(1), FakeCaptureBackend::MakeStarter(backend), MakeCallback(result1),
+        CAPTURE_TIMEOUT_MS);
+    uint64_t handle2 = pipeline.CaptureAsync(MakeKey(1), FakeCaptureBackend::MakeStarter(backend), MakeCallback(result2),
+        CAPTURE_TIMEOUT_MS);
+    EXPECT_NE(0, handle1);
+    EXPECT_NE(handle1, handle2);
+    EXPECT_EQ(1, pipeline.GetCaptureStat().deduplicated);
+    EXPECT_EQ(1, pipeline.GetCaptureStat().waiting);
+
+    auto pixelMap = CreatePixelMap();
+    ASSERT_NE(nullptr, pixelMap);
+    backend->Complete(0, pixelMap);
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == 2; }));
+    backend->Complete(1, pixelMap);
+    ASSERT_TRUE(WaitUntil([&result1, &result2] { return result1->count == 1 && result2->count == 1; }));
+    EXPECT_EQ(pixelMap, result1->pixelMap);
+    EXPECT_EQ(pixelMap, result2->pixelMap);
+    EXPECT_FALSE(pipeline.CancelCapture(handle1));
+    EXPECT_EQ(2, backend->GetStartCount());
+    EXPECT_EQ(0, pipeline.GetCaptureStat().running);
+}
+
+/**
+ * @tc.name: CaptureDedupAfterStart
+ * @tc.desc: a request arriving after the capture of its key started gets a capture of its own
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CaptureDedupAfterStart, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    auto backend = std::make_shared<FakeCaptureBackend>();
+    auto result1 = std::make_shared<CaptureResult>();
+    auto result2 = std::make_shared<CaptureResult>();
+    pipeline.CaptureAsync(MakeKey(3), FakeCaptureBackend::MakeStarter(backend), MakeCallback(result1),
+        CAPTURE_TIMEOUT_MS);
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == 1; }));
+    uint64_t handle2 = pipeline.CaptureAsync(MakeKey(3), FakeCaptureBackend::MakeStarter(backend),
+        MakeCallback(result2), CAPTURE_TIMEOUT_MS);
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == 2; }));
+    EXPECT_EQ(0, pipeline.GetCaptureStat().deduplicated);
+
+    auto stalePixelMap = CreatePixelMap();
+    auto pixelMap = CreatePixelMap();
+    backend->Complete(0, stalePixelMap);
+    ASSERT_TRUE(WaitUntil([&result1] { return result1->count == 1; }));
+    EXPECT_EQ(stalePixelMap, result1->pixelMap);
+    EXPECT_EQ(0, result2->count);
+    backend->Complete(1, pixelMap);
+    ASSERT_TRUE(WaitUntil([&result2] { return result2->count == 1; }));
+    EXPECT_EQ(pixelMap, result2->pixelMap);
+    EXPECT_FALSE(pipeline.CancelCapture(handle2));
+    EXPECT_EQ(0, pipeline.GetCaptureStat().running);
+}
+
+/**
+ * @tc.name: CaptureCancel
+ * @tc.desc: a cancelled request gets no result and a capture nobody waits for is never started
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CaptureCancel, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    pipeline.SetCaptureConcurrency(1);
+    auto backend = std::make_shared<FakeCaptureBackend>();
+    auto resultA = std::make_shared<CaptureResult>();
+    auto resultB1 = std::make_shared<CaptureResult>();
+    auto resultB2 = std::make_shared<CaptureResult>();
+    auto resultC = std::make_shared<CaptureResult>();
+    pipeline.CaptureAsync(MakeKey(10), FakeCaptureBackend::MakeStarter(backend), MakeCallback(resultA), CAPTURE_TIMEOUT_MS);
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == 1; }));
+    uint64_t handleB1 = pipeline.CaptureAsync(MakeKey(11), FakeCaptureBackend::MakeStarter(backend), MakeCallback(resultB1),
+        CAPTURE_TIMEOUT_MS);
+    pipeline.CaptureAsync(MakeKey(11), FakeCaptureBackend::MakeStarter(backend), MakeCallback(resultB2), CAPTURE_TIMEOUT_MS);
+    uint64_t handleC = pipeline.CaptureAsync(MakeKey(12), FakeCaptureBackend::MakeStarter(backend), MakeCallback(resultC),
+        CAPTURE_TIMEOUT_MS);
+    EXPECT_EQ(2, pipeline.GetCaptureStat().waiting);
+
+    EXPECT_TRUE(pipeline.CancelCapture(handleB1));
+    EXPECT_FALSE(pipeline.CancelCapture(handleB1));
+    EXPECT_TRUE(pipeline.CancelCapture(handleC));
+    EXPECT_EQ(1, pipeline.GetCaptureStat().waiting);
+    EXPECT_EQ(2, pipeline.GetCaptureStat().cancelled);
+
+    auto pixelMap = CreatePixelMap();
+    backend->Complete(0, pixelMap);
+    EXPECT_TRUE(WaitUntil([&resultA] { return resultA->count == 1; }));
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == 2; }));
+    backend->Complete(1, pixelMap);
+    ASSERT_TRUE(WaitUntil([&resultB2] { return resultB2->count == 1; }));
+    EXPECT_EQ(0, resultB1->count);
+    EXPECT_EQ(pixelMap, resultB2->pixelMap);
+    EXPECT_EQ(0, resultC->count);
+    EXPECT_EQ(2, backend->GetStartCount());
+    EXPECT_EQ(0, pipeline.GetCaptureStat().waiting);
+}
+
+/**
+ * @tc.name: CaptureTimeout
+ * @tc.desc: a capture that never completes or fails to start ends with nullptr and frees its slot
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CaptureTimeout, TestSize.Level1)
+{
+    constexpr uint32_t shortTimeoutMs = 50;
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    auto backend = std::make_shared<FakeCaptureBackend>();
+    auto result = std::make_shared<CaptureResult>();
+    result->pixelMap = CreatePixelMap();
+    pipeline.CaptureAsync(MakeKey(20), FakeCaptureBackend::MakeStarter(backend), MakeCallback(result), shortTimeoutMs);
+    ASSERT_TRUE(WaitUntil([&result] { return result->count == 1; }));
+    EXPECT_EQ(nullptr, result->pixelMap);
+    EXPECT_EQ(1, pipeline.GetCaptureStat().timeout);
+    EXPECT_EQ(0, pipeline.GetCaptureStat().running);
+    backend->Complete(0, CreatePixelMap());
+    EXPECT_EQ(1, result->count);
+    EXPECT_EQ(nullptr, result->pixelMap);
+
+    auto failResult = std::make_shared<CaptureResult>();
+    failResult->pixelMap = CreatePixelMap();
+    pipeline.CaptureAsync(MakeKey(21), FakeCaptureBackend::MakeStarter(backend, false), MakeCallback(failResult),
+        CAPTURE_TIMEOUT_MS);
+    ASSERT_TRUE(WaitUntil([&failResult] { return failResult->count == 1; }));
+    EXPECT_EQ(nullptr, failResult->pixelMap);
+    EXPECT_EQ(1, pipeline.GetCaptureStat().timeout);
+}
+
+/**
+ * @tc.name: CaptureConcurrency
+ * @tc.desc: at most captureConcurrency captures run at once, the next one starts when a slot frees
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CaptureConcurrency, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    auto backend = std::make_shared<FakeCaptureBackend>();
+    std::vector<std::shared_ptr<CaptureResult>> results;
+    for (int32_t persistentId = 30; persistentId < 34; persistentId++) {
+        results.push_back(std::make_shared<CaptureResult>());
+        pipeline.CaptureAsync(MakeKey(persistentId), FakeCaptureBackend::MakeStarter(backend), MakeCallback(results.back()),
+            CAPTURE_TIMEOUT_MS);
+    }
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == CAPTURE_CONCURRENCY; }));
+    EXPECT_EQ(CAPTURE_CONCURRENCY, pipeline.GetCaptureStat().running);
+    EXPECT_EQ(1, pipeline.GetCaptureStat().waiting);
+
+    auto pixelMap = CreatePixelMap();
+    backend->Complete(0, pixelMap);
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == CAPTURE_CONCURRENCY + 1; }));
+    for (size_t i = 1; i <= CAPTURE_CONCURRENCY; i++) {
+        backend->Complete(i, pixelMap);
+    }
+    for (const auto& result : results) {
+        EXPECT_TRUE(WaitUntil([&result] { return result->count == 1; }));
+        EXPECT_EQ(pixelMap, result->pixelMap);
+    }
+    EXPECT_EQ(0, pipeline.GetCaptureStat().running);
+    EXPECT_NE(0, pipeline.GetStageStat(SnapshotStage::CAPTURE).count);
+}
+
+/**
+ * @tc.name: CaptureKey
+ * @tc.desc: requests of the same session with another capture key do not share a capture
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CaptureKey, TestSize.Level1)
+{
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    auto backend = std::make_shared<FakeCaptureBackend>();
+    auto result1 = std::make_shared<CaptureResult>();
+    auto result2 = std::make_shared<CaptureResult>();
+    auto result3 = std::make_shared<CaptureResult>();
+    auto rotatedKey = MakeKey(40);
+    rotatedKey.rotation = 90;
+    pipeline.CaptureAsync(MakeKey(40), FakeCaptureBackend::MakeStarter(backend), MakeCallback(result1),
+        CAPTURE_TIMEOUT_MS);
+    pipeline.CaptureAsync(MakeKey(40, 0.5f), FakeCaptureBackend::MakeStarter(backend), MakeCallback(result2),
+        CAPTURE_TIMEOUT_MS);
+    pipeline.CaptureAsync(rotatedKey, FakeCaptureBackend::MakeStarter(backend), MakeCallback(result3),
+        CAPTURE_TIMEOUT_MS);
+    ASSERT_TRUE(WaitUntil([&backend] { return backend->GetStartCount() == 3; }));
+    EXPECT_EQ(0, pipeline.GetCaptureStat().deduplicated);
+
+    auto pixelMap = CreatePixelMap();
+    for (size_t i = 0; i < 3; i++) {
+        backend->Complete(i, pixelMap);
+    }
+    EXPECT_TRUE(WaitUntil([&result1, &result2, &result3] {
+        return result1->count == 1 && result2->count == 1 && result3->count == 1;
+    }));
+    EXPECT_EQ(0, pipeline.GetCaptureStat().running);
+}
+
+/**
+ * @tc.name: CaptureTaskCount
+ * @tc.desc: finished and timed out captures leave no task behind in the ffrt helpers
+ * @tc.type: FUNC
+ */
+HWTEST_F(WSSnapshotPipelineTest, CaptureTaskCount, TestSize.Level1)
+{
+    constexpr int32_t captureCount = 64;
+    constexpr uint32_t shortTimeoutMs = 50;
+    auto& pipeline = WSSnapshotPipeline::GetInstance();
+    auto& laneHelper = pipeline.lanes_[static_cast<size_t>(SnapshotLane::INTERACTIVE)].ffrtHelper;
+    size_t laneTaskCount = laneHelper->CountTask();
+    size_t timerTaskCount = pipeline.captureTimer_->CountTask();
+    auto pixelMap = CreatePixelMap();
+    std::vector<std::shared_ptr<CaptureResult>> results;
+    for (int32_t persistentId = 50; persistentId < 50 + captureCount; persistentId++) {
+        results.push_back(std::make_shared<CaptureResult>());
+        auto starter = [pixelMap](SnapshotCaptureCallback&& onCaptured) {
+            onCaptured(pixelMap);
+            return true;
+        };
+        pipeline.CaptureAsync(MakeKey(persistentId), starter, MakeCallback(results.back()), CAPTURE_TIMEOUT_MS);
+    }
+    auto backend = std::make_shared<FakeCaptureBackend>();
+    results.push_back(std::make_shared<CaptureResult>());
+    pipeline.CaptureAsync(MakeKey(50 + captureCount), FakeCaptureBackend::MakeStarter(backend),
+        MakeCallback(results.back()), shortTimeoutMs);
+    for (const auto& result : results) {
+        EXPECT_TRUE(WaitUntil([&result] { return result->count == 1; }));
+    }
+    EXPECT_EQ(1, pipeline.GetCaptureStat().timeout);
+    EXPECT_LE(laneHelper->CountTask(), laneTaskCount);
+    EXPECT_LE(pipeline.captureTimer_->CountTask(), timerTaskCount);
+}
+} // namespace OHOS::Rosen
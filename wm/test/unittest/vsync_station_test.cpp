@@ -14,6 +14,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <thread>
+#include <unordered_map>
 #include <vsync_station.h>
 
 using namespace testing;
@@ -158,6 +160,210 @@ HWTEST_F(VsyncStationTest, DecreaseRequestVsyncTimes, TestSize.Level1)
         EXPECT_EQ(current - 1, desired);
     }
 }
+
+constexpr int32_t THREAD_COUNT = 4;
+constexpr int32_t CALLBACK_COUNT = 256;
+constexpr int32_t FRAME_CALLBACK_COUNT = 8;
+constexpr int32_t REGISTRATION_COUNT = 1000;
+
+std::vector<std::shared_ptr<VsyncCallback>> CreateCallbacks(int32_t count)
+{
+    std::vector<std::shared_ptr<VsyncCallback>> callbacks;
+    for (int32_t i = 0; i < count; i++) {
+        callbacks.push_back(std::make_shared<VsyncCallback>());
+    }
+    return callbacks;
+}
+
+/**
+ * @tc.name: VsyncCallbackQueuePopAll
+ * @tc.desc: callbacks are taken in push order and each callback once per frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, VsyncCallbackQueuePopAll, TestSize.Level1)
+{
+    auto callbacks = CreateCallbacks(3);
+    VsyncCallbackQueue queue;
+    EXPECT_TRUE(queue.IsEmpty());
+    queue.Push(callbacks[0]);
+    queue.Push(callbacks[1]);
+    queue.Push(callbacks[0]);
+    queue.Push(callbacks[2]);
+    EXPECT_FALSE(queue.IsEmpty());
+    std::vector<std::shared_ptr<VsyncCallback>> frameCallbacks;
+    queue.PopAll(frameCallbacks);
+    ASSERT_EQ(frameCallbacks.size(), 3);
+    EXPECT_EQ(frameCallbacks[0], callbacks[0]);
+    EXPECT_EQ(frameCallbacks[1], callbacks[1]);
+    EXPECT_EQ(frameCallbacks[2], callbacks[2]);
+    EXPECT_TRUE(queue.IsEmpty());
+
+    frameCallbacks.clear();
+    queue.Push(callbacks[1]);
+    queue.Clear();
+    queue.PopAll(frameCallbacks);
+    EXPECT_TRUE(frameCallbacks.empty());
+    EXPECT_EQ(callbacks[1].use_count(), 1);
+}
+
+/**
+ * @tc.name: VsyncCallbackQueueStress
+ * @tc.desc: concurrent producers and a consumer taking frames lose no callback
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, VsyncCallbackQueueStress, TestSize.Level1)
+{
+    constexpr int32_t pushCount = 2;
+    std::vector<std::vector<std::shared_ptr<VsyncCallback>>> callbacks;
+    std::unordered_map<VsyncCallback*, int32_t> dispatchCount;
+    for (int32_t i = 0; i < THREAD_COUNT; i++) {
+        callbacks.push_back(CreateCallbacks(CALLBACK_COUNT));
+        for (const auto& callback : callbacks.back()) {
+            dispatchCount[callback.get()] = 0;
+        }
+    }
+    VsyncCallbackQueue queue;
+    std::atomic<int32_t> runningCount { THREAD_COUNT };
+    std::vector<std::thread> producers;
+    for (int32_t i = 0; i < THREAD_COUNT; i++) {
+        producers.emplace_back([&queue, &runningCount, &threadCallbacks = callbacks[i]] {
+            for (const auto& callback : threadCallbacks) {
+                for (int32_t j = 0; j < pushCount; j++) {
+                    queue.Push(callback);
+                }
+            }
+            runningCount--;
+        });
+    }
+    std::vector<std::shared_ptr<VsyncCallback>> frameCallbacks;
+    uint32_t frameCount = 0;
+    bool isProducing = true;
+    while (isProducing) {
+        isProducing = runningCount.load() > 0;
+        queue.PopAll(frameCallbacks);
+        std::unordered_set<VsyncCallback*> frameSet;
+        for (const auto& callback : frameCallbacks) {
+            EXPECT_TRUE(frameSet.insert(callback.get()).second);
+            dispatchCount[callback.get()]++;
+        }
+        frameCallbacks.clear();
+        frameCount++;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQ(dispatchCount.size(), THREAD_COUNT * CALLBACK_COUNT);
+    for (const auto& [callback, count] : dispatchCount) {
+        EXPECT_GE(count, 1);
+        EXPECT_LE(count, pushCount);
+    }
+    GTEST_LOG_(INFO) << "frames: " << frameCount;
+}
+
+/**
+ * @tc.name: RequestVsyncConcurrentWithVsync
+ * @tc.desc: a callback requested while a vsync is dispatched is taken by that vsync or requests the next one
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, RequestVsyncConcurrentWithVsync, TestSize.Level1)
+{
+    // the runner is not started, vsyncs are delivered by this test only
+    auto vsyncHandler = std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create(false));
+    auto vsyncStation = std::make_shared<VsyncStation>(0, vsyncHandler);
+    if (!vsyncStation->IsVsyncReceiverCreated()) {
+        GTEST_LOG_(INFO) << "vsync receiver not available";
+        return;
+    }
+    std::vector<std::vector<std::shared_ptr<VsyncCallback>>> callbacks;
+    std::vector<int32_t> dispatchCount(THREAD_COUNT * CALLBACK_COUNT, 0);
+    for (int32_t i = 0; i < THREAD_COUNT; i++) {
+        callbacks.push_back(CreateCallbacks(CALLBACK_COUNT));
+        for (int32_t j = 0; j < CALLBACK_COUNT; j++) {
+            int32_t index = i * CALLBACK_COUNT + j;
+            callbacks[i][j]->onCallback = [&dispatchCount, index](int64_t, int64_t) { dispatchCount[index]++; };
+        }
+    }
+    std::atomic<int32_t> runningCount { THREAD_COUNT };
+    std::vector<std::thread> producers;
+    for (int32_t i = 0; i < THREAD_COUNT; i++) {
+        producers.emplace_back([&vsyncStation, &runningCount, &threadCallbacks = callbacks[i]] {
+            for (const auto& callback : threadCallbacks) {
+                vsyncStation->RequestVsync(callback);
+            }
+            runningCount--;
+        });
+    }
+    // a queued callback must always leave a vsync requested, otherwise it would never be dispatched
+    int64_t frameCount = 0;
+    while (runningCount.load() > 0 || vsyncStation->HasRequestedVsync()) {
+        if (vsyncStation->HasRequestedVsync()) {
+            vsyncStation->VsyncCallbackInner(frameCount, frameCount);
+            frameCount++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_FALSE(vsyncStation->HasRequestedVsync());
+    EXPECT_TRUE(vsyncStation->vsyncCallbacks_.IsEmpty());
+    for (auto count : dispatchCount) {
+        EXPECT_EQ(count, 1);
+    }
+    GTEST_LOG_(INFO) << "frames: " << frameCount;
+}
+
+/**
+ * @tc.name: VsyncCallbackQueueRepeatedRegistration
+ * @tc.desc: a few callbacks registered again and again from several threads while frames are taken are never
+ *           lost and never taken twice in one frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, VsyncCallbackQueueRepeatedRegistration, TestSize.Level1)
+{
+    auto callbacks = CreateCallbacks(FRAME_CALLBACK_COUNT);
+    // set before every push and cleared when a frame takes the callback, a flag left set is a lost registration
+    std::vector<std::atomic<bool>> isPending(FRAME_CALLBACK_COUNT);
+    std::unordered_map<VsyncCallback*, int32_t> callbackIndex;
+    for (int32_t i = 0; i < FRAME_CALLBACK_COUNT; i++) {
+        isPending[i].store(false);
+        callbackIndex[callbacks[i].get()] = i;
+    }
+    VsyncCallbackQueue queue;
+    std::atomic<int32_t> runningCount { THREAD_COUNT };
+    std::vector<std::thread> producers;
+    for (int32_t i = 0; i < THREAD_COUNT; i++) {
+        producers.emplace_back([&queue, &runningCount, &callbacks, &isPending] {
+            for (int32_t j = 0; j < REGISTRATION_COUNT; j++) {
+                int32_t index = j % FRAME_CALLBACK_COUNT;
+                isPending[index].store(true);
+                queue.Push(callbacks[index]);
+            }
+            runningCount--;
+        });
+    }
+    std::vector<std::shared_ptr<VsyncCallback>> frameCallbacks;
+    bool isProducing = true;
+    while (isProducing) {
+        isProducing = runningCount.load() > 0;
+        queue.PopAll(frameCallbacks);
+        std::unordered_set<VsyncCallback*> frameSet;
+        for (const auto& callback : frameCallbacks) {
+            EXPECT_TRUE(frameSet.insert(callback.get()).second);
+            isPending[callbackIndex.at(callback.get())].store(false);
+        }
+        frameCallbacks.clear();
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.IsEmpty());
+    for (int32_t i = 0; i < FRAME_CALLBACK_COUNT; i++) {
+        EXPECT_FALSE(isPending[i].load());
+    }
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -82,6 +82,7 @@ WindowManagerService::WindowManagerService() : SystemAbility(WINDOW_MANAGER_SERV
     runner_ = AppExecFwk::EventRunner::Create(name_);
     handler_ = std::make_shared<AppExecFwk::EventHandler>(runner_);
     snapshotController_ = new SnapshotController(windowRoot_, handler_);
+    PersistentStorage::SetFlushHandler(handler_);
     int ret = HiviewDFX::Watchdog::GetInstance().AddThread(name_, handler_);
     if (ret != 0) {
         WLOGFE("Add watchdog thread failed");
@@ -799,6 +800,8 @@ void WindowManagerService::OnStop()
 {
     windowCommonEvent_->UnSubscriberEvent();
     WindowInnerManager::GetInstance().Stop();
+    PersistentStorage::Flush();
+    PersistentStorage::SetFlushHandler(nullptr);
     WLOGI("ready to stop service.");
 }
 